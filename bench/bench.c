@@ -0,0 +1,732 @@
+/*
+ * bench.c
+ * Micro-benchmarks of every public collector function (system_info.h,
+ * network_info.h, storage_info.h, socket_info.h, wireless_info.h, cgroup_info.h,
+ * cpu_topology.h, memory_info.h, block_latency.h, disk_health.h, speed_test.h,
+ * speed_history.h) and of the snapshot publication (metrics.h)
+ *
+ * For each function: cost of the first call (caches cold), then ns/call,
+ * syscalls/call (perf_event raw_syscalls tracepoint, when allowed), libc I/O
+ * calls/call and subprocesses/call (link-time shim, see bench_shim.c).
+ * Results are written as JSON; --compare turns a previous run into a
+ * regression gate (non-zero exit status).
+ *
+ * Usage: syswatch-bench [--min-time-ms N] [--output FILE] [--filter TEXT]
+ *                       [--compare BASELINE.json] [--threshold PERCENT] [--speed-test]
+ */
+
+#include "system_info.h"
+#include "network_info.h"
+#include "storage_info.h"
+#include "socket_info.h"
+#include "wireless_info.h"
+#include "cgroup_info.h"
+#include "cpu_topology.h"
+#include "memory_info.h"
+#include "block_latency.h"
+#include "disk_health.h"
+#include "speed_test.h"
+#include "speed_history.h"
+#include "mount_table.h"
+#include "volume_info.h"
+#include "filesystem_info.h"
+#include "metrics.h"
+#include "bench_shim.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+
+#define DEFAULT_MIN_TIME_MS   200
+#define DEFAULT_THRESHOLD     25.0    // % de ralentissement toléré par --compare
+#define MAX_ITERATIONS        (1UL << 20)
+#define MIN_REGRESSION_NS     50.0    // Écart absolu minimal pour signaler une régression
+
+#ifndef APP_VERSION
+#define APP_VERSION unknown
+#endif
+#define STRINGIFY(x) #x
+#define TOSTRING(x) STRINGIFY(x)
+
+typedef void (*BenchFunction)(void);
+
+typedef struct {
+    const char *name;
+    const char *module;
+    BenchFunction function;
+    bool single_shot;       // Test long ou écrivant sur disque: un seul appel, sur demande
+} BenchCase;
+
+typedef struct {
+    unsigned long iterations;
+    double first_call_ns;
+    double ns_per_call;
+    double syscalls_per_call;      // < 0 si perf_event indisponible
+    double io_calls_per_call;
+    double subprocesses_per_call;
+} BenchResult;
+
+// Empêche le compilateur d'éliminer les appels mesurés
+static volatile double bench_sink;
+
+// Arguments des fonctions paramétrées (première interface / premier disque trouvés)
+static char bench_interface[64] = "eth0";
+static PhysicalStorage bench_storage;
+static Metrics *bench_metrics;
+
+// Compteur perf_event des entrées en appel système (-1 si indisponible)
+static int syscall_counter_fd = -1;
+
+// ============================================================================
+// ENVELOPPES (une par fonction publique)
+// ============================================================================
+
+#define BENCH_NUMBER(fn) static void bench_##fn(void) { bench_sink += (double)fn(); }
+#define BENCH_STRING(fn) static void bench_##fn(void) { const char *s = fn(); bench_sink += s ? s[0] : 0; }
+
+// system_info.h
+BENCH_NUMBER(get_cpu_temperature_celsius)
+BENCH_STRING(get_hardware_model)
+BENCH_STRING(get_processor_type)
+BENCH_STRING(get_architecture_info)
+BENCH_STRING(get_cpu_cores)
+BENCH_STRING(get_gpu_info)
+BENCH_STRING(get_kernel_version)
+BENCH_STRING(get_locale_info)
+BENCH_STRING(get_distro_info)
+BENCH_STRING(get_desktop_environment)
+BENCH_STRING(get_uptime_string)
+BENCH_NUMBER(get_cpu_usage_percent)
+BENCH_NUMBER(get_gpu_usage_percent)
+BENCH_NUMBER(get_memory_usage_percent)
+BENCH_NUMBER(get_memory_available_gb)
+BENCH_NUMBER(get_memory_total_gb)
+
+static void bench_get_cpu_temperature_string(void) {
+    char buffer[64];
+    bench_sink += get_cpu_temperature_string(buffer, sizeof(buffer));
+}
+
+// network_info.h
+BENCH_STRING(get_hostname)
+BENCH_STRING(get_local_ip_address)
+BENCH_STRING(get_network_interfaces)
+BENCH_NUMBER(get_network_upload_kbps)
+BENCH_NUMBER(get_network_download_kbps)
+
+static void bench_get_interface_ip_address(void) {
+    const char *ip = get_interface_ip_address(bench_interface);
+    bench_sink += ip ? ip[0] : 0;
+}
+
+static void bench_get_network_interface_type(void) {
+    const char *type = get_network_interface_type(bench_interface);
+    bench_sink += type ? type[0] : 0;
+}
+
+static void bench_get_interface_download_kbps(void) {
+    bench_sink += get_interface_download_kbps(bench_interface);
+}
+
+static void bench_get_interface_upload_kbps(void) {
+    bench_sink += get_interface_upload_kbps(bench_interface);
+}
+
+static void bench_get_interface_packet_rates(void) {
+    InterfacePacketRates rates;
+    bench_sink += get_interface_packet_rates(bench_interface, &rates);
+}
+
+static void bench_get_interface_rates(void) {
+    const char *names[1] = { bench_interface };
+    InterfaceRates rates[1];
+    bench_sink += get_interface_rates(names, 1, rates);
+}
+
+static void bench_get_interface_link_speed_mbps(void) {
+    bench_sink += get_interface_link_speed_mbps(bench_interface);
+}
+
+static void bench_get_interface_duplex(void) {
+    bench_sink += strlen(get_interface_duplex(bench_interface));
+}
+
+// Libérer puis recréer l'état de l'interface (cache IP + compteurs précédents)
+static void bench_forget_network_interface(void) {
+    forget_network_interface(bench_interface);
+    bench_sink += get_interface_download_kbps(bench_interface);
+}
+
+// storage_info.h
+BENCH_NUMBER(get_storage_used_gb)
+BENCH_NUMBER(get_storage_available_gb)
+
+static void bench_get_physical_storages(void) {
+    int count = 0;
+    PhysicalStorage *storages = get_physical_storages(&count);
+    bench_sink += count;
+    free_physical_storages(storages);
+}
+
+static void bench_get_physical_storage_info(void) {
+    PhysicalStorage storage;
+    bench_sink += get_physical_storage_info(bench_storage.name, &storage);
+}
+
+static void bench_update_physical_storage_usage(void) {
+    PhysicalStorage storage = bench_storage;
+    bench_sink += update_physical_storage_usage(&storage);
+}
+
+static void bench_get_storage_file_speed_test(void) {
+    static FileSpeedTestResult result;
+    bench_sink += get_storage_file_speed_test(bench_storage.name, false, &result, NULL);
+}
+
+static void bench_get_file_speed_test_parameters(void) {
+    char parameters[64];            // Taille de SpeedTestRecord.parameters
+    get_file_speed_test_parameters(64, true, parameters, sizeof(parameters));
+    bench_sink += strlen(parameters);
+}
+
+static void bench_perform_storage_speed_test(void) {
+    float read_mbps = 0.0f, write_mbps = 0.0f;
+    perform_storage_speed_test(&read_mbps, &write_mbps);
+    bench_sink += read_mbps + write_mbps;
+}
+
+// socket_info.h
+static void bench_get_tcp_socket_summary(void) {
+    TcpSocketSummary summary;
+    bench_sink += get_tcp_socket_summary(&summary);
+}
+
+static void bench_get_protocol_counter_rates(void) {
+    ProtocolCounterRates rates;
+    bench_sink += get_protocol_counter_rates(&rates);
+}
+
+// wireless_info.h (false sans WiFi: mesure le coût d'un refus nl80211)
+static void bench_get_wireless_link_info(void) {
+    WirelessLinkInfo info;
+    bench_sink += get_wireless_link_info(bench_interface, &info);
+}
+
+// cgroup_info.h (-1 sans cgroup v2)
+static void bench_get_top_cgroups(void) {
+    CgroupUsage top[10];
+    bench_sink += get_top_cgroups(top, 10);
+}
+
+// cpu_topology.h (topologie lue une fois; la charge par nœud relit /proc/stat)
+static void bench_get_numa_node_usage(void) {
+    NumaNodeUsage usage[TOPOLOGY_MAX_NODES];
+    bench_sink += get_numa_node_usage(usage, TOPOLOGY_MAX_NODES);
+}
+
+static void bench_get_cpu_cache_summary(void) {
+    bench_sink += strlen(get_cpu_cache_summary());
+}
+
+// memory_info.h
+static void bench_get_memory_usage(void) {
+    MemoryUsage usage;
+    bench_sink += get_memory_usage(&usage);
+}
+
+static void bench_get_zram_usage(void) {
+    ZramUsage usage;
+    bench_sink += get_zram_usage(&usage);
+}
+
+static void bench_get_paging_rates(void) {
+    PagingRates rates;
+    bench_sink += get_paging_rates(&rates);
+}
+
+// block_latency.h
+static void bench_get_disk_latency(void) {
+    DiskLatency latency;
+    bench_sink += get_disk_latency(bench_storage.name, &latency);
+}
+
+// disk_health.h
+static void bench_get_disk_health(void) {
+    DiskHealth health;
+    bench_sink += get_disk_health(bench_storage.name, &health);
+}
+
+// speed_test.h
+static void bench_get_storage_read_speed_test(void) {
+    ReadSpeedTestResult result;
+    bench_sink += get_storage_read_speed_test(bench_storage.name, &result, NULL);
+}
+
+// speed_history.h (lecture seule: le fichier d'historique de l'utilisateur n'est pas modifié)
+static void bench_get_storage_identity(void) {
+    char identity[96];
+    bench_sink += get_storage_identity(bench_storage.name, identity, sizeof(identity));
+}
+
+// mount_table.h (table relue seulement si poll() signale un changement de mountinfo)
+static void bench_get_mount_table(void) {
+    static MountEntry entries[256];  // ~130 Ko: hors de la pile
+    bench_sink += get_mount_table(entries, 256);
+}
+
+static void bench_get_storage_filesystems(void) {
+    MountEntry entries[8];
+    bench_sink += get_storage_filesystems(bench_storage.name, entries, 8);
+}
+
+// volume_info.h: /proc/diskstats + fichiers md / dm de chaque volume
+static void bench_get_logical_volumes(void) {
+    static LogicalVolume volumes[32];  // ~30 Ko: hors de la pile
+    bench_sink += get_logical_volumes(volumes, 32);
+}
+
+// filesystem_info.h: table des montages + statvfs() limité à un par période et par montage
+static void bench_get_filesystem_usage(void) {
+    static FilesystemUsage filesystems[64];  // ~50 Ko: hors de la pile
+    bench_sink += get_filesystem_usage(filesystems, 64);
+}
+
+// metrics.h: échantillonnage + publication, et copie d'un instantané par un lecteur
+static void bench_metrics_collect_cpu(void) {
+    metrics_collect_cpu(bench_metrics);
+}
+
+static void bench_metrics_collect_sensors(void) {
+    metrics_collect_sensors(bench_metrics);
+}
+
+static void bench_metrics_collect_network(void) {
+    metrics_collect_network(bench_metrics);
+}
+
+static void bench_metrics_read_cpu(void) {
+    CpuSnapshot snapshot;
+    bench_sink += (double)metrics_read_cpu(bench_metrics, &snapshot);
+}
+
+static void bench_metrics_read_network(void) {
+    static NetworkSnapshot snapshot;  // ~35 Ko: hors de la pile
+    bench_sink += (double)metrics_read_network(bench_metrics, &snapshot);
+}
+
+#define CASE(module, fn) { #fn, module, bench_##fn, false }
+#define SINGLE_SHOT_CASE(module, fn) { #fn, module, bench_##fn, true }
+
+static const BenchCase bench_cases[] = {
+    CASE("system_info", get_cpu_temperature_celsius),
+    CASE("system_info", get_cpu_temperature_string),
+    CASE("system_info", get_hardware_model),
+    CASE("system_info", get_processor_type),
+    CASE("system_info", get_architecture_info),
+    CASE("system_info", get_cpu_cores),
+    CASE("system_info", get_gpu_info),
+    CASE("system_info", get_kernel_version),
+    CASE("system_info", get_locale_info),
+    CASE("system_info", get_distro_info),
+    CASE("system_info", get_desktop_environment),
+    CASE("system_info", get_uptime_string),
+    CASE("system_info", get_cpu_usage_percent),
+    CASE("system_info", get_gpu_usage_percent),
+    CASE("system_info", get_memory_usage_percent),
+    CASE("system_info", get_memory_available_gb),
+    CASE("system_info", get_memory_total_gb),
+    CASE("network_info", get_hostname),
+    CASE("network_info", get_local_ip_address),
+    CASE("network_info", get_interface_ip_address),
+    CASE("network_info", get_network_interface_type),
+    CASE("network_info", get_network_interfaces),
+    CASE("network_info", get_network_upload_kbps),
+    CASE("network_info", get_network_download_kbps),
+    CASE("network_info", get_interface_download_kbps),
+    CASE("network_info", get_interface_upload_kbps),
+    CASE("network_info", get_interface_packet_rates),
+    CASE("network_info", get_interface_rates),
+    CASE("network_info", get_interface_link_speed_mbps),
+    CASE("network_info", get_interface_duplex),
+    CASE("network_info", forget_network_interface),
+    CASE("storage_info", get_physical_storages),
+    CASE("storage_info", get_physical_storage_info),
+    CASE("storage_info", update_physical_storage_usage),
+    CASE("storage_info", get_storage_used_gb),
+    CASE("storage_info", get_storage_available_gb),
+    SINGLE_SHOT_CASE("storage_info", get_storage_file_speed_test),
+    CASE("storage_info", get_file_speed_test_parameters),
+    SINGLE_SHOT_CASE("storage_info", perform_storage_speed_test),
+    CASE("socket_info", get_tcp_socket_summary),
+    CASE("socket_info", get_protocol_counter_rates),
+    CASE("wireless_info", get_wireless_link_info),
+    CASE("cgroup_info", get_top_cgroups),
+    CASE("cpu_topology", get_numa_node_usage),
+    CASE("cpu_topology", get_cpu_cache_summary),
+    CASE("memory_info", get_memory_usage),
+    CASE("memory_info", get_zram_usage),
+    CASE("memory_info", get_paging_rates),
+    CASE("block_latency", get_disk_latency),
+    CASE("disk_health", get_disk_health),
+    SINGLE_SHOT_CASE("speed_test", get_storage_read_speed_test),
+    CASE("speed_history", get_storage_identity),
+    CASE("mount_table", get_mount_table),
+    CASE("mount_table", get_storage_filesystems),
+    CASE("volume_info", get_logical_volumes),
+    CASE("filesystem_info", get_filesystem_usage),
+    CASE("metrics", metrics_collect_cpu),
+    CASE("metrics", metrics_collect_sensors),
+    CASE("metrics", metrics_collect_network),
+    CASE("metrics", metrics_read_cpu),
+    CASE("metrics", metrics_read_network),
+};
+
+#define BENCH_CASE_COUNT (sizeof(bench_cases) / sizeof(bench_cases[0]))
+
+// ============================================================================
+// MESURE
+// ============================================================================
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+// Identifiant du tracepoint raw_syscalls:sys_enter (tracefs ou debugfs)
+static long read_sys_enter_tracepoint_id(void) {
+    static const char *paths[] = {
+        "/sys/kernel/tracing/events/raw_syscalls/sys_enter/id",
+        "/sys/kernel/debug/tracing/events/raw_syscalls/sys_enter/id",
+    };
+
+    for (size_t i = 0; i < sizeof(paths) / sizeof(paths[0]); i++) {
+        FILE *fp = fopen(paths[i], "r");
+        if (fp == NULL) {
+            continue;
+        }
+        long id = -1;
+        if (fscanf(fp, "%ld", &id) != 1) {
+            id = -1;
+        }
+        fclose(fp);
+        if (id >= 0) {
+            return id;
+        }
+    }
+    return -1;
+}
+
+// Compter les appels système de ce processus seulement (pas des enfants popen)
+static void open_syscall_counter(void) {
+    long id = read_sys_enter_tracepoint_id();
+    if (id < 0) {
+        return;
+    }
+
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.type = PERF_TYPE_TRACEPOINT;
+    attr.size = sizeof(attr);
+    attr.config = (uint64_t)id;
+    attr.disabled = 0;
+    attr.inherit = 0;
+    attr.exclude_kernel = 0;
+
+    syscall_counter_fd = (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+}
+
+static long long read_syscall_counter(void) {
+    uint64_t value = 0;
+    if (syscall_counter_fd < 0 || read(syscall_counter_fd, &value, sizeof(value)) != sizeof(value)) {
+        return -1;
+    }
+    return (long long)value;
+}
+
+static void run_case(const BenchCase *bench_case, unsigned long min_time_ms, BenchResult *result) {
+    memset(result, 0, sizeof(BenchResult));
+
+    // Premier appel: caches statiques encore vides
+    uint64_t start = now_ns();
+    bench_case->function();
+    result->first_call_ns = (double)(now_ns() - start);
+
+    long long syscalls_before = read_syscall_counter();
+    ShimCounters shim_before;
+    shim_get_counters(&shim_before);
+
+    // Régime établi: lots doublés jusqu'à couvrir min_time_ms
+    uint64_t min_time_ns = (uint64_t)min_time_ms * 1000000ULL;
+    uint64_t elapsed = 0;
+    unsigned long iterations = 0;
+    unsigned long batch = 1;
+
+    start = now_ns();
+    do {
+        for (unsigned long i = 0; i < batch; i++) {
+            bench_case->function();
+        }
+        iterations += batch;
+        batch *= 2;
+        elapsed = now_ns() - start;
+    } while (!bench_case->single_shot && elapsed < min_time_ns && iterations < MAX_ITERATIONS);
+
+    ShimCounters shim_after;
+    shim_get_counters(&shim_after);
+    long long syscalls_after = read_syscall_counter();
+
+    result->iterations = iterations;
+    result->ns_per_call = (double)elapsed / iterations;
+    result->io_calls_per_call = (double)(shim_after.io_calls - shim_before.io_calls) / iterations;
+    result->subprocesses_per_call = (double)(shim_after.subprocesses - shim_before.subprocesses) / iterations;
+    result->syscalls_per_call = (syscalls_before >= 0 && syscalls_after >= 0)
+                                ? (double)(syscalls_after - syscalls_before) / iterations
+                                : -1.0;
+}
+
+// Choisir une vraie interface et un vrai disque pour les fonctions paramétrées
+static void pick_bench_arguments(void) {
+    const char *interface = getenv("SYSWATCH_BENCH_INTERFACE");
+    if (interface == NULL) {
+        // Format: "eth0 (Ethernet), wlan0 (WiFi)"
+        const char *list = get_network_interfaces();
+        const char *end = list != NULL ? strchr(list, ' ') : NULL;
+        if (end != NULL && (size_t)(end - list) < sizeof(bench_interface)) {
+            memcpy(bench_interface, list, end - list);
+            bench_interface[end - list] = '\0';
+        }
+    } else {
+        snprintf(bench_interface, sizeof(bench_interface), "%s", interface);
+    }
+
+    memset(&bench_storage, 0, sizeof(bench_storage));
+    snprintf(bench_storage.name, sizeof(bench_storage.name), "sda");
+
+    int count = 0;
+    PhysicalStorage *storages = get_physical_storages(&count);
+    if (storages != NULL && count > 0) {
+        bench_storage = storages[0];
+    }
+    free_physical_storages(storages);
+
+    // Instantanés: l'interface choisie est suivie par le collecteur réseau
+    bench_metrics = metrics_create();
+    if (bench_metrics == NULL) {
+        fprintf(stderr, "bench: cannot allocate metrics snapshots\n");
+        exit(1);
+    }
+    metrics_track_interface(bench_metrics, bench_interface);
+}
+
+// ============================================================================
+// RAPPORT JSON ET COMPARAISON
+// ============================================================================
+
+static void write_json(FILE *out, const BenchResult *results, const bool *selected,
+                       unsigned long min_time_ms) {
+    fprintf(out, "{\n");
+    fprintf(out, "  \"tool\": \"syswatch-bench\",\n");
+    fprintf(out, "  \"version\": \"%s\",\n", TOSTRING(APP_VERSION));
+    fprintf(out, "  \"min_time_ms\": %lu,\n", min_time_ms);
+    fprintf(out, "  \"syscall_counter\": \"%s\",\n", syscall_counter_fd >= 0 ? "perf_event" : "unavailable");
+    fprintf(out, "  \"interface\": \"%s\",\n", bench_interface);
+    fprintf(out, "  \"storage\": \"%s\",\n", bench_storage.name);
+    fprintf(out, "  \"results\": [\n");
+
+    bool first = true;
+    for (size_t i = 0; i < BENCH_CASE_COUNT; i++) {
+        if (!selected[i]) {
+            continue;
+        }
+        const BenchResult *r = &results[i];
+
+        char syscalls[32];
+        if (r->syscalls_per_call < 0) {
+            snprintf(syscalls, sizeof(syscalls), "null");
+        } else {
+            snprintf(syscalls, sizeof(syscalls), "%.2f", r->syscalls_per_call);
+        }
+
+        // Un objet par ligne: relu simplement par --compare
+        fprintf(out, "%s    {\"name\": \"%s\", \"module\": \"%s\", \"iterations\": %lu, "
+                "\"first_call_ns\": %.0f, \"ns_per_call\": %.1f, \"syscalls_per_call\": %s, "
+                "\"io_calls_per_call\": %.2f, \"subprocesses_per_call\": %.2f}",
+                first ? "" : ",\n", bench_cases[i].name, bench_cases[i].module, r->iterations,
+                r->first_call_ns, r->ns_per_call, syscalls,
+                r->io_calls_per_call, r->subprocesses_per_call);
+        first = false;
+    }
+
+    fprintf(out, "\n  ]\n}\n");
+}
+
+// Lire un champ numérique d'une ligne de résultat ("key": valeur)
+static bool read_json_number(const char *line, const char *key, double *value) {
+    char pattern[64];
+    snprintf(pattern, sizeof(pattern), "\"%s\": ", key);
+    const char *field = strstr(line, pattern);
+    if (field == NULL) {
+        return false;
+    }
+    return sscanf(field + strlen(pattern), "%lf", value) == 1;
+}
+
+// Comparer au fichier de référence; retourne le nombre de régressions
+static int compare_with_baseline(const char *path, const BenchResult *results, const bool *selected,
+                                 double threshold_percent) {
+    FILE *fp = fopen(path, "r");
+    if (fp == NULL) {
+        fprintf(stderr, "bench: cannot open baseline %s\n", path);
+        return -1;
+    }
+
+    int regressions = 0;
+    char line[1024];
+    while (fgets(line, sizeof(line), fp) != NULL) {
+        char name[64];
+        const char *name_field = strstr(line, "\"name\": \"");
+        if (name_field == NULL || sscanf(name_field + 9, "%63[^\"]", name) != 1) {
+            continue;
+        }
+
+        for (size_t i = 0; i < BENCH_CASE_COUNT; i++) {
+            if (!selected[i] || strcmp(bench_cases[i].name, name) != 0) {
+                continue;
+            }
+
+            double base_ns = 0.0, base_subprocesses = 0.0, base_syscalls = 0.0;
+            if (!read_json_number(line, "ns_per_call", &base_ns)) {
+                break;
+            }
+            read_json_number(line, "subprocesses_per_call", &base_subprocesses);
+
+            const BenchResult *r = &results[i];
+            double change = base_ns > 0.0 ? (r->ns_per_call - base_ns) * 100.0 / base_ns : 0.0;
+            // Les écarts de quelques ns (fonctions factices, cache) ne sont que du bruit
+            bool slower = change > threshold_percent && r->ns_per_call - base_ns > MIN_REGRESSION_NS;
+            // Lancer plus de processus ou d'appels système est toujours une régression
+            bool more_processes = r->subprocesses_per_call > base_subprocesses + 0.01;
+            bool more_syscalls = r->syscalls_per_call >= 0 &&
+                                 read_json_number(line, "syscalls_per_call", &base_syscalls) &&
+                                 r->syscalls_per_call > base_syscalls * 1.05 + 0.5;
+
+            if (slower || more_processes || more_syscalls) {
+                regressions++;
+                fprintf(stderr, "REGRESSION %-32s %10.1f -> %10.1f ns (%+.1f%%)%s%s\n",
+                        name, base_ns, r->ns_per_call, change,
+                        more_processes ? ", more subprocesses" : "",
+                        more_syscalls ? ", more syscalls" : "");
+            } else {
+                fprintf(stderr, "ok         %-32s %10.1f -> %10.1f ns (%+.1f%%)\n",
+                        name, base_ns, r->ns_per_call, change);
+            }
+            break;
+        }
+    }
+
+    fclose(fp);
+    return regressions;
+}
+
+static void print_usage(const char *program) {
+    fprintf(stderr,
+            "Usage: %s [--min-time-ms N] [--output FILE] [--filter TEXT]\n"
+            "          [--compare BASELINE.json] [--threshold PERCENT] [--speed-test]\n",
+            program);
+}
+
+int main(int argc, char *argv[]) {
+    unsigned long min_time_ms = DEFAULT_MIN_TIME_MS;
+    double threshold = DEFAULT_THRESHOLD;
+    const char *output_path = NULL;
+    const char *baseline_path = NULL;
+    const char *filter = NULL;
+    bool speed_test = false;
+
+    for (int i = 1; i < argc; i++) {
+        bool has_value = i + 1 < argc;
+        if (strcmp(argv[i], "--min-time-ms") == 0 && has_value) {
+            min_time_ms = strtoul(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--output") == 0 && has_value) {
+            output_path = argv[++i];
+        } else if (strcmp(argv[i], "--compare") == 0 && has_value) {
+            baseline_path = argv[++i];
+        } else if (strcmp(argv[i], "--threshold") == 0 && has_value) {
+            threshold = strtod(argv[++i], NULL);
+        } else if (strcmp(argv[i], "--filter") == 0 && has_value) {
+            filter = argv[++i];
+        } else if (strcmp(argv[i], "--speed-test") == 0) {
+            speed_test = true;
+        } else {
+            print_usage(argv[0]);
+            return 2;
+        }
+    }
+
+    open_syscall_counter();
+    pick_bench_arguments();
+
+    static BenchResult results[BENCH_CASE_COUNT];
+    bool selected[BENCH_CASE_COUNT];
+
+    fprintf(stderr, "%-32s %10s %14s %14s %10s %10s %8s\n",
+            "function", "iters", "first (ns)", "ns/call", "syscalls", "io calls", "procs");
+
+    for (size_t i = 0; i < BENCH_CASE_COUNT; i++) {
+        const BenchCase *bench_case = &bench_cases[i];
+        selected[i] = (filter == NULL || strstr(bench_case->name, filter) != NULL) &&
+                      (!bench_case->single_shot || speed_test);
+        if (!selected[i]) {
+            continue;
+        }
+
+        run_case(bench_case, min_time_ms, &results[i]);
+
+        const BenchResult *r = &results[i];
+        char syscalls[16];
+        if (r->syscalls_per_call < 0) {
+            snprintf(syscalls, sizeof(syscalls), "n/a");
+        } else {
+            snprintf(syscalls, sizeof(syscalls), "%.1f", r->syscalls_per_call);
+        }
+        fprintf(stderr, "%-32s %10lu %14.0f %14.1f %10s %10.1f %8.2f\n",
+                bench_case->name, r->iterations, r->first_call_ns, r->ns_per_call,
+                syscalls, r->io_calls_per_call, r->subprocesses_per_call);
+    }
+
+    FILE *out = stdout;
+    if (output_path != NULL) {
+        out = fopen(output_path, "w");
+        if (out == NULL) {
+            fprintf(stderr, "bench: cannot write %s\n", output_path);
+            return 1;
+        }
+    }
+    write_json(out, results, selected, min_time_ms);
+    if (out != stdout) {
+        fclose(out);
+    }
+
+    if (syscall_counter_fd >= 0) {
+        close(syscall_counter_fd);
+    }
+    metrics_destroy(bench_metrics);
+
+    if (baseline_path != NULL) {
+        int regressions = compare_with_baseline(baseline_path, results, selected, threshold);
+        if (regressions != 0) {
+            fprintf(stderr, "bench: %d regression(s) against %s (threshold %.0f%%)\n",
+                    regressions < 0 ? 1 : regressions, baseline_path, threshold);
+            return 1;
+        }
+        fprintf(stderr, "bench: no regression against %s\n", baseline_path);
+    }
+
+    return 0;
+}
@@ -0,0 +1,176 @@
+/*
+ * bench_shim.c
+ * Counting wrappers around libc I/O and process-spawning calls
+ *
+ * Linked with -Wl,--wrap=<symbol> (see BENCH_WRAPPED in the Makefile): every call
+ * to <symbol> from the collectors lands in __wrap_<symbol>, which counts it and
+ * forwards to the real libc function (__real_<symbol>).
+ */
+
+#define _GNU_SOURCE  // O_TMPFILE
+
+#include "bench_shim.h"
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <stdlib.h>
+#include <fcntl.h>
+#include <dirent.h>
+#include <spawn.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/statvfs.h>
+
+static ShimCounters counters;
+
+void shim_get_counters(ShimCounters *out) {
+    *out = counters;
+}
+
+// open()/openat() only carry a mode argument with O_CREAT or O_TMPFILE
+static bool open_needs_mode(int flags) {
+    return (flags & O_CREAT) != 0 || (flags & O_TMPFILE) == O_TMPFILE;
+}
+
+// ============================================================================
+// I/O
+// ============================================================================
+
+int __real_open(const char *path, int flags, ...);
+int __wrap_open(const char *path, int flags, ...) {
+    mode_t mode = 0;
+    if (open_needs_mode(flags)) {
+        va_list args;
+        va_start(args, flags);
+        mode = (mode_t)va_arg(args, int);
+        va_end(args);
+    }
+
+    counters.io_calls++;
+    return __real_open(path, flags, mode);
+}
+
+int __real_openat(int dirfd, const char *path, int flags, ...);
+int __wrap_openat(int dirfd, const char *path, int flags, ...) {
+    mode_t mode = 0;
+    if (open_needs_mode(flags)) {
+        va_list args;
+        va_start(args, flags);
+        mode = (mode_t)va_arg(args, int);
+        va_end(args);
+    }
+
+    counters.io_calls++;
+    return __real_openat(dirfd, path, flags, mode);
+}
+
+ssize_t __real_read(int fd, void *buffer, size_t count);
+ssize_t __wrap_read(int fd, void *buffer, size_t count) {
+    counters.io_calls++;
+    return __real_read(fd, buffer, count);
+}
+
+int __real_close(int fd);
+int __wrap_close(int fd) {
+    counters.io_calls++;
+    return __real_close(fd);
+}
+
+FILE* __real_fopen(const char *path, const char *mode);
+FILE* __wrap_fopen(const char *path, const char *mode) {
+    counters.io_calls++;
+    return __real_fopen(path, mode);
+}
+
+int __real_fclose(FILE *stream);
+int __wrap_fclose(FILE *stream) {
+    counters.io_calls++;
+    return __real_fclose(stream);
+}
+
+DIR* __real_opendir(const char *path);
+DIR* __wrap_opendir(const char *path) {
+    counters.io_calls++;
+    return __real_opendir(path);
+}
+
+int __real_stat(const char *path, struct stat *buf);
+int __wrap_stat(const char *path, struct stat *buf) {
+    counters.io_calls++;
+    return __real_stat(path, buf);
+}
+
+int __real_lstat(const char *path, struct stat *buf);
+int __wrap_lstat(const char *path, struct stat *buf) {
+    counters.io_calls++;
+    return __real_lstat(path, buf);
+}
+
+int __real_statvfs(const char *path, struct statvfs *buf);
+int __wrap_statvfs(const char *path, struct statvfs *buf) {
+    counters.io_calls++;
+    return __real_statvfs(path, buf);
+}
+
+int __real_ioctl(int fd, unsigned long request, ...);
+int __wrap_ioctl(int fd, unsigned long request, ...) {
+    va_list args;
+    va_start(args, request);
+    void *argument = va_arg(args, void *);
+    va_end(args);
+
+    counters.io_calls++;
+    return __real_ioctl(fd, request, argument);
+}
+
+int __real_socket(int domain, int type, int protocol);
+int __wrap_socket(int domain, int type, int protocol) {
+    counters.io_calls++;
+    return __real_socket(domain, type, protocol);
+}
+
+// ============================================================================
+// SOUS-PROCESSUS
+// ============================================================================
+
+FILE* __real_popen(const char *command, const char *mode);
+FILE* __wrap_popen(const char *command, const char *mode) {
+    counters.subprocesses++;
+    return __real_popen(command, mode);
+}
+
+int __real_pclose(FILE *stream);
+int __wrap_pclose(FILE *stream) {
+    counters.io_calls++;
+    return __real_pclose(stream);
+}
+
+int __real_system(const char *command);
+int __wrap_system(const char *command) {
+    counters.subprocesses++;
+    return __real_system(command);
+}
+
+pid_t __real_fork(void);
+pid_t __wrap_fork(void) {
+    counters.subprocesses++;
+    return __real_fork();
+}
+
+int __real_posix_spawn(pid_t *pid, const char *path, const posix_spawn_file_actions_t *actions,
+                       const posix_spawnattr_t *attr, char *const argv[], char *const envp[]);
+int __wrap_posix_spawn(pid_t *pid, const char *path, const posix_spawn_file_actions_t *actions,
+                       const posix_spawnattr_t *attr, char *const argv[], char *const envp[]) {
+    counters.subprocesses++;
+    return __real_posix_spawn(pid, path, actions, attr, argv, envp);
+}
+
+int __real_posix_spawnp(pid_t *pid, const char *file, const posix_spawn_file_actions_t *actions,
+                        const posix_spawnattr_t *attr, char *const argv[], char *const envp[]);
+int __wrap_posix_spawnp(pid_t *pid, const char *file, const posix_spawn_file_actions_t *actions,
+                        const posix_spawnattr_t *attr, char *const argv[], char *const envp[]) {
+    counters.subprocesses++;
+    return __real_posix_spawnp(pid, file, actions, attr, argv, envp);
+}
@@ -0,0 +1,23 @@
+/*
+ * bench_shim.h
+ * Compteurs d'appels libc interceptés à l'édition de liens (-Wl,--wrap=...)
+ *
+ * Seuls les appels faits depuis le code lié sont comptés (pas ceux internes à la libc,
+ * ex: le read() d'un fgets()). Le nombre exact d'appels système vient de perf_event
+ * quand le noyau l'autorise; ces compteurs restent disponibles partout.
+ */
+
+#ifndef BENCH_SHIM_H
+#define BENCH_SHIM_H
+
+typedef struct {
+    unsigned long long io_calls;       // open, read, fopen, opendir, stat, ioctl, socket...
+    unsigned long long subprocesses;   // popen, system, fork, posix_spawn
+} ShimCounters;
+
+/*
+ * Copier les compteurs courants (cumulés depuis le démarrage)
+ */
+void shim_get_counters(ShimCounters *counters);
+
+#endif // BENCH_SHIM_H
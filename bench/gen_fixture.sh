@@ -0,0 +1,447 @@
+#!/bin/sh
+# gen_fixture.sh
+# Génère une arborescence /proc + /sys + /etc fictive pour les collecteurs
+# (utilisée avec SYSWATCH_ROOT, voir include/sysroot.h)
+#
+# Usage: bench/gen_fixture.sh [-c CPUS] [-i INTERFACES] [-d DISKS] DESTINATION
+# Défaut: 256 CPU, 100 interfaces, 64 disques
+
+set -eu
+
+CPUS=256
+INTERFACES=100
+DISKS=64
+
+usage() {
+    echo "Usage: $0 [-c CPUS] [-i INTERFACES] [-d DISKS] DESTINATION" >&2
+    exit 2
+}
+
+while getopts "c:i:d:h" option; do
+    case "$option" in
+        c) CPUS=$OPTARG ;;
+        i) INTERFACES=$OPTARG ;;
+        d) DISKS=$OPTARG ;;
+        *) usage ;;
+    esac
+done
+shift $((OPTIND - 1))
+[ $# -eq 1 ] || usage
+
+ROOT=$1
+# SÉCURITÉ: ne jamais écraser autre chose qu'une fixture générée par ce script
+if [ -e "$ROOT" ] && [ ! -f "$ROOT/.syswatch-fixture" ]; then
+    echo "$ROOT exists and is not a SysWatch fixture, refusing to overwrite" >&2
+    exit 1
+fi
+rm -rf "$ROOT"
+mkdir -p "$ROOT/proc/net" "$ROOT/etc" "$ROOT/sys/class/net" "$ROOT/sys/block" \
+         "$ROOT/sys/class/thermal/thermal_zone0" "$ROOT/sys/devices/system/cpu"
+touch "$ROOT/.syswatch-fixture"
+
+# Nom de disque SCSI à partir d'un index: 0 -> sda, 25 -> sdz, 26 -> sdaa
+sd_name() {
+    index=$1
+    letters=""
+    while :; do
+        letters=$(printf "\\$(printf '%03o' $((97 + index % 26)))")$letters
+        index=$((index / 26 - 1))
+        [ $index -ge 0 ] || break
+    done
+    echo "sd$letters"
+}
+
+# ============================================================================
+# /etc
+# ============================================================================
+
+echo "fixture-host" > "$ROOT/etc/hostname"
+cat > "$ROOT/etc/os-release" <<EOF
+PRETTY_NAME="SysWatch Fixture Linux 1.0"
+NAME="SysWatch Fixture Linux"
+VERSION_ID="1.0"
+ID=fixture
+EOF
+
+# ============================================================================
+# /proc
+# ============================================================================
+
+echo "Linux version 6.6.0-fixture (builder@fixture) (gcc 12.2.0) #1 SMP PREEMPT" > "$ROOT/proc/version"
+echo "123456.78 987654.32" > "$ROOT/proc/uptime"
+
+cat > "$ROOT/proc/meminfo" <<EOF
+MemTotal:       263921344 kB
+MemFree:        101234560 kB
+MemAvailable:   198765432 kB
+Buffers:          1234560 kB
+Cached:          80123456 kB
+SwapCached:         12345 kB
+Active:          90123456 kB
+Inactive:        50123456 kB
+SwapTotal:        8388604 kB
+SwapFree:         8123456 kB
+Zswap:              65536 kB
+Zswapped:          196608 kB
+Dirty:               1234 kB
+EOF
+
+# /proc/vmstat: ~180 compteurs sur un vrai noyau, ceux lus par SysWatch dispersés parmi d'autres
+{
+    for name in nr_free_pages nr_zone_inactive_anon nr_zone_active_anon nr_zone_inactive_file \
+                nr_zone_active_file nr_mlock nr_bounce nr_zspages nr_free_cma numa_hit numa_miss \
+                numa_foreign numa_interleave numa_local numa_other nr_inactive_anon nr_active_anon \
+                nr_inactive_file nr_active_file nr_isolated_anon nr_isolated_file workingset_nodes; do
+        echo "$name 123456"
+    done
+    echo "pgpgin 987654321"
+    echo "pgpgout 123456789"
+    echo "pswpin 12345"
+    echo "pswpout 23456"
+    for name in pgalloc_dma pgalloc_dma32 pgalloc_normal pgalloc_movable pgfree pgactivate \
+                pgdeactivate pglazyfree pgfault; do
+        echo "$name 98765432"
+    done
+    echo "pgmajfault 34567"
+    for name in pgrefill pgsteal_kswapd pgsteal_direct pgscan_kswapd pgscan_direct slabs_scanned \
+                kswapd_inodesteal pageoutrun pgrotated drop_pagecache drop_slab; do
+        echo "$name 4567"
+    done
+    echo "oom_kill 2"
+    echo "compact_migrate_scanned 123456"
+    echo "compact_free_scanned 234567"
+    echo "compact_isolated 3456"
+    echo "compact_stall 45"
+    echo "compact_fail 12"
+    echo "compact_success 33"
+    for name in htlb_buddy_alloc_success htlb_buddy_alloc_fail unevictable_pgs_culled \
+                thp_fault_alloc thp_fault_fallback thp_collapse_alloc swap_ra swap_ra_hit; do
+        echo "$name 0"
+    done
+} > "$ROOT/proc/vmstat"
+
+# /proc/stat: ligne agrégée + une ligne par CPU
+{
+    echo "cpu  $((CPUS * 10000)) $((CPUS * 100)) $((CPUS * 5000)) $((CPUS * 80000)) $((CPUS * 300)) 0 $((CPUS * 50)) 0 0 0"
+    cpu=0
+    while [ $cpu -lt "$CPUS" ]; do
+        echo "cpu$cpu 10000 100 5000 80000 300 0 50 0 0 0"
+        cpu=$((cpu + 1))
+    done
+    echo "intr 123456789"
+    echo "ctxt 987654321"
+    echo "btime 1700000000"
+    echo "processes 123456"
+    echo "procs_running 3"
+    echo "procs_blocked 0"
+} > "$ROOT/proc/stat"
+
+# /proc/cpuinfo + topologie /sys/devices/system/cpu
+{
+    cpu=0
+    while [ $cpu -lt "$CPUS" ]; do
+        echo "processor	: $cpu"
+        echo "vendor_id	: GenuineIntel"
+        echo "model name	: Fixture Xeon(R) CPU @ 2.10GHz"
+        echo "cpu MHz		: 2100.000"
+        echo ""
+        mkdir -p "$ROOT/sys/devices/system/cpu/cpu$cpu/topology"
+        echo $((cpu % (CPUS / 2 > 0 ? CPUS / 2 : 1))) > "$ROOT/sys/devices/system/cpu/cpu$cpu/topology/core_id"
+        echo $((cpu * 2 / CPUS)) > "$ROOT/sys/devices/system/cpu/cpu$cpu/topology/physical_package_id"
+        cpu=$((cpu + 1))
+    done
+} > "$ROOT/proc/cpuinfo"
+echo "0-$((CPUS - 1))" > "$ROOT/sys/devices/system/cpu/online"
+
+# Deux nœuds NUMA (un par socket) et caches du CPU 0: L1d/L1i/L2 par cœur, L3 par socket
+half=$((CPUS / 2 > 0 ? CPUS / 2 : 1))
+for node in 0 1; do
+    dir="$ROOT/sys/devices/system/node/node$node"
+    mkdir -p "$dir"
+    first=$((node * half))
+    last=$((node * half + half - 1))
+    [ $last -ge "$CPUS" ] && last=$((CPUS - 1))
+    if [ $first -le $last ]; then
+        echo "$first-$last" > "$dir/cpulist"
+    else
+        echo "" > "$dir/cpulist"   # Nœud sans CPU (mémoire seule)
+    fi
+    cat > "$dir/meminfo" <<EOF
+Node $node MemTotal:       131960672 kB
+Node $node MemFree:         50617280 kB
+Node $node MemUsed:         81343392 kB
+Node $node Active:          45061728 kB
+Node $node FilePages:       40061728 kB
+Node $node Slab:             2345678 kB
+Node $node SReclaimable:     1234567 kB
+EOF
+done
+add_cache() {
+    dir="$ROOT/sys/devices/system/cpu/cpu0/cache/index$1"
+    mkdir -p "$dir"
+    echo "$2" > "$dir/level"
+    echo "$3" > "$dir/type"
+    echo "$4" > "$dir/size"
+    echo "$5" > "$dir/shared_cpu_list"
+}
+add_cache 0 1 Data 48K 0
+add_cache 1 1 Instruction 32K 0
+add_cache 2 2 Unified 2048K 0
+add_cache 3 3 Unified 36864K "0-$((half - 1))"
+
+echo "52000" > "$ROOT/sys/class/thermal/thermal_zone0/temp"
+
+# ============================================================================
+# Réseau: /proc/net/dev + /sys/class/net
+# ============================================================================
+
+add_interface() {
+    name=$1
+    type=$2        # 1 = Ethernet/WiFi, 772 = loopback
+    physical=$3    # 1 = lien "device" vers un périphérique PCI
+    devtype=${4:-} # DEVTYPE du uevent (interfaces logiques: vlan, wireguard, bond)
+    dir="$ROOT/sys/class/net/$name"
+    mkdir -p "$dir"
+    echo "$type" > "$dir/type"
+    echo "up" > "$dir/operstate"
+    if [ -n "$devtype" ]; then
+        printf "DEVTYPE=%s\nINTERFACE=%s\n" "$devtype" "$name" > "$dir/uevent"
+    else
+        printf "INTERFACE=%s\n" "$name" > "$dir/uevent"
+    fi
+    if [ "$physical" -eq 1 ]; then
+        mkdir -p "$ROOT/sys/devices/pci0000:00/net-$name"
+        ln -s "../../../devices/pci0000:00/net-$name" "$dir/device"
+    fi
+}
+
+{
+    echo "Inter-|   Receive                                                |  Transmit"
+    echo " face |bytes    packets errs drop fifo frame compressed multicast|bytes    packets errs drop fifo colls carrier compressed"
+    echo "    lo: 123456789 123456 0 0 0 0 0 0 123456789 123456 0 0 0 0 0 0"
+    add_interface lo 772 0
+
+    iface=0
+    while [ $iface -lt "$INTERFACES" ]; do
+        # Un quart de WiFi, le reste en Ethernet
+        if [ $((iface % 4)) -eq 3 ]; then
+            name="wlan$iface"
+            add_interface "$name" 1 1
+            mkdir -p "$ROOT/sys/class/net/$name/wireless"
+        else
+            name="eth$iface"
+            add_interface "$name" 1 1
+            echo 1000 > "$ROOT/sys/class/net/$name/speed"
+            echo full > "$ROOT/sys/class/net/$name/duplex"
+        fi
+        printf "%6s: %d %d 0 0 0 0 0 0 %d %d 0 0 0 0 0 0\n" "$name" \
+            $(( (iface + 1) * 1000000007 )) $(( (iface + 1) * 1000003 )) \
+            $(( (iface + 1) * 500000003 )) $(( (iface + 1) * 500009 ))
+        iface=$((iface + 1))
+    done
+
+    # Interfaces logiques affichées: VPN (65534 = ARPHRD_NONE), VLAN, agrégat
+    add_interface wg0 65534 0 wireguard
+    add_interface tun0 65534 0
+    echo 0x1001 > "$ROOT/sys/class/net/tun0/tun_flags"
+    add_interface eth0.100 1 0 vlan
+    add_interface bond0 1 0 bond
+    for name in wg0 tun0 eth0.100 bond0; do
+        printf "%8s: 5000000 4000 0 0 0 0 0 0 3000000 3500 0 0 0 0 0 0\n" "$name"
+    done
+
+    # Interfaces virtuelles: ignorées par les collecteurs
+    for name in docker0 veth1234567 br-0123456789ab; do
+        add_interface "$name" 1 0
+        echo "$name: 1000 10 0 0 0 0 0 0 1000 10 0 0 0 0 0 0"
+    done
+} > "$ROOT/proc/net/dev"
+
+# Compteurs de protocoles (lignes d'en-têtes puis de valeurs, MaxConn négatif)
+cat > "$ROOT/proc/net/snmp" <<EOF
+Ip: Forwarding DefaultTTL InReceives InHdrErrors InAddrErrors ForwDatagrams InUnknownProtos InDiscards InDelivers OutRequests OutDiscards OutNoRoutes ReasmTimeout ReasmReqds ReasmOKs ReasmFails FragOKs FragFails FragCreates
+Ip: 1 64 987654321 0 12 0 0 0 987654000 876543210 4 0 0 0 0 0 0 0 0
+Tcp: RtoAlgorithm RtoMin RtoMax MaxConn ActiveOpens PassiveOpens AttemptFails EstabResets CurrEstab InSegs OutSegs RetransSegs InErrs OutRsts InCsumErrors
+Tcp: 1 200 120000 -1 123456 65432 1234 4321 256 987654321 876543210 12345 12 23456 0
+Udp: InDatagrams NoPorts InErrors OutDatagrams RcvbufErrors SndbufErrors InCsumErrors IgnoredMulti MemErrors
+Udp: 4567890 1234 56 4567000 7 0 0 0 0
+EOF
+
+# ============================================================================
+# Disques: /sys/block + /proc/mounts + /proc/self/mountinfo
+# ============================================================================
+
+add_disk() {
+    name=$1
+    model=$2
+    sectors=$3
+    device=$4      # Cible du lien "device" (relative à sys/)
+    major=$5
+    minor=$6
+    dir="$ROOT/sys/block/$name"
+    mkdir -p "$dir/queue" "$ROOT/sys/$device"
+    ln -s "../../$device" "$dir/device"
+    echo "$model" > "$ROOT/sys/$device/model"
+    echo "$sectors" > "$dir/size"
+    echo 0 > "$dir/queue/rotational"
+    echo "$major:$minor" > "$dir/dev"
+    printf 'naa.5000c5%010x\n' "$disk" > "$ROOT/sys/$device/wwid"
+    echo "  123456 0 9876543 12345 654321 0 87654321 54321 0 23456 66666 0 0 0 0 0 0" > "$dir/stat"
+    ln -s "../../block/$name" "$ROOT/sys/class/block/$name"
+    ln -s "../../block/$name" "$ROOT/sys/dev/block/$major:$minor"
+}
+
+# Partition montée: /sys/block/<disque>/<partition> + mountinfo (format du noyau)
+add_partition() {
+    disk_name=$1
+    name=$2
+    major=$3
+    minor=$4
+    mount_point=$5
+    fstype=$6
+    dir="$ROOT/sys/block/$disk_name/$name"
+    mkdir -p "$dir" "$ROOT$mount_point"
+    echo "$major:$minor" > "$dir/dev"
+    echo "${name##*[!0-9]}" > "$dir/partition"
+    ln -s "../../block/$disk_name/$name" "$ROOT/sys/class/block/$name"
+    ln -s "../../block/$disk_name/$name" "$ROOT/sys/dev/block/$major:$minor"
+    echo "/dev/$name $mount_point $fstype rw,relatime 0 0" >> "$ROOT/proc/mounts"
+    mount_id=$((mount_id + 1))
+    echo "$mount_id 1 $major:$minor / $mount_point rw,relatime shared:$mount_id - $fstype /dev/$name rw" >> "$ROOT/proc/self/mountinfo"
+}
+
+: > "$ROOT/proc/mounts"
+echo "proc /proc proc rw,nosuid,nodev,noexec,relatime 0 0" >> "$ROOT/proc/mounts"
+echo "sysfs /sys sysfs rw,nosuid,nodev,noexec,relatime 0 0" >> "$ROOT/proc/mounts"
+mkdir -p "$ROOT/proc/self" "$ROOT/sys/class/block" "$ROOT/sys/dev/block"
+: > "$ROOT/proc/self/mountinfo"
+echo "22 1 0:21 / /proc rw,nosuid,nodev,noexec,relatime shared:12 - proc proc rw" >> "$ROOT/proc/self/mountinfo"
+echo "23 1 0:22 / /sys rw,nosuid,nodev,noexec,relatime shared:2 - sysfs sysfs rw" >> "$ROOT/proc/self/mountinfo"
+mount_id=100
+
+disk=0
+sd_index=0
+while [ $disk -lt "$DISKS" ]; do
+    case $((disk % 4)) in
+        0|1)
+            name=$(sd_name $sd_index)
+            sd_index=$((sd_index + 1))
+            add_disk "$name" "Fixture SATA SSD" 1953525168 "devices/pci0000:00/ata$disk/host$disk/target$disk:0:0/$disk:0:0:0" 8 $((sd_index * 16 - 16))
+            add_partition "$name" "${name}1" 8 $((sd_index * 16 - 15)) "/srv/$name" ext4
+            ;;
+        2)
+            name="nvme$((disk / 4))n1"
+            add_disk "$name" "Fixture NVMe 2TB" 3907029168 "devices/pci0000:00/nvme$disk/nvme$((disk / 4))" 259 $((disk / 4))
+            # Contrôleur -> fonction PCI parente (lu via device/device/current_link_speed)
+            ln -s .. "$ROOT/sys/devices/pci0000:00/nvme$disk/nvme$((disk / 4))/device"
+            echo "16.0 GT/s PCIe" > "$ROOT/sys/devices/pci0000:00/nvme$disk/current_link_speed"
+            add_partition "$name" "${name}p1" 259 $((disk / 4 + 100)) "/data/$name" xfs
+            ;;
+        3)
+            # Disque USB 3.0 (vitesse lue sur le port: .../usb2/2-N/speed)
+            name=$(sd_name $sd_index)
+            sd_index=$((sd_index + 1))
+            port="usb2/2-$disk"
+            add_disk "$name" "Fixture USB Stick" 62521344 "devices/pci0000:00/$port/2-$disk:1.0/host$disk/target$disk:0:0/$disk:0:0:0" 8 $((sd_index * 16 - 16))
+            echo 5000 > "$ROOT/sys/devices/pci0000:00/$port/speed"
+            ;;
+    esac
+    disk=$((disk + 1))
+done
+
+# Périphériques bloc ignorés par les collecteurs
+for name in loop0 loop1 zram0 dm-0 dm-1; do
+    mkdir -p "$ROOT/sys/block/$name"
+    echo 0 > "$ROOT/sys/block/$name/size"
+done
+
+# LVM sur LUKS: sda2 -> dm-0 (crypt) -> dm-1 (volume logique) monté sur /, vu par le
+# montage sous /dev/mapper: seul major:minor + slaves le rattache à sda
+if [ "$DISKS" -gt 0 ]; then
+    mkdir -p "$ROOT/sys/block/sda/sda2"
+    echo "8:2" > "$ROOT/sys/block/sda/sda2/dev"
+    echo 2 > "$ROOT/sys/block/sda/sda2/partition"
+    ln -s ../../block/sda/sda2 "$ROOT/sys/class/block/sda2"
+    ln -s ../../block/sda/sda2 "$ROOT/sys/dev/block/8:2"
+    for dm in 0 1; do
+        echo "253:$dm" > "$ROOT/sys/block/dm-$dm/dev"
+        mkdir -p "$ROOT/sys/block/dm-$dm/slaves" "$ROOT/sys/block/dm-$dm/dm"
+        ln -s ../../block/dm-$dm "$ROOT/sys/class/block/dm-$dm"
+        ln -s ../../block/dm-$dm "$ROOT/sys/dev/block/253:$dm"
+    done
+    ln -s ../../../class/block/sda2 "$ROOT/sys/block/dm-0/slaves/sda2"
+    ln -s ../../../class/block/dm-0 "$ROOT/sys/block/dm-1/slaves/dm-0"
+    echo "/dev/mapper/vg-root / ext4 rw,relatime 0 0" >> "$ROOT/proc/mounts"
+    echo "30 1 253:1 / / rw,relatime shared:1 - ext4 /dev/mapper/vg-root rw" >> "$ROOT/proc/self/mountinfo"
+    echo "31 30 253:1 /srv/sda /mnt/bind\\040sda rw,relatime shared:1 - ext4 /dev/mapper/vg-root rw" >> "$ROOT/proc/self/mountinfo"
+    echo "CRYPT-LUKS2-0f1e2d3c4b5a69788796a5b4c3d2e1f0-luks-0f1e2d3c" > "$ROOT/sys/block/dm-0/dm/uuid"
+    echo "luks-0f1e2d3c" > "$ROOT/sys/block/dm-0/dm/name"
+    echo "LVM-Wq0nXxYy1z2A3b4C5d6E7f8G9h0I1j2KLm3N4o5P6q7R8s9T0u1V2w3X4y5Z6a7B" > "$ROOT/sys/block/dm-1/dm/uuid"
+    echo "vg-root" > "$ROOT/sys/block/dm-1/dm/name"
+    echo 419430400 > "$ROOT/sys/block/dm-0/size"
+    echo 419430400 > "$ROOT/sys/block/dm-1/size"
+fi
+
+# RAID1 logiciel en resynchronisation: md0 sur sda3 + sdb2
+if [ "$DISKS" -gt 1 ]; then
+    md="$ROOT/sys/block/md0"
+    mkdir -p "$md/md/dev-sda3" "$md/md/dev-sdb2" "$md/slaves"
+    for member in sda/sda3:8:3 sdb/sdb2:8:18; do
+        path=${member%%:*}
+        name=${path#*/}
+        mkdir -p "$ROOT/sys/block/$path"
+        echo "${member#*:}" > "$ROOT/sys/block/$path/dev"
+        echo "${name##*[!0-9]}" > "$ROOT/sys/block/$path/partition"
+        ln -s "../../block/$path" "$ROOT/sys/class/block/$name"
+        ln -s "../../block/$path" "$ROOT/sys/dev/block/${member#*:}"
+        ln -s "../../../class/block/$name" "$md/slaves/$name"
+        echo in_sync > "$md/md/dev-$name/state"
+    done
+    echo "9:0" > "$md/dev"
+    echo 976502784 > "$md/size"
+    echo raid1 > "$md/md/level"
+    echo clean > "$md/md/array_state"
+    echo resync > "$md/md/sync_action"
+    echo "244125696 / 976502784" > "$md/md/sync_completed"
+    echo 118400 > "$md/md/sync_speed"
+    echo 2 > "$md/md/raid_disks"
+    echo 0 > "$md/md/degraded"
+    ln -s ../../block/md0 "$ROOT/sys/class/block/md0"
+    ln -s ../../block/md0 "$ROOT/sys/dev/block/9:0"
+fi
+
+# /proc/diskstats: une ligne par périphérique bloc (disques, partitions, md, dm)
+: > "$ROOT/proc/diskstats"
+for dev in "$ROOT"/sys/block/* "$ROOT"/sys/block/*/*; do
+    [ -f "$dev/dev" ] || continue
+    numbers=$(cat "$dev/dev")
+    printf '%4d %7d %s 123456 0 9876543 12345 654321 0 87654321 54321 0 23456 66666 0 0 0 0 0 0\n' \
+        "${numbers%%:*}" "${numbers#*:}" "${dev##*/}" >> "$ROOT/proc/diskstats"
+done
+# zram0 initialisé (swap compressé): 1 Go, 300 Mo stockés dans 80 Mo
+echo 1073741824 > "$ROOT/sys/block/zram0/disksize"
+echo "314572800 83886080 88080384 0 88080384 1024 0 12" > "$ROOT/sys/block/zram0/mm_stat"
+
+# ============================================================================
+# cgroup v2: quelques services systemd et un conteneur
+# ============================================================================
+
+add_cgroup() {
+    dir="$ROOT/sys/fs/cgroup/$1"
+    mkdir -p "$dir"
+    printf 'usage_usec %s\nuser_usec %s\nsystem_usec 0\n' "$2" "$2" > "$dir/cpu.stat"
+    echo "$3" > "$dir/memory.current"
+    printf 'some avg10=%s avg60=0.00 avg300=0.00 total=0\nfull avg10=0.00 avg60=0.00 avg300=0.00 total=0\n' "$4" > "$dir/memory.pressure"
+    echo "8:0 rbytes=$5 wbytes=$6 rios=10 wios=10 dbytes=0 dios=0" > "$dir/io.stat"
+}
+
+mkdir -p "$ROOT/sys/fs/cgroup"
+echo "cpuset cpu io memory pids" > "$ROOT/sys/fs/cgroup/cgroup.controllers"
+add_cgroup system.slice 900000000 2147483648 0.00 1048576000 524288000
+add_cgroup system.slice/sshd.service 1200000 8388608 0.00 1048576 0
+add_cgroup system.slice/postgresql.service 450000000 1073741824 1.25 734003200 314572800
+add_cgroup system.slice/docker-0123456789ab.scope 300000000 536870912 0.10 104857600 209715200
+add_cgroup user.slice 120000000 1610612736 0.00 52428800 10485760
+add_cgroup user.slice/user-1000.slice 118000000 1600000000 0.00 52428800 10485760
+
+echo "Fixture written to $ROOT ($CPUS CPUs, $INTERFACES interfaces, $DISKS disks)"
@@ -0,0 +1,75 @@
+/*
+ * block_latency.h
+ * Latence des requêtes bloc par disque: histogramme log2 et percentiles p50 / p99
+ *
+ * Backend principal: tracepoints block:block_rq_issue / block:block_rq_complete
+ * ouverts avec perf_event_open() sur chaque CPU (root ou perf_event_paranoid
+ * permissif, tracefs monté). Chaque requête est appariée par (disque, secteur)
+ * et sa durée rangée dans un histogramme en puissances de 2 de microsecondes.
+ *
+ * Sans ces droits (ou avec SYSWATCH_BLOCK_TRACEPOINTS=0, ou une racine de test),
+ * repli sur /sys/block/<disque>/stat: seule la latence moyenne est disponible.
+ *
+ * Les tampons perf sont dimensionnés pour un appel toutes les BLOCK_LATENCY_DRAIN_MS.
+ * S'ils débordent quand même, le noyau perd des événements (PERF_RECORD_LOST): ils
+ * sont comptés et la période est rapportée par le backend stat, l'histogramme
+ * n'étant plus représentatif (les pertes surviennent justement sous forte charge).
+ */
+
+#ifndef BLOCK_LATENCY_H
+#define BLOCK_LATENCY_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Case i: [2^i, 2^(i+1)) µs (la case 0 inclut aussi < 1 µs), dernière case: >= 2^23 µs (~8 s)
+#define BLOCK_LATENCY_BUCKETS 24
+
+// Période d'appel prévue de get_disk_latency() par disque
+#define BLOCK_LATENCY_DRAIN_MS 1000
+
+typedef enum {
+    LATENCY_SOURCE_NONE,            // Disque inconnu ou aucune donnée lisible
+    LATENCY_SOURCE_TRACEPOINT,      // Histogramme complet
+    LATENCY_SOURCE_STAT             // Moyenne seulement (/sys/block/<disque>/stat)
+} LatencySource;
+
+// Requêtes terminées depuis l'appel précédent pour ce disque
+typedef struct {
+    LatencySource source;
+    uint64_t completed;
+    float average_ms;
+    float p50_ms;                   // 0 hors LATENCY_SOURCE_TRACEPOINT
+    float p99_ms;
+    uint32_t histogram[BLOCK_LATENCY_BUCKETS];
+    uint64_t lost_events;           // Événements perdus sur la période, tous disques confondus
+                                    // (> 0: source = LATENCY_SOURCE_STAT pour cette période)
+} DiskLatency;
+
+/*
+ * Latence des requêtes du disque (ex: "sda", "nvme0n1") depuis l'appel précédent
+ * pour ce même disque; le premier appel sert de référence (completed = 0)
+ * Retourne false si le disque n'existe pas (source = LATENCY_SOURCE_NONE)
+ */
+bool get_disk_latency(const char *storage_name, DiskLatency *latency);
+
+/*
+ * Oublier un disque retiré: rebranché sous le même nom, il est suivi à nouveau
+ * avec son nouveau numéro de périphérique (NVMe 259:N attribué dynamiquement)
+ */
+void forget_disk_latency(const char *storage_name);
+
+/*
+ * Suspendre la collecte quand personne ne la lit (fenêtre masquée): les tracepoints
+ * sont désactivés (PERF_EVENT_IOC_DISABLE) et ne remplissent plus les tampons.
+ * À la reprise, les événements restés en tampon sont ignorés et les compteurs stat
+ * repris comme référence: la période suivante ne couvre pas le temps suspendu
+ */
+void set_block_latency_paused(bool paused);
+
+/*
+ * Backend actif après le premier appel: "tracepoints" ou "/sys/block stat"
+ */
+const char* get_block_latency_backend(void);
+
+#endif // BLOCK_LATENCY_H
@@ -0,0 +1,40 @@
+/*
+ * cgroup_info.h
+ * Consommation par cgroup v2 (conteneurs, services systemd)
+ *
+ * L'arborescence /sys/fs/cgroup est parcourue une seule fois puis tenue à jour
+ * par inotify (création / suppression de cgroups): chaque mesure ne relit que
+ * cpu.stat, memory.current, memory.pressure et io.stat des cgroups connus.
+ */
+
+#ifndef CGROUP_INFO_H
+#define CGROUP_INFO_H
+
+#include <stdint.h>
+
+#define CGROUP_PATH_MAX 256
+
+// Consommation d'un cgroup depuis la mesure précédente
+typedef struct {
+    char path[CGROUP_PATH_MAX];     // Relatif à /sys/fs/cgroup (ex: "system.slice/nginx.service")
+    float cpu_percent;              // usage_usec de cpu.stat (100 = un cœur entier)
+    uint64_t memory_bytes;          // memory.current (0 si le contrôleur memory est inactif)
+    float memory_pressure;          // PSI "some avg10": % du temps bloqué en attente de mémoire
+    float io_read_kbps;             // rbytes / wbytes de io.stat, tous périphériques
+    float io_write_kbps;
+} CgroupUsage;
+
+/*
+ * Mesurer tous les cgroups et copier les max_count plus gros consommateurs CPU
+ * (le cgroup racine, qui correspond au système entier, est exclu)
+ * Le premier appel parcourt l'arborescence et sert de référence (CPU et E/S à 0)
+ * Retourne le nombre de cgroups copiés, -1 si cgroup v2 n'est pas monté
+ */
+int get_top_cgroups(CgroupUsage *top, int max_count);
+
+/*
+ * Nombre de cgroups suivis (0 avant le premier get_top_cgroups())
+ */
+int get_cgroup_count(void);
+
+#endif // CGROUP_INFO_H
@@ -0,0 +1,66 @@
+/*
+ * counter_delta.h
+ * Différences de compteurs cumulés du noyau (/proc, /sys) entre deux lectures
+ *
+ * Chaque compteur garde sa dernière valeur, l'instant de la lecture et un
+ * indicateur de validité: la première lecture ne fait qu'enregistrer une
+ * référence (même si le compteur vaut 0), une valeur en baisse est reconnue
+ * comme un rebouclage 32 bits ou une remise à zéro (pilote rechargé, interface
+ * recréée) au lieu de produire un delta géant en arithmétique non signée.
+ */
+
+#ifndef COUNTER_DELTA_H
+#define COUNTER_DELTA_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Largeur des compteurs "unsigned long" du noyau (32 bits sur ARMv7)
+#define COUNTER_BITS_LONG ((int)(sizeof(unsigned long) * 8))
+
+// État d'un compteur (une structure remplie de zéros = compteur 64 bits sans référence)
+typedef struct {
+    uint64_t value;         // Dernière valeur lue
+    double timestamp;       // Instant de cette lecture (secondes, horloge monotone)
+    bool valid;             // false: pas encore de référence
+    int bits;               // Largeur du compteur source: 32 ou 64 (0 = 64)
+} CounterDelta;
+
+// Résultat d'une mise à jour
+typedef enum {
+    COUNTER_FIRST,          // Première lecture: référence enregistrée, pas de delta
+    COUNTER_OK,             // Delta valide (rebouclage 32 bits compris)
+    COUNTER_RESET,          // Valeur en baisse sans rebouclage plausible: nouvelle référence
+    COUNTER_STALE           // Aucun temps écoulé depuis la référence: rien n'est modifié
+} CounterStatus;
+
+/*
+ * Préparer un compteur d'une largeur donnée (32 ou 64 bits), sans référence
+ */
+void counter_delta_init(CounterDelta *counter, int bits);
+
+/*
+ * Oublier la référence: la prochaine lecture sera traitée comme la première
+ */
+void counter_delta_invalidate(CounterDelta *counter);
+
+/*
+ * Instant courant pour counter_delta_update() (secondes, horloge monotone)
+ */
+double counter_clock_seconds(void);
+
+/*
+ * Enregistrer une nouvelle valeur lue à l'instant now
+ * delta / elapsed (facultatifs) reçoivent l'augmentation et le temps écoulé
+ * depuis la référence si le résultat est COUNTER_OK, 0 sinon
+ */
+CounterStatus counter_delta_update(CounterDelta *counter, uint64_t value, double now,
+                                   uint64_t *delta, double *elapsed);
+
+/*
+ * Raccourci: augmentation par seconde depuis la lecture précédente
+ * Retourne 0 pour une première lecture, une remise à zéro ou sans temps écoulé
+ */
+double counter_delta_rate(CounterDelta *counter, uint64_t value, double now);
+
+#endif // COUNTER_DELTA_H
@@ -0,0 +1,72 @@
+/*
+ * cpu_topology.h
+ * Topologie CPU (sockets, cœurs, nœuds NUMA, caches) et charge par nœud NUMA
+ *
+ * La topologie est lue une seule fois dans /sys/devices/system/cpu et
+ * /sys/devices/system/node (les CPU mis hors ligne ensuite restent comptés).
+ * Sans répertoire node (noyau sans NUMA), tous les CPU forment un nœud 0
+ * dont la mémoire est celle de /proc/meminfo.
+ */
+
+#ifndef CPU_TOPOLOGY_H
+#define CPU_TOPOLOGY_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define TOPOLOGY_MAX_NODES   64
+#define TOPOLOGY_MAX_CACHES  8
+
+// Un niveau de cache (vu depuis le premier CPU en ligne)
+typedef struct {
+    int level;                      // 1, 2, 3...
+    char type[16];                  // "Data", "Instruction" ou "Unified"
+    unsigned int size_kb;           // Taille d'une instance
+    int instances;                  // Nombre d'instances dans le système (ex: un L3 par socket)
+} CpuCacheInfo;
+
+// Un nœud NUMA
+typedef struct {
+    int id;                         // Numéro du nœud (nodeN)
+    int cpu_count;
+    char cpulist[64];               // Tel que publié par le noyau (ex: "0-15,32-47")
+} NumaNodeInfo;
+
+typedef struct {
+    int cpu_count;                  // CPU logiques en ligne au chargement
+    int core_count;                 // Paires (socket, core_id) distinctes
+    int package_count;              // Sockets physiques
+    int node_count;
+    NumaNodeInfo nodes[TOPOLOGY_MAX_NODES];
+    int cache_count;
+    CpuCacheInfo caches[TOPOLOGY_MAX_CACHES];
+} CpuTopology;
+
+// Charge d'un nœud NUMA depuis l'appel précédent
+typedef struct {
+    int id;
+    float cpu_percent;              // Moyenne de ses CPU (0 au premier appel)
+    uint64_t memory_total_kb;
+    uint64_t memory_used_kb;        // Total - (libre + cache de pages + slab récupérable)
+} NumaNodeUsage;
+
+/*
+ * Topologie lue au premier appel puis conservée
+ * Retourne NULL si /sys/devices/system/cpu/online est illisible
+ */
+const CpuTopology* get_cpu_topology(void);
+
+/*
+ * Charge CPU et mémoire de chaque nœud NUMA (au plus max_nodes)
+ * La charge CPU agrège les lignes par CPU de /proc/stat depuis l'appel précédent
+ * Retourne le nombre de nœuds remplis, ou -1 si la topologie est indisponible
+ */
+int get_numa_node_usage(NumaNodeUsage *usage, int max_nodes);
+
+/*
+ * Résumé des caches (ex: "L1d 48K · L1i 32K · L2 2M · L3 2x 36M")
+ * Retourne "Unknown" si aucun cache n'est décrit
+ */
+const char* get_cpu_cache_summary(void);
+
+#endif // CPU_TOPOLOGY_H
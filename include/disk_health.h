@@ -0,0 +1,54 @@
+/*
+ * disk_health.h
+ * État de santé des disques sans smartctl: attributs SMART ATA et journal SMART / Health NVMe
+ *
+ * ATA (SATA, ponts USB compatibles SAT): SMART READ DATA par ATA PASS-THROUGH (16)
+ * via l'ioctl SG_IO. NVMe: Get Log Page 0x02 via NVME_IOCTL_ADMIN_CMD.
+ * Les deux demandent l'ouverture de /dev/<disque> (root ou groupe "disk"
+ * + CAP_SYS_RAWIO / CAP_SYS_ADMIN). Chaque disque est interrogé au plus une fois
+ * par DISK_HEALTH_REFRESH_SECONDS, échec compris: une baie de 24 disques ne
+ * coûte que quelques ioctl par minute.
+ *
+ * Un disque ATA en veille ou au repos (CHECK POWER MODE) n'est pas interrogé,
+ * pour ne pas le réveiller: le dernier état lu est conservé (aucun au départ).
+ */
+
+#ifndef DISK_HEALTH_H
+#define DISK_HEALTH_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define DISK_HEALTH_REFRESH_SECONDS 60
+
+typedef enum {
+    DISK_HEALTH_NONE,               // Non lisible (droits, disque non ATA/NVMe, racine de test)
+    DISK_HEALTH_ATA,
+    DISK_HEALTH_NVME
+} DiskHealthSource;
+
+// Champs à -1 (ou 0 pour les compteurs) quand le disque ne les fournit pas
+typedef struct {
+    DiskHealthSource source;
+    float temperature_celsius;      // -1 si inconnue
+    int percentage_used;            // Usure estimée 0-100 (peut dépasser 100 en NVMe), -1 si inconnue
+    uint64_t media_errors;          // NVMe: Media Errors; ATA: 187 Reported_Uncorrect + 198 Offline_Uncorrectable
+    uint64_t unsafe_shutdowns;      // NVMe: Unsafe Shutdowns; ATA: 174 Unexpect_Power_Loss, sinon 192
+    uint64_t data_written_gb;       // NVMe: Data Units Written; ATA: 241 Total_LBAs_Written (x 512 octets)
+    uint64_t power_on_hours;
+    uint8_t critical_warning;       // NVMe seulement: bits d'alerte (0 = aucune)
+} DiskHealth;
+
+/*
+ * État de santé du disque (ex: "sda", "nvme0n1"), relu au plus toutes les
+ * DISK_HEALTH_REFRESH_SECONDS secondes
+ * Retourne false si le disque ne peut pas être interrogé (source = DISK_HEALTH_NONE)
+ */
+bool get_disk_health(const char *storage_name, DiskHealth *health);
+
+/*
+ * Oublier l'état en cache d'un disque (retiré ou remplacé)
+ */
+void forget_disk_health(const char *storage_name);
+
+#endif // DISK_HEALTH_H
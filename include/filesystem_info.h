@@ -0,0 +1,54 @@
+/*
+ * filesystem_info.h
+ * Occupation de chaque système de fichiers monté: octets, inodes et vitesse de remplissage
+ *
+ * Le tableau des disques additionne les partitions d'un disque; une partition /var
+ * pleine y passe inaperçue si le reste du disque est libre. Ici chaque système de
+ * fichiers a sa ligne (table des montages en cache, mount_table.h: un seul montage
+ * par système de fichiers, binds et sous-volumes écartés).
+ *
+ * statvfs() n'est appelé qu'une fois toutes les FILESYSTEM_STAT_INTERVAL_SECONDS par
+ * système de fichiers, quelle que soit la fréquence des appels; entre deux, la dernière
+ * mesure est resservie. Chaque mesure alimente un historique (history.h) dont la
+ * tendance sur la dernière heure donne la croissance et le temps restant avant
+ * saturation.
+ */
+
+#ifndef FILESYSTEM_INFO_H
+#define FILESYSTEM_INFO_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "mount_table.h"
+
+#define FILESYSTEM_STAT_INTERVAL_SECONDS  10      // statvfs() au plus une fois par période et par montage
+#define FILESYSTEM_GROWTH_WINDOW_SECONDS  3600    // Tendance calculée sur la dernière heure
+#define FILESYSTEM_GROWTH_MIN_SECONDS     300     // En deçà, la tendance n'est pas donnée
+
+typedef struct {
+    MountEntry mount;
+    bool valid;                     // false: statvfs() a échoué (montage disparu, droits)
+
+    uint64_t total_bytes;
+    uint64_t used_bytes;            // f_blocks - f_bfree (réserve root comprise dans le libre)
+    uint64_t available_bytes;       // f_bavail: ce qu'un utilisateur non root peut encore écrire
+    float usage_percent;            // used / (used + available), comme df
+
+    uint64_t total_inodes;          // 0: pas de table d'inodes fixe (btrfs, vfat...)
+    uint64_t used_inodes;
+    uint64_t available_inodes;      // f_favail
+    float inode_percent;            // -1 sans table d'inodes
+
+    bool growth_known;              // Historique d'au moins FILESYSTEM_GROWTH_MIN_SECONDS
+    float growth_bytes_per_hour;    // Pente de l'occupation (négative si elle baisse)
+    double seconds_until_full;      // available / croissance; -1 si l'occupation ne croît pas
+    double history_seconds;         // Durée couverte par la tendance
+} FilesystemUsage;
+
+/*
+ * Lister les systèmes de fichiers montés avec leur occupation et sa tendance
+ * Retourne le nombre d'entrées copiées (au plus max_filesystems), 0 si aucune
+ */
+int get_filesystem_usage(FilesystemUsage *filesystems, int max_filesystems);
+
+#endif // FILESYSTEM_INFO_H
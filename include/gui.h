@@ -8,27 +8,55 @@
 
 #include <gtk/gtk.h>
 #include "system_info.h"
+#include "scheduler.h"
+#include "history.h"
+#include "metrics.h"
+#include "speed_history.h"
+#include "speed_test.h"
 
-// Structure pour stocker les widgets d'une interface réseau
+// Nombre maximal de collecteurs d'affichage (un par source de données)
+#define MAX_DISPLAY_COLLECTORS 16
+
+// Points de la courbe du test de vitesse (un par rapport d'avancement: 2 min à 100 ms)
+#define SPEED_CURVE_POINTS 1200
+
+// Ligne d'une interface réseau dans le modèle du tableau
 typedef struct {
     char interface_name[64];
-    GtkWidget *ip_label;
-    GtkWidget *upload_label;
-    GtkWidget *download_label;
+    GtkTreeRowReference *row;   // Suit la ligne quand le tableau est trié
+    // Derniers textes affichés: row-changed seulement si l'un d'eux change
+    char address[64];
+    char upload_text[32];
+    char download_text[32];
+    char packets_text[32];
+    char errors_text[32];
+    char link_text[48];
+    char line_rate_text[16];
+    char signal_text[32];
+    const char *background;     // Surlignage de saturation (NULL = aucun)
 } NetworkInterfaceWidgets;
 
-// Structure pour stocker les labels d'un stockage physique
+// Ligne d'un stockage physique dans le modèle du tableau
 typedef struct {
     char storage_name[32];
-    GtkWidget *used_label;
-    GtkWidget *available_label;
-    GtkWidget *total_label;
-    GtkWidget *percent_label;
-    GtkWidget *read_label;
-    GtkWidget *write_label;
-    GtkWidget *speed_test_button;
+    GtkTreeRowReference *row;   // Suit la ligne quand le tableau est trié
     float read_speed;
     float write_speed;
+    float random_iops;          // Lectures aléatoires de 4 Kio (test en lecture seule)
+    bool raw_read;              // Lecture mesurée sur /dev/<disque> (sinon fichier temporaire)
+    bool write_tested;          // Test d'écriture demandé
+    bool speed_tested;
+    SpeedTestStats read_stats;  // Répétitions du dernier test (médiane affichée)
+    SpeedTestStats write_stats;
+    float write_cliff_seconds;  // Chute du débit d'écriture (cache SLC plein), -1 = aucune
+    float sustained_write_mbps;
+    int sustained_write_mb;     // Volume de l'écriture soutenue (0 = non faite)
+    char identity[96];          // WWN / numéro de série (historique des tests de vitesse)
+    SpeedTestRecord previous_read;   // Dernier test enregistré comparable (timestamp 0 = aucun)
+    SpeedTestRecord previous_write;
+    char latency_text[48];      // Dernier texte de la colonne Latency (mis à jour si modifié)
+    char health_text[48];       // Colonne Health (température, usure)
+    char health_details[192];   // Détails SMART / NVMe de l'info-bulle
 } StorageWidgets;
 
 // Structure contenant tous les widgets de l'application
@@ -51,16 +79,26 @@ typedef struct {
     GtkWidget *temp_label;
     GtkWidget *cpu_usage_label;
     GtkWidget *gpu_usage_label;
+    GtkWidget *cpu_cache_label;         // Résumé L1/L2/L3 (statique)
     
     // Labels Mémoire
     GtkWidget *mem_usage_label;
     GtkWidget *mem_available_label;
     GtkWidget *mem_total_label;
+    GtkWidget *swap_label;              // Occupation (info-bulle: zswap / zram)
+    GtkWidget *paging_label;            // pgpgin / pgpgout
+    GtkWidget *swap_io_label;           // pswpin / pswpout
+    GtkWidget *faults_label;            // Défauts majeurs et blocages de compaction
+    GtkWidget *oom_label;
+    GtkWidget *numa_label;              // Charge CPU / mémoire par nœud NUMA
     
     // Labels Réseau
     GtkWidget *network_hostname_label;
+    GtkWidget *network_sockets_label;   // Résumé des connexions TCP
     GtkWidget *network_ip_label;
     GtkWidget *network_vbox;  // Conteneur dynamique pour les interfaces
+    GtkWidget *network_view;  // Tableau des interfaces (GtkTreeView, seules les lignes visibles sont dessinées)
+    GtkListStore *network_store;
     
     // Interfaces réseau dynamiques
     NetworkInterfaceWidgets *network_interfaces;
@@ -69,7 +107,7 @@ typedef struct {
     // Stockages physiques dynamiques
     StorageWidgets *storages;
     int storage_count;
-    PhysicalStorage *physical_storages;  // Données brutes des stockages
+    PhysicalStorage *physical_storages;  // Données brutes des stockages (dernières valeurs affichées)
     
     // Labels Stockage (anciens, à garder pour compatibilité)
     GtkWidget *storage_used_label;
@@ -79,7 +117,60 @@ typedef struct {
     GtkWidget *storage_read_speed_label;
     GtkWidget *storage_write_speed_label;
     GtkWidget *speed_test_button;
+    GtkWidget *speed_test_write_check;  // Test d'écriture (fichier temporaire) sur demande
+    GtkWidget *speed_test_sustained_check;  // Écriture soutenue (cache SLC) en plus, sur demande
+    GtkWidget *speed_test_progress;     // Avancement et débit instantané (visible pendant le test)
+    GtkWidget *speed_test_curve;        // Courbe du débit instantané du disque en cours
+    float speed_curve_mbps[SPEED_CURVE_POINTS];
+    int speed_curve_count;
+    char speed_curve_title[64];
+    SpeedTestControl *speed_test_control;  // Test en cours (NULL = aucun): le bouton l'annule
     GtkWidget *storage_vbox;  // Conteneur pour la liste des stockages
+    GtkWidget *storage_view;  // Tableau des stockages (GtkTreeView triable)
+    GtkListStore *storage_store;
+    GtkWidget *storage_empty_label;  // "No physical storages found"
+    
+    // Volumes logiques (md, LVM, dm-crypt) sous les disques: masqués s'il n'y en a aucun
+    GtkWidget *volume_box;
+    GtkWidget *volume_view;
+    GtkListStore *volume_store;
+    
+    // Un système de fichiers par ligne: octets, inodes, croissance et temps avant saturation
+    GtkWidget *filesystem_view;
+    GtkListStore *filesystem_store;
+    
+    // Tableau des cgroups les plus consommateurs (reconstruit à chaque mesure qui change)
+    GtkWidget *cgroup_view;
+    GtkListStore *cgroup_store;
+    GtkWidget *cgroup_status_label;
+    
+    // Instantanés publiés par les collecteurs (l'affichage ne lit que ceux-ci)
+    Metrics *metrics;
+    
+    // Ordonnanceur des collecteurs (un intervalle par collecteur)
+    Scheduler *scheduler;
+    guint scheduler_source_id;
+    
+    // Collecteurs d'affichage: suspendus quand la fenêtre n'est pas visible
+    int display_collector_ids[MAX_DISPLAY_COLLECTORS];
+    unsigned int display_collector_intervals[MAX_DISPLAY_COLLECTORS];
+    int display_collector_count;
+    int history_collector_id;        // Échantillonnage lent en arrière-plan
+    unsigned int background_interval_ms;
+    
+    // Visibilité de la fenêtre (rafraîchissement adaptatif)
+    gboolean window_iconified;
+    gboolean window_obscured;
+    gboolean window_unmapped;
+    gboolean window_visible;
+    
+    // Historique de la dernière minute (info-bulles moyenne/max)
+    MetricHistory cpu_history;
+    MetricHistory memory_history;
+    
+    // Hotplug (uevents netlink)
+    int hotplug_fd;
+    guint hotplug_source_id;
     
     // Boutons
     GtkWidget *about_button;
@@ -98,7 +189,8 @@ AppWidgets* create_gui(void);
 void update_system_info_display(AppWidgets *widgets);
 
 /*
- * Met à jour tous les affichages dynamiques (temp, CPU, mémoire, réseau, disque)
+ * Met à jour immédiatement tous les affichages dynamiques (temp, CPU, GPU, mémoire, réseau)
+ * En fonctionnement normal, chaque section est rafraîchie par son propre collecteur
  */
 void update_all_displays(AppWidgets *widgets);
 
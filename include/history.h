@@ -0,0 +1,68 @@
+/*
+ * history.h
+ * Historique circulaire de mesures horodatées (CPU, mémoire...)
+ */
+
+#ifndef HISTORY_H
+#define HISTORY_H
+
+#include <stdbool.h>
+
+// Une mesure: instant (secondes, horloge monotone) et valeur
+typedef struct {
+    double timestamp;
+    float value;
+} HistorySample;
+
+// Tampon circulaire: les mesures les plus anciennes sont écrasées
+typedef struct {
+    HistorySample *samples;
+    int capacity;
+    int head;       // Prochaine position d'écriture
+    int count;      // Nombre de mesures valides
+} MetricHistory;
+
+/*
+ * Allouer un historique de capacity mesures
+ * Retourne false en cas d'erreur d'allocation
+ * IMPORTANT: Libérer avec history_free()
+ */
+bool history_init(MetricHistory *history, int capacity);
+
+/*
+ * Libérer la mémoire de l'historique
+ */
+void history_free(MetricHistory *history);
+
+/*
+ * Ajouter une mesure (écrase la plus ancienne si l'historique est plein)
+ */
+void history_push(MetricHistory *history, double timestamp, float value);
+
+/*
+ * Lire la mesure d'indice index (0 = la plus ancienne)
+ * Retourne false si l'indice est hors limites
+ */
+bool history_get(const MetricHistory *history, int index, HistorySample *sample);
+
+/*
+ * Résumer les mesures des window_seconds dernières secondes (jusqu'à now)
+ * La moyenne est pondérée par le temps: chaque mesure couvre l'intervalle depuis
+ * la précédente, ce qui reste juste quand la fréquence d'échantillonnage varie
+ * average, maximum : résultats (peuvent être NULL)
+ * Retourne false si aucune mesure ne tombe dans la fenêtre
+ */
+bool history_summary(const MetricHistory *history, double now, double window_seconds,
+                     float *average, float *maximum);
+
+/*
+ * Tendance des mesures des window_seconds dernières secondes (jusqu'à now)
+ * Pente de la droite des moindres carrés: une mesure isolée (pic, creux) pèse peu
+ * per_second : variation de la valeur par seconde
+ * span_seconds : écart entre la première et la dernière mesure retenues (peut être NULL)
+ * Retourne false s'il y a moins de deux mesures d'instants différents dans la fenêtre
+ */
+bool history_slope(const MetricHistory *history, double now, double window_seconds,
+                   double *per_second, double *span_seconds);
+
+#endif // HISTORY_H
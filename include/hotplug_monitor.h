@@ -0,0 +1,53 @@
+/*
+ * hotplug_monitor.h
+ * Écoute des événements hotplug du noyau (uevents netlink) pour les disques
+ * et les interfaces réseau
+ */
+
+#ifndef HOTPLUG_MONITOR_H
+#define HOTPLUG_MONITOR_H
+
+// Action signalée par le noyau
+typedef enum {
+    HOTPLUG_ACTION_ADD,
+    HOTPLUG_ACTION_REMOVE,
+    HOTPLUG_ACTION_MOVE,        // Renommage (udev: eth0 -> enx...), ancien nom dans old_name
+    HOTPLUG_ACTION_CHANGE       // Disques seulement: média inséré ou retiré (lecteur de cartes)
+} HotplugAction;
+
+// Sous-système concerné par l'événement
+typedef enum {
+    HOTPLUG_SUBSYSTEM_BLOCK,    // Disque entier (DEVTYPE=disk), pas les partitions
+    HOTPLUG_SUBSYSTEM_NET       // Interface réseau
+} HotplugSubsystem;
+
+// Événement hotplug décodé
+typedef struct {
+    HotplugAction action;
+    HotplugSubsystem subsystem;
+    char name[64];              // ex: "sda", "nvme0n1", "eth0", "wg0"
+    char old_name[64];          // HOTPLUG_ACTION_MOVE: nom avant renommage (DEVPATH_OLD)
+} HotplugEvent;
+
+/*
+ * Ouvrir un socket NETLINK_KOBJECT_UEVENT abonné aux événements du noyau
+ * Le socket est non bloquant: l'appelant l'ajoute à sa boucle d'événements
+ * Retourne le descripteur de fichier, ou -1 en cas d'erreur
+ */
+int hotplug_monitor_open(void);
+
+/*
+ * Lire le prochain événement en attente sur le socket
+ * event : structure à remplir
+ * Retourne 1 si un événement disque/réseau add/remove/move (ou change d'un disque) a été lu,
+ *          0 si un message a été lu mais ignoré (autre sous-système, partition...),
+ *         -1 s'il n'y a plus de message en attente (ou erreur)
+ */
+int hotplug_monitor_read(int fd, HotplugEvent *event);
+
+/*
+ * Fermer le socket ouvert par hotplug_monitor_open()
+ */
+void hotplug_monitor_close(int fd);
+
+#endif // HOTPLUG_MONITOR_H
@@ -0,0 +1,66 @@
+/*
+ * memory_info.h
+ * Mémoire virtuelle: swap, zswap, zram et activité de pagination
+ *
+ * /proc/meminfo et /proc/vmstat sont chacun lus d'un bloc et parcourus une
+ * seule fois; les compteurs cumulés de vmstat sont convertis en débits avec
+ * counter_delta (référence au premier appel).
+ */
+
+#ifndef MEMORY_INFO_H
+#define MEMORY_INFO_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Occupation de la mémoire et du swap (une lecture de /proc/meminfo)
+typedef struct {
+    uint64_t total_kb;
+    uint64_t available_kb;
+    uint64_t swap_total_kb;
+    uint64_t swap_free_kb;
+    uint64_t swap_cached_kb;
+    bool has_zswap;                 // Champs Zswap/Zswapped présents (Linux 5.19+)
+    uint64_t zswap_pool_kb;         // Taille compressée en RAM
+    uint64_t zswapped_kb;           // Pages d'origine stockées dans zswap
+} MemoryUsage;
+
+// Somme des périphériques /sys/block/zram*/mm_stat
+typedef struct {
+    int device_count;
+    uint64_t original_kb;           // Données stockées avant compression
+    uint64_t compressed_kb;
+    uint64_t memory_used_kb;        // RAM réellement consommée (allocateur compris)
+} ZramUsage;
+
+// Activité de pagination par seconde depuis l'appel précédent (/proc/vmstat)
+typedef struct {
+    float page_in_kbps;             // pgpgin (lectures de pages depuis les disques)
+    float page_out_kbps;            // pgpgout
+    float swap_in_per_sec;          // pswpin (pages)
+    float swap_out_per_sec;         // pswpout (pages)
+    float major_faults_per_sec;     // pgmajfault
+    float compaction_stalls_per_sec; // compact_stall
+    float oom_kills_per_sec;        // oom_kill (Linux 4.13+)
+    uint64_t oom_kills;             // Total depuis le démarrage
+} PagingRates;
+
+/*
+ * Mémoire et swap en une lecture de /proc/meminfo
+ * Retourne false si /proc/meminfo est illisible ou sans MemTotal
+ */
+bool get_memory_usage(MemoryUsage *usage);
+
+/*
+ * Utilisation cumulée des périphériques zram
+ * Retourne false s'il n'y a aucun zram initialisé
+ */
+bool get_zram_usage(ZramUsage *usage);
+
+/*
+ * Débits de pagination depuis l'appel précédent (premier appel: tous à 0)
+ * Retourne false si /proc/vmstat est illisible
+ */
+bool get_paging_rates(PagingRates *rates);
+
+#endif // MEMORY_INFO_H
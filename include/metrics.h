@@ -0,0 +1,238 @@
+/*
+ * metrics.h
+ * Instantanés versionnés des collecteurs (publication sans verrou, voir snapshot.h)
+ *
+ * Chaque collecteur lit le système avec les fonctions get_*() puis publie un
+ * instantané complet. Les consommateurs (interface, exporteur, enregistrement...)
+ * lisent une copie cohérente depuis n'importe quel thread, sans jamais bloquer
+ * l'échantillonnage ni toucher aux tampons statiques des get_*().
+ *
+ * Règle: toutes les fonctions metrics_collect_*() et metrics_track_*() sont appelées
+ * depuis un seul thread (celui des collecteurs). Les metrics_read_*() sont libres.
+ */
+
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "storage_info.h"
+#include "socket_info.h"
+#include "network_info.h"
+#include "wireless_info.h"
+#include "cgroup_info.h"
+#include "cpu_topology.h"
+#include "memory_info.h"
+#include "block_latency.h"
+#include "disk_health.h"
+#include "volume_info.h"
+#include "filesystem_info.h"
+
+#define METRICS_MAX_INTERFACES  256
+#define METRICS_MAX_STORAGES    128
+#define METRICS_MAX_VOLUMES     32
+#define METRICS_MAX_FILESYSTEMS 64
+#define METRICS_TOP_CGROUPS     10
+
+// Collecteur CPU (rapide)
+typedef struct {
+    double timestamp;               // Secondes, horloge monotone
+    float usage_percent;
+} CpuSnapshot;
+
+// Collecteur capteurs: température, mémoire, swap et pagination, uptime
+typedef struct {
+    double timestamp;
+    float temperature_celsius;      // -1 si indisponible
+    float memory_usage_percent;
+    float memory_available_gb;
+    float memory_total_gb;
+    MemoryUsage memory;             // Swap / zswap (même lecture de /proc/meminfo)
+    bool zram_available;            // false: aucun zram initialisé
+    ZramUsage zram;
+    bool paging_available;          // false: /proc/vmstat illisible
+    PagingRates paging;
+    char uptime[128];
+} SensorsSnapshot;
+
+// Collecteur GPU (lent: popen)
+typedef struct {
+    double timestamp;
+    float usage_percent;
+} GpuSnapshot;
+
+// Une interface suivie: débits (collecteur réseau), adresse et lien (collecteur adresses)
+typedef struct {
+    char name[64];
+    char address[64];
+    float upload_kbps;
+    float download_kbps;
+    InterfacePacketRates packets;   // Paquets, erreurs et pertes par seconde
+    int link_speed_mbps;            // -1 si inconnue
+    char duplex[8];                 // "full", "half" ou "unknown"
+    bool wireless;                  // Interface WiFi: champ wifi tenu à jour (collecteur WiFi)
+    WirelessLinkInfo wifi;
+} InterfaceSnapshot;
+
+typedef struct {
+    double timestamp;
+    int interface_count;
+    InterfaceSnapshot interfaces[METRICS_MAX_INTERFACES];
+} NetworkSnapshot;
+
+// Collecteur connexions: états TCP (sock_diag) et débits d'erreurs TCP/UDP
+typedef struct {
+    double timestamp;
+    bool tcp_available;             // false: sock_diag indisponible
+    bool counters_available;        // false: /proc/net/snmp illisible
+    TcpSocketSummary tcp;
+    ProtocolCounterRates counters;
+} SocketSnapshot;
+
+// Collecteur cgroups: plus gros consommateurs CPU (conteneurs, services systemd)
+typedef struct {
+    double timestamp;
+    bool available;                 // false: cgroup v2 non monté
+    int cgroup_count;               // Nombre total de cgroups suivis
+    int top_count;
+    CgroupUsage top[METRICS_TOP_CGROUPS];
+} CgroupSnapshot;
+
+// Collecteur NUMA: charge CPU et mémoire de chaque nœud
+typedef struct {
+    double timestamp;
+    int node_count;                 // 0: topologie indisponible
+    NumaNodeUsage nodes[TOPOLOGY_MAX_NODES];
+} NumaSnapshot;
+
+// Collecteur occupation des disques (statvfs des systèmes de fichiers montés)
+typedef struct {
+    double timestamp;
+    int storage_count;
+    PhysicalStorage storages[METRICS_MAX_STORAGES];
+} StorageSnapshot;
+
+// Latence d'un disque suivi depuis la publication précédente
+typedef struct {
+    char name[32];
+    DiskLatency latency;
+} StorageLatencySample;
+
+// Collecteur latence des disques (tracepoints bloc ou /sys/block stat)
+typedef struct {
+    double timestamp;
+    int storage_count;
+    StorageLatencySample storages[METRICS_MAX_STORAGES];
+} StorageLatencySnapshot;
+
+// État SMART / NVMe d'un disque suivi
+typedef struct {
+    char name[32];
+    DiskHealth health;
+} StorageHealthSample;
+
+// Collecteur santé des disques (lent: un ioctl par disque et par minute)
+typedef struct {
+    double timestamp;
+    int storage_count;
+    StorageHealthSample storages[METRICS_MAX_STORAGES];
+} StorageHealthSnapshot;
+
+// Collecteur volumes logiques: grappes md et volumes dm, débits par /proc/diskstats
+typedef struct {
+    double timestamp;
+    int volume_count;
+    LogicalVolume volumes[METRICS_MAX_VOLUMES];
+} VolumeSnapshot;
+
+// Collecteur systèmes de fichiers: occupation par montage et tendance (statvfs limité par montage)
+typedef struct {
+    double timestamp;
+    int filesystem_count;
+    FilesystemUsage filesystems[METRICS_MAX_FILESYSTEMS];
+} FilesystemSnapshot;
+
+// Informations statiques (collectées une fois)
+typedef struct {
+    char hardware_model[256];
+    char processor[256];
+    char architecture[64];
+    char cpu_cores[64];
+    char cpu_cache[128];            // Résumé L1/L2/L3
+    char numa_layout[512];          // "Node 0: CPUs 0-15" par ligne
+    char gpu[256];
+    char kernel[256];
+    char distro[256];
+    char desktop[256];
+    char locale[64];
+    char hostname[256];
+} SystemSnapshot;
+
+// Ensemble des instantanés (opaque)
+typedef struct Metrics Metrics;
+
+/*
+ * Créer l'ensemble des instantanés (tous en version 0)
+ * Retourne NULL en cas d'erreur d'allocation
+ * IMPORTANT: Libérer avec metrics_destroy()
+ */
+Metrics* metrics_create(void);
+
+/*
+ * Libérer les instantanés (plus aucun lecteur actif)
+ */
+void metrics_destroy(Metrics *metrics);
+
+/*
+ * Écrivain: échantillonner puis publier un nouvel instantané
+ */
+void metrics_collect_cpu(Metrics *metrics);
+void metrics_collect_sensors(Metrics *metrics);
+void metrics_collect_gpu(Metrics *metrics);
+void metrics_collect_network(Metrics *metrics);              // Débits par interface
+void metrics_collect_network_addresses(Metrics *metrics);    // Adresses IP (`ip addr`) et vitesse du lien
+void metrics_collect_wireless(Metrics *metrics);             // Lien WiFi (nl80211)
+void metrics_collect_sockets(Metrics *metrics);
+void metrics_collect_cgroups(Metrics *metrics);
+void metrics_collect_numa(Metrics *metrics);
+void metrics_collect_storage_usage(Metrics *metrics);
+void metrics_collect_storage_latency(Metrics *metrics);
+void metrics_collect_storage_health(Metrics *metrics);
+void metrics_collect_volumes(Metrics *metrics);
+void metrics_collect_filesystems(Metrics *metrics);
+void metrics_collect_system_info(Metrics *metrics);
+
+/*
+ * Écrivain: ajouter / retirer une interface ou un disque des instantanés
+ * Pris en compte à la prochaine publication du collecteur concerné
+ * Retourne false si la liste est pleine
+ */
+bool metrics_track_interface(Metrics *metrics, const char *interface_name);
+void metrics_untrack_interface(Metrics *metrics, const char *interface_name);
+bool metrics_track_storage(Metrics *metrics, const PhysicalStorage *storage);
+void metrics_untrack_storage(Metrics *metrics, const char *storage_name);
+
+/*
+ * Écrivain: suspendre / reprendre la latence disque (tracepoints coûteux sans lecteur)
+ */
+void metrics_set_storage_latency_paused(Metrics *metrics, bool paused);
+
+/*
+ * Lecteurs (n'importe quel thread): copier le dernier instantané publié
+ * Retourne sa version (0 = encore jamais publié, snapshot rempli de zéros)
+ */
+uint64_t metrics_read_cpu(const Metrics *metrics, CpuSnapshot *snapshot);
+uint64_t metrics_read_sensors(const Metrics *metrics, SensorsSnapshot *snapshot);
+uint64_t metrics_read_gpu(const Metrics *metrics, GpuSnapshot *snapshot);
+uint64_t metrics_read_network(const Metrics *metrics, NetworkSnapshot *snapshot);
+uint64_t metrics_read_sockets(const Metrics *metrics, SocketSnapshot *snapshot);
+uint64_t metrics_read_cgroups(const Metrics *metrics, CgroupSnapshot *snapshot);
+uint64_t metrics_read_numa(const Metrics *metrics, NumaSnapshot *snapshot);
+uint64_t metrics_read_storage(const Metrics *metrics, StorageSnapshot *snapshot);
+uint64_t metrics_read_storage_latency(const Metrics *metrics, StorageLatencySnapshot *snapshot);
+uint64_t metrics_read_storage_health(const Metrics *metrics, StorageHealthSnapshot *snapshot);
+uint64_t metrics_read_volumes(const Metrics *metrics, VolumeSnapshot *snapshot);
+uint64_t metrics_read_filesystems(const Metrics *metrics, FilesystemSnapshot *snapshot);
+uint64_t metrics_read_system_info(const Metrics *metrics, SystemSnapshot *snapshot);
+
+#endif // METRICS_H
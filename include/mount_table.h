@@ -0,0 +1,70 @@
+/*
+ * mount_table.h
+ * Table des montages (/proc/self/mountinfo) rattachés à leurs disques physiques
+ *
+ * Chaque système de fichiers monté sur un périphérique bloc est relié au(x) disque(s)
+ * qui le portent en descendant /sys/class/block/<périphérique>/slaves: LVM, dm-crypt,
+ * md et les partitions mènent au disque entier. Le périphérique vient du champ
+ * major:minor de mountinfo (de la source /dev/... pour btrfs, dont le major:minor
+ * est anonyme): les sources /dev/disk/by-uuid ou /dev/mapper, les montages bind et
+ * les sous-volumes sont reconnus sans comparer de noms.
+ *
+ * La table n'est relue que lorsque poll() sur /proc/self/mountinfo signale un
+ * changement (POLLPRI): sans montage ni démontage, un appel ne coûte qu'un poll().
+ * Les fonctions peuvent être appelées depuis plusieurs fils (test de vitesse).
+ */
+
+#ifndef MOUNT_TABLE_H
+#define MOUNT_TABLE_H
+
+#include <stdbool.h>
+
+#define MOUNT_MAX_DISKS 8
+
+typedef struct {
+    char mount_point[256];
+    char fstype[32];
+    char source[128];               // Tel qu'écrit dans mountinfo (ex: "/dev/mapper/vg-root")
+    char device[32];                // Périphérique bloc monté (ex: "dm-1", "sda2", "nvme0n1p1")
+    unsigned int major;             // Numéros de ce périphérique
+    unsigned int minor;
+    bool subtree;                   // Montage bind ou sous-volume (racine différente de "/")
+    bool read_only;
+    int disk_count;
+    char disks[MOUNT_MAX_DISKS][32];   // Disques physiques sous-jacents (ex: "sda", "nvme0n1")
+} MountEntry;
+
+// Bas d'une pile de périphériques: partition (ou disque sans partition) et disque qui la porte
+typedef struct {
+    char device[32];                // ex: "sda2", "nvme0n1p1", "sdc"
+    char disk[32];                  // ex: "sda", "nvme0n1", "sdc"
+} BlockMember;
+
+/*
+ * Membres d'un périphérique bloc (ex: "dm-1", "md0"): slaves parcourus jusqu'en bas
+ * Un périphérique sans slaves (partition, disque) est son propre et unique membre
+ * Retourne le nombre de membres copiés (au plus max_members)
+ */
+int get_block_members(const char *device_name, BlockMember *members, int max_members);
+
+/*
+ * Copier les montages sur périphérique bloc (pseudo-systèmes de fichiers exclus)
+ * Retourne le nombre d'entrées copiées (au plus max_entries), -1 si mountinfo est illisible
+ */
+int get_mount_table(MountEntry *entries, int max_entries);
+
+/*
+ * Systèmes de fichiers qui reposent sur un disque physique (ex: "sda"), même via LVM / dm-crypt
+ * Un seul montage par système de fichiers: le montage principal plutôt qu'un bind ou un sous-volume
+ * Retourne le nombre d'entrées copiées (au plus max_entries)
+ */
+int get_storage_filesystems(const char *storage_name, MountEntry *entries, int max_entries);
+
+/*
+ * Tous les systèmes de fichiers montés sur un périphérique bloc, un montage par système de
+ * fichiers (même choix que get_storage_filesystems()), dans l'ordre de mountinfo
+ * Retourne le nombre d'entrées copiées (au plus max_entries)
+ */
+int get_mounted_filesystems(MountEntry *entries, int max_entries);
+
+#endif // MOUNT_TABLE_H
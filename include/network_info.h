@@ -6,6 +6,28 @@
 #ifndef NETWORK_INFO_H
 #define NETWORK_INFO_H
 
+#include <stdbool.h>
+
+// Paquets, erreurs et pertes d'une interface, par seconde (colonnes de /proc/net/dev)
+typedef struct {
+    float rx_packets_per_sec;
+    float tx_packets_per_sec;
+    float rx_errors_per_sec;
+    float tx_errors_per_sec;
+    float rx_drops_per_sec;
+    float tx_drops_per_sec;
+} InterfacePacketRates;
+
+#define PACKET_COUNTER_COUNT 6
+
+// Débits d'une interface calculés sur une même lecture de /proc/net/dev
+typedef struct {
+    bool found;                     // false si l'interface est absente de /proc/net/dev
+    float upload_kbps;
+    float download_kbps;
+    InterfacePacketRates packets;
+} InterfaceRates;
+
 /*
  * Récupérer le nom d'hôte de la machine
  * Retourne une chaîne de caractères (buffer statique)
@@ -25,6 +47,15 @@ const char* get_local_ip_address(void);
  */
 const char* get_interface_ip_address(const char *interface_name);
 
+/*
+ * Déterminer le type d'une interface réseau
+ * interface_name : nom de l'interface (ex: "eth0", "wlan0", "wg0", "eth0.100")
+ * Retourne "Ethernet", "WiFi" ou "Mobile" pour une interface physique,
+ * "VPN" (WireGuard, tun / tap), "VLAN" ou "Bond" d'après le DEVTYPE de sysfs (tun_flags pour tun / tap)
+ * Retourne NULL si l'interface est ignorée (loopback, conteneurs, ponts, inexistante)
+ */
+const char* get_network_interface_type(const char *interface_name);
+
 /*
  * Récupérer la liste des interfaces réseau disponibles
  * Retourne une chaîne formatée avec les noms et types (Ethernet, WiFi, Mobile)
@@ -47,15 +78,50 @@ float get_network_download_kbps(void);
 /*
  * Récupérer la vitesse de téléchargement pour une interface spécifique en KB/s
  * interface_name : nom de l'interface (ex: "eth0", "wlan0")
- * Retourne la vitesse en KB/s (moyenne depuis la dernière lecture)
+ * Retourne la vitesse en KB/s (moyenne sur le temps écoulé depuis la dernière lecture)
  */
 float get_interface_download_kbps(const char *interface_name);
 
 /*
  * Récupérer la vitesse de chargement pour une interface spécifique en KB/s
  * interface_name : nom de l'interface (ex: "eth0", "wlan0")
- * Retourne la vitesse en KB/s (moyenne depuis la dernière lecture)
+ * Retourne la vitesse en KB/s (moyenne sur le temps écoulé depuis la dernière lecture)
  */
 float get_interface_upload_kbps(const char *interface_name);
 
+/*
+ * Récupérer les débits de paquets, d'erreurs et de pertes d'une interface
+ * Même lecture de /proc/net/dev que les débits en KB/s; le premier appel sert
+ * de référence (tous les débits valent 0)
+ * Retourne false si l'interface est absente de /proc/net/dev
+ */
+bool get_interface_packet_rates(const char *interface_name, InterfacePacketRates *rates);
+
+/*
+ * Débits de plusieurs interfaces: /proc/net/dev lu et découpé une seule fois
+ * rates[i] correspond à interface_names[i]; le premier appel pour une interface sert
+ * de référence (débits à 0). Compteurs précédents distincts de ceux des fonctions
+ * par interface ci-dessus: les deux peuvent servir pour une même interface.
+ * Retourne le nombre d'interfaces trouvées
+ */
+int get_interface_rates(const char *const *interface_names, int interface_count, InterfaceRates *rates);
+
+/*
+ * Récupérer la vitesse négociée du lien en Mb/s (/sys/class/net/<if>/speed)
+ * Retourne -1 si inconnue (lien coupé, WiFi, interface virtuelle)
+ */
+int get_interface_link_speed_mbps(const char *interface_name);
+
+/*
+ * Récupérer le mode duplex du lien (/sys/class/net/<if>/duplex)
+ * Retourne "full", "half" ou "unknown"
+ */
+const char* get_interface_duplex(const char *interface_name);
+
+/*
+ * Oublier les données en cache d'une interface (adresse IP, compteurs)
+ * À appeler lorsque l'interface disparaît (hotplug) pour libérer son entrée
+ */
+void forget_network_interface(const char *interface_name);
+
 #endif // NETWORK_INFO_H
@@ -0,0 +1,51 @@
+/*
+ * parse_utils.h
+ * Lecture de fichiers /proc et /sys sans stdio ni allocation
+ *
+ * Les fichiers sont lus d'un bloc (open/read) dans un tampon fourni par l'appelant,
+ * puis parcourus avec un curseur [cursor, end). Les entiers sont décodés à la main:
+ * indépendant de la locale, pas d'interprétation de format comme sscanf.
+ */
+
+#ifndef PARSE_UTILS_H
+#define PARSE_UTILS_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Lire un fichier (chemin relatif à la racine, voir sysroot.h) dans buffer
+ * Le contenu est terminé par '\0'; tronqué s'il dépasse buffer_size - 1
+ * Retourne la longueur lue, ou -1 en cas d'erreur
+ */
+long parse_read_file(const char *path, char *buffer, size_t buffer_size);
+
+/*
+ * Idem avec un chemin déjà complet (ex: construit par sysroot_path())
+ */
+long parse_read_file_at(const char *full_path, char *buffer, size_t buffer_size);
+
+/*
+ * Décoder un entier décimal non signé (espaces et tabulations initiaux ignorés)
+ * Retourne la position après le dernier chiffre, ou NULL si aucun chiffre
+ */
+const char* parse_u64(const char *cursor, const char *end, uint64_t *value);
+
+/*
+ * Décoder jusqu'à max_values entiers consécutifs de la ligne courante
+ * Retourne le nombre d'entiers lus (s'arrête au premier champ non numérique)
+ */
+int parse_u64_fields(const char *cursor, const char *end, uint64_t *values, int max_values);
+
+/*
+ * Position du début de la ligne suivante (end si dernière ligne)
+ */
+const char* parse_next_line(const char *cursor, const char *end);
+
+/*
+ * Si la ligne commence par prefix, retourne la position juste après, sinon NULL
+ */
+const char* parse_skip_prefix(const char *cursor, const char *end, const char *prefix);
+
+#endif // PARSE_UTILS_H
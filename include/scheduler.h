@@ -0,0 +1,67 @@
+/*
+ * scheduler.h
+ * Ordonnanceur multi-fréquences des collecteurs (timerfd + epoll)
+ *
+ * Chaque collecteur possède son propre intervalle (ex: CPU 250 ms, réseau 500 ms,
+ * utilisation disque 10 s). Tous les timers sont ancrés sur la même origine et
+ * arrondis à la granularité de coalescence: les échéances communes tombent au même
+ * instant et sont traitées en un seul réveil du processus.
+ */
+
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include <stdbool.h>
+
+// Fonction appelée à chaque échéance d'un collecteur
+typedef void (*CollectorCallback)(void *user_data);
+
+// Ordonnanceur opaque
+typedef struct Scheduler Scheduler;
+
+/*
+ * Créer un ordonnanceur
+ * coalesce_ms : granularité d'alignement des intervalles (ex: 50 ms)
+ * Retourne NULL en cas d'erreur (epoll indisponible)
+ * IMPORTANT: Libérer avec scheduler_destroy()
+ */
+Scheduler* scheduler_create(unsigned int coalesce_ms);
+
+/*
+ * Enregistrer un collecteur
+ * name : nom du collecteur (diagnostic)
+ * interval_ms : période en ms, 0 = exécuté une seule fois (infos statiques)
+ * Retourne l'identifiant du collecteur, ou -1 en cas d'erreur
+ */
+int scheduler_add_collector(Scheduler *scheduler, const char *name, unsigned int interval_ms,
+                            CollectorCallback callback, void *user_data);
+
+/*
+ * Modifier la période d'un collecteur (0 = suspendu)
+ * La prochaine échéance reste alignée sur l'origine commune
+ */
+bool scheduler_set_interval(Scheduler *scheduler, int collector_id, unsigned int interval_ms);
+
+/*
+ * Exécuter immédiatement un collecteur, sans décaler ses échéances
+ */
+void scheduler_run_now(Scheduler *scheduler, int collector_id);
+
+/*
+ * Descripteur epoll à surveiller (lisible quand au moins un timer a expiré)
+ * Permet d'intégrer l'ordonnanceur à une boucle existante (GLib, poll...)
+ */
+int scheduler_get_fd(const Scheduler *scheduler);
+
+/*
+ * Exécuter tous les collecteurs arrivés à échéance (non bloquant)
+ * Les collecteurs d'un même réveil sont exécutés dans l'ordre d'enregistrement
+ */
+void scheduler_dispatch(Scheduler *scheduler);
+
+/*
+ * Libérer l'ordonnanceur et fermer ses descripteurs
+ */
+void scheduler_destroy(Scheduler *scheduler);
+
+#endif // SCHEDULER_H
@@ -0,0 +1,62 @@
+/*
+ * snapshot.h
+ * Publication sans verrou d'une valeur versionnée (un écrivain, plusieurs lecteurs)
+ *
+ * Les fonctions get_*() des collecteurs renvoient des tampons statiques réécrits à
+ * chaque appel: un second consommateur (exporteur, enregistrement) ou un thread
+ * d'échantillonnage verrait des valeurs déchirées. Une SnapshotCell garde deux copies
+ * de la valeur et un compteur de séquence (technique du "latch" seqlock):
+ *   - l'écrivain ne bloque jamais et n'attend aucun lecteur;
+ *   - un lecteur copie la valeur et recommence seulement si une publication
+ *     a eu lieu pendant sa copie: il n'observe jamais une valeur partielle.
+ *
+ * Chaque publication incrémente la version: un lecteur peut ignorer une valeur
+ * déjà traitée en comparant les versions.
+ */
+
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Valeur publiée: deux copies de size octets (contenu sans pointeur)
+typedef struct {
+    _Atomic uint64_t sequence;   // Impair: copie 0 en cours d'écriture
+    size_t size;
+    void *copies[2];
+} SnapshotCell;
+
+/*
+ * Allouer les deux copies (remplies de zéros, version 0 = jamais publiée)
+ * Retourne false en cas d'erreur d'allocation
+ * IMPORTANT: Libérer avec snapshot_cell_free()
+ */
+bool snapshot_cell_init(SnapshotCell *cell, size_t size);
+
+/*
+ * Libérer les copies (aucun lecteur ne doit être actif)
+ */
+void snapshot_cell_free(SnapshotCell *cell);
+
+/*
+ * Publier une nouvelle valeur (size octets copiés depuis value)
+ * Un seul écrivain par cellule: appeler toujours depuis le même thread
+ * Retourne la version publiée
+ */
+uint64_t snapshot_publish(SnapshotCell *cell, const void *value);
+
+/*
+ * Copier la dernière valeur publiée dans value (size octets), depuis n'importe quel thread
+ * Retourne sa version (0 si rien n'a encore été publié)
+ */
+uint64_t snapshot_read(const SnapshotCell *cell, void *value);
+
+/*
+ * Version de la dernière valeur publiée, sans la copier
+ */
+uint64_t snapshot_version(const SnapshotCell *cell);
+
+#endif // SNAPSHOT_H
@@ -0,0 +1,65 @@
+/*
+ * socket_info.h
+ * Statistiques de connexions TCP (netlink sock_diag) et compteurs d'erreurs
+ * TCP/UDP (/proc/net/snmp)
+ *
+ * Les états des sockets sont obtenus par un dump NETLINK_SOCK_DIAG (inet_diag):
+ * messages binaires, sans lire /proc/net/tcp dont le texte coûte O(connexions)
+ * en formatage côté noyau et en analyse côté SysWatch.
+ */
+
+#ifndef SOCKET_INFO_H
+#define SOCKET_INFO_H
+
+#include <stdbool.h>
+
+// États TCP du noyau (1 = ESTABLISHED ... 12 = NEW_SYN_RECV), index 0 inutilisé
+#define TCP_STATE_SLOTS 13
+
+// Résumé des sockets TCP IPv4 + IPv6
+typedef struct {
+    unsigned int states[TCP_STATE_SLOTS];  // Nombre de sockets par état
+    unsigned int total;
+    unsigned int established;
+    unsigned int time_wait;
+    unsigned int listening;
+    unsigned int retransmitting;           // Sockets avec une retransmission en cours
+    float rtt_avg_ms;                      // RTT lissé moyen des connexions établies
+    float rtt_max_ms;
+} TcpSocketSummary;
+
+// Compteurs /proc/net/snmp convertis en événements par seconde depuis l'appel précédent
+typedef struct {
+    float tcp_active_opens;
+    float tcp_passive_opens;
+    float tcp_attempt_fails;
+    float tcp_estab_resets;
+    float tcp_retrans_segs;
+    float tcp_in_errs;
+    float tcp_out_rsts;
+    float udp_in_errors;
+    float udp_no_ports;
+    float udp_rcvbuf_errors;
+    float udp_sndbuf_errors;
+} ProtocolCounterRates;
+
+/*
+ * Compter les sockets TCP par état, avec résumé RTT / retransmissions
+ * Retourne false si sock_diag est indisponible (noyau sans inet_diag)
+ * ou si une racine de test est active (voir sysroot.h: netlink décrit l'hôte réel)
+ */
+bool get_tcp_socket_summary(TcpSocketSummary *summary);
+
+/*
+ * Débits des compteurs d'erreurs TCP/UDP depuis l'appel précédent
+ * Le premier appel sert de référence: tous les débits valent 0
+ * Retourne false si /proc/net/snmp est illisible
+ */
+bool get_protocol_counter_rates(ProtocolCounterRates *rates);
+
+/*
+ * Nom court d'un état TCP (ex: "ESTABLISHED", "TIME_WAIT"), "?" si inconnu
+ */
+const char* get_tcp_state_name(int state);
+
+#endif // SOCKET_INFO_H
@@ -0,0 +1,55 @@
+/*
+ * speed_history.h
+ * Historique des tests de vitesse, conservé entre deux lancements
+ *
+ * Un disque est reconnu par son identité matérielle (WWN / EUI, numéro de série,
+ * CID d'une carte SD), pas par son nom: "sdb" peut désigner un autre disque au
+ * prochain démarrage. Les mesures sont ajoutées à un petit fichier texte
+ * ($XDG_STATE_HOME/syswatch/speed_tests.tsv, ~/.local/state/syswatch/ par défaut),
+ * compacté au-delà de SPEED_HISTORY_MAX_BYTES. Seules des mesures de mêmes
+ * paramètres sont comparées.
+ */
+
+#ifndef SPEED_HISTORY_H
+#define SPEED_HISTORY_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define SPEED_HISTORY_MAX_BYTES (64 * 1024)
+
+typedef enum {
+    SPEED_RECORD_READ,
+    SPEED_RECORD_WRITE
+} SpeedRecordKind;
+
+typedef struct {
+    int64_t timestamp;              // Secondes depuis l'epoch (heure murale)
+    SpeedRecordKind kind;
+    float mbps;
+    float iops;                     // Lectures aléatoires (0 si non mesurées)
+    char parameters[64];            // Méthode et paramètres du test (sans tabulation)
+} SpeedTestRecord;
+
+/*
+ * Identité stable d'un disque (ex: "naa.5002538e40a1b2c3", "eui.0025388b91b2c3d4")
+ * Lue dans /sys/block/<disque>: wwid, device/wwid, device/serial, serial puis device/cid
+ * Retourne false si le disque n'expose aucun identifiant (pas d'historique possible)
+ */
+bool get_storage_identity(const char *storage_name, char *identity, size_t identity_size);
+
+/*
+ * Dernière mesure enregistrée pour ce disque, ce type et ces paramètres
+ * Retourne false si aucune mesure comparable n'existe
+ */
+bool speed_history_find_latest(const char *identity, SpeedRecordKind kind, const char *parameters,
+                               SpeedTestRecord *record);
+
+/*
+ * Ajouter une mesure (crée le répertoire et le fichier au besoin)
+ * Retourne false si le fichier ne peut pas être écrit
+ */
+bool speed_history_append(const char *identity, const SpeedTestRecord *record);
+
+#endif // SPEED_HISTORY_H
@@ -0,0 +1,141 @@
+/*
+ * speed_test.h
+ * Test de vitesse non destructif: lectures O_DIRECT sur le périphérique bloc brut
+ *
+ * Aucune écriture: utilisable sur un disque de production, non monté ou monté en
+ * lecture seule, sans user une carte SD. Demande le droit de lecture sur
+ * /dev/<disque> (root ou groupe "disk"). Le test par fichier temporaire
+ * (get_storage_file_speed_test(), storage_info.h) ne sert qu'à la demande, pour l'écriture.
+ *
+ * Méthode commune aux deux tests: SPEED_TEST_WARMUP_RUNS passe(s) d'échauffement
+ * non comptée(s), puis SPEED_TEST_RUNS répétitions mesurées résumées par leur
+ * médiane, leur écart-type et un intervalle de confiance à 95 % (t de Student).
+ * Une mesure isolée peut être faussée par une E/S concurrente ou un cache.
+ *
+ * Un test peut durer plus d'une minute (clé USB 2.0): il rend compte de son
+ * avancement toutes les SPEED_TEST_PROGRESS_SECONDS et s'arrête dès la prochaine
+ * E/S quand l'annulation est demandée (SpeedTestControl).
+ */
+
+#ifndef SPEED_TEST_H
+#define SPEED_TEST_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdatomic.h>
+
+#define SPEED_TEST_WARMUP_RUNS      1
+#define SPEED_TEST_RUNS             5
+#define SPEED_TEST_SLICE_SECONDS    0.1     // Débit par tranche de 100 ms d'E/S
+#define SPEED_TEST_MAX_SLICES       600     // Une minute d'E/S, le reste est ignoré
+#define SPEED_TEST_PROGRESS_SECONDS 0.1     // Période des rapports d'avancement
+
+// Résumé des répétitions mesurées (même unité que les échantillons: MB/s ou IOPS)
+typedef struct {
+    int runs;
+    float median;
+    float mean;
+    float stddev;                   // Écart-type de l'échantillon (n - 1)
+    float ci95;                     // Demi-largeur de l'intervalle de confiance à 95 % (0 si runs < 2)
+    float min;
+    float max;
+} SpeedTestStats;
+
+/*
+ * Débit par tranche de temps, répétitions mises bout à bout
+ * Seul le temps passé en E/S compte: les pauses entre répétitions (vidage des
+ * caches) ne créent pas de creux. Un SSD grand public écrit d'abord dans un cache
+ * SLC rapide puis chute au débit TLC/QLC une fois ce cache plein: la chute n'est
+ * visible que si le volume écrit dépasse ce cache.
+ */
+typedef struct {
+    float slice_mbps[SPEED_TEST_MAX_SLICES];
+    int slice_count;
+    double slice_seconds;           // Tranche en cours
+    uint64_t slice_bytes;
+    float cliff_seconds;            // Début de la chute durable de débit (-1 = aucune)
+    float sustained_mbps;           // Débit médian après la chute
+} SpeedTestTimeline;
+
+// Rapport d'avancement (débit instantané: octets de la dernière période)
+typedef struct {
+    const char *phase;              // "Write", "Read", "Random read"... (chaîne statique)
+    float fraction;                 // Avancement du test de ce disque (0 à 1)
+    float mbps;
+    double elapsed_seconds;         // Depuis le début du test de ce disque
+} SpeedTestProgress;
+
+typedef void (*SpeedTestProgressCallback)(const SpeedTestProgress *progress, void *user_data);
+
+/*
+ * Pilotage d'un test depuis un autre fil (interface)
+ * cancel : lu après chaque E/S; le test s'arrête et retourne false
+ * progress : facultatif, appelé depuis le fil du test
+ */
+typedef struct {
+    atomic_bool cancel;
+    SpeedTestProgressCallback progress;
+    void *user_data;
+} SpeedTestControl;
+
+// Compteur d'avancement d'un test (fil du test)
+typedef struct {
+    SpeedTestControl *control;      // NULL = ni rapport ni annulation
+    uint64_t total_work;            // Unité choisie par le test (en pratique des octets prévus)
+    uint64_t done_work;
+    double start;
+    double window_start;
+    uint64_t window_bytes;
+} SpeedTestMeter;
+
+typedef struct {
+    SpeedTestStats sequential_mbps; // Blocs de 1 Mio lus à la suite dans des zones réparties sur tout le disque
+    SpeedTestStats random_iops;     // Blocs de 4 Kio à des positions aléatoires
+    float random_mbps;              // Médiane
+    uint64_t bytes_read;            // Échauffement compris
+} ReadSpeedTestResult;
+
+// Paramètres enregistrés avec chaque mesure (speed_history.h): à changer avec la méthode
+#define READ_SPEED_TEST_PARAMETERS "raw O_DIRECT seq 16x4MiB rand 4KiB 0.5s median of 5"
+
+/*
+ * Mesurer la lecture séquentielle et aléatoire d'un disque (ex: "sda", "nvme0n1")
+ * Durée: quelques secondes (64 Mio séquentiels et une demi-seconde d'aléatoire par passe)
+ * Chaque passe lit d'autres zones: le cache interne du disque ne resert pas les mêmes blocs
+ * control : avancement et annulation (NULL = aucun)
+ * Retourne false si /dev/<disque> ne peut pas être ouvert en O_DIRECT (droits, racine de test)
+ * ou si le test a été annulé
+ */
+bool get_storage_read_speed_test(const char *storage_name, ReadSpeedTestResult *result,
+                                 SpeedTestControl *control);
+
+/*
+ * Résumer des échantillons (une valeur par répétition mesurée)
+ * samples est trié sur place
+ */
+void speed_test_summarize(float *samples, int count, SpeedTestStats *stats);
+
+/*
+ * Découpage en tranches: start() avant la première répétition, add() après
+ * chaque E/S (octets, durée), finish() pour détecter une chute de débit
+ */
+void speed_test_timeline_start(SpeedTestTimeline *timeline);
+void speed_test_timeline_add(SpeedTestTimeline *timeline, uint64_t bytes, double seconds);
+void speed_test_timeline_finish(SpeedTestTimeline *timeline);
+
+/*
+ * Avancement: start() avec le travail prévu, add() après chaque E/S (octets
+ * transférés, travail accompli). add() appelle le rapport au plus une fois par
+ * période et retourne false si l'annulation est demandée.
+ */
+void speed_test_meter_start(SpeedTestMeter *meter, SpeedTestControl *control, uint64_t total_work);
+bool speed_test_meter_add(SpeedTestMeter *meter, const char *phase, uint64_t bytes, uint64_t work);
+
+/*
+ * Écarter le cache de pages avant une passe de lecture
+ * fdatasync + posix_fadvise(DONTNEED) sur le fichier, puis /proc/sys/vm/drop_caches
+ * si le processus en a le droit (root). Retourne true si le cache global a été vidé.
+ */
+bool speed_test_drop_caches(int fd);
+
+#endif // SPEED_TEST_H
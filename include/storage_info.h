@@ -6,6 +6,10 @@
 #ifndef STORAGE_INFO_H
 #define STORAGE_INFO_H
 
+#include <stdbool.h>
+#include <stddef.h>
+#include "speed_test.h"
+
 // Structure pour représenter un stockage physique
 typedef struct {
     char name[32];           // ex: "sda", "nvme0n1"
@@ -26,21 +30,65 @@ typedef struct {
  */
 PhysicalStorage* get_physical_storages(int *count);
 
+/*
+ * Lire les informations d'un stockage physique spécifique
+ * storage_name : nom du périphérique bloc (ex: "sda", "nvme0n1")
+ * storage : structure à remplir
+ * Retourne false si le périphérique n'est pas un disque physique pris en charge
+ * (partition, loop, dm, nom invalide...)
+ */
+bool get_physical_storage_info(const char *storage_name, PhysicalStorage *storage);
+
+/*
+ * Relire l'espace utilisé/disponible d'un stockage (somme de ses partitions montées)
+ * storage : stockage à mettre à jour (champ name renseigné)
+ * Retourne false si aucune partition montée n'a été trouvée (used/available à 0)
+ */
+bool update_physical_storage_usage(PhysicalStorage *storage);
+
 /*
  * Libérer la mémoire allouée par get_physical_storages()
  */
 void free_physical_storages(PhysicalStorage *storages);
 
+// Résultat du test par fichier temporaire (répétitions résumées, speed_test.h)
+typedef struct {
+    SpeedTestStats read_mbps;
+    SpeedTestStats write_mbps;
+    SpeedTestTimeline write_timeline;   // Vide si O_DIRECT indisponible (FAT)
+    bool direct_io;                     // Sinon écritures en cache + fdatasync, lectures après vidage du cache
+    bool caches_dropped;                // /proc/sys/vm/drop_caches écrit (root) en plus de posix_fadvise
+    int size_mb;                        // Taille du fichier (écrit à chaque passe)
+    int sustained_mb;                   // Écrit à la suite pour remplir le cache SLC (0 = pas fait)
+} FileSpeedTestResult;
+
 /*
  * Effectuer un test de vitesse pour un stockage spécifique
  * storage_name : nom du stockage (ex: "sda", "nvme0n1")
- * read_mbps : pointeur pour stocker la vitesse de lecture en MB/s
- * write_mbps : pointeur pour stocker la vitesse d'écriture en MB/s
+ * sustained_write : prolonger le test d'écriture pour chercher la chute du cache SLC
+ * result : répétitions d'écriture puis de lecture sur un même fichier temporaire
+ * control : avancement et annulation (speed_test.h, NULL = aucun)
  * 
- * Note: Le test crée un fichier temporaire de 20-100 MB selon l'espace disponible
- * Les valeurs seront 0.0f si le test échoue ou si le stockage n'est pas accessible
+ * Note: Le fichier fait 16 ou 64 MB selon l'espace disponible, réécrit à chaque passe
+ * sustained_write et O_DIRECT: une écriture soutenue le prolonge ensuite (quart de l'espace
+ * libre, 4 Gio ou une minute d'E/S au plus); sans elle la chute du cache SLC n'est pas visible
+ * Il n'a pas de nom (O_TMPFILE, sinon supprimé dès sa création): rien ne reste sur le
+ * disque après une annulation ou un arrêt brutal
+ * Retourne false si le test échoue, est annulé ou si le stockage n'est pas monté en écriture
+ */
+bool get_storage_file_speed_test(const char *storage_name, bool sustained_write, FileSpeedTestResult *result,
+                                 SpeedTestControl *control);
+
+#define FILE_SPEED_TEST_MB          64      // Fichier réécrit puis relu à chaque passe
+#define FILE_SPEED_TEST_SMALL_MB    16      // Moins de 4 passes d'espace libre
+
+/*
+ * Méthode d'un test par fichier, telle qu'enregistrée dans l'historique (speed_history.h)
+ * La taille et le mode d'E/S en font partie: 16 Mio en cache (FAT, O_DIRECT refusé) ne se
+ * comparent pas à 64 Mio en O_DIRECT
+ * ex: "tempfile 64MiB O_DIRECT+fdatasync median of 5", "tempfile 16MiB buffered+fdatasync median of 5"
  */
-void get_storage_speed_test(const char *storage_name, float *read_mbps, float *write_mbps);
+void get_file_speed_test_parameters(int size_mb, bool direct_io, char *parameters, size_t parameters_size);
 
 /*
  * Effectuer un test de vitesse stockage global (sur /tmp)
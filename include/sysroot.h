@@ -0,0 +1,50 @@
+/*
+ * sysroot.h
+ * Racine configurable des pseudo-systèmes de fichiers lus par les collecteurs
+ *
+ * Par défaut les collecteurs lisent le système réel (/proc, /sys, /etc). Avec la
+ * variable d'environnement SYSWATCH_ROOT=/chemin (ou sysroot_set()), ils lisent une
+ * arborescence de test à la place: /proc/stat devient /chemin/proc/stat.
+ * Voir bench/gen_fixture.sh pour générer un hôte fictif (256 CPU, 100 interfaces...).
+ */
+
+#ifndef SYSROOT_H
+#define SYSROOT_H
+
+#include <stdio.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <dirent.h>
+
+/*
+ * Définir la racine (NULL ou "" = système réel)
+ * Remplace la valeur lue dans SYSWATCH_ROOT
+ */
+void sysroot_set(const char *root);
+
+/*
+ * Racine courante ("" pour le système réel)
+ */
+const char* sysroot_get(void);
+
+/*
+ * true si une racine de test est active
+ * Les méthodes qui lancent une commande (nproc, lscpu...) décrivent l'hôte réel:
+ * les collecteurs les évitent quand une racine est définie
+ */
+bool sysroot_is_set(void);
+
+/*
+ * Construire un chemin absolu préfixé par la racine (format printf)
+ * Retourne false si le chemin est tronqué
+ */
+bool sysroot_path(char *buffer, size_t buffer_size, const char *format, ...)
+    __attribute__((format(printf, 3, 4)));
+
+/*
+ * fopen()/opendir() d'un chemin absolu, relatif à la racine
+ */
+FILE* sysroot_fopen(const char *path, const char *mode);
+DIR* sysroot_opendir(const char *path);
+
+#endif // SYSROOT_H
@@ -0,0 +1,78 @@
+/*
+ * volume_info.h
+ * Volumes logiques: grappes RAID logicielles (md) et périphériques device-mapper
+ *
+ * get_physical_storages() ne liste que les disques physiques. Une grappe md ou un
+ * volume dm (LVM, dm-crypt, multipath) est décrit ici avec ses membres, obtenus en
+ * descendant les slaves jusqu'aux partitions (get_block_members(), mount_table.h):
+ * un volume LVM sur LUKS sur RAID1 mène aux partitions des deux disques.
+ *
+ * Débits: /proc/diskstats lu d'un bloc à chaque appel, compteurs convertis avec
+ * counter_delta (référence au premier appel). Le débit du volume et la somme de
+ * ceux de ses membres sont donnés côte à côte: pendant une resynchronisation, les
+ * membres travaillent bien plus que le volume, dont le débit utile s'effondre.
+ */
+
+#ifndef VOLUME_INFO_H
+#define VOLUME_INFO_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "mount_table.h"
+
+#define VOLUME_MAX_MEMBERS 8
+
+typedef enum {
+    VOLUME_MD,                      // /sys/block/md*/md/
+    VOLUME_LVM,                     // dm, uuid "LVM-..."
+    VOLUME_CRYPT,                   // dm, uuid "CRYPT-..." (LUKS, plain)
+    VOLUME_DM                       // Autre cible dm (multipath, kpartx, thin...)
+} VolumeKind;
+
+// Débits depuis l'appel précédent (une ligne de /proc/diskstats)
+typedef struct {
+    float read_kbps;
+    float write_kbps;
+    float read_iops;
+    float write_iops;
+} BlockIoRates;
+
+typedef struct {
+    BlockMember member;             // Partition (ou disque) et disque physique
+    char state[24];                 // md: "in_sync", "faulty", "spare", "in_sync,write_mostly"... (vide hors md)
+    BlockIoRates io;
+} VolumeMember;
+
+typedef struct {
+    char name[32];                  // Périphérique bloc (ex: "md0", "dm-1")
+    char label[64];                 // Nom dm (ex: "vg-root", "luks-3f2a..."), vide pour md
+    VolumeKind kind;
+    char type[16];                  // "RAID1", "RAID5", "LVM", "LUKS2", "crypt", "multipath", "dm"...
+    uint64_t size_bytes;            // 0 pour une grappe inactive
+    char array_state[16];           // md: "clean", "active", "inactive", "read-auto"...; dm: "active", "suspended"
+
+    // md seulement
+    char sync_action[16];           // "idle", "resync", "recover", "check", "repair", "reshape", "frozen"
+    float sync_fraction;            // Avancement (0 à 1), -1 sans synchronisation en cours
+    float sync_kbps;                // md/sync_speed
+    int raid_disks;
+    int degraded;                   // Membres manquants
+
+    BlockIoRates io;                // Le volume lui-même
+    BlockIoRates member_io;         // Somme des membres (synchronisation et écritures en miroir comprises)
+    int member_count;
+    VolumeMember members[VOLUME_MAX_MEMBERS];
+} LogicalVolume;
+
+/*
+ * Lister les grappes md et les volumes dm, avec leurs débits depuis l'appel précédent
+ * Retourne le nombre de volumes copiés (au plus max_volumes), 0 si aucun
+ */
+int get_logical_volumes(LogicalVolume *volumes, int max_volumes);
+
+/*
+ * Synchronisation md en cours (resync, recover, check, repair, reshape)
+ */
+bool is_volume_syncing(const LogicalVolume *volume);
+
+#endif // VOLUME_INFO_H
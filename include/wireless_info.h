@@ -0,0 +1,34 @@
+/*
+ * wireless_info.h
+ * Qualité du lien WiFi via nl80211 (generic netlink)
+ *
+ * Signal, bruit, débits PHY, MCS et fréquence du point d'accès sont demandés
+ * au noyau sur un socket netlink conservé: ni `iw`, ni `iwconfig`, ni libnl.
+ */
+
+#ifndef WIRELESS_INFO_H
+#define WIRELESS_INFO_H
+
+#include <stdbool.h>
+
+// Lien d'une interface WiFi (mode station)
+typedef struct {
+    bool connected;             // false: aucune station associée (autres champs à zéro)
+    int signal_dbm;             // 0 si inconnu
+    int noise_dbm;              // 0 si le pilote ne fournit pas de survey
+    float tx_bitrate_mbps;      // Débit PHY du dernier paquet émis
+    float rx_bitrate_mbps;
+    int tx_mcs;                 // Index MCS (HT, VHT ou HE), -1 si débit hérité 802.11a/b/g
+    int rx_mcs;
+    int frequency_mhz;          // Canal du BSS associé, 0 si inconnu
+} WirelessLinkInfo;
+
+/*
+ * Lire l'état du lien WiFi d'une interface
+ * interface_name : nom de l'interface (ex: "wlan0")
+ * Retourne false si nl80211 est indisponible, si l'interface n'est pas WiFi
+ * ou si une racine de test est active (voir sysroot.h: netlink décrit l'hôte réel)
+ */
+bool get_wireless_link_info(const char *interface_name, WirelessLinkInfo *info);
+
+#endif // WIRELESS_INFO_H
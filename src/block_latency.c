@@ -0,0 +1,679 @@
+/*
+ * block_latency.c
+ * Per-disk block request latency: perf tracepoints with a /sys/block stat fallback
+ */
+
+#define _GNU_SOURCE  // Pour syscall
+#include "block_latency.h"
+#include "sysroot.h"
+#include "parse_utils.h"
+#include "counter_delta.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+
+// Tampon par CPU: RING_REQUESTS_PER_SECOND requêtes (issue + complete) entre deux lectures
+#define RING_REQUESTS_PER_SECOND 4096    // Au-delà, PERF_RECORD_LOST et repli sur la moyenne stat
+#define RING_BYTES_PER_REQUEST   192     // Deux PERF_RECORD_SAMPLE (en-tête, id, time, données brutes)
+#define RING_MIN_DATA_PAGES      8
+#define RING_MAX_BYTES           (1024 * 1024)          // Par CPU
+#define RING_TOTAL_MAX_BYTES     (16ULL * 1024 * 1024)  // Tous CPU confondus (mémoire verrouillée)
+#define PENDING_SLOTS       16384       // Requêtes en vol (table à adressage direct)
+
+// État d'un disque suivi
+typedef struct {
+    char name[32];
+    uint32_t dev;                       // dev_t noyau des tracepoints: (majeur << 20) | mineur
+    // Backend tracepoints: accumulé depuis le dernier get_disk_latency()
+    uint32_t histogram[BLOCK_LATENCY_BUCKETS];
+    uint64_t completed;
+    uint64_t total_ns;
+    uint64_t lost_seen;                 // lost_events au dernier get_disk_latency()
+    // Backend stat: compteurs cumulés
+    CounterDelta read_ios;
+    CounterDelta write_ios;
+    CounterDelta read_ticks;
+    CounterDelta write_ticks;
+} DiskState;
+
+static DiskState *disks = NULL;
+static int disk_count = 0;
+static int disk_capacity = 0;
+
+// ============================================================================
+// DISQUES SUIVIS
+// ============================================================================
+
+static DiskState* find_disk(const char *name) {
+    for (int i = 0; i < disk_count; i++) {
+        if (strcmp(disks[i].name, name) == 0) {
+            return &disks[i];
+        }
+    }
+    return NULL;
+}
+
+static DiskState* find_disk_by_dev(uint32_t dev) {
+    for (int i = 0; i < disk_count; i++) {
+        if (disks[i].dev == dev) {
+            return &disks[i];
+        }
+    }
+    return NULL;
+}
+
+// Format de /sys/block/<disque>/dev: "259:0"
+static bool read_disk_dev(const char *name, uint32_t *dev) {
+    char path[PATH_MAX];
+    char buffer[32];
+    snprintf(path, sizeof(path), "/sys/block/%s/dev", name);
+    long length = parse_read_file(path, buffer, sizeof(buffer));
+    if (length <= 0) {
+        return false;
+    }
+    const char *end = buffer + length;
+    uint64_t major = 0, minor = 0;
+    const char *cursor = parse_u64(buffer, end, &major);
+    if (cursor == NULL || cursor >= end || *cursor != ':' || parse_u64(cursor + 1, end, &minor) == NULL) {
+        return false;
+    }
+    *dev = (uint32_t)((major << 20) | (minor & 0xFFFFF));
+    return true;
+}
+
+static DiskState* add_disk(const char *name) {
+    uint32_t dev = 0;
+    if (strchr(name, '/') != NULL || !read_disk_dev(name, &dev)) {
+        return NULL;
+    }
+
+    if (disk_count == disk_capacity) {
+        int new_capacity = disk_capacity > 0 ? disk_capacity * 2 : 16;
+        DiskState *grown = realloc(disks, sizeof(DiskState) * new_capacity);
+        if (grown == NULL) {
+            return NULL;
+        }
+        disks = grown;
+        disk_capacity = new_capacity;
+    }
+
+    DiskState *disk = &disks[disk_count++];
+    memset(disk, 0, sizeof(*disk));
+    snprintf(disk->name, sizeof(disk->name), "%s", name);
+    disk->dev = dev;
+    // Compteurs d'E/S en "unsigned long", durées en "unsigned int" (ms)
+    counter_delta_init(&disk->read_ios, COUNTER_BITS_LONG);
+    counter_delta_init(&disk->write_ios, COUNTER_BITS_LONG);
+    counter_delta_init(&disk->read_ticks, 32);
+    counter_delta_init(&disk->write_ticks, 32);
+    return disk;
+}
+
+// ============================================================================
+// BACKEND TRACEPOINTS (perf_event_open)
+// ============================================================================
+
+// Tampon circulaire d'un CPU (issue et complete y écrivent tous les deux)
+typedef struct {
+    int issue_fd;
+    int complete_fd;
+    struct perf_event_mmap_page *meta;
+    size_t mapped_size;
+} CpuRing;
+
+// Position des champs dev / sector dans les données brutes d'un tracepoint
+typedef struct {
+    uint64_t id;                        // Identifiant de tracepoint (events/block/<nom>/id)
+    int dev_offset;
+    int sector_offset;
+} TracepointFormat;
+
+// Événement extrait des tampons, trié par horodatage avant appariement
+typedef struct {
+    uint64_t time_ns;
+    uint64_t sector;
+    uint32_t dev;
+    bool issue;
+} BlockEvent;
+
+// Requête émise en attente de sa fin
+typedef struct {
+    uint64_t sector;
+    uint64_t time_ns;
+    uint32_t dev;
+    bool used;
+} PendingRequest;
+
+static TracepointFormat issue_format;
+static TracepointFormat complete_format;
+static CpuRing *rings = NULL;
+static int ring_count = 0;
+static uint64_t *issue_ids = NULL;      // PERF_EVENT_IOC_ID des événements issue (un par CPU)
+static PendingRequest *pending = NULL;
+static BlockEvent *events = NULL;
+static size_t event_capacity = 0;
+static size_t page_size = 0;
+static size_t ring_data_pages = 0;      // Puissance de 2 (exigence de perf)
+static uint64_t lost_events = 0;        // Cumul des PERF_RECORD_LOST de tous les CPU
+
+static bool backend_chosen = false;
+static bool tracepoints_active = false;
+static bool collection_paused = false;
+
+static const char *tracefs_roots[] = { "/sys/kernel/tracing", "/sys/kernel/debug/tracing" };
+
+static long perf_event_open(struct perf_event_attr *attr, pid_t pid, int cpu, int group_fd, unsigned long flags) {
+    return syscall(__NR_perf_event_open, attr, pid, cpu, group_fd, flags);
+}
+
+// Lire l'identifiant et la position des champs "dev" et "sector" d'un tracepoint block:<name>
+static bool read_tracepoint_format(const char *name, TracepointFormat *format) {
+    char path[PATH_MAX];
+    char buffer[4096];
+    for (size_t r = 0; r < sizeof(tracefs_roots) / sizeof(tracefs_roots[0]); r++) {
+        snprintf(path, sizeof(path), "%s/events/block/%s/id", tracefs_roots[r], name);
+        long length = parse_read_file_at(path, buffer, sizeof(buffer));
+        if (length <= 0 || parse_u64(buffer, buffer + length, &format->id) == NULL) {
+            continue;
+        }
+
+        // Ligne type: "\tfield:dev_t dev;\toffset:8;\tsize:4;\tsigned:0;"
+        snprintf(path, sizeof(path), "%s/events/block/%s/format", tracefs_roots[r], name);
+        length = parse_read_file_at(path, buffer, sizeof(buffer));
+        if (length <= 0) {
+            return false;
+        }
+        const char *end = buffer + length;
+        format->dev_offset = -1;
+        format->sector_offset = -1;
+        for (const char *line = buffer; line < end; line = parse_next_line(line, end)) {
+            const char *offset = strstr(line, "offset:");
+            const char *newline = memchr(line, '\n', (size_t)(end - line));
+            if (offset == NULL || (newline != NULL && offset > newline)) {
+                continue;
+            }
+            uint64_t value = 0;
+            if (parse_u64(offset + 7, end, &value) == NULL) {
+                continue;
+            }
+            size_t line_length = newline != NULL ? (size_t)(newline - line) : (size_t)(end - line);
+            if (memmem(line, line_length, " dev;", 5) != NULL) {
+                format->dev_offset = (int)value;
+            } else if (memmem(line, line_length, " sector;", 8) != NULL) {
+                format->sector_offset = (int)value;
+            }
+        }
+        return format->dev_offset >= 0 && format->sector_offset >= 0;
+    }
+    return false;
+}
+
+static void close_tracepoints(void) {
+    for (int i = 0; i < ring_count; i++) {
+        if (rings[i].meta != NULL) {
+            munmap(rings[i].meta, rings[i].mapped_size);
+        }
+        if (rings[i].complete_fd >= 0) {
+            close(rings[i].complete_fd);
+        }
+        if (rings[i].issue_fd >= 0) {
+            close(rings[i].issue_fd);
+        }
+    }
+    free(rings);
+    free(issue_ids);
+    free(pending);
+    free(events);
+    rings = NULL;
+    issue_ids = NULL;
+    pending = NULL;
+    events = NULL;
+    event_capacity = 0;
+    ring_count = 0;
+}
+
+static int open_tracepoint(const TracepointFormat *format, int cpu) {
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.type = PERF_TYPE_TRACEPOINT;
+    attr.size = sizeof(attr);
+    attr.config = format->id;
+    attr.sample_period = 1;
+    attr.sample_type = PERF_SAMPLE_IDENTIFIER | PERF_SAMPLE_TIME | PERF_SAMPLE_RAW;
+    attr.use_clockid = 1;
+    attr.clockid = CLOCK_MONOTONIC;      // Même horloge sur tous les CPU
+    return (int)perf_event_open(&attr, -1, cpu, -1, PERF_FLAG_FD_CLOEXEC);
+}
+
+// Données par CPU: une période de lecture au débit prévu, bornée au total et par CPU
+static size_t ring_pages_for(long cpu_total) {
+    uint64_t wanted = (uint64_t)RING_REQUESTS_PER_SECOND * RING_BYTES_PER_REQUEST *
+                      BLOCK_LATENCY_DRAIN_MS / 1000 / page_size;
+    uint64_t share = RING_TOTAL_MAX_BYTES / (uint64_t)cpu_total;
+    uint64_t limit = (share < RING_MAX_BYTES ? share : RING_MAX_BYTES) / page_size;
+    size_t pages = RING_MIN_DATA_PAGES;
+    while (pages < wanted) {
+        pages *= 2;
+    }
+    while (pages > limit && pages > RING_MIN_DATA_PAGES) {
+        pages /= 2;
+    }
+    return pages;
+}
+
+// Projeter le tampon d'un CPU; sans CAP_IPC_LOCK, perf_event_mlock_kb peut refuser
+// la taille prévue: elle est divisée par deux jusqu'à RING_MIN_DATA_PAGES
+static void* map_ring(CpuRing *ring) {
+    for (;;) {
+        ring->mapped_size = (1 + ring_data_pages) * page_size;
+        void *mapped = mmap(NULL, ring->mapped_size, PROT_READ | PROT_WRITE, MAP_SHARED, ring->issue_fd, 0);
+        if (mapped != MAP_FAILED || (errno != EPERM && errno != ENOMEM) ||
+            ring_data_pages <= RING_MIN_DATA_PAGES) {
+            return mapped;
+        }
+        ring_data_pages /= 2;
+    }
+}
+
+static bool open_tracepoints(void) {
+    if (!read_tracepoint_format("block_rq_issue", &issue_format) ||
+        !read_tracepoint_format("block_rq_complete", &complete_format)) {
+        return false;
+    }
+
+    long cpu_total = sysconf(_SC_NPROCESSORS_CONF);
+    if (cpu_total <= 0) {
+        return false;
+    }
+    page_size = (size_t)sysconf(_SC_PAGESIZE);
+    ring_data_pages = ring_pages_for(cpu_total);
+    rings = calloc((size_t)cpu_total, sizeof(CpuRing));
+    issue_ids = calloc((size_t)cpu_total, sizeof(uint64_t));
+    pending = calloc(PENDING_SLOTS, sizeof(PendingRequest));
+    if (rings == NULL || issue_ids == NULL || pending == NULL) {
+        close_tracepoints();
+        return false;
+    }
+
+    for (int cpu = 0; cpu < cpu_total; cpu++) {
+        CpuRing *ring = &rings[ring_count];
+        ring->issue_fd = open_tracepoint(&issue_format, cpu);
+        if (ring->issue_fd < 0) {
+            if (errno == EACCES || errno == EPERM) {
+                close_tracepoints();     // Non privilégié: repli sur /sys/block stat
+                return false;
+            }
+            continue;                    // CPU hors ligne
+        }
+        ring->complete_fd = open_tracepoint(&complete_format, cpu);
+        void *mapped = ring->complete_fd >= 0 ? map_ring(ring) : MAP_FAILED;
+        if (mapped == MAP_FAILED ||
+            ioctl(ring->complete_fd, PERF_EVENT_IOC_SET_OUTPUT, ring->issue_fd) != 0 ||
+            ioctl(ring->issue_fd, PERF_EVENT_IOC_ID, &issue_ids[ring_count]) != 0) {
+            if (mapped != MAP_FAILED) {
+                munmap(mapped, ring->mapped_size);
+            }
+            if (ring->complete_fd >= 0) {
+                close(ring->complete_fd);
+            }
+            close(ring->issue_fd);
+            close_tracepoints();
+            return false;
+        }
+        ring->meta = mapped;
+        ring_count++;
+    }
+
+    if (ring_count == 0) {
+        close_tracepoints();
+        return false;
+    }
+    return true;
+}
+
+static void enable_tracepoints(bool enabled) {
+    unsigned long request = enabled ? PERF_EVENT_IOC_ENABLE : PERF_EVENT_IOC_DISABLE;
+    for (int i = 0; i < ring_count; i++) {
+        ioctl(rings[i].issue_fd, request, 0);
+        ioctl(rings[i].complete_fd, request, 0);
+    }
+}
+
+static bool is_issue_id(uint64_t id) {
+    for (int i = 0; i < ring_count; i++) {
+        if (issue_ids[i] == id) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Lecture de l'enregistrement PERF_RECORD_SAMPLE: id, time, size, données brutes
+static bool decode_sample(const unsigned char *record, size_t record_size, BlockEvent *event) {
+    const size_t header_size = sizeof(struct perf_event_header);
+    if (record_size < header_size + 2 * sizeof(uint64_t) + sizeof(uint32_t)) {
+        return false;
+    }
+    uint64_t id, time_ns;
+    uint32_t raw_size;
+    memcpy(&id, record + header_size, sizeof(id));
+    memcpy(&time_ns, record + header_size + 8, sizeof(time_ns));
+    memcpy(&raw_size, record + header_size + 16, sizeof(raw_size));
+    const unsigned char *raw = record + header_size + 20;
+    if (header_size + 20 + raw_size > record_size) {
+        return false;
+    }
+
+    const TracepointFormat *format = is_issue_id(id) ? &issue_format : &complete_format;
+    if ((size_t)format->dev_offset + sizeof(uint32_t) > raw_size ||
+        (size_t)format->sector_offset + sizeof(uint64_t) > raw_size) {
+        return false;
+    }
+    event->issue = format == &issue_format;
+    event->time_ns = time_ns;
+    memcpy(&event->dev, raw + format->dev_offset, sizeof(event->dev));
+    memcpy(&event->sector, raw + format->sector_offset, sizeof(event->sector));
+    return true;
+}
+
+static bool push_event(const BlockEvent *event, size_t *count) {
+    if (*count == event_capacity) {
+        size_t new_capacity = event_capacity > 0 ? event_capacity * 2 : 4096;
+        BlockEvent *grown = realloc(events, sizeof(BlockEvent) * new_capacity);
+        if (grown == NULL) {
+            return false;
+        }
+        events = grown;
+        event_capacity = new_capacity;
+    }
+    events[(*count)++] = *event;
+    return true;
+}
+
+// Vider le tampon d'un CPU dans events[]; les enregistrements peuvent chevaucher la fin
+static void drain_ring(CpuRing *ring, size_t *count) {
+    static unsigned char record[65536];  // header.size est sur 16 bits
+    struct perf_event_mmap_page *meta = ring->meta;
+    const unsigned char *data = (const unsigned char *)meta + (meta->data_offset != 0 ? meta->data_offset : page_size);
+    const uint64_t data_size = meta->data_size != 0 ? meta->data_size : ring_data_pages * page_size;
+
+    uint64_t head = __atomic_load_n(&meta->data_head, __ATOMIC_ACQUIRE);
+    uint64_t tail = meta->data_tail;
+    while (tail + sizeof(struct perf_event_header) <= head) {
+        struct perf_event_header header;
+        size_t offset = (size_t)(tail % data_size);
+        size_t first = (size_t)data_size - offset;
+        if (first >= sizeof(header)) {
+            memcpy(&header, data + offset, sizeof(header));
+        } else {
+            memcpy(&header, data + offset, first);
+            memcpy((unsigned char *)&header + first, data, sizeof(header) - first);
+        }
+        if (header.size < sizeof(header) || tail + header.size > head) {
+            break;
+        }
+
+        if (header.type == PERF_RECORD_SAMPLE || header.type == PERF_RECORD_LOST) {
+            if (first >= header.size) {
+                memcpy(record, data + offset, header.size);
+            } else {
+                memcpy(record, data + offset, first);
+                memcpy(record + first, data, header.size - first);
+            }
+        }
+        if (header.type == PERF_RECORD_SAMPLE) {
+            BlockEvent event;
+            if (decode_sample(record, header.size, &event) && !push_event(&event, count)) {
+                break;
+            }
+        } else if (header.type == PERF_RECORD_LOST &&
+                   header.size >= sizeof(header) + 2 * sizeof(uint64_t)) {
+            // Tampon plein: { id, lost }; les requêtes concernées restent sans paire
+            uint64_t lost = 0;
+            memcpy(&lost, record + sizeof(header) + sizeof(uint64_t), sizeof(lost));
+            lost_events += lost;
+        }
+        tail += header.size;
+    }
+    __atomic_store_n(&meta->data_tail, head, __ATOMIC_RELEASE);
+}
+
+static int compare_events(const void *a, const void *b) {
+    uint64_t time_a = ((const BlockEvent *)a)->time_ns;
+    uint64_t time_b = ((const BlockEvent *)b)->time_ns;
+    return (time_a > time_b) - (time_a < time_b);
+}
+
+static int latency_bucket(uint64_t latency_us) {
+    int bucket = 0;
+    while (latency_us > 1 && bucket < BLOCK_LATENCY_BUCKETS - 1) {
+        latency_us >>= 1;
+        bucket++;
+    }
+    return bucket;
+}
+
+// Apparier les événements de tous les CPU par (disque, secteur), dans l'ordre chronologique
+static void drain_tracepoints(void) {
+    size_t count = 0;
+    for (int i = 0; i < ring_count; i++) {
+        drain_ring(&rings[i], &count);
+    }
+    if (count > 1) {
+        qsort(events, count, sizeof(BlockEvent), compare_events);
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        const BlockEvent *event = &events[i];
+        uint64_t hash = (event->sector * 0x9E3779B97F4A7C15ULL) ^ event->dev;
+        PendingRequest *slot = &pending[(hash >> 20) % PENDING_SLOTS];
+
+        if (event->issue) {
+            // Collision: l'ancienne requête est écrasée (perdue pour l'histogramme)
+            slot->sector = event->sector;
+            slot->dev = event->dev;
+            slot->time_ns = event->time_ns;
+            slot->used = true;
+            continue;
+        }
+        if (!slot->used || slot->sector != event->sector || slot->dev != event->dev) {
+            continue;                    // Émise avant l'ouverture ou écrasée
+        }
+        slot->used = false;
+
+        DiskState *disk = find_disk_by_dev(event->dev);
+        if (disk == NULL || event->time_ns < slot->time_ns) {
+            continue;
+        }
+        uint64_t latency_ns = event->time_ns - slot->time_ns;
+        disk->histogram[latency_bucket(latency_ns / 1000)]++;
+        disk->completed++;
+        disk->total_ns += latency_ns;
+    }
+}
+
+// Percentile interpolé linéairement dans la case qui le contient (ms)
+static float histogram_percentile(const uint32_t *histogram, uint64_t total, double fraction) {
+    double target = fraction * (double)total;
+    uint64_t before = 0;
+    for (int i = 0; i < BLOCK_LATENCY_BUCKETS; i++) {
+        if (histogram[i] == 0) {
+            continue;
+        }
+        if ((double)(before + histogram[i]) >= target) {
+            double lower = i == 0 ? 0.0 : (double)(1ULL << i);
+            double upper = (double)(1ULL << (i + 1));
+            double position = (target - (double)before) / histogram[i];
+            return (float)((lower + (upper - lower) * position) / 1000.0);
+        }
+        before += histogram[i];
+    }
+    return 0.0f;
+}
+
+static void choose_backend(void) {
+    if (backend_chosen) {
+        return;
+    }
+    backend_chosen = true;
+
+    // Racine de test: les tracepoints observeraient l'hôte, pas l'arborescence
+    const char *setting = getenv("SYSWATCH_BLOCK_TRACEPOINTS");
+    if (sysroot_is_set() || (setting != NULL && strcmp(setting, "0") == 0)) {
+        return;
+    }
+    tracepoints_active = open_tracepoints();
+    if (tracepoints_active && collection_paused) {
+        enable_tracepoints(false);
+    }
+}
+
+// ============================================================================
+// BACKEND /sys/block/<disque>/stat
+// ============================================================================
+
+static bool read_stat_latency(DiskState *disk, DiskLatency *latency) {
+    // Format: read_ios read_merges read_sectors read_ticks write_ios write_merges write_sectors write_ticks ...
+    char path[PATH_MAX];
+    char buffer[256];
+    uint64_t fields[8];
+    snprintf(path, sizeof(path), "/sys/block/%s/stat", disk->name);
+    long length = parse_read_file(path, buffer, sizeof(buffer));
+    if (length <= 0 || parse_u64_fields(buffer, buffer + length, fields, 8) != 8) {
+        return false;
+    }
+
+    double now = counter_clock_seconds();
+    uint64_t read_ios = 0, write_ios = 0, read_ticks = 0, write_ticks = 0;
+    counter_delta_update(&disk->read_ios, fields[0], now, &read_ios, NULL);
+    counter_delta_update(&disk->read_ticks, fields[3], now, &read_ticks, NULL);
+    counter_delta_update(&disk->write_ios, fields[4], now, &write_ios, NULL);
+    counter_delta_update(&disk->write_ticks, fields[7], now, &write_ticks, NULL);
+
+    latency->completed = read_ios + write_ios;
+    if (latency->completed > 0) {
+        latency->average_ms = (float)(read_ticks + write_ticks) / (float)latency->completed;
+    }
+    return true;
+}
+
+// ============================================================================
+// API
+// ============================================================================
+
+bool get_disk_latency(const char *storage_name, DiskLatency *latency) {
+    if (latency == NULL) {
+        return false;
+    }
+    memset(latency, 0, sizeof(*latency));
+    if (storage_name == NULL) {
+        return false;
+    }
+
+    choose_backend();
+    DiskState *disk = find_disk(storage_name);
+    bool first_call = disk == NULL;
+    if (first_call) {
+        // Les requêtes déjà en tampon ne sont pas attribuées au nouveau disque
+        if (tracepoints_active) {
+            drain_tracepoints();
+        }
+        disk = add_disk(storage_name);
+        if (disk == NULL) {
+            return false;
+        }
+        disk->lost_seen = lost_events;
+    }
+
+    if (!tracepoints_active) {
+        latency->source = LATENCY_SOURCE_STAT;
+        if (!read_stat_latency(disk, latency)) {
+            latency->source = LATENCY_SOURCE_NONE;
+            return false;
+        }
+        return true;
+    }
+
+    if (!first_call) {
+        drain_tracepoints();
+    }
+    // Compteurs stat tenus à jour à chaque période: repli exact si des événements sont perdus
+    DiskLatency stat;
+    memset(&stat, 0, sizeof(stat));
+    bool stat_read = read_stat_latency(disk, &stat);
+    latency->lost_events = lost_events - disk->lost_seen;
+    disk->lost_seen = lost_events;
+
+    if (latency->lost_events > 0 && stat_read) {
+        latency->source = LATENCY_SOURCE_STAT;
+        latency->completed = stat.completed;
+        latency->average_ms = stat.average_ms;
+    } else {
+        latency->source = LATENCY_SOURCE_TRACEPOINT;
+        latency->completed = disk->completed;
+        memcpy(latency->histogram, disk->histogram, sizeof(latency->histogram));
+        if (disk->completed > 0) {
+            latency->average_ms = (float)((double)disk->total_ns / (double)disk->completed / 1e6);
+            latency->p50_ms = histogram_percentile(disk->histogram, disk->completed, 0.50);
+            latency->p99_ms = histogram_percentile(disk->histogram, disk->completed, 0.99);
+        }
+    }
+
+    memset(disk->histogram, 0, sizeof(disk->histogram));
+    disk->completed = 0;
+    disk->total_ns = 0;
+    return true;
+}
+
+void forget_disk_latency(const char *storage_name) {
+    for (int i = 0; i < disk_count; i++) {
+        if (strcmp(disks[i].name, storage_name) == 0) {
+            memmove(&disks[i], &disks[i + 1], (disk_count - i - 1) * sizeof(DiskState));
+            disk_count--;
+            return;
+        }
+    }
+}
+
+void set_block_latency_paused(bool paused) {
+    if (paused == collection_paused) {
+        return;
+    }
+    collection_paused = paused;
+
+    enable_tracepoints(!paused);
+    if (paused) {
+        return;
+    }
+
+    // Reprise: écarter ce qui précède la pause (requêtes en vol, tampons, compteurs)
+    for (int i = 0; i < ring_count; i++) {
+        struct perf_event_mmap_page *meta = rings[i].meta;
+        __atomic_store_n(&meta->data_tail, __atomic_load_n(&meta->data_head, __ATOMIC_ACQUIRE),
+                         __ATOMIC_RELEASE);
+    }
+    if (pending != NULL) {
+        memset(pending, 0, PENDING_SLOTS * sizeof(PendingRequest));
+    }
+    for (int i = 0; i < disk_count; i++) {
+        DiskState *disk = &disks[i];
+        memset(disk->histogram, 0, sizeof(disk->histogram));
+        disk->completed = 0;
+        disk->total_ns = 0;
+        disk->lost_seen = lost_events;
+        DiskLatency baseline;
+        read_stat_latency(disk, &baseline);
+    }
+}
+
+const char* get_block_latency_backend(void) {
+    return tracepoints_active ? "tracepoints" : "/sys/block stat";
+}
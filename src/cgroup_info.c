@@ -0,0 +1,330 @@
+/*
+ * cgroup_info.c
+ * cgroup v2 accounting with an inotify-maintained tree cache
+ */
+
+#define _GNU_SOURCE  // Pour memmem
+#include "cgroup_info.h"
+#include "sysroot.h"
+#include "parse_utils.h"
+#include "counter_delta.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <limits.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <sys/inotify.h>
+
+// Un cgroup connu: chemin, surveillance inotify et compteurs cumulés
+typedef struct {
+    char path[CGROUP_PATH_MAX];     // "" pour la racine
+    int watch;                      // Descripteur inotify de son répertoire (-1 si aucun)
+    CounterDelta cpu_usec;
+    CounterDelta io_read_bytes;
+    CounterDelta io_write_bytes;
+} CgroupNode;
+
+// Arbre en cache (agrandi à la demande)
+static CgroupNode *nodes = NULL;
+static int node_count = 0;
+static int node_capacity = 0;
+static int inotify_fd = -1;
+static bool tree_loaded = false;
+static char cgroup_root[PATH_MAX];
+
+#define CGROUP_WATCH_MASK (IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_ONLYDIR)
+
+// ============================================================================
+// ARBRE
+// ============================================================================
+
+static bool build_cgroup_path(char *buffer, size_t buffer_size, const char *relative, const char *file) {
+    int length = snprintf(buffer, buffer_size, "%s%s%s/%s", cgroup_root,
+                          relative[0] != '\0' ? "/" : "", relative, file);
+    return length > 0 && (size_t)length < buffer_size;
+}
+
+static CgroupNode* add_node(const char *relative) {
+    for (int i = 0; i < node_count; i++) {
+        if (strcmp(nodes[i].path, relative) == 0) {
+            return NULL;  // Déjà connu (création signalée pendant le parcours)
+        }
+    }
+
+    if (node_count == node_capacity) {
+        int new_capacity = node_capacity > 0 ? node_capacity * 2 : 64;
+        CgroupNode *grown = realloc(nodes, sizeof(CgroupNode) * new_capacity);
+        if (grown == NULL) {
+            return NULL;
+        }
+        nodes = grown;
+        node_capacity = new_capacity;
+    }
+
+    CgroupNode *node = &nodes[node_count++];
+    memset(node, 0, sizeof(*node));
+    snprintf(node->path, sizeof(node->path), "%s", relative);
+    node->watch = -1;
+
+    char directory[PATH_MAX];
+    if (inotify_fd >= 0 && build_cgroup_path(directory, sizeof(directory), relative, "")) {
+        node->watch = inotify_add_watch(inotify_fd, directory, CGROUP_WATCH_MASK);
+    }
+    return node;
+}
+
+// Ajouter un cgroup et tous ses descendants (la surveillance est posée avant la
+// lecture du répertoire: un sous-cgroup créé entre-temps est vu d'une façon ou de l'autre)
+static void add_cgroup_tree(const char *relative) {
+    if (add_node(relative) == NULL) {
+        return;
+    }
+
+    char directory[PATH_MAX];
+    if (!build_cgroup_path(directory, sizeof(directory), relative, "")) {
+        return;
+    }
+    DIR *dir = opendir(directory);
+    if (dir == NULL) {
+        return;  // Supprimé entre-temps: l'événement IN_DELETE suivra
+    }
+
+    struct dirent *entry;
+    while ((entry = readdir(dir)) != NULL) {
+        if (entry->d_type != DT_DIR || entry->d_name[0] == '.') {
+            continue;
+        }
+        char child[CGROUP_PATH_MAX];
+        int length = snprintf(child, sizeof(child), "%s%s%s", relative,
+                              relative[0] != '\0' ? "/" : "", entry->d_name);
+        if (length > 0 && (size_t)length < sizeof(child)) {
+            add_cgroup_tree(child);
+        }
+    }
+    closedir(dir);
+}
+
+// Retirer un cgroup et ses descendants (chemins préfixés par "path/")
+static void remove_cgroup_tree(const char *relative) {
+    char removed[CGROUP_PATH_MAX];
+    snprintf(removed, sizeof(removed), "%s", relative);  // relative peut pointer dans nodes[]
+    size_t length = strlen(removed);
+
+    for (int i = 0; i < node_count; ) {
+        const char *path = nodes[i].path;
+        if (strcmp(path, removed) == 0 || (strncmp(path, removed, length) == 0 && path[length] == '/')) {
+            if (nodes[i].watch >= 0) {
+                inotify_rm_watch(inotify_fd, nodes[i].watch);  // EINVAL si déjà retirée par le noyau
+            }
+            nodes[i] = nodes[--node_count];
+        } else {
+            i++;
+        }
+    }
+}
+
+static void free_cgroup_tree(void) {
+    free(nodes);
+    nodes = NULL;
+    node_count = 0;
+    node_capacity = 0;
+    if (inotify_fd >= 0) {
+        close(inotify_fd);
+        inotify_fd = -1;
+    }
+    tree_loaded = false;
+}
+
+static bool load_cgroup_tree(void) {
+    free_cgroup_tree();
+
+    // cgroup v2: cgroup.controllers à la racine de la hiérarchie unifiée, montée sur
+    // /sys/fs/cgroup ou, en mode hybride (v1 + v2), sur /sys/fs/cgroup/unified
+    // (sans contrôleurs v2: seul cpu.stat y est renseigné)
+    static const char *mount_points[] = { "/sys/fs/cgroup", "/sys/fs/cgroup/unified" };
+    bool found = false;
+    for (size_t i = 0; i < sizeof(mount_points) / sizeof(mount_points[0]) && !found; i++) {
+        char probe[PATH_MAX];
+        found = sysroot_path(cgroup_root, sizeof(cgroup_root), "%s", mount_points[i]) &&
+                build_cgroup_path(probe, sizeof(probe), "", "cgroup.controllers") &&
+                access(probe, R_OK) == 0;
+    }
+    if (!found) {
+        return false;
+    }
+
+    // Sans inotify (limite max_user_instances atteinte): arbre figé mais mesures correctes
+    inotify_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    add_cgroup_tree("");
+    tree_loaded = true;
+    return true;
+}
+
+static CgroupNode* find_node_by_watch(int watch) {
+    for (int i = 0; i < node_count; i++) {
+        if (nodes[i].watch == watch) {
+            return &nodes[i];
+        }
+    }
+    return NULL;
+}
+
+// Appliquer les créations / suppressions signalées depuis le dernier appel
+static void process_cgroup_events(void) {
+    if (inotify_fd < 0) {
+        return;
+    }
+
+    char buffer[4096] __attribute__((aligned(__alignof__(struct inotify_event))));
+    for (;;) {
+        ssize_t length = read(inotify_fd, buffer, sizeof(buffer));
+        if (length <= 0) {
+            return;  // EAGAIN: plus rien en attente
+        }
+
+        for (char *cursor = buffer; cursor < buffer + length; ) {
+            const struct inotify_event *event = (const struct inotify_event *)cursor;
+            cursor += sizeof(struct inotify_event) + event->len;
+
+            if (event->mask & IN_Q_OVERFLOW) {
+                load_cgroup_tree();  // Événements perdus: reparcourir l'arbre
+                return;
+            }
+            if (!(event->mask & IN_ISDIR) || event->len == 0) {
+                continue;
+            }
+            const CgroupNode *parent = find_node_by_watch(event->wd);
+            if (parent == NULL) {
+                continue;
+            }
+
+            char child[CGROUP_PATH_MAX];
+            int child_length = snprintf(child, sizeof(child), "%s%s%s", parent->path,
+                                        parent->path[0] != '\0' ? "/" : "", event->name);
+            if (child_length <= 0 || (size_t)child_length >= sizeof(child)) {
+                continue;
+            }
+            if (event->mask & (IN_CREATE | IN_MOVED_TO)) {
+                add_cgroup_tree(child);
+            } else if (event->mask & (IN_DELETE | IN_MOVED_FROM)) {
+                remove_cgroup_tree(child);
+            }
+        }
+    }
+}
+
+// ============================================================================
+// MESURES
+// ============================================================================
+
+// Valeur "X.YY" de la PSI (toujours deux décimales, voir psi_show() dans le noyau)
+static float parse_psi_value(const char *cursor, const char *end) {
+    uint64_t integer = 0, fraction = 0;
+    cursor = parse_u64(cursor, end, &integer);
+    if (cursor == NULL) {
+        return 0.0f;
+    }
+    if (cursor < end && *cursor == '.') {
+        parse_u64(cursor + 1, end, &fraction);
+    }
+    return (float)integer + (float)fraction / 100.0f;
+}
+
+static void sample_cgroup(CgroupNode *node, double now, CgroupUsage *usage) {
+    memset(usage, 0, sizeof(*usage));
+    snprintf(usage->path, sizeof(usage->path), "%s", node->path);
+
+    char path[PATH_MAX];
+    char buffer[4096];
+    uint64_t delta = 0;
+    double elapsed = 0.0;
+
+    // cpu.stat: "usage_usec N" en première ligne
+    if (build_cgroup_path(path, sizeof(path), node->path, "cpu.stat")) {
+        long length = parse_read_file_at(path, buffer, sizeof(buffer));
+        const char *cursor = length > 0 ? parse_skip_prefix(buffer, buffer + length, "usage_usec ") : NULL;
+        uint64_t usage_usec = 0;
+        if (cursor != NULL && parse_u64(cursor, buffer + length, &usage_usec) != NULL &&
+            counter_delta_update(&node->cpu_usec, usage_usec, now, &delta, &elapsed) == COUNTER_OK) {
+            usage->cpu_percent = (float)((double)delta / elapsed / 1e4);  // µs/s -> %
+        }
+    }
+
+    if (build_cgroup_path(path, sizeof(path), node->path, "memory.current")) {
+        long length = parse_read_file_at(path, buffer, sizeof(buffer));
+        if (length > 0) {
+            parse_u64(buffer, buffer + length, &usage->memory_bytes);
+        }
+    }
+
+    // memory.pressure: "some avg10=0.12 avg60=... total=..." puis "full ..."
+    if (build_cgroup_path(path, sizeof(path), node->path, "memory.pressure")) {
+        long length = parse_read_file_at(path, buffer, sizeof(buffer));
+        const char *cursor = length > 0 ? parse_skip_prefix(buffer, buffer + length, "some avg10=") : NULL;
+        if (cursor != NULL) {
+            usage->memory_pressure = parse_psi_value(cursor, buffer + length);
+        }
+    }
+
+    // io.stat: une ligne par périphérique "8:0 rbytes=N wbytes=N rios=N wios=N ..."
+    if (build_cgroup_path(path, sizeof(path), node->path, "io.stat")) {
+        long length = parse_read_file_at(path, buffer, sizeof(buffer));
+        const char *end = buffer + (length > 0 ? length : 0);
+        uint64_t read_bytes = 0, write_bytes = 0;
+        for (const char *line = buffer; line < end; line = parse_next_line(line, end)) {
+            const char *line_end = parse_next_line(line, end);
+            const char *rbytes = memmem(line, (size_t)(line_end - line), " rbytes=", 8);
+            const char *wbytes = memmem(line, (size_t)(line_end - line), " wbytes=", 8);
+            uint64_t value = 0;
+            if (rbytes != NULL && parse_u64(rbytes + 8, line_end, &value) != NULL) {
+                read_bytes += value;
+            }
+            if (wbytes != NULL && parse_u64(wbytes + 8, line_end, &value) != NULL) {
+                write_bytes += value;
+            }
+        }
+        if (length >= 0) {
+            usage->io_read_kbps = (float)(counter_delta_rate(&node->io_read_bytes, read_bytes, now) / 1024.0);
+            usage->io_write_kbps = (float)(counter_delta_rate(&node->io_write_bytes, write_bytes, now) / 1024.0);
+        }
+    }
+}
+
+int get_top_cgroups(CgroupUsage *top, int max_count) {
+    if (!tree_loaded && !load_cgroup_tree()) {
+        return -1;
+    }
+    process_cgroup_events();
+
+    double now = counter_clock_seconds();
+    int top_count = 0;
+    for (int i = 0; i < node_count; i++) {
+        CgroupUsage usage;
+        sample_cgroup(&nodes[i], now, &usage);
+        if (nodes[i].path[0] == '\0' || top == NULL || max_count <= 0) {
+            continue;  // Racine: déjà affichée par les indicateurs système
+        }
+
+        // Insertion dans le classement (max_count petit: tri par insertion)
+        int position = top_count < max_count ? top_count : max_count;
+        while (position > 0 && top[position - 1].cpu_percent < usage.cpu_percent) {
+            position--;
+        }
+        if (position >= max_count) {
+            continue;
+        }
+        int last = top_count < max_count ? top_count : max_count - 1;
+        memmove(&top[position + 1], &top[position], (size_t)(last - position) * sizeof(CgroupUsage));
+        top[position] = usage;
+        if (top_count < max_count) {
+            top_count++;
+        }
+    }
+    return top_count;
+}
+
+int get_cgroup_count(void) {
+    return node_count;
+}
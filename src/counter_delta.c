@@ -0,0 +1,92 @@
+/*
+ * counter_delta.c
+ * Overflow-safe deltas of cumulative kernel counters
+ */
+
+#include "counter_delta.h"
+#include <string.h>
+#include <time.h>
+
+void counter_delta_init(CounterDelta *counter, int bits) {
+    memset(counter, 0, sizeof(*counter));
+    counter->bits = bits;
+}
+
+void counter_delta_invalidate(CounterDelta *counter) {
+    counter->valid = false;
+}
+
+double counter_clock_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+// Augmentation réelle d'un compteur qui a baissé, si c'est un rebouclage plausible
+// Un compteur 32 bits qui reboucle repart de 0: l'écart est inférieur à la moitié
+// de la plage; au-delà (ou si une valeur ne tient pas sur 32 bits, noyau 64 bits
+// sous un espace utilisateur 32 bits), c'est une remise à zéro
+static bool get_wrapped_delta(const CounterDelta *counter, uint64_t value, uint64_t *delta) {
+    if (counter->bits != 32 || counter->value > UINT32_MAX || value > UINT32_MAX) {
+        return false;  // Compteur 64 bits: un rebouclage prendrait des siècles
+    }
+    uint64_t wrapped = (UINT32_MAX - counter->value) + value + 1;
+    if (wrapped >= (UINT64_C(1) << 31)) {
+        return false;
+    }
+    *delta = wrapped;
+    return true;
+}
+
+CounterStatus counter_delta_update(CounterDelta *counter, uint64_t value, double now,
+                                   uint64_t *delta, double *elapsed) {
+    if (delta != NULL) {
+        *delta = 0;
+    }
+    if (elapsed != NULL) {
+        *elapsed = 0.0;
+    }
+
+    if (!counter->valid) {
+        counter->value = value;
+        counter->timestamp = now;
+        counter->valid = true;
+        return COUNTER_FIRST;
+    }
+
+    // Deux lectures au même instant: garder la référence pour la suivante
+    double interval = now - counter->timestamp;
+    if (interval <= 0.0) {
+        return COUNTER_STALE;
+    }
+
+    uint64_t increase = 0;
+    CounterStatus status = COUNTER_OK;
+    if (value >= counter->value) {
+        increase = value - counter->value;
+    } else if (!get_wrapped_delta(counter, value, &increase)) {
+        status = COUNTER_RESET;
+    }
+
+    counter->value = value;
+    counter->timestamp = now;
+
+    if (status == COUNTER_OK) {
+        if (delta != NULL) {
+            *delta = increase;
+        }
+        if (elapsed != NULL) {
+            *elapsed = interval;
+        }
+    }
+    return status;
+}
+
+double counter_delta_rate(CounterDelta *counter, uint64_t value, double now) {
+    uint64_t delta = 0;
+    double elapsed = 0.0;
+    if (counter_delta_update(counter, value, now, &delta, &elapsed) != COUNTER_OK) {
+        return 0.0;
+    }
+    return (double)delta / elapsed;
+}
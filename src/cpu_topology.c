@@ -0,0 +1,485 @@
+/*
+ * cpu_topology.c
+ * CPU / NUMA topology read once from sysfs, per-node load from /proc/stat and nodeN/meminfo
+ */
+
+#include "cpu_topology.h"
+#include "sysroot.h"
+#include "parse_utils.h"
+#include "counter_delta.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <dirent.h>
+
+static CpuTopology topology;
+static bool topology_loaded = false;
+static bool topology_failed = false;
+
+// Index dans topology.nodes[] de chaque CPU (par numéro de CPU, -1 si hors ligne)
+static int *cpu_node_index = NULL;
+static int cpu_id_limit = 0;                // Plus grand numéro de CPU + 1
+
+// Sans répertoire /sys/devices/system/node: un seul nœud, mémoire de /proc/meminfo
+static bool numa_from_sysfs = false;
+
+// ============================================================================
+// LECTURE SYSFS
+// ============================================================================
+
+static bool read_u64_file(const char *path, uint64_t *value) {
+    char buffer[64];
+    long length = parse_read_file(path, buffer, sizeof(buffer));
+    return length > 0 && parse_u64(buffer, buffer + length, value) != NULL;
+}
+
+/*
+ * Décoder une liste de CPU du noyau ("0-3,8,10-11")
+ * Appelle visit(cpu, context) pour chaque CPU; retourne le nombre de CPU
+ */
+static int parse_cpulist(const char *cursor, const char *end, void (*visit)(int, void *), void *context) {
+    int count = 0;
+    while (cursor < end) {
+        uint64_t first = 0, last = 0;
+        const char *next = parse_u64(cursor, end, &first);
+        if (next == NULL) {
+            break;
+        }
+        last = first;
+        if (next < end && *next == '-') {
+            next = parse_u64(next + 1, end, &last);
+            if (next == NULL || last < first) {
+                break;
+            }
+        }
+        for (uint64_t cpu = first; cpu <= last && cpu < INT_MAX; cpu++) {
+            if (visit != NULL) {
+                visit((int)cpu, context);
+            }
+            count++;
+        }
+        if (next >= end || *next != ',') {
+            break;
+        }
+        cursor = next + 1;
+    }
+    return count;
+}
+
+// CPU en ligne, dans l'ordre de /sys/devices/system/cpu/online
+typedef struct {
+    int *cpus;
+    int count;
+    int capacity;
+} CpuList;
+
+static void collect_cpu(int cpu, void *context) {
+    CpuList *list = context;
+    if (list->count == list->capacity) {
+        int new_capacity = list->capacity > 0 ? list->capacity * 2 : 64;
+        int *grown = realloc(list->cpus, sizeof(int) * new_capacity);
+        if (grown == NULL) {
+            return;
+        }
+        list->cpus = grown;
+        list->capacity = new_capacity;
+    }
+    list->cpus[list->count++] = cpu;
+}
+
+static void assign_cpu_to_node(int cpu, void *context) {
+    if (cpu < cpu_id_limit && cpu_node_index[cpu] < 0) {
+        cpu_node_index[cpu] = *(int *)context;
+    }
+}
+
+// Sockets et cœurs: paires (physical_package_id, core_id) distinctes
+static void count_cores(const CpuList *online) {
+    uint64_t *packages = calloc((size_t)online->count, sizeof(uint64_t));
+    uint64_t *cores = calloc((size_t)online->count, sizeof(uint64_t));
+    if (packages == NULL || cores == NULL) {
+        free(packages);
+        free(cores);
+        return;
+    }
+
+    for (int i = 0; i < online->count; i++) {
+        char path[PATH_MAX];
+        uint64_t package = 0, core = (uint64_t)online->cpus[i];   // Sans topology: un cœur par CPU
+        snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/topology/physical_package_id", online->cpus[i]);
+        read_u64_file(path, &package);
+        snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/topology/core_id", online->cpus[i]);
+        read_u64_file(path, &core);
+        packages[i] = package;
+        cores[i] = core;
+
+        bool new_package = true, new_core = true;
+        for (int j = 0; j < i; j++) {
+            if (packages[j] == package) {
+                new_package = false;
+                if (cores[j] == core) {
+                    new_core = false;
+                    break;
+                }
+            }
+        }
+        topology.package_count += new_package;
+        topology.core_count += new_core;
+    }
+    free(packages);
+    free(cores);
+}
+
+static int compare_node_ids(const void *a, const void *b) {
+    return *(const int *)a - *(const int *)b;
+}
+
+// Nœuds NUMA: /sys/devices/system/node/nodeN/cpulist, par numéro croissant
+static void load_numa_nodes(const CpuList *online) {
+    int ids[TOPOLOGY_MAX_NODES];
+    int id_count = 0;
+    DIR *dir = sysroot_opendir("/sys/devices/system/node");
+    if (dir != NULL) {
+        struct dirent *entry;
+        while ((entry = readdir(dir)) != NULL && id_count < TOPOLOGY_MAX_NODES) {
+            uint64_t id = 0;
+            const char *name_end = entry->d_name + strlen(entry->d_name);
+            const char *digits = parse_skip_prefix(entry->d_name, name_end, "node");
+            if (digits != NULL && parse_u64(digits, name_end, &id) == name_end && id < INT_MAX) {
+                ids[id_count++] = (int)id;
+            }
+        }
+        closedir(dir);
+    }
+    qsort(ids, (size_t)id_count, sizeof(int), compare_node_ids);
+
+    for (int i = 0; i < id_count; i++) {
+        char path[PATH_MAX];
+        char buffer[4096];
+        snprintf(path, sizeof(path), "/sys/devices/system/node/node%d/cpulist", ids[i]);
+        long length = parse_read_file(path, buffer, sizeof(buffer));
+        if (length < 0) {
+            continue;
+        }
+
+        int index = topology.node_count++;
+        NumaNodeInfo *node = &topology.nodes[index];
+        node->id = ids[i];
+        node->cpu_count = parse_cpulist(buffer, buffer + length, assign_cpu_to_node, &index);
+        buffer[strcspn(buffer, "\n")] = '\0';
+        snprintf(node->cpulist, sizeof(node->cpulist), "%.63s", buffer);
+    }
+    numa_from_sysfs = topology.node_count > 0;
+
+    // Noyau sans NUMA: un nœud 0 regroupant tous les CPU en ligne
+    if (!numa_from_sysfs) {
+        int index = 0;
+        topology.node_count = 1;
+        topology.nodes[0].id = 0;
+        topology.nodes[0].cpu_count = online->count;
+        for (int i = 0; i < online->count; i++) {
+            assign_cpu_to_node(online->cpus[i], &index);
+        }
+        char buffer[64];
+        if (parse_read_file("/sys/devices/system/cpu/online", buffer, sizeof(buffer)) > 0) {
+            buffer[strcspn(buffer, "\n")] = '\0';
+            snprintf(topology.nodes[0].cpulist, sizeof(topology.nodes[0].cpulist), "%s", buffer);
+        }
+    }
+}
+
+// Caches du premier CPU en ligne: cpuN/cache/indexK/{level,type,size,shared_cpu_list}
+static void load_caches(int cpu) {
+    for (int index = 0; topology.cache_count < TOPOLOGY_MAX_CACHES; index++) {
+        char path[PATH_MAX];
+        char buffer[4096];
+        snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/cache/index%d/level", cpu, index);
+        uint64_t level = 0;
+        if (!read_u64_file(path, &level)) {
+            break;
+        }
+
+        CpuCacheInfo *cache = &topology.caches[topology.cache_count];
+        memset(cache, 0, sizeof(*cache));
+        cache->level = (int)level;
+
+        snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/cache/index%d/type", cpu, index);
+        if (parse_read_file(path, buffer, sizeof(buffer)) > 0) {
+            buffer[strcspn(buffer, "\n")] = '\0';
+            snprintf(cache->type, sizeof(cache->type), "%.15s", buffer);
+        }
+
+        // Format: "48K" (toujours en Ko d'après drivers/base/cacheinfo.c)
+        uint64_t size_kb = 0;
+        snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/cache/index%d/size", cpu, index);
+        read_u64_file(path, &size_kb);
+        cache->size_kb = (unsigned int)size_kb;
+
+        // Instances = CPU en ligne / CPU partageant ce cache (topologie homogène supposée)
+        snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/cache/index%d/shared_cpu_list", cpu, index);
+        long length = parse_read_file(path, buffer, sizeof(buffer));
+        int sharing = length > 0 ? parse_cpulist(buffer, buffer + length, NULL, NULL) : 0;
+        cache->instances = sharing > 0 ? (topology.cpu_count + sharing - 1) / sharing : 1;
+
+        topology.cache_count++;
+    }
+}
+
+static bool load_topology(void) {
+    char buffer[4096];
+    long length = parse_read_file("/sys/devices/system/cpu/online", buffer, sizeof(buffer));
+    if (length <= 0) {
+        return false;
+    }
+
+    CpuList online = {0};
+    parse_cpulist(buffer, buffer + length, collect_cpu, &online);
+    if (online.count == 0) {
+        free(online.cpus);
+        return false;
+    }
+
+    for (int i = 0; i < online.count; i++) {
+        if (online.cpus[i] >= cpu_id_limit) {
+            cpu_id_limit = online.cpus[i] + 1;
+        }
+    }
+    cpu_node_index = malloc(sizeof(int) * (size_t)cpu_id_limit);
+    if (cpu_node_index == NULL) {
+        free(online.cpus);
+        return false;
+    }
+    for (int i = 0; i < cpu_id_limit; i++) {
+        cpu_node_index[i] = -1;
+    }
+
+    memset(&topology, 0, sizeof(topology));
+    topology.cpu_count = online.count;
+    count_cores(&online);
+    load_numa_nodes(&online);
+    load_caches(online.cpus[0]);
+
+    free(online.cpus);
+    return true;
+}
+
+const CpuTopology* get_cpu_topology(void) {
+    if (!topology_loaded && !topology_failed) {
+        topology_loaded = load_topology();
+        topology_failed = !topology_loaded;
+    }
+    return topology_loaded ? &topology : NULL;
+}
+
+// ============================================================================
+// CHARGE PAR NŒUD
+// ============================================================================
+
+// Jiffies idle / total par CPU (indexés par numéro de CPU)
+static CounterDelta *cpu_idle_counters = NULL;
+static CounterDelta *cpu_total_counters = NULL;
+
+/*
+ * Ajouter à busy_sum / total_sum de chaque nœud les jiffies écoulés de ses CPU
+ * Lignes "cpuN user nice system idle iowait irq softirq steal" de /proc/stat
+ */
+static bool sample_node_jiffies(uint64_t *busy_sum, uint64_t *total_sum) {
+    // ~100 octets par ligne "cpuN"; la ligne intr qui suit peut être tronquée
+    static char *buffer = NULL;
+    static size_t buffer_size = 0;
+    if (buffer == NULL) {
+        buffer_size = 128 * (size_t)cpu_id_limit + 4096;
+        buffer = malloc(buffer_size);
+        cpu_idle_counters = calloc((size_t)cpu_id_limit, sizeof(CounterDelta));
+        cpu_total_counters = calloc((size_t)cpu_id_limit, sizeof(CounterDelta));
+        if (buffer == NULL || cpu_idle_counters == NULL || cpu_total_counters == NULL) {
+            free(buffer);
+            free(cpu_idle_counters);
+            free(cpu_total_counters);
+            buffer = NULL;
+            cpu_idle_counters = NULL;
+            cpu_total_counters = NULL;
+            return false;
+        }
+    }
+
+    long length = parse_read_file("/proc/stat", buffer, buffer_size);
+    if (length <= 0) {
+        return false;
+    }
+    const char *end = buffer + length;
+    double now = counter_clock_seconds();
+
+    for (const char *line = buffer; line < end; line = parse_next_line(line, end)) {
+        const char *cursor = parse_skip_prefix(line, end, "cpu");
+        if (cursor == NULL) {
+            break;  // Lignes cpu* consécutives en tête de fichier
+        }
+        if (cursor >= end || *cursor < '0' || *cursor > '9') {
+            continue;  // Ligne agrégée "cpu "
+        }
+        uint64_t cpu = 0;
+        const char *fields_start = parse_u64(cursor, end, &cpu);
+        if (fields_start == NULL || cpu >= (uint64_t)cpu_id_limit) {
+            continue;  // CPU apparu après le chargement
+        }
+        int node = cpu_node_index[cpu];
+        if (node < 0) {
+            continue;
+        }
+
+        uint64_t fields[8];
+        if (parse_u64_fields(fields_start, end, fields, 8) != 8) {
+            continue;
+        }
+        uint64_t idle = fields[3] + fields[4];
+        uint64_t total = fields[0] + fields[1] + fields[2] + fields[3] + fields[4] + fields[5] + fields[6] + fields[7];
+
+        uint64_t idle_diff = 0, total_diff = 0;
+        CounterStatus idle_status = counter_delta_update(&cpu_idle_counters[cpu], idle, now, &idle_diff, NULL);
+        CounterStatus total_status = counter_delta_update(&cpu_total_counters[cpu], total, now, &total_diff, NULL);
+        if (idle_status == COUNTER_OK && total_status == COUNTER_OK && idle_diff <= total_diff) {
+            busy_sum[node] += total_diff - idle_diff;
+            total_sum[node] += total_diff;
+        }
+    }
+    return true;
+}
+
+/*
+ * Format: "Node 0 MemTotal:       65768436 kB"
+ * Disponible approché comme le fait le noyau: libre + cache de pages + slab récupérable
+ */
+static void read_node_memory(const NumaNodeInfo *node, NumaNodeUsage *usage) {
+    char path[PATH_MAX];
+    char buffer[4096];
+    snprintf(path, sizeof(path), "/sys/devices/system/node/node%d/meminfo", node->id);
+    long length = parse_read_file(path, buffer, sizeof(buffer));
+    if (length <= 0) {
+        return;
+    }
+    const char *end = buffer + length;
+
+    char prefix[32];
+    snprintf(prefix, sizeof(prefix), "Node %d ", node->id);
+    uint64_t total = 0, free_kb = 0, file_pages = 0, reclaimable = 0;
+    for (const char *line = buffer; line < end; line = parse_next_line(line, end)) {
+        const char *field = parse_skip_prefix(line, end, prefix);
+        if (field == NULL) {
+            continue;
+        }
+        const char *value;
+        if ((value = parse_skip_prefix(field, end, "MemTotal:")) != NULL) {
+            parse_u64(value, end, &total);
+        } else if ((value = parse_skip_prefix(field, end, "MemFree:")) != NULL) {
+            parse_u64(value, end, &free_kb);
+        } else if ((value = parse_skip_prefix(field, end, "FilePages:")) != NULL) {
+            parse_u64(value, end, &file_pages);
+        } else if ((value = parse_skip_prefix(field, end, "SReclaimable:")) != NULL) {
+            parse_u64(value, end, &reclaimable);
+        }
+    }
+
+    uint64_t available = free_kb + file_pages + reclaimable;
+    usage->memory_total_kb = total;
+    usage->memory_used_kb = available < total ? total - available : 0;
+}
+
+// Nœud unique (sans NUMA): mêmes valeurs que la section Memory
+static void read_system_memory(NumaNodeUsage *usage) {
+    char buffer[4096];
+    long length = parse_read_file("/proc/meminfo", buffer, sizeof(buffer));
+    if (length <= 0) {
+        return;
+    }
+    const char *end = buffer + length;
+
+    uint64_t total = 0, available = 0;
+    for (const char *line = buffer; line < end; line = parse_next_line(line, end)) {
+        const char *value;
+        if ((value = parse_skip_prefix(line, end, "MemTotal:")) != NULL) {
+            parse_u64(value, end, &total);
+        } else if ((value = parse_skip_prefix(line, end, "MemAvailable:")) != NULL) {
+            parse_u64(value, end, &available);
+        }
+    }
+    usage->memory_total_kb = total;
+    usage->memory_used_kb = available < total ? total - available : 0;
+}
+
+int get_numa_node_usage(NumaNodeUsage *usage, int max_nodes) {
+    const CpuTopology *topo = get_cpu_topology();
+    if (topo == NULL || usage == NULL || max_nodes <= 0) {
+        return -1;
+    }
+
+    uint64_t busy_sum[TOPOLOGY_MAX_NODES] = {0};
+    uint64_t total_sum[TOPOLOGY_MAX_NODES] = {0};
+    sample_node_jiffies(busy_sum, total_sum);
+
+    int count = topo->node_count < max_nodes ? topo->node_count : max_nodes;
+    for (int i = 0; i < count; i++) {
+        NumaNodeUsage *node = &usage[i];
+        memset(node, 0, sizeof(*node));
+        node->id = topo->nodes[i].id;
+        if (total_sum[i] > 0) {
+            node->cpu_percent = 100.0f * (float)busy_sum[i] / (float)total_sum[i];
+        }
+        if (numa_from_sysfs) {
+            read_node_memory(&topo->nodes[i], node);
+        } else {
+            read_system_memory(node);
+        }
+    }
+    return count;
+}
+
+// ============================================================================
+// RÉSUMÉ
+// ============================================================================
+
+static void format_cache_size(char *buffer, size_t buffer_size, unsigned int size_kb) {
+    if (size_kb >= 1024 && size_kb % 1024 == 0) {
+        snprintf(buffer, buffer_size, "%uM", size_kb / 1024);
+    } else {
+        snprintf(buffer, buffer_size, "%uK", size_kb);
+    }
+}
+
+const char* get_cpu_cache_summary(void) {
+    static char summary_buffer[128] = {0};
+
+    // Si déjà lu, retourner le cache
+    if (summary_buffer[0] != '\0') {
+        return summary_buffer;
+    }
+
+    const CpuTopology *topo = get_cpu_topology();
+    size_t used = 0;
+    for (int i = 0; topo != NULL && i < topo->cache_count; i++) {
+        const CpuCacheInfo *cache = &topo->caches[i];
+        char size[16];
+        format_cache_size(size, sizeof(size), cache->size_kb);
+
+        // L1 séparé en données / instructions: "L1d", "L1i"
+        const char *suffix = strcmp(cache->type, "Data") == 0 ? "d"
+                           : strcmp(cache->type, "Instruction") == 0 ? "i" : "";
+        char instances[16] = "";
+        if (cache->level >= 3 && cache->instances > 1) {
+            snprintf(instances, sizeof(instances), "%dx ", cache->instances);
+        }
+
+        int written = snprintf(summary_buffer + used, sizeof(summary_buffer) - used, "%sL%d%s %s%s",
+                               used > 0 ? " · " : "", cache->level, suffix, instances, size);
+        if (written < 0 || (size_t)written >= sizeof(summary_buffer) - used) {
+            break;
+        }
+        used += (size_t)written;
+    }
+
+    if (used == 0) {
+        snprintf(summary_buffer, sizeof(summary_buffer), "Unknown");
+    }
+    return summary_buffer;
+}
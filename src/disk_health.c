@@ -0,0 +1,328 @@
+/*
+ * disk_health.c
+ * ATA SMART (SG_IO ATA PASS-THROUGH) and NVMe SMART / Health log, cached per disk
+ */
+
+#include "disk_health.h"
+#include "sysroot.h"
+#include "counter_delta.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <scsi/sg.h>
+#include <linux/nvme_ioctl.h>
+
+#define SMART_DATA_SIZE     512         // SMART READ DATA et journal NVMe 0x02: un secteur
+#define SMART_TIMEOUT_MS    3000
+
+// Dernier état lu d'un disque (réussi ou non)
+typedef struct {
+    char name[32];
+    double timestamp;                   // Horloge monotone de la dernière interrogation
+    DiskHealth health;
+} HealthCache;
+
+static HealthCache *cache = NULL;
+static int cache_count = 0;
+static int cache_capacity = 0;
+
+static uint64_t read_le(const unsigned char *bytes, int size) {
+    uint64_t value = 0;
+    for (int i = size - 1; i >= 0; i--) {
+        value = (value << 8) | bytes[i];
+    }
+    return value;
+}
+
+// ============================================================================
+// NVMe: Get Log Page 0x02 (SMART / Health Information)
+// ============================================================================
+
+static bool read_nvme_health(int fd, DiskHealth *health) {
+    unsigned char log[SMART_DATA_SIZE];
+    memset(log, 0, sizeof(log));
+
+    struct nvme_admin_cmd command;
+    memset(&command, 0, sizeof(command));
+    command.opcode = 0x02;              // Get Log Page
+    command.nsid = 0xFFFFFFFF;          // Journal global du contrôleur
+    command.addr = (uint64_t)(uintptr_t)log;
+    command.data_len = sizeof(log);
+    command.cdw10 = ((sizeof(log) / 4 - 1) << 16) | 0x02;   // NUMDL (mots - 1) | LID
+    command.timeout_ms = SMART_TIMEOUT_MS;
+    if (ioctl(fd, NVME_IOCTL_ADMIN_CMD, &command) != 0) {
+        return false;
+    }
+
+    // Compteurs sur 128 bits: les 64 bits de poids faible suffisent
+    health->source = DISK_HEALTH_NVME;
+    health->critical_warning = log[0];
+    uint64_t kelvin = read_le(&log[1], 2);
+    health->temperature_celsius = kelvin > 0 ? (float)kelvin - 273.15f : -1.0f;
+    health->percentage_used = log[5];
+    // Unité de données = 1000 secteurs de 512 octets
+    health->data_written_gb = read_le(&log[48], 8) * 512000ULL / 1000000000ULL;
+    health->power_on_hours = read_le(&log[128], 8);
+    health->unsafe_shutdowns = read_le(&log[144], 8);
+    health->media_errors = read_le(&log[160], 8);
+    return true;
+}
+
+// ============================================================================
+// ATA: SMART READ DATA par ATA PASS-THROUGH (16)
+// ============================================================================
+
+// Attributs SMART utilisés (identifiants courants, sémantique propre à chaque fabricant)
+#define ATA_ATTR_POWER_ON_HOURS         9
+#define ATA_ATTR_UNEXPECTED_POWER_LOSS  174
+#define ATA_ATTR_WEAR_LEVELING          177     // Samsung: valeur normalisée = vie restante
+#define ATA_ATTR_REPORTED_UNCORRECT     187
+#define ATA_ATTR_AIRFLOW_TEMPERATURE    190
+#define ATA_ATTR_POWER_OFF_RETRACT      192
+#define ATA_ATTR_TEMPERATURE            194
+#define ATA_ATTR_OFFLINE_UNCORRECTABLE  198
+#define ATA_ATTR_PERCENT_LIFE_REMAINING 202     // Crucial / Micron
+#define ATA_ATTR_SSD_LIFE_LEFT          231
+#define ATA_ATTR_MEDIA_WEAROUT          233     // Intel
+#define ATA_ATTR_TOTAL_LBAS_WRITTEN     241
+
+static bool read_ata_smart(int fd, unsigned char *data) {
+    unsigned char cdb[16];
+    unsigned char sense[32];
+    memset(cdb, 0, sizeof(cdb));
+    cdb[0] = 0x85;                      // ATA PASS-THROUGH (16)
+    cdb[1] = 4 << 1;                    // Protocole PIO data-in
+    cdb[2] = 0x0E;                      // T_DIR = lecture, BYT_BLOK, T_LENGTH = secteurs
+    cdb[4] = 0xD0;                      // Feature: SMART READ DATA
+    cdb[6] = 1;                         // Un secteur
+    cdb[10] = 0x4F;                     // LBA mid / high: signature SMART
+    cdb[12] = 0xC2;
+    cdb[14] = 0xB0;                     // Commande SMART
+
+    sg_io_hdr_t io;
+    memset(&io, 0, sizeof(io));
+    io.interface_id = 'S';
+    io.dxfer_direction = SG_DXFER_FROM_DEV;
+    io.cmd_len = sizeof(cdb);
+    io.cmdp = cdb;
+    io.dxfer_len = SMART_DATA_SIZE;
+    io.dxferp = data;
+    io.mx_sb_len = sizeof(sense);
+    io.sbp = sense;
+    io.timeout = SMART_TIMEOUT_MS;
+    if (ioctl(fd, SG_IO, &io) != 0) {
+        return false;
+    }
+    // Disque SCSI/SAS ou pont USB sans SAT: commande refusée (CHECK CONDITION)
+    return io.status == 0 && io.host_status == 0 && (io.driver_status & 0x0F) == 0;
+}
+
+// CHECK POWER MODE: true si le disque est en veille (standby) ou au repos (idle).
+// Toute autre réponse, ou une commande refusée (pont USB), laisse passer la lecture SMART
+static bool ata_drive_sleeping(int fd) {
+    unsigned char cdb[16];
+    unsigned char sense[32];
+    memset(cdb, 0, sizeof(cdb));
+    memset(sense, 0, sizeof(sense));
+    cdb[0] = 0x85;                      // ATA PASS-THROUGH (16)
+    cdb[1] = 3 << 1;                    // Protocole non-data
+    cdb[2] = 0x20;                      // CK_COND: registres ATA renvoyés dans le sense
+    cdb[14] = 0xE5;                     // CHECK POWER MODE
+
+    sg_io_hdr_t io;
+    memset(&io, 0, sizeof(io));
+    io.interface_id = 'S';
+    io.dxfer_direction = SG_DXFER_NONE;
+    io.cmd_len = sizeof(cdb);
+    io.cmdp = cdb;
+    io.mx_sb_len = sizeof(sense);
+    io.sbp = sense;
+    io.timeout = SMART_TIMEOUT_MS;
+    if (ioctl(fd, SG_IO, &io) != 0) {
+        return false;
+    }
+
+    // Registre Count: 0x00 standby, 0x80-0x83 idle, 0xFF actif
+    int count = -1;
+    if ((sense[0] & 0x7F) == 0x72) {
+        // Format descripteur: chercher l'ATA Status Return (0x09), Count (7:0) à l'octet 5
+        int length = 8 + sense[7] < io.sb_len_wr ? 8 + sense[7] : io.sb_len_wr;
+        for (int offset = 8; offset + 14 <= length; offset += 2 + sense[offset + 1]) {
+            if (sense[offset] == 0x09) {
+                count = sense[offset + 5];
+                break;
+            }
+        }
+    } else if ((sense[0] & 0x7F) == 0x70 && io.sb_len_wr >= 14 &&
+               sense[12] == 0x00 && sense[13] == 0x1D) {
+        count = sense[6];               // Format fixe: ATA PASS THROUGH INFORMATION AVAILABLE
+    }
+    return count == 0x00 || (count >= 0x80 && count <= 0x83);
+}
+
+static bool read_ata_health(int fd, DiskHealth *health) {
+    unsigned char data[SMART_DATA_SIZE];
+    memset(data, 0, sizeof(data));
+    if (!read_ata_smart(fd, data)) {
+        return false;
+    }
+
+    // Octets 0-1: version de la structure; 0 = réponse vide (pont USB qui ignore la commande)
+    if (read_le(data, 2) == 0) {
+        return false;
+    }
+
+    health->source = DISK_HEALTH_ATA;
+    bool has_power_loss = false;
+    bool has_temperature = false;
+    uint64_t power_off_retract = 0;
+
+    // 30 entrées de 12 octets: id, flags (2), valeur normalisée, pire valeur, brut (6), réservé
+    for (int i = 0; i < 30; i++) {
+        const unsigned char *entry = &data[2 + i * 12];
+        uint8_t id = entry[0];
+        uint8_t normalized = entry[3];
+        uint64_t raw = read_le(&entry[5], 6);
+        switch (id) {
+            case ATA_ATTR_POWER_ON_HOURS:
+                health->power_on_hours = raw & 0xFFFFFFFF;  // Certains firmwares mettent des minutes au-delà
+                break;
+            case ATA_ATTR_UNEXPECTED_POWER_LOSS:
+                health->unsafe_shutdowns = raw;
+                has_power_loss = true;
+                break;
+            case ATA_ATTR_POWER_OFF_RETRACT:
+                power_off_retract = raw;
+                break;
+            case ATA_ATTR_REPORTED_UNCORRECT:
+            case ATA_ATTR_OFFLINE_UNCORRECTABLE:
+                health->media_errors += raw & 0xFFFFFFFF;
+                break;
+            case ATA_ATTR_TEMPERATURE:
+                health->temperature_celsius = (float)(raw & 0xFF);
+                has_temperature = true;
+                break;
+            case ATA_ATTR_AIRFLOW_TEMPERATURE:
+                if (!has_temperature) {
+                    health->temperature_celsius = (float)(raw & 0xFF);
+                }
+                break;
+            case ATA_ATTR_WEAR_LEVELING:
+            case ATA_ATTR_PERCENT_LIFE_REMAINING:
+            case ATA_ATTR_SSD_LIFE_LEFT:
+            case ATA_ATTR_MEDIA_WEAROUT:
+                if (normalized <= 100) {
+                    health->percentage_used = 100 - normalized;
+                }
+                break;
+            case ATA_ATTR_TOTAL_LBAS_WRITTEN:
+                health->data_written_gb = raw * 512ULL / 1000000000ULL;
+                break;
+            default:
+                break;
+        }
+    }
+    if (!has_power_loss) {
+        health->unsafe_shutdowns = power_off_retract;
+    }
+    return true;
+}
+
+// ============================================================================
+// API
+// ============================================================================
+
+static void reset_disk_health(DiskHealth *health) {
+    memset(health, 0, sizeof(*health));
+    health->source = DISK_HEALTH_NONE;
+    health->temperature_celsius = -1.0f;
+    health->percentage_used = -1;
+}
+
+// Retourne false sans toucher à health si le disque ATA dort: SMART READ DATA le
+// réveillerait (disque dur: démarrage du moteur) à chaque DISK_HEALTH_REFRESH_SECONDS
+static bool query_disk_health(const char *storage_name, DiskHealth *health) {
+    // Les ioctl interrogent le matériel de l'hôte, pas l'arborescence de test
+    if (sysroot_is_set()) {
+        reset_disk_health(health);
+        return true;
+    }
+
+    char path[64];
+    snprintf(path, sizeof(path), "/dev/%.31s", storage_name);
+    int fd = open(path, O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+    if (fd < 0) {
+        reset_disk_health(health);
+        return true;
+    }
+    bool nvme = strncmp(storage_name, "nvme", 4) == 0;
+    if (!nvme && ata_drive_sleeping(fd)) {
+        close(fd);
+        return false;
+    }
+
+    reset_disk_health(health);
+    bool ok = nvme ? read_nvme_health(fd, health) : read_ata_health(fd, health);
+    close(fd);
+
+    if (!ok) {
+        reset_disk_health(health);      // Champs partiellement remplis avant l'échec
+    }
+    return true;
+}
+
+bool get_disk_health(const char *storage_name, DiskHealth *health) {
+    if (health == NULL) {
+        return false;
+    }
+    reset_disk_health(health);
+    if (storage_name == NULL || strchr(storage_name, '/') != NULL) {
+        return false;
+    }
+
+    double now = counter_clock_seconds();
+    HealthCache *entry = NULL;
+    for (int i = 0; i < cache_count; i++) {
+        if (strcmp(cache[i].name, storage_name) == 0) {
+            entry = &cache[i];
+            break;
+        }
+    }
+
+    if (entry == NULL) {
+        if (cache_count == cache_capacity) {
+            int new_capacity = cache_capacity > 0 ? cache_capacity * 2 : 16;
+            HealthCache *grown = realloc(cache, sizeof(HealthCache) * new_capacity);
+            if (grown == NULL) {
+                return false;
+            }
+            cache = grown;
+            cache_capacity = new_capacity;
+        }
+        entry = &cache[cache_count++];
+        snprintf(entry->name, sizeof(entry->name), "%s", storage_name);
+        reset_disk_health(&entry->health);
+        query_disk_health(storage_name, &entry->health);
+        entry->timestamp = now;
+    } else if (now - entry->timestamp >= DISK_HEALTH_REFRESH_SECONDS) {
+        // Disque endormi: le dernier état lu reste affiché, nouvel essai à la période suivante
+        query_disk_health(storage_name, &entry->health);
+        entry->timestamp = now;
+    }
+
+    *health = entry->health;
+    return health->source != DISK_HEALTH_NONE;
+}
+
+void forget_disk_health(const char *storage_name) {
+    for (int i = 0; i < cache_count; i++) {
+        if (strcmp(cache[i].name, storage_name) == 0) {
+            memmove(&cache[i], &cache[i + 1], (cache_count - i - 1) * sizeof(HealthCache));
+            cache_count--;
+            return;
+        }
+    }
+}
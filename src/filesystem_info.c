@@ -0,0 +1,159 @@
+/*
+ * filesystem_info.c
+ * Per-filesystem usage (statvfs) with a rate-limited stat and a growth trend
+ */
+
+#include "filesystem_info.h"
+#include "history.h"
+#include "sysroot.h"
+#include "counter_delta.h"
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <sys/statvfs.h>
+
+#define MAX_FILESYSTEMS 128
+#define STAT_INTERVAL_SLACK_SECONDS 0.5    // Minuteries regroupées par l'ordonnanceur: réveil un peu en avance
+#define GROWTH_HISTORY_CAPACITY (FILESYSTEM_GROWTH_WINDOW_SECONDS / FILESYSTEM_STAT_INTERVAL_SECONDS + 1)
+
+// État conservé par système de fichiers (identifié par son périphérique)
+typedef struct {
+    unsigned int major;
+    unsigned int minor;
+    double last_stat;               // Instant du dernier statvfs() (horloge monotone)
+    FilesystemUsage usage;          // Dernière mesure, resservie jusqu'au prochain statvfs()
+    uint64_t base_used_bytes;       // L'historique garde used - base: un float y reste précis
+    MetricHistory used_history;
+    unsigned int generation;        // Appel où le système de fichiers était monté
+} FilesystemState;
+
+static FilesystemState *states = NULL;
+static int state_count = 0;
+static int state_capacity = 0;
+static unsigned int state_generation = 0;
+
+// Chercher ou créer l'état d'un système de fichiers (NULL si plus de mémoire)
+static FilesystemState* get_filesystem_state(const MountEntry *mount) {
+    for (int i = 0; i < state_count; i++) {
+        if (states[i].major == mount->major && states[i].minor == mount->minor) {
+            return &states[i];
+        }
+    }
+
+    if (state_count == state_capacity) {
+        int new_capacity = state_capacity > 0 ? state_capacity * 2 : 16;
+        FilesystemState *grown = realloc(states, sizeof(FilesystemState) * new_capacity);
+        if (grown == NULL) {
+            return NULL;
+        }
+        states = grown;
+        state_capacity = new_capacity;
+    }
+
+    FilesystemState *state = &states[state_count];
+    memset(state, 0, sizeof(FilesystemState));
+    if (!history_init(&state->used_history, GROWTH_HISTORY_CAPACITY)) {
+        return NULL;
+    }
+    state->major = mount->major;
+    state->minor = mount->minor;
+    state_count++;
+    return state;
+}
+
+// Oublier les systèmes de fichiers démontés depuis l'appel précédent
+static void prune_filesystem_states(void) {
+    int kept = 0;
+    for (int i = 0; i < state_count; i++) {
+        if (states[i].generation == state_generation) {
+            states[kept++] = states[i];
+        } else {
+            history_free(&states[i].used_history);
+        }
+    }
+    state_count = kept;
+}
+
+// Un statvfs(): octets et inodes, puis une mesure de plus dans l'historique
+static void stat_filesystem(FilesystemState *state, double now) {
+    FilesystemUsage *usage = &state->usage;
+    char path[PATH_MAX];
+    struct statvfs fs;
+    state->last_stat = now;
+    if (!sysroot_path(path, sizeof(path), "%s", usage->mount.mount_point) || statvfs(path, &fs) != 0) {
+        usage->valid = false;
+        return;
+    }
+
+    usage->valid = true;
+    usage->total_bytes = (uint64_t)fs.f_blocks * fs.f_frsize;
+    usage->used_bytes = (uint64_t)(fs.f_blocks - fs.f_bfree) * fs.f_frsize;
+    usage->available_bytes = (uint64_t)fs.f_bavail * fs.f_frsize;
+    uint64_t usable = usage->used_bytes + usage->available_bytes;
+    usage->usage_percent = usable > 0 ? (float)((double)usage->used_bytes * 100.0 / (double)usable) : 0.0f;
+
+    usage->total_inodes = (uint64_t)fs.f_files;
+    usage->used_inodes = fs.f_files > fs.f_ffree ? (uint64_t)(fs.f_files - fs.f_ffree) : 0;
+    usage->available_inodes = (uint64_t)fs.f_favail;
+    usage->inode_percent = fs.f_files > 0
+        ? (float)((double)usage->used_inodes * 100.0 / (double)fs.f_files) : -1.0f;
+
+    if (state->used_history.count == 0) {
+        state->base_used_bytes = usage->used_bytes;
+    }
+    history_push(&state->used_history, now, (float)((double)usage->used_bytes - (double)state->base_used_bytes));
+}
+
+// Tendance de l'occupation sur FILESYSTEM_GROWTH_WINDOW_SECONDS
+static void update_growth(FilesystemState *state, double now) {
+    FilesystemUsage *usage = &state->usage;
+    double per_second = 0.0;
+    double span = 0.0;
+    usage->growth_known = history_slope(&state->used_history, now, FILESYSTEM_GROWTH_WINDOW_SECONDS,
+                                        &per_second, &span) &&
+                          span >= FILESYSTEM_GROWTH_MIN_SECONDS;
+    usage->history_seconds = span;
+    usage->growth_bytes_per_hour = usage->growth_known ? (float)(per_second * 3600.0) : 0.0f;
+
+    if (usage->valid && usage->available_bytes == 0) {
+        usage->seconds_until_full = 0.0;
+    } else if (usage->growth_known && per_second > 0.0) {
+        usage->seconds_until_full = (double)usage->available_bytes / per_second;
+    } else {
+        usage->seconds_until_full = -1.0;
+    }
+}
+
+int get_filesystem_usage(FilesystemUsage *filesystems, int max_filesystems) {
+    static MountEntry mounts[MAX_FILESYSTEMS];  // ~80 Ko: hors de la pile
+    if (filesystems == NULL || max_filesystems <= 0) {
+        return 0;
+    }
+
+    int mount_count = get_mounted_filesystems(mounts, MAX_FILESYSTEMS);
+    double now = counter_clock_seconds();
+    state_generation++;
+
+    int count = 0;
+    for (int i = 0; i < mount_count; i++) {
+        FilesystemState *state = get_filesystem_state(&mounts[i]);
+        if (state == NULL) {
+            continue;
+        }
+        state->generation = state_generation;
+
+        // Le point de montage peut changer (bind devenu principal): toujours la dernière entrée
+        state->usage.mount = mounts[i];
+        double since_stat = now - state->last_stat;
+        if (state->last_stat == 0.0 || since_stat >= FILESYSTEM_STAT_INTERVAL_SECONDS - STAT_INTERVAL_SLACK_SECONDS) {
+            stat_filesystem(state, now);
+            update_growth(state, now);
+        }
+        if (count < max_filesystems) {
+            filesystems[count++] = state->usage;
+        }
+    }
+
+    prune_filesystem_states();
+    return count;
+}
@@ -10,46 +10,371 @@
 
 #include "gui.h"
 #include "system_info.h"
+#include "hotplug_monitor.h"
+#include "speed_test.h"
+#include "speed_history.h"
 #include <stdlib.h>
+#include <math.h>
+#include <float.h>
+#include <time.h>
 #include <glib.h>
+#include <glib-unix.h>
+
+// Speed test result for one disk (matched back by name: rows may change meanwhile)
+typedef struct {
+    char storage_name[32];
+    float read_speed;
+    float write_speed;
+    float random_iops;
+    bool raw_read;          // Read speed from the raw device (otherwise from the temp file)
+    int file_size_mb;       // Temp file test method (0 = not run): part of its history key
+    bool file_direct_io;
+    SpeedTestStats read_stats;       // Repetitions behind the medians above
+    SpeedTestStats write_stats;
+    float write_cliff_seconds;       // Write throughput drop (SLC cache full), -1 = none
+    float sustained_write_mbps;
+    int sustained_write_mb;          // Written past the SLC cache to look for the drop (0 = not run)
+    SpeedTestRecord previous_read;   // Last saved comparable results (timestamp 0 = none)
+    SpeedTestRecord previous_write;
+    bool completed;         // False if the test was cancelled before this disk finished
+} DiskSpeedTestResult;
 
 // Structure to pass disk speed test data to the thread
 typedef struct {
     AppWidgets *widgets;
-    GtkWidget *button;
+    bool write_test;        // Also run the temp file test (writes to the disk)
+    bool sustained_write;   // ...extended past the SLC cache (up to 4 GB more)
+    SpeedTestControl control;  // Cancel flag (set by the button) and progress callback
+    int current;            // Disk and stage under test (test thread only)
+    int stage;
+    bool new_disk;          // Next progress report starts a new curve
+    int count;
+    DiskSpeedTestResult results[];
 } DiskSpeedTestData;
 
+// Progress report copied from the test thread to the main loop
+typedef struct {
+    AppWidgets *widgets;
+    char storage_name[32];
+    float fraction;         // Whole run (all disks)
+    bool new_disk;
+    SpeedTestProgress progress;
+} SpeedTestProgressUpdate;
+
+// Collector periods (ms): cheap metrics run fast, popen/df-based ones slowly
+#define CPU_INTERVAL_MS            250
+#define NETWORK_INTERVAL_MS        500
+#define SENSORS_INTERVAL_MS        1000   // Temperature, memory, uptime
+#define GPU_INTERVAL_MS            2000   // nvidia-smi / vcgencmd
+#define ADDRESSES_INTERVAL_MS      5000   // `ip addr` per interface
+#define SOCKETS_INTERVAL_MS        2000   // sock_diag dump (O(sockets) in the kernel)
+#define WIRELESS_INTERVAL_MS       2000   // nl80211 station + survey per WiFi interface
+#define CGROUPS_INTERVAL_MS        2000   // 4 small files per cgroup
+#define NUMA_INTERVAL_MS           1000   // Per-CPU /proc/stat lines + nodeN/meminfo
+#define STORAGE_USAGE_INTERVAL_MS  10000  // statvfs() per mounted filesystem (usage changes slowly)
+#define STORAGE_LATENCY_INTERVAL_MS BLOCK_LATENCY_DRAIN_MS  // Tracepoint drain (sizes the perf rings) or /sys/block stat
+#define STORAGE_HEALTH_INTERVAL_MS 60000  // SMART / NVMe log ioctl per disk (cached by disk_health.c)
+#define VOLUMES_INTERVAL_MS        1000   // /proc/diskstats + a few md / dm sysfs files per volume
+#define FILESYSTEMS_INTERVAL_MS    (FILESYSTEM_STAT_INTERVAL_SECONDS * 1000)  // statvfs() per mount (rate-limited there too)
+#define SCHEDULER_COALESCE_MS      50     // Timer alignment granularity
+
+// Window hidden: display collectors are suspended, history keeps a slow sampler
+#define BACKGROUND_INTERVAL_MS     5000   // Default, overridden by SYSWATCH_BACKGROUND_INTERVAL_MS
+#define HISTORY_WINDOW_SECONDS     60     // Tooltips summarise the last minute
+#define HISTORY_CAPACITY           (HISTORY_WINDOW_SECONDS * 1000 / CPU_INTERVAL_MS)
+
 // Macro to convert a number to string
 #define STRINGIFY(x) #x
 #define TOSTRING(x) STRINGIFY(x)
 
+// Network table columns (the *_KBPS columns are the numeric sort keys)
+enum {
+    NET_COL_ICON,
+    NET_COL_NAME,
+    NET_COL_ADDRESS,
+    NET_COL_UPLOAD_TEXT,
+    NET_COL_UPLOAD_KBPS,
+    NET_COL_DOWNLOAD_TEXT,
+    NET_COL_DOWNLOAD_KBPS,
+    NET_COL_PACKETS_TEXT,
+    NET_COL_PACKETS_RATE,
+    NET_COL_ERRORS_TEXT,
+    NET_COL_ERRORS_RATE,
+    NET_COL_LINK_TEXT,
+    NET_COL_LINK_MBPS,
+    NET_COL_LINE_RATE_TEXT,
+    NET_COL_LINE_RATE_PERCENT,
+    NET_COL_SIGNAL_TEXT,
+    NET_COL_SIGNAL_DBM,
+    NET_COL_BACKGROUND,
+    NET_COL_COUNT
+};
+
+// Storage table columns (text shown, float used for sorting)
+enum {
+    STORAGE_COL_NAME,
+    STORAGE_COL_TYPE,
+    STORAGE_COL_INTERFACE,
+    STORAGE_COL_USED_TEXT,
+    STORAGE_COL_USED_GB,
+    STORAGE_COL_AVAILABLE_TEXT,
+    STORAGE_COL_AVAILABLE_GB,
+    STORAGE_COL_TOTAL_TEXT,
+    STORAGE_COL_TOTAL_GB,
+    STORAGE_COL_USAGE_TEXT,
+    STORAGE_COL_USAGE_PERCENT,
+    STORAGE_COL_READ_TEXT,
+    STORAGE_COL_READ_MBPS,
+    STORAGE_COL_WRITE_TEXT,
+    STORAGE_COL_WRITE_MBPS,
+    STORAGE_COL_LATENCY_TEXT,
+    STORAGE_COL_LATENCY_MS,
+    STORAGE_COL_HEALTH_TEXT,
+    STORAGE_COL_WEAR_PERCENT,
+    STORAGE_COL_TOOLTIP,
+    STORAGE_COL_COUNT
+};
+
+// Logical volume table columns (md arrays, device-mapper volumes)
+enum {
+    VOLUME_COL_NAME,
+    VOLUME_COL_TYPE,
+    VOLUME_COL_MEMBERS,
+    VOLUME_COL_SIZE_TEXT,
+    VOLUME_COL_SIZE_GB,
+    VOLUME_COL_STATE,
+    VOLUME_COL_READ_TEXT,
+    VOLUME_COL_READ_KBPS,
+    VOLUME_COL_WRITE_TEXT,
+    VOLUME_COL_WRITE_KBPS,
+    VOLUME_COL_MEMBER_IO_TEXT,
+    VOLUME_COL_MEMBER_IO_KBPS,
+    VOLUME_COL_TOOLTIP,
+    VOLUME_COL_BACKGROUND,
+    VOLUME_COL_COUNT
+};
+
+// Filesystem table columns (one row per mounted filesystem)
+enum {
+    FILESYSTEM_COL_MOUNT,
+    FILESYSTEM_COL_DEVICE,
+    FILESYSTEM_COL_TYPE,
+    FILESYSTEM_COL_USED_TEXT,
+    FILESYSTEM_COL_USED_GB,
+    FILESYSTEM_COL_AVAILABLE_TEXT,
+    FILESYSTEM_COL_AVAILABLE_GB,
+    FILESYSTEM_COL_USAGE_TEXT,
+    FILESYSTEM_COL_USAGE_PERCENT,
+    FILESYSTEM_COL_INODES_TEXT,
+    FILESYSTEM_COL_INODES_PERCENT,
+    FILESYSTEM_COL_GROWTH_TEXT,
+    FILESYSTEM_COL_GROWTH_GB_PER_HOUR,
+    FILESYSTEM_COL_FULL_TEXT,
+    FILESYSTEM_COL_FULL_HOURS,
+    FILESYSTEM_COL_TOOLTIP,
+    FILESYSTEM_COL_BACKGROUND,
+    FILESYSTEM_COL_COUNT
+};
+
+enum {
+    CGROUP_COL_NAME,
+    CGROUP_COL_CPU_TEXT,
+    CGROUP_COL_CPU_PERCENT,
+    CGROUP_COL_MEMORY_TEXT,
+    CGROUP_COL_MEMORY_MB,
+    CGROUP_COL_PRESSURE_TEXT,
+    CGROUP_COL_PRESSURE_PERCENT,
+    CGROUP_COL_READ_TEXT,
+    CGROUP_COL_READ_KBPS,
+    CGROUP_COL_WRITE_TEXT,
+    CGROUP_COL_WRITE_KBPS,
+    CGROUP_COL_COUNT
+};
+
+// Device tables taller than this (pixels) scroll instead of growing the window
+#define TABLE_MAX_HEIGHT  320
+
+// Interfaces using at least this share of their line rate are highlighted
+#define NETWORK_SATURATION_PERCENT  95.0f
+
+// Filesystems: red when nearly full (space or inodes) or full within a day, orange within a week
+#define FILESYSTEM_ALERT_PERCENT    95.0f
+#define FILESYSTEM_WARNING_PERCENT  90.0f
+#define FILESYSTEM_ALERT_HOURS      24.0
+#define FILESYSTEM_WARNING_HOURS    (7 * 24.0)
+
 // ============================================================================
 // FORWARD DECLARATIONS
 // ============================================================================
 
 static gboolean update_storage_speed_test_results(gpointer data);
 static void init_physical_storages(AppWidgets *widgets);
+static int find_storage_index(AppWidgets *widgets, const char *storage_name);
+static void set_storage_tooltip(AppWidgets *widgets, int index, GtkTreeIter *iter);
+static gboolean get_row_iter(GtkListStore *store, GtkTreeRowReference *row, GtkTreeIter *iter);
+static void init_collectors(AppWidgets *widgets);
+static void record_background_history(AppWidgets *widgets);
+static gboolean on_history_query_tooltip(GtkWidget *widget, gint x, gint y, gboolean keyboard_mode,
+                                         GtkTooltip *tooltip, gpointer user_data);
+static gboolean on_sockets_query_tooltip(GtkWidget *widget, gint x, gint y, gboolean keyboard_mode,
+                                         GtkTooltip *tooltip, gpointer user_data);
+static gboolean on_swap_query_tooltip(GtkWidget *widget, gint x, gint y, gboolean keyboard_mode,
+                                      GtkTooltip *tooltip, gpointer user_data);
 
 // ============================================================================
 // PRIVATE FUNCTIONS (CALLBACKS)
 // ============================================================================
 
+// Compare with the last saved test of this disk, then save the new results (test thread)
+static void save_speed_test_result(DiskSpeedTestResult *result, bool write_test) {
+    char identity[96];
+    if (!get_storage_identity(result->storage_name, identity, sizeof(identity))) {
+        return;  // No WWN / serial: the name alone may point at another disk next time
+    }
+    
+    // Raw device and temp file reads are not comparable: separate histories
+    // A temp file test is only compared with one of the same size and I/O mode
+    char file_parameters[64];
+    get_file_speed_test_parameters(result->file_size_mb, result->file_direct_io,
+                                   file_parameters, sizeof(file_parameters));
+    const char *read_parameters = result->raw_read ? READ_SPEED_TEST_PARAMETERS : file_parameters;
+    speed_history_find_latest(identity, SPEED_RECORD_READ, read_parameters, &result->previous_read);
+    speed_history_find_latest(identity, SPEED_RECORD_WRITE, file_parameters, &result->previous_write);
+    
+    SpeedTestRecord record;
+    memset(&record, 0, sizeof(record));
+    record.timestamp = (int64_t)time(NULL);
+    if (result->read_speed > 0) {
+        record.kind = SPEED_RECORD_READ;
+        record.mbps = result->read_speed;
+        record.iops = result->random_iops;
+        snprintf(record.parameters, sizeof(record.parameters), "%s", read_parameters);
+        speed_history_append(identity, &record);
+    }
+    if (write_test && result->write_speed > 0) {
+        record.kind = SPEED_RECORD_WRITE;
+        record.mbps = result->write_speed;
+        record.iops = 0.0f;
+        snprintf(record.parameters, sizeof(record.parameters), "%s", file_parameters);
+        speed_history_append(identity, &record);
+    }
+}
+
+// "498.1 MB/s (-2.8%)": speed with its change since the previous comparable test
+static void format_speed_cell(char *buffer, size_t buffer_size, float mbps, const char *suffix,
+                              const SpeedTestRecord *previous) {
+    if (previous != NULL && previous->timestamp > 0 && previous->mbps > 0) {
+        float change = (mbps - previous->mbps) / previous->mbps * 100.0f;
+        snprintf(buffer, buffer_size, "%.1f MB/s%s (%+.1f%%)", mbps, suffix, change);
+    } else {
+        snprintf(buffer, buffer_size, "%.1f MB/s%s", mbps, suffix);
+    }
+}
+
+// Update the progress bar and the live curve (main loop)
+static gboolean show_speed_test_progress(gpointer data) {
+    SpeedTestProgressUpdate *update = (SpeedTestProgressUpdate *)data;
+    AppWidgets *widgets = update->widgets;
+    
+    if (update->new_disk) {
+        widgets->speed_curve_count = 0;
+        snprintf(widgets->speed_curve_title, sizeof(widgets->speed_curve_title), "%s", update->storage_name);
+    }
+    if (widgets->speed_curve_count == SPEED_CURVE_POINTS) {
+        // Full: drop the oldest point (tests longer than two minutes)
+        memmove(widgets->speed_curve_mbps, widgets->speed_curve_mbps + 1,
+                (SPEED_CURVE_POINTS - 1) * sizeof(float));
+        widgets->speed_curve_count--;
+    }
+    widgets->speed_curve_mbps[widgets->speed_curve_count++] = update->progress.mbps;
+    
+    char text[96];
+    snprintf(text, sizeof(text), "%s · %s · %.1f MB/s · %.0f%%", update->storage_name,
+             update->progress.phase, update->progress.mbps, update->progress.fraction * 100.0f);
+    gtk_progress_bar_set_fraction(GTK_PROGRESS_BAR(widgets->speed_test_progress), update->fraction);  // [GTK]
+    gtk_progress_bar_set_text(GTK_PROGRESS_BAR(widgets->speed_test_progress), text);                  // [GTK]
+    gtk_widget_queue_draw(widgets->speed_test_curve);
+    
+    free(update);
+    return FALSE;
+}
+
+// Progress callback (test thread, at most every SPEED_TEST_PROGRESS_SECONDS)
+static void on_speed_test_progress(const SpeedTestProgress *progress, void *user_data) {
+    DiskSpeedTestData *test_data = (DiskSpeedTestData *)user_data;
+    SpeedTestProgressUpdate *update = malloc(sizeof(SpeedTestProgressUpdate));
+    if (update == NULL) {
+        return;
+    }
+    
+    // Each disk runs the raw read test, then the temp file test when requested
+    int stages = test_data->write_test ? 2 : 1;
+    float disk_fraction = (test_data->stage + progress->fraction) / stages;
+    update->widgets = test_data->widgets;
+    snprintf(update->storage_name, sizeof(update->storage_name), "%s",
+             test_data->results[test_data->current].storage_name);
+    update->fraction = (test_data->current + disk_fraction) / test_data->count;
+    update->new_disk = test_data->new_disk;
+    update->progress = *progress;
+    test_data->new_disk = false;
+    
+    // Queued before the results callback: same priority, FIFO
+    g_idle_add(show_speed_test_progress, update);
+}
+
+static bool speed_test_cancelled(DiskSpeedTestData *test_data) {
+    return atomic_load_explicit(&test_data->control.cancel, memory_order_relaxed);
+}
+
 // Thread to perform disk speed tests
 static gpointer storage_speed_test_thread(gpointer data) {
     DiskSpeedTestData *test_data = (DiskSpeedTestData *)data;
-    AppWidgets *widgets = test_data->widgets;
     
-    // Loop through all disks and perform tests
-    for (int i = 0; i < widgets->storage_count; i++) {
-        float read_speed = 0.0f;
-        float write_speed = 0.0f;
+    // Loop through the disks captured at click time (the GUI arrays may change)
+    for (int i = 0; i < test_data->count && !speed_test_cancelled(test_data); i++) {
+        DiskSpeedTestResult *result = &test_data->results[i];
+        test_data->current = i;
+        test_data->stage = 0;
+        test_data->new_disk = true;
         
-        // Perform the speed test for this disk
-        get_storage_speed_test(widgets->physical_storages[i].name, &read_speed, &write_speed);
+        // Read-only test on /dev/<disk> first: nothing is written
+        ReadSpeedTestResult raw;
+        result->write_cliff_seconds = -1.0f;
+        if (get_storage_read_speed_test(result->storage_name, &raw, &test_data->control)) {
+            result->read_speed = raw.sequential_mbps.median;
+            result->read_stats = raw.sequential_mbps;
+            result->random_iops = raw.random_iops.median;
+            result->raw_read = true;
+        }
         
-        // Store results in the structure
-        widgets->storages[i].read_speed = read_speed;
-        widgets->storages[i].write_speed = write_speed;
+        if (speed_test_cancelled(test_data)) {
+            break;
+        }
+        
+        // Temp file test only on request (needs a writable mounted partition)
+        test_data->stage = 1;
+        FileSpeedTestResult *file = test_data->write_test ? malloc(sizeof(FileSpeedTestResult)) : NULL;
+        if (file != NULL && get_storage_file_speed_test(result->storage_name, test_data->sustained_write, file,
+                                                        &test_data->control)) {
+            result->file_size_mb = file->size_mb;
+            result->file_direct_io = file->direct_io;
+            result->write_speed = file->write_mbps.median;
+            result->write_stats = file->write_mbps;
+            result->write_cliff_seconds = file->write_timeline.cliff_seconds;
+            result->sustained_write_mbps = file->write_timeline.sustained_mbps;
+            result->sustained_write_mb = file->sustained_mb;
+            if (!result->raw_read) {
+                result->read_speed = file->read_mbps.median;
+                result->read_stats = file->read_mbps;
+            }
+        }
+        free(file);  // Heap: the slice series is too large for a thread stack
+        if (speed_test_cancelled(test_data)) {
+            break;  // Partial passes are not saved nor shown
+        }
+        
+        result->completed = true;
+        save_speed_test_result(result, test_data->write_test);
     }
     
     // Request UI update (thread-safe via g_idle_add)
@@ -63,53 +388,126 @@ static gboolean update_storage_speed_test_results(gpointer data) {
     DiskSpeedTestData *test_data = (DiskSpeedTestData *)data;
     AppWidgets *widgets = test_data->widgets;
     
-    char buffer[64];
+    char read_text[64], write_text[64];
     
-    // Update Read/Write labels for each disk
-    for (int i = 0; i < widgets->storage_count; i++) {
-        // Check if this is an NVMe (results are approximate due to controller cache)
+    // Update Read/Write cells for each disk still present
+    for (int r = 0; r < test_data->count; r++) {
+        int i = find_storage_index(widgets, test_data->results[r].storage_name);
+        GtkTreeIter iter;
+        if (!test_data->results[r].completed || i < 0 ||
+            !get_row_iter(widgets->storage_store, widgets->storages[i].row, &iter)) {
+            continue;  // Cancelled before this disk, or disk unplugged during the test
+        }
+        
+        // Store results in the structure
+        StorageWidgets *storage = &widgets->storages[i];
+        storage->read_speed = test_data->results[r].read_speed;
+        storage->write_speed = test_data->results[r].write_speed;
+        storage->random_iops = test_data->results[r].random_iops;
+        storage->raw_read = test_data->results[r].raw_read;
+        storage->read_stats = test_data->results[r].read_stats;
+        storage->write_stats = test_data->results[r].write_stats;
+        storage->write_cliff_seconds = test_data->results[r].write_cliff_seconds;
+        storage->sustained_write_mbps = test_data->results[r].sustained_write_mbps;
+        storage->sustained_write_mb = test_data->results[r].sustained_write_mb;
+        storage->write_tested = test_data->write_test;
+        storage->speed_tested = true;
+        storage->previous_read = test_data->results[r].previous_read;
+        storage->previous_write = test_data->results[r].previous_write;
+        
+        // Check if this is an NVMe (temp file results are approximate due to controller cache)
         bool is_nvme = (strncmp(widgets->physical_storages[i].name, "nvme", 4) == 0);
         const char *suffix = is_nvme ? " ~" : "";  // ~ indicates approximate value
         
-        // Update Read label
-        if (widgets->storages[i].read_speed > 0) {
-            snprintf(buffer, sizeof(buffer), "%.1f MB/s%s", widgets->storages[i].read_speed, suffix);
+        if (storage->read_speed > 0) {
+            format_speed_cell(read_text, sizeof(read_text), storage->read_speed,
+                              storage->raw_read ? "" : suffix, &storage->previous_read);
         } else {
-            snprintf(buffer, sizeof(buffer), "N/A");
+            snprintf(read_text, sizeof(read_text), "N/A");
         }
-        gtk_label_set_text(GTK_LABEL(widgets->storages[i].read_label), buffer);
         
-        // Update Write label
-        if (widgets->storages[i].write_speed > 0) {
-            snprintf(buffer, sizeof(buffer), "%.1f MB/s%s", widgets->storages[i].write_speed, suffix);
+        if (!storage->write_tested) {
+            snprintf(write_text, sizeof(write_text), "—");  // Read-only test
+        } else if (storage->write_speed > 0) {
+            format_speed_cell(write_text, sizeof(write_text), storage->write_speed, suffix,
+                              &storage->previous_write);
         } else {
-            snprintf(buffer, sizeof(buffer), "N/A");
+            snprintf(write_text, sizeof(write_text), "N/A");
         }
-        gtk_label_set_text(GTK_LABEL(widgets->storages[i].write_label), buffer);
         
-        // Add tooltip for NVMe explaining the approximation
-        if (is_nvme) {
-            gtk_widget_set_tooltip_text(widgets->storages[i].read_label, 
-                "~ Approximate: NVMe speeds are limited by PCIe bandwidth.\n"
-                "Actual speeds may vary due to controller cache.");
-            gtk_widget_set_tooltip_text(widgets->storages[i].write_label, 
-                "~ Approximate: NVMe speeds are limited by PCIe bandwidth.\n"
-                "Actual speeds may vary due to controller cache.");
-        }
+        gtk_list_store_set(widgets->storage_store, &iter,
+                           STORAGE_COL_READ_TEXT, read_text,
+                           STORAGE_COL_READ_MBPS, widgets->storages[i].read_speed,
+                           STORAGE_COL_WRITE_TEXT, write_text,
+                           STORAGE_COL_WRITE_MBPS, widgets->storages[i].write_speed,
+                           -1);
+        set_storage_tooltip(widgets, i, &iter);  // Random reads, NVMe approximation
     }
     
-    // Re-enable the button
-    gtk_widget_set_sensitive(test_data->button, TRUE);
-    gtk_button_set_label(GTK_BUTTON(test_data->button), "⚡ Speed Test");
+    // Back to idle: the curve of the last disk stays visible
+    widgets->speed_test_control = NULL;
+    gtk_widget_hide(widgets->speed_test_progress);
+    gtk_widget_set_sensitive(widgets->speed_test_write_check, TRUE);
+    gtk_widget_set_sensitive(widgets->speed_test_sustained_check,
+                             gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(widgets->speed_test_write_check)));  // [GTK]
+    gtk_widget_set_sensitive(widgets->speed_test_button, TRUE);
+    gtk_button_set_label(GTK_BUTTON(widgets->speed_test_button), "⚡ Speed Test");
     
     free(test_data);
     return FALSE;
 }
 
-// Automatic callback every second
+// Live throughput curve of the disk under test (filled area, scaled to its peak)
+static gboolean on_speed_curve_draw(GtkWidget *widget, cairo_t *cr, gpointer user_data) {
+    AppWidgets *widgets = (AppWidgets *)user_data;
+    int width = gtk_widget_get_allocated_width(widget);
+    int height = gtk_widget_get_allocated_height(widget);
+    gtk_render_background(gtk_widget_get_style_context(widget), cr, 0, 0, width, height);  // [GTK]
+    
+    int count = widgets->speed_curve_count;
+    if (count < 2 || width < 2 || height < 2) {
+        return FALSE;
+    }
+    float peak = 0.0f;
+    for (int i = 0; i < count; i++) {
+        peak = widgets->speed_curve_mbps[i] > peak ? widgets->speed_curve_mbps[i] : peak;
+    }
+    if (peak <= 0.0f) {
+        return FALSE;
+    }
+    
+    // Whole test fitted to the width, 10% headroom above the peak
+    double x_step = (double)width / (count - 1);
+    double y_scale = (height - 1) / (peak * 1.1);
+    cairo_move_to(cr, 0, height);
+    for (int i = 0; i < count; i++) {
+        cairo_line_to(cr, i * x_step, height - widgets->speed_curve_mbps[i] * y_scale);
+    }
+    cairo_line_to(cr, (count - 1) * x_step, height);
+    cairo_close_path(cr);
+    cairo_set_source_rgba(cr, 0.0, 0.75, 1.0, 0.25);
+    cairo_fill_preserve(cr);
+    cairo_set_source_rgb(cr, 0.0, 0.75, 1.0);
+    cairo_set_line_width(cr, 1.5);
+    cairo_stroke(cr);
+    
+    char label[96];
+    snprintf(label, sizeof(label), "%s · peak %.1f MB/s · now %.1f MB/s", widgets->speed_curve_title,
+             peak, widgets->speed_curve_mbps[count - 1]);
+    cairo_set_source_rgb(cr, 0.6, 0.6, 0.6);
+    cairo_move_to(cr, 6, 14);
+    cairo_show_text(cr, label);
+    return FALSE;
+}
+
+// Fallback timer (every second) when the collector scheduler is unavailable
 static gboolean update_all_callback(gpointer user_data) {
     AppWidgets *widgets = (AppWidgets *)user_data;
-    update_all_displays(widgets);
+    if (widgets->window_visible) {
+        update_all_displays(widgets);
+    } else {
+        record_background_history(widgets);  // Nothing to redraw, keep the history going
+    }
     return TRUE;
 }
 
@@ -213,29 +611,60 @@ static void on_storage_refresh_clicked(GtkWidget *widget, gpointer user_data) {
     init_physical_storages(widgets);
 }
 
-// Callback when clicking "Speed Test" (disk)
+// The sustained write extends the write test: only offered when it is checked
+static void on_speed_test_write_toggled(GtkWidget *widget, gpointer user_data) {
+    AppWidgets *widgets = (AppWidgets *)user_data;
+    gtk_widget_set_sensitive(widgets->speed_test_sustained_check,
+                             gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(widget)));  // [GTK]
+}
+
+// Callback when clicking "Speed Test" (disk), or "Cancel" while a test runs
 static void on_storage_speed_test_clicked(GtkWidget *widget, gpointer user_data) {
     AppWidgets *widgets = (AppWidgets *)user_data;
     
-    if (widgets->storage_count == 0) {
+    // Test running: the thread stops after its current I/O, results callback resets the button
+    if (widgets->speed_test_control != NULL) {
+        atomic_store_explicit(&widgets->speed_test_control->cancel, true, memory_order_relaxed);
+        gtk_widget_set_sensitive(widget, FALSE);
+        gtk_button_set_label(GTK_BUTTON(widget), "⏳ Cancelling...");
         return;
     }
     
-    // Disable button during test
-    gtk_widget_set_sensitive(widget, FALSE);
-    gtk_button_set_label(GTK_BUTTON(widget), "🔄 Testing...");
+    if (widgets->storage_count == 0) {
+        return;
+    }
     
-    // Create structure to pass data to thread
-    DiskSpeedTestData *test_data = malloc(sizeof(DiskSpeedTestData));
+    // Create structure to pass data to thread (copy of the disk names)
+    DiskSpeedTestData *test_data = calloc(1, sizeof(DiskSpeedTestData) +
+                                          widgets->storage_count * sizeof(DiskSpeedTestResult));
+    if (test_data == NULL) {
+        return;
+    }
     test_data->widgets = widgets;
-    test_data->button = widget;
-    
-    // Initialize speeds
+    test_data->write_test = gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(widgets->speed_test_write_check));  // [GTK]
+    test_data->sustained_write = test_data->write_test &&
+        gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(widgets->speed_test_sustained_check));  // [GTK]
+    test_data->count = widgets->storage_count;
+    atomic_init(&test_data->control.cancel, false);
+    test_data->control.progress = on_speed_test_progress;
+    test_data->control.user_data = test_data;
+    
+    // Previous results stay displayed until this disk's new results arrive
     for (int i = 0; i < widgets->storage_count; i++) {
-        widgets->storages[i].read_speed = 0.0f;
-        widgets->storages[i].write_speed = 0.0f;
+        strncpy(test_data->results[i].storage_name, widgets->storages[i].storage_name,
+                sizeof(test_data->results[i].storage_name) - 1);
     }
     
+    // The button becomes "Cancel" during the test
+    widgets->speed_test_control = &test_data->control;
+    gtk_button_set_label(GTK_BUTTON(widget), "✖ Cancel");
+    gtk_widget_set_sensitive(widgets->speed_test_write_check, FALSE);
+    gtk_widget_set_sensitive(widgets->speed_test_sustained_check, FALSE);
+    gtk_progress_bar_set_fraction(GTK_PROGRESS_BAR(widgets->speed_test_progress), 0.0);  // [GTK]
+    gtk_progress_bar_set_text(GTK_PROGRESS_BAR(widgets->speed_test_progress), "Starting...");
+    gtk_widget_show(widgets->speed_test_progress);
+    gtk_widget_show(widgets->speed_test_curve);
+    
     // Launch test in a thread
     GThread *thread = g_thread_new("storage_speed_test", storage_speed_test_thread, test_data);
     g_thread_unref(thread);
@@ -256,6 +685,25 @@ static const char* get_temperature_color(float temp_celsius) {
     }
 }
 
+// Set a label's text only when it differs from what is displayed: an identical
+// gtk_label_set_text() still costs a Pango relayout and a redraw
+static void set_label_text(GtkWidget *label, const char *text) {
+    if (!gtk_label_get_use_markup(GTK_LABEL(label)) &&
+        g_strcmp0(gtk_label_get_label(GTK_LABEL(label)), text) == 0) {
+        return;
+    }
+    gtk_label_set_text(GTK_LABEL(label), text);  // [GTK]
+}
+
+// Same for markup (compared with the markup source, not the rendered text)
+static void set_label_markup(GtkWidget *label, const char *markup) {
+    if (gtk_label_get_use_markup(GTK_LABEL(label)) &&
+        g_strcmp0(gtk_label_get_label(GTK_LABEL(label)), markup) == 0) {
+        return;
+    }
+    gtk_label_set_markup(GTK_LABEL(label), markup);  // [GTK]
+}
+
 // Create a frame (frame) with title
 static GtkWidget* create_frame(const char *title) {
     GtkWidget *frame = gtk_frame_new(title);
@@ -264,77 +712,265 @@ static GtkWidget* create_frame(const char *title) {
 }
 
 // ============================================================================
-// PRIVATE FUNCTIONS - NETWORK INITIALIZATION
+// PRIVATE FUNCTIONS - DEVICE TABLES (GtkTreeView + GtkListStore)
 // ============================================================================
 
-// Initialize network interface list (called once)
-static void init_network_interfaces(AppWidgets *widgets) {
-    if (widgets == NULL) {
-        return;
+// Add a sortable, fixed-width text column (fixed sizing lets GTK skip measuring off-screen rows)
+static GtkTreeViewColumn* add_table_column(GtkWidget *view, const char *title, int text_column,
+                                           int sort_column, gfloat xalign, int width) {
+    GtkCellRenderer *renderer = gtk_cell_renderer_text_new();
+    g_object_set(renderer, "xalign", xalign, NULL);
+    
+    GtkTreeViewColumn *column = gtk_tree_view_column_new_with_attributes(title, renderer,
+                                                                         "text", text_column, NULL);
+    gtk_tree_view_column_set_sizing(column, GTK_TREE_VIEW_COLUMN_FIXED);
+    gtk_tree_view_column_set_fixed_width(column, width);
+    gtk_tree_view_column_set_resizable(column, TRUE);
+    gtk_tree_view_column_set_alignment(column, xalign);
+    gtk_tree_view_column_set_sort_column_id(column, sort_column);
+    gtk_tree_view_append_column(GTK_TREE_VIEW(view), column);
+    return column;
+}
+
+// Bind the background of every cell to a color column (whole-row highlight, NULL = theme default)
+static void set_table_row_background(GtkWidget *view, int background_column) {
+    GList *columns = gtk_tree_view_get_columns(GTK_TREE_VIEW(view));
+    for (GList *column = columns; column != NULL; column = column->next) {
+        GList *cells = gtk_cell_layout_get_cells(GTK_CELL_LAYOUT(column->data));
+        for (GList *cell = cells; cell != NULL; cell = cell->next) {
+            gtk_tree_view_column_add_attribute(column->data, cell->data, "cell-background", background_column);
+        }
+        g_list_free(cells);
+    }
+    g_list_free(columns);
+}
+
+// Wrap a table in a scroller that follows its natural height up to TABLE_MAX_HEIGHT
+static GtkWidget* create_table_scroller(GtkWidget *view) {
+    gtk_tree_view_set_fixed_height_mode(GTK_TREE_VIEW(view), TRUE);
+    gtk_tree_selection_set_mode(gtk_tree_view_get_selection(GTK_TREE_VIEW(view)), GTK_SELECTION_NONE);
+    
+    GtkWidget *scroller = gtk_scrolled_window_new(NULL, NULL);
+    gtk_scrolled_window_set_policy(GTK_SCROLLED_WINDOW(scroller), GTK_POLICY_NEVER, GTK_POLICY_AUTOMATIC);
+    gtk_scrolled_window_set_propagate_natural_height(GTK_SCROLLED_WINDOW(scroller), TRUE);
+    gtk_scrolled_window_set_max_content_height(GTK_SCROLLED_WINDOW(scroller), TABLE_MAX_HEIGHT);
+    gtk_container_add(GTK_CONTAINER(scroller), view);
+    return scroller;
+}
+
+// Resolve a row reference to an iterator (FALSE if the row is gone)
+static gboolean get_row_iter(GtkListStore *store, GtkTreeRowReference *row, GtkTreeIter *iter) {
+    GtkTreePath *path = row != NULL ? gtk_tree_row_reference_get_path(row) : NULL;
+    if (path == NULL) {
+        return FALSE;
+    }
+    gboolean found = gtk_tree_model_get_iter(GTK_TREE_MODEL(store), iter, path);
+    gtk_tree_path_free(path);
+    return found;
+}
+
+// Reference to the row just inserted at iter (stays valid across sorting)
+static GtkTreeRowReference* create_row_reference(GtkListStore *store, GtkTreeIter *iter) {
+    GtkTreePath *path = gtk_tree_model_get_path(GTK_TREE_MODEL(store), iter);
+    GtkTreeRowReference *row = gtk_tree_row_reference_new(GTK_TREE_MODEL(store), path);
+    gtk_tree_path_free(path);
+    return row;
+}
+
+// Remove a row from its store and release its reference
+static void remove_table_row(GtkListStore *store, GtkTreeRowReference *row) {
+    GtkTreeIter iter;
+    if (get_row_iter(store, row, &iter)) {
+        gtk_list_store_remove(store, &iter);
+    }
+    gtk_tree_row_reference_free(row);
+}
+
+// Row of a table rebuilt from each snapshot, found again by its key (volume, mount point...)
+typedef struct {
+    char key[256];
+    GtkTreeRowReference *row;
+} TableRowSlot;
+
+// Take over the row shown last time under this key, or append a new one
+// Returns the index of the previous slot (its text can be compared), -1 for a new row
+static int claim_table_row(GtkListStore *store, TableRowSlot *previous, int previous_count,
+                           const char *key, TableRowSlot *slot, GtkTreeIter *iter) {
+    snprintf(slot->key, sizeof(slot->key), "%s", key);
+    for (int i = 0; i < previous_count; i++) {
+        if (previous[i].row != NULL && strcmp(previous[i].key, key) == 0 &&
+            get_row_iter(store, previous[i].row, iter)) {
+            slot->row = previous[i].row;
+            previous[i].row = NULL;
+            return i;
+        }
+    }
+    gtk_list_store_append(store, iter);
+    slot->row = create_row_reference(store, iter);
+    return -1;
+}
+
+// Remove the rows whose key is gone from the new snapshot
+static void release_table_rows(GtkListStore *store, TableRowSlot *previous, int previous_count) {
+    for (int i = 0; i < previous_count; i++) {
+        if (previous[i].row != NULL) {
+            remove_table_row(store, previous[i].row);
+            previous[i].row = NULL;
+        }
+    }
+}
+
+// Find the row of a network interface (-1 if absent)
+static int find_network_interface_index(AppWidgets *widgets, const char *interface_name) {
+    for (int i = 0; i < widgets->network_interface_count; i++) {
+        if (strcmp(widgets->network_interfaces[i].interface_name, interface_name) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// Append one interface row to the network table
+static void add_network_interface_row(AppWidgets *widgets, const char *iface_name, const char *iface_type) {
+    if (find_network_interface_index(widgets, iface_name) >= 0) {
+        return;  // Already displayed
     }
     
-    // Create a SINGLE grid for the entire table (header + data)
-    GtkWidget *table_grid = gtk_grid_new();
-    gtk_grid_set_column_spacing(GTK_GRID(table_grid), 10);
-    gtk_grid_set_row_spacing(GTK_GRID(table_grid), 5);
-    
-    // Ligne 0: Headers
-    GtkWidget *header_iface = gtk_label_new("Interface");
-    gtk_label_set_xalign(GTK_LABEL(header_iface), 0.0);
-    
-    GtkWidget *header_ip = gtk_label_new("IP Address");
-    gtk_label_set_xalign(GTK_LABEL(header_ip), 0.0);
-    gtk_widget_set_hexpand(header_ip, TRUE);
-    
-    GtkWidget *header_upload = gtk_label_new("Upload");
-    gtk_label_set_xalign(GTK_LABEL(header_upload), 1.0);
-    gtk_widget_set_hexpand(header_upload, TRUE);
-    
-    GtkWidget *header_download = gtk_label_new("Download");
-    gtk_label_set_xalign(GTK_LABEL(header_download), 1.0);
-    gtk_widget_set_hexpand(header_download, TRUE);
-    
-    gtk_grid_attach(GTK_GRID(table_grid), header_iface, 0, 0, 1, 1);
-    gtk_grid_attach(GTK_GRID(table_grid), header_ip, 1, 0, 1, 1);
-    gtk_grid_attach(GTK_GRID(table_grid), header_upload, 2, 0, 1, 1);
-    gtk_grid_attach(GTK_GRID(table_grid), header_download, 3, 0, 1, 1);
-    
-    // Ligne 1: Séparateur
-    GtkWidget *separator = gtk_separator_new(GTK_ORIENTATION_HORIZONTAL);
-    gtk_grid_attach(GTK_GRID(table_grid), separator, 0, 1, 4, 1);
+    NetworkInterfaceWidgets *interfaces = realloc(widgets->network_interfaces,
+        (widgets->network_interface_count + 1) * sizeof(NetworkInterfaceWidgets));
+    if (interfaces == NULL) {
+        return;
+    }
+    widgets->network_interfaces = interfaces;
+    
+    // Icon from the system theme
+    const char *icon_name = "network-wired";  // Default
+    if (strstr(iface_type, "WiFi") != NULL) {
+        icon_name = "network-wireless";
+    } else if (strstr(iface_type, "Ethernet") != NULL) {
+        icon_name = "network-wired";
+    } else if (strstr(iface_type, "Mobile") != NULL) {
+        icon_name = "network-mobile";
+    } else if (strstr(iface_type, "VPN") != NULL) {
+        icon_name = "network-vpn";
+    }
     
-    // Parse interfaces and add to the same grid
-    const char *interfaces_str = get_network_interfaces();
-    char interfaces_copy[512];
-    strncpy(interfaces_copy, interfaces_str, sizeof(interfaces_copy) - 1);
-    interfaces_copy[sizeof(interfaces_copy) - 1] = '\0';
+    char iface_text[128];
+    snprintf(iface_text, sizeof(iface_text), "%s (%s)", iface_name, iface_type);
+    
+    NetworkInterfaceWidgets *entry = &widgets->network_interfaces[widgets->network_interface_count];
+    memset(entry, 0, sizeof(NetworkInterfaceWidgets));
+    strncpy(entry->interface_name, iface_name, sizeof(entry->interface_name) - 1);
+    snprintf(entry->address, sizeof(entry->address), "Loading...");
+    snprintf(entry->upload_text, sizeof(entry->upload_text), "0 KB/s");
+    snprintf(entry->download_text, sizeof(entry->download_text), "0 KB/s");
+    snprintf(entry->packets_text, sizeof(entry->packets_text), "0 / 0");
+    snprintf(entry->errors_text, sizeof(entry->errors_text), "0 / 0");
+    snprintf(entry->link_text, sizeof(entry->link_text), "--");
+    snprintf(entry->line_rate_text, sizeof(entry->line_rate_text), "--");
+    snprintf(entry->signal_text, sizeof(entry->signal_text), "--");
+    
+    GtkTreeIter iter;
+    gtk_list_store_insert_with_values(widgets->network_store, &iter, -1,
+                                      NET_COL_ICON, icon_name,
+                                      NET_COL_NAME, iface_text,
+                                      NET_COL_ADDRESS, entry->address,
+                                      NET_COL_UPLOAD_TEXT, entry->upload_text,
+                                      NET_COL_UPLOAD_KBPS, 0.0f,
+                                      NET_COL_DOWNLOAD_TEXT, entry->download_text,
+                                      NET_COL_DOWNLOAD_KBPS, 0.0f,
+                                      NET_COL_PACKETS_TEXT, entry->packets_text,
+                                      NET_COL_PACKETS_RATE, 0.0f,
+                                      NET_COL_ERRORS_TEXT, entry->errors_text,
+                                      NET_COL_ERRORS_RATE, 0.0f,
+                                      NET_COL_LINK_TEXT, entry->link_text,
+                                      NET_COL_LINK_MBPS, -1.0f,
+                                      NET_COL_LINE_RATE_TEXT, entry->line_rate_text,
+                                      NET_COL_LINE_RATE_PERCENT, -1.0f,
+                                      NET_COL_SIGNAL_TEXT, entry->signal_text,
+                                      NET_COL_SIGNAL_DBM, -200.0f,
+                                      NET_COL_BACKGROUND, NULL,
+                                      -1);
+    entry->row = create_row_reference(widgets->network_store, &iter);
+    widgets->network_interface_count++;
+    metrics_track_interface(widgets->metrics, iface_name);
+}
+
+// Remove one interface row from the network table
+static void remove_network_interface_row(AppWidgets *widgets, const char *iface_name) {
+    int index = find_network_interface_index(widgets, iface_name);
+    if (index < 0) {
+        return;
+    }
     
-    char *token = strtok(interfaces_copy, ",");
-    int row = 2;
-    int interface_count = 0;
+    remove_table_row(widgets->network_store, widgets->network_interfaces[index].row);
     
-    // Allocate memory to store interfaces
-    widgets->network_interface_count = 0;
+    memmove(&widgets->network_interfaces[index], &widgets->network_interfaces[index + 1],
+            (widgets->network_interface_count - index - 1) * sizeof(NetworkInterfaceWidgets));
+    widgets->network_interface_count--;
     
-    // Count interfaces first
-    char interfaces_count_copy[512];
-    strncpy(interfaces_count_copy, interfaces_str, sizeof(interfaces_count_copy) - 1);
-    char *count_token = strtok(interfaces_count_copy, ",");
-    while (count_token != NULL) {
-        interface_count++;
-        count_token = strtok(NULL, ",");
+    metrics_untrack_interface(widgets->metrics, iface_name);
+}
+
+// Initialize network interface list (called once, then kept current by hotplug)
+static void init_network_interfaces(AppWidgets *widgets) {
+    if (widgets == NULL) {
+        return;
     }
     
-    if (interface_count > 0) {
-        widgets->network_interfaces = malloc(interface_count * sizeof(NetworkInterfaceWidgets));
-        widgets->network_interface_count = interface_count;
-    }
+    widgets->network_store = gtk_list_store_new(NET_COL_COUNT,
+                                                G_TYPE_STRING, G_TYPE_STRING, G_TYPE_STRING,
+                                                G_TYPE_STRING, G_TYPE_FLOAT,
+                                                G_TYPE_STRING, G_TYPE_FLOAT,
+                                                G_TYPE_STRING, G_TYPE_FLOAT,
+                                                G_TYPE_STRING, G_TYPE_FLOAT,
+                                                G_TYPE_STRING, G_TYPE_FLOAT,
+                                                G_TYPE_STRING, G_TYPE_FLOAT,
+                                                G_TYPE_STRING, G_TYPE_FLOAT,
+                                                G_TYPE_STRING);
+    widgets->network_view = gtk_tree_view_new_with_model(GTK_TREE_MODEL(widgets->network_store));
+    g_object_unref(widgets->network_store);  // Owned by the view from now on
+    
+    // Column 0: icon + "name (type)" in the same cell
+    GtkTreeViewColumn *iface_column = gtk_tree_view_column_new();
+    gtk_tree_view_column_set_title(iface_column, "Interface");
+    GtkCellRenderer *icon_renderer = gtk_cell_renderer_pixbuf_new();
+    gtk_tree_view_column_pack_start(iface_column, icon_renderer, FALSE);
+    gtk_tree_view_column_add_attribute(iface_column, icon_renderer, "icon-name", NET_COL_ICON);
+    GtkCellRenderer *name_renderer = gtk_cell_renderer_text_new();
+    gtk_tree_view_column_pack_start(iface_column, name_renderer, TRUE);
+    gtk_tree_view_column_add_attribute(iface_column, name_renderer, "text", NET_COL_NAME);
+    gtk_tree_view_column_set_sizing(iface_column, GTK_TREE_VIEW_COLUMN_FIXED);
+    gtk_tree_view_column_set_fixed_width(iface_column, 220);
+    gtk_tree_view_column_set_resizable(iface_column, TRUE);
+    gtk_tree_view_column_set_sort_column_id(iface_column, NET_COL_NAME);
+    gtk_tree_view_append_column(GTK_TREE_VIEW(widgets->network_view), iface_column);
+    
+    // Columns 1-3: IP address, Upload, Download (rates sorted numerically)
+    GtkTreeViewColumn *ip_column = add_table_column(widgets->network_view, "IP Address",
+                                                    NET_COL_ADDRESS, NET_COL_ADDRESS, 0.0f, 160);
+    gtk_tree_view_column_set_expand(ip_column, TRUE);
+    add_table_column(widgets->network_view, "Upload", NET_COL_UPLOAD_TEXT, NET_COL_UPLOAD_KBPS, 1.0f, 110);
+    add_table_column(widgets->network_view, "Download", NET_COL_DOWNLOAD_TEXT, NET_COL_DOWNLOAD_KBPS, 1.0f, 110);
+    
+    // Columns 4-8: packets, errors + drops (up / down, per second), link, share of line rate
+    // and WiFi signal / noise (for WiFi, link shows channel, PHY rates and MCS)
+    add_table_column(widgets->network_view, "Packets/s", NET_COL_PACKETS_TEXT, NET_COL_PACKETS_RATE, 1.0f, 110);
+    add_table_column(widgets->network_view, "Err+Drop/s", NET_COL_ERRORS_TEXT, NET_COL_ERRORS_RATE, 1.0f, 90);
+    add_table_column(widgets->network_view, "Link", NET_COL_LINK_TEXT, NET_COL_LINK_MBPS, 1.0f, 210);
+    add_table_column(widgets->network_view, "Line Rate", NET_COL_LINE_RATE_TEXT, NET_COL_LINE_RATE_PERCENT, 1.0f, 80);
+    add_table_column(widgets->network_view, "Signal", NET_COL_SIGNAL_TEXT, NET_COL_SIGNAL_DBM, 1.0f, 110);
+    set_table_row_background(widgets->network_view, NET_COL_BACKGROUND);
+    
+    gtk_box_pack_start(GTK_BOX(widgets->network_vbox), create_table_scroller(widgets->network_view),
+                       TRUE, TRUE, 2);
+    gtk_widget_show_all(widgets->network_vbox);
     
-    // Reset token for traversal
-    strncpy(interfaces_copy, interfaces_str, sizeof(interfaces_copy) - 1);
-    token = strtok(interfaces_copy, ",");
-    interface_count = 0;
+    // Parse interfaces "eth0 (Ethernet), wlan0 (WiFi)" and add one row each
+    // (no length limit: hosts may have dozens of interfaces)
+    char *interfaces_copy = g_strdup(get_network_interfaces());
     
+    char *token = strtok(interfaces_copy, ",");
     while (token != NULL) {
         // Clean spaces at start
         while (*token == ' ') token++;
@@ -342,102 +978,383 @@ static void init_network_interfaces(AppWidgets *widgets) {
         // Extract interface name (before parenthesis)
         char iface_name[64] = {0};
         char iface_type[64] = {0};
-        sscanf(token, "%s (%[^)])", iface_name, iface_type);
-        
-        // Column 0: Icon (image) + interface name + type (in HBox)
-        GtkWidget *iface_hbox = gtk_box_new(GTK_ORIENTATION_HORIZONTAL, 5);
-        gtk_widget_set_halign(iface_hbox, GTK_ALIGN_START);
-        
-        // Load icon from system theme
-        const char *icon_name = "network-wired";  // Default
-        if (strstr(iface_type, "WiFi") != NULL) {
-            icon_name = "network-wireless";
-        } else if (strstr(iface_type, "Ethernet") != NULL) {
-            icon_name = "network-wired";
-        } else if (strstr(iface_type, "Mobile") != NULL) {
-            icon_name = "network-mobile";
-        }
-        
-        GtkWidget *icon_image = gtk_image_new_from_icon_name(icon_name, GTK_ICON_SIZE_BUTTON);
-        
-        // Create text for interface
-        char iface_text[128];
-        snprintf(iface_text, sizeof(iface_text), "%s (%s)", iface_name, iface_type);
-        GtkWidget *iface_label = gtk_label_new(iface_text);
-        gtk_label_set_xalign(GTK_LABEL(iface_label), 0.0);
-        
-        // Add icon and label to HBox
-        gtk_box_pack_start(GTK_BOX(iface_hbox), icon_image, FALSE, FALSE, 0);
-        gtk_box_pack_start(GTK_BOX(iface_hbox), iface_label, FALSE, FALSE, 0);
-        
-        // Column 1: IP Address
-        GtkWidget *ip_label = gtk_label_new("Loading...");
-        gtk_label_set_xalign(GTK_LABEL(ip_label), 0.0);
-        gtk_widget_set_hexpand(ip_label, TRUE);
-        
-        // Column 2: Upload
-        GtkWidget *upload_label = gtk_label_new("0 KB/s");
-        gtk_label_set_xalign(GTK_LABEL(upload_label), 1.0);
-        gtk_widget_set_hexpand(upload_label, TRUE);
-        
-        // Column 3: Download
-        GtkWidget *download_label = gtk_label_new("0 KB/s");
-        gtk_label_set_xalign(GTK_LABEL(download_label), 1.0);
-        gtk_widget_set_hexpand(download_label, TRUE);
-        
-        // Store labels for later update
-        if (interface_count < widgets->network_interface_count) {
-            strncpy(widgets->network_interfaces[interface_count].interface_name, iface_name, 63);
-            widgets->network_interfaces[interface_count].ip_label = ip_label;
-            widgets->network_interfaces[interface_count].upload_label = upload_label;
-            widgets->network_interfaces[interface_count].download_label = download_label;
+        if (sscanf(token, "%63s (%63[^)])", iface_name, iface_type) == 2) {
+            add_network_interface_row(widgets, iface_name, iface_type);
         }
         
-        // Attach to main grid
-        gtk_grid_attach(GTK_GRID(table_grid), iface_hbox, 0, row, 1, 1);
-        gtk_grid_attach(GTK_GRID(table_grid), ip_label, 1, row, 1, 1);
-        gtk_grid_attach(GTK_GRID(table_grid), upload_label, 2, row, 1, 1);
-        gtk_grid_attach(GTK_GRID(table_grid), download_label, 3, row, 1, 1);
-        
-        row++;
-        interface_count++;
         token = strtok(NULL, ",");
     }
+    g_free(interfaces_copy);
+}
+
+// Find the row of a physical storage (-1 if absent)
+static int find_storage_index(AppWidgets *widgets, const char *storage_name) {
+    for (int i = 0; i < widgets->storage_count; i++) {
+        if (strcmp(widgets->storages[i].storage_name, storage_name) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// "Last read test (2026-09-18 14:02): 512.3 MB/s" from the speed test history
+static void append_saved_speed(GString *tooltip, const char *title, const SpeedTestRecord *record) {
+    if (record->timestamp <= 0) {
+        return;
+    }
+    char date[32];
+    time_t when = (time_t)record->timestamp;
+    struct tm local;
+    strftime(date, sizeof(date), "%Y-%m-%d %H:%M", localtime_r(&when, &local));
+    g_string_append_printf(tooltip, "%s%s (%s): %.1f MB/s", tooltip->len > 0 ? "\n" : "", title, date, record->mbps);
+    if (record->iops > 0) {
+        g_string_append_printf(tooltip, ", %.0f IOPS", record->iops);
+    }
+}
+
+// "Read: 498.1 MB/s ± 3.2 (95% CI, 5 runs, σ 2.6, 492.0–503.3)"
+static void append_speed_stats(GString *tooltip, const char *title, const SpeedTestStats *stats) {
+    if (stats->runs == 0) {
+        return;
+    }
+    g_string_append_printf(tooltip, "%s%s: %.1f MB/s ± %.1f (95%% CI, %d runs, σ %.1f, %.1f–%.1f)",
+                           tooltip->len > 0 ? "\n" : "", title, stats->median, stats->ci95, stats->runs,
+                           stats->stddev, stats->min, stats->max);
+}
+
+// Row tooltip: SMART / NVMe health details, then the speed test details once tested
+static void set_storage_tooltip(AppWidgets *widgets, int index, GtkTreeIter *iter) {
+    const StorageWidgets *storage = &widgets->storages[index];
+    bool approximate = strncmp(storage->storage_name, "nvme", 4) == 0 && storage->write_tested &&
+                       (storage->read_speed > 0 || storage->write_speed > 0);
+    
+    GString *tooltip = g_string_new(storage->health_details);
+    if (storage->speed_tested && storage->raw_read) {
+        g_string_append_printf(tooltip, "%sRead test on /dev/%s (O_DIRECT, nothing written)\n"
+                               "Random 4K read: %.0f IOPS",
+                               tooltip->len > 0 ? "\n\n" : "", storage->storage_name, storage->random_iops);
+    } else if (storage->speed_tested) {
+        g_string_append_printf(tooltip, "%sRead-only test needs read access to /dev/%s (root)",
+                               tooltip->len > 0 ? "\n\n" : "", storage->storage_name);
+    }
+    append_speed_stats(tooltip, "Read", &storage->read_stats);
+    if (storage->write_tested) {
+        append_speed_stats(tooltip, "Write", &storage->write_stats);
+    }
+    if (storage->write_tested && storage->write_cliff_seconds >= 0) {
+        g_string_append_printf(tooltip, "\nWrite speed drops after %.1f s to %.1f MB/s (SLC cache full)",
+                               storage->write_cliff_seconds, storage->sustained_write_mbps);
+    } else if (storage->write_tested && storage->sustained_write_mb > 0) {
+        g_string_append_printf(tooltip, "\nNo lasting write speed drop over %.1f GB of sustained writes",
+                               storage->sustained_write_mb / 1024.0);
+    }
+    append_saved_speed(tooltip, storage->speed_tested ? "Previous read test" : "Last read test",
+                       &storage->previous_read);
+    append_saved_speed(tooltip, storage->speed_tested ? "Previous write test" : "Last write test",
+                       &storage->previous_write);
+    if (approximate) {
+        g_string_append_printf(tooltip, "%s~ Approximate: NVMe speeds are limited by PCIe bandwidth.\n"
+                               "Actual speeds may vary due to controller cache.",
+                               tooltip->len > 0 ? "\n\n" : "");
+    }
+    gtk_list_store_set(widgets->storage_store, iter,
+                       STORAGE_COL_TOOLTIP, tooltip->len > 0 ? tooltip->str : NULL,
+                       -1);
+    g_string_free(tooltip, TRUE);
+}
+
+// Format a size in GB (display in MB if < 1 GB, otherwise in GB)
+static void format_storage_size(char *buffer, size_t buffer_size, float size_gb) {
+    if (size_gb < 1.0f) {
+        snprintf(buffer, buffer_size, "%.0f MB", size_gb * 1024.0f);
+    } else {
+        snprintf(buffer, buffer_size, "%.1f GB", size_gb);
+    }
+}
+
+// Fill the Used / Available / Total / Usage cells of a disk row (one row-changed)
+static void set_storage_usage_cells(AppWidgets *widgets, int index) {
+    const PhysicalStorage *disk = &widgets->physical_storages[index];
+    GtkTreeIter iter;
+    if (!get_row_iter(widgets->storage_store, widgets->storages[index].row, &iter)) {
+        return;
+    }
     
-    // Add complete grid to vbox
-    gtk_box_pack_start(GTK_BOX(widgets->network_vbox), table_grid, FALSE, FALSE, 2);
+    char used[32], available[32], total[32], usage[32];
+    format_storage_size(used, sizeof(used), disk->used_gb);
+    format_storage_size(available, sizeof(available), disk->available_gb);
+    format_storage_size(total, sizeof(total), disk->capacity_gb);
     
-    gtk_widget_show_all(widgets->network_vbox);
+    // Calculate usage percentage
+    float usage_percent = 0.0f;
+    if (disk->capacity_gb > 0) {
+        usage_percent = (disk->used_gb / disk->capacity_gb) * 100.0f;
+    }
+    snprintf(usage, sizeof(usage), "%.1f%%", usage_percent);
+    
+    gtk_list_store_set(widgets->storage_store, &iter,
+                       STORAGE_COL_USED_TEXT, used,
+                       STORAGE_COL_USED_GB, disk->used_gb,
+                       STORAGE_COL_AVAILABLE_TEXT, available,
+                       STORAGE_COL_AVAILABLE_GB, disk->available_gb,
+                       STORAGE_COL_TOTAL_TEXT, total,
+                       STORAGE_COL_TOTAL_GB, disk->capacity_gb,
+                       STORAGE_COL_USAGE_TEXT, usage,
+                       STORAGE_COL_USAGE_PERCENT, usage_percent,
+                       -1);
 }
 
-// Initialize physical storage list (called once)
-static void init_physical_storages(AppWidgets *widgets) {
-    if (widgets == NULL) {
+// Latest temp file result of any method (size, O_DIRECT or buffered): only for display
+static bool find_latest_file_speed_test(const char *identity, SpeedRecordKind kind, SpeedTestRecord *latest) {
+    static const int sizes_mb[] = { FILE_SPEED_TEST_MB, FILE_SPEED_TEST_SMALL_MB };
+    memset(latest, 0, sizeof(*latest));
+    for (size_t i = 0; i < sizeof(sizes_mb) / sizeof(sizes_mb[0]); i++) {
+        for (int direct_io = 1; direct_io >= 0; direct_io--) {
+            char parameters[64];
+            SpeedTestRecord record;
+            get_file_speed_test_parameters(sizes_mb[i], direct_io, parameters, sizeof(parameters));
+            if (speed_history_find_latest(identity, kind, parameters, &record) &&
+                record.timestamp > latest->timestamp) {
+                *latest = record;
+            }
+        }
+    }
+    return latest->timestamp > 0;
+}
+
+// Show the last saved speed test of a disk (found by WWN / serial) until a new one runs
+static void show_saved_speed_tests(AppWidgets *widgets, int index, GtkTreeIter *iter) {
+    StorageWidgets *storage = &widgets->storages[index];
+    if (!get_storage_identity(storage->storage_name, storage->identity, sizeof(storage->identity))) {
         return;
     }
     
-    // Clear the box if it exists
-    GList *children = gtk_container_get_children(GTK_CONTAINER(widgets->storage_vbox));
-    for (GList *iter = children; iter != NULL; iter = g_list_next(iter)) {
-        gtk_widget_destroy(GTK_WIDGET(iter->data));
+    // Raw device result first; a temp file read only if the raw test was never permitted
+    if (!speed_history_find_latest(storage->identity, SPEED_RECORD_READ, READ_SPEED_TEST_PARAMETERS,
+                                   &storage->previous_read)) {
+        find_latest_file_speed_test(storage->identity, SPEED_RECORD_READ, &storage->previous_read);
     }
-    g_list_free(children);
+    find_latest_file_speed_test(storage->identity, SPEED_RECORD_WRITE, &storage->previous_write);
     
-    // Get physical storages list
-    int storage_count = 0;
-    widgets->physical_storages = get_physical_storages(&storage_count);
+    char read_text[32], write_text[32];
+    snprintf(read_text, sizeof(read_text), "NA");
+    snprintf(write_text, sizeof(write_text), "NA");
+    if (storage->previous_read.timestamp > 0) {
+        format_speed_cell(read_text, sizeof(read_text), storage->previous_read.mbps, "", NULL);
+    }
+    if (storage->previous_write.timestamp > 0) {
+        format_speed_cell(write_text, sizeof(write_text), storage->previous_write.mbps, "", NULL);
+    }
+    gtk_list_store_set(widgets->storage_store, iter,
+                       STORAGE_COL_READ_TEXT, read_text,
+                       STORAGE_COL_READ_MBPS, storage->previous_read.mbps,
+                       STORAGE_COL_WRITE_TEXT, write_text,
+                       STORAGE_COL_WRITE_MBPS, storage->previous_write.mbps,
+                       -1);
+    set_storage_tooltip(widgets, index, iter);
+}
+
+// Fill a disk row from scratch: nothing measured yet, saved speed tests of this disk
+static void reset_storage_row(AppWidgets *widgets, int index, GtkTreeIter *iter) {
+    const PhysicalStorage *disk = &widgets->physical_storages[index];
+    gtk_list_store_set(widgets->storage_store, iter,
+                       STORAGE_COL_NAME, disk->name,
+                       STORAGE_COL_TYPE, disk->type,
+                       STORAGE_COL_INTERFACE, disk->interface,
+                       STORAGE_COL_READ_TEXT, "NA",
+                       STORAGE_COL_READ_MBPS, 0.0f,
+                       STORAGE_COL_WRITE_TEXT, "NA",
+                       STORAGE_COL_WRITE_MBPS, 0.0f,
+                       STORAGE_COL_LATENCY_TEXT, "NA",
+                       STORAGE_COL_LATENCY_MS, 0.0f,
+                       STORAGE_COL_HEALTH_TEXT, "NA",
+                       STORAGE_COL_WEAR_PERCENT, -1.0f,
+                       -1);
+    set_storage_usage_cells(widgets, index);
+    show_saved_speed_tests(widgets, index, iter);
+}
+
+// Append one disk row to the storage table
+static void add_storage_row(AppWidgets *widgets, const PhysicalStorage *disk) {
+    if (find_storage_index(widgets, disk->name) >= 0) {
+        return;  // Already displayed
+    }
+    
+    PhysicalStorage *physical_storages = realloc(widgets->physical_storages,
+        (widgets->storage_count + 1) * sizeof(PhysicalStorage));
+    if (physical_storages == NULL) {
+        return;
+    }
+    widgets->physical_storages = physical_storages;
+    
+    StorageWidgets *storages = realloc(widgets->storages,
+        (widgets->storage_count + 1) * sizeof(StorageWidgets));
+    if (storages == NULL) {
+        return;
+    }
+    widgets->storages = storages;
+    
+    int i = widgets->storage_count;
+    widgets->physical_storages[i] = *disk;
+    
+    // Initialize structure
+    memset(&widgets->storages[i], 0, sizeof(StorageWidgets));
+    strncpy(widgets->storages[i].storage_name, disk->name, sizeof(widgets->storages[i].storage_name) - 1);
+    
+    GtkTreeIter iter;
+    gtk_list_store_append(widgets->storage_store, &iter);
+    widgets->storages[i].row = create_row_reference(widgets->storage_store, &iter);
+    widgets->storage_count++;
+    reset_storage_row(widgets, i, &iter);
+    
+    metrics_track_storage(widgets->metrics, disk);
+    gtk_widget_hide(widgets->storage_empty_label);
+}
+
+// Medium inserted or ejected (card reader, optical drive): same row, new disk behind it
+// Speed results, health and latency of the previous medium are dropped
+static void refresh_storage_row(AppWidgets *widgets, const PhysicalStorage *disk) {
+    int index = find_storage_index(widgets, disk->name);
+    GtkTreeIter iter;
+    if (index < 0 || !get_row_iter(widgets->storage_store, widgets->storages[index].row, &iter)) {
+        add_storage_row(widgets, disk);
+        return;
+    }
+    
+    metrics_untrack_storage(widgets->metrics, disk->name);
+    GtkTreeRowReference *row = widgets->storages[index].row;
+    widgets->physical_storages[index] = *disk;
+    memset(&widgets->storages[index], 0, sizeof(StorageWidgets));
+    strncpy(widgets->storages[index].storage_name, disk->name, sizeof(widgets->storages[index].storage_name) - 1);
+    widgets->storages[index].row = row;
+    reset_storage_row(widgets, index, &iter);
+    metrics_track_storage(widgets->metrics, disk);
+}
+
+// Remove one disk row from the storage table
+static void remove_storage_row(AppWidgets *widgets, const char *storage_name) {
+    int index = find_storage_index(widgets, storage_name);
+    if (index < 0) {
+        return;
+    }
+    
+    remove_table_row(widgets->storage_store, widgets->storages[index].row);
     
-    if (storage_count == 0 || widgets->physical_storages == NULL) {
-        GtkWidget *no_storage_label = gtk_label_new("No physical storages found");
-        gtk_box_pack_start(GTK_BOX(widgets->storage_vbox), no_storage_label, FALSE, FALSE, 2);
-        gtk_widget_show_all(widgets->storage_vbox);
+    int tail = widgets->storage_count - index - 1;
+    memmove(&widgets->storages[index], &widgets->storages[index + 1], tail * sizeof(StorageWidgets));
+    memmove(&widgets->physical_storages[index], &widgets->physical_storages[index + 1],
+            tail * sizeof(PhysicalStorage));
+    widgets->storage_count--;
+    metrics_untrack_storage(widgets->metrics, storage_name);
+    
+    if (widgets->storage_count == 0) {
+        gtk_widget_show(widgets->storage_empty_label);
+    }
+}
+
+// (Re)enumerate physical storages (at startup and on "Refresh"): only the model is rebuilt
+static void init_physical_storages(AppWidgets *widgets) {
+    if (widgets == NULL) {
         return;
     }
     
-    // Allocate memory for disk widgets
-    widgets->storage_count = storage_count;
-    widgets->storages = malloc(sizeof(StorageWidgets) * storage_count);
+    // Release the previous rows (Refresh)
+    for (int i = 0; i < widgets->storage_count; i++) {
+        metrics_untrack_storage(widgets->metrics, widgets->storages[i].storage_name);
+        gtk_tree_row_reference_free(widgets->storages[i].row);
+    }
+    gtk_list_store_clear(widgets->storage_store);
+    free(widgets->storages);
+    free_physical_storages(widgets->physical_storages);
+    widgets->storages = NULL;
+    widgets->physical_storages = NULL;
+    widgets->storage_count = 0;
+    gtk_widget_show(widgets->storage_empty_label);
     
+    // Get physical storages list and add each disk
+    int storage_count = 0;
+    PhysicalStorage *disks = get_physical_storages(&storage_count);
+    for (int i = 0; i < storage_count; i++) {
+        add_storage_row(widgets, &disks[i]);
+    }
+    free_physical_storages(disks);
+}
+
+// Build the logical volume table (hidden until an md array or dm volume shows up)
+static void create_volume_table(AppWidgets *widgets) {
+    widgets->volume_box = gtk_box_new(GTK_ORIENTATION_VERTICAL, 5);
+    
+    GtkWidget *title = gtk_label_new("Volumes (software RAID, LVM, encryption)");
+    gtk_label_set_xalign(GTK_LABEL(title), 0.0);
+    gtk_box_pack_start(GTK_BOX(widgets->volume_box), title, FALSE, FALSE, 2);
+    
+    widgets->volume_store = gtk_list_store_new(VOLUME_COL_COUNT,
+                                               G_TYPE_STRING, G_TYPE_STRING, G_TYPE_STRING,
+                                               G_TYPE_STRING, G_TYPE_FLOAT,
+                                               G_TYPE_STRING,
+                                               G_TYPE_STRING, G_TYPE_FLOAT,
+                                               G_TYPE_STRING, G_TYPE_FLOAT,
+                                               G_TYPE_STRING, G_TYPE_FLOAT,
+                                               G_TYPE_STRING, G_TYPE_STRING);
+    widgets->volume_view = gtk_tree_view_new_with_model(GTK_TREE_MODEL(widgets->volume_store));
+    g_object_unref(widgets->volume_store);  // Owned by the view from now on
+    gtk_tree_view_set_tooltip_column(GTK_TREE_VIEW(widgets->volume_view), VOLUME_COL_TOOLTIP);
+    
+    GtkWidget *view = widgets->volume_view;
+    add_table_column(view, "Volume", VOLUME_COL_NAME, VOLUME_COL_NAME, 0.0f, 160);
+    add_table_column(view, "Type", VOLUME_COL_TYPE, VOLUME_COL_TYPE, 0.0f, 70);
+    add_table_column(view, "Members", VOLUME_COL_MEMBERS, VOLUME_COL_MEMBERS, 0.0f, 150);
+    add_table_column(view, "Size", VOLUME_COL_SIZE_TEXT, VOLUME_COL_SIZE_GB, 1.0f, 90);
+    add_table_column(view, "State", VOLUME_COL_STATE, VOLUME_COL_STATE, 0.0f, 220);
+    add_table_column(view, "Read", VOLUME_COL_READ_TEXT, VOLUME_COL_READ_KBPS, 1.0f, 100);
+    add_table_column(view, "Write", VOLUME_COL_WRITE_TEXT, VOLUME_COL_WRITE_KBPS, 1.0f, 100);
+    add_table_column(view, "Members I/O", VOLUME_COL_MEMBER_IO_TEXT, VOLUME_COL_MEMBER_IO_KBPS, 1.0f, 110);
+    set_table_row_background(view, VOLUME_COL_BACKGROUND);
+    
+    gtk_box_pack_start(GTK_BOX(widgets->volume_box), create_table_scroller(view), TRUE, TRUE, 2);
+    gtk_box_pack_start(GTK_BOX(widgets->storage_vbox), widgets->volume_box, FALSE, FALSE, 2);
+    
+    gtk_widget_show_all(widgets->volume_box);
+    gtk_widget_set_no_show_all(widgets->volume_box, TRUE);
+    gtk_widget_hide(widgets->volume_box);
+}
+
+// Build the filesystem table: one row per mounted filesystem, below the disks and volumes
+static void create_filesystem_table(AppWidgets *widgets) {
+    GtkWidget *title = gtk_label_new("Filesystems");
+    gtk_label_set_xalign(GTK_LABEL(title), 0.0);
+    gtk_box_pack_start(GTK_BOX(widgets->storage_vbox), title, FALSE, FALSE, 2);
+    
+    widgets->filesystem_store = gtk_list_store_new(FILESYSTEM_COL_COUNT,
+                                                   G_TYPE_STRING, G_TYPE_STRING, G_TYPE_STRING,
+                                                   G_TYPE_STRING, G_TYPE_FLOAT,
+                                                   G_TYPE_STRING, G_TYPE_FLOAT,
+                                                   G_TYPE_STRING, G_TYPE_FLOAT,
+                                                   G_TYPE_STRING, G_TYPE_FLOAT,
+                                                   G_TYPE_STRING, G_TYPE_FLOAT,
+                                                   G_TYPE_STRING, G_TYPE_FLOAT,
+                                                   G_TYPE_STRING, G_TYPE_STRING);
+    widgets->filesystem_view = gtk_tree_view_new_with_model(GTK_TREE_MODEL(widgets->filesystem_store));
+    g_object_unref(widgets->filesystem_store);  // Owned by the view from now on
+    gtk_tree_view_set_tooltip_column(GTK_TREE_VIEW(widgets->filesystem_view), FILESYSTEM_COL_TOOLTIP);
+    
+    GtkWidget *view = widgets->filesystem_view;
+    add_table_column(view, "Mount", FILESYSTEM_COL_MOUNT, FILESYSTEM_COL_MOUNT, 0.0f, 160);
+    add_table_column(view, "Device", FILESYSTEM_COL_DEVICE, FILESYSTEM_COL_DEVICE, 0.0f, 160);
+    add_table_column(view, "Type", FILESYSTEM_COL_TYPE, FILESYSTEM_COL_TYPE, 0.0f, 60);
+    add_table_column(view, "Used", FILESYSTEM_COL_USED_TEXT, FILESYSTEM_COL_USED_GB, 1.0f, 90);
+    add_table_column(view, "Available", FILESYSTEM_COL_AVAILABLE_TEXT, FILESYSTEM_COL_AVAILABLE_GB, 1.0f, 90);
+    add_table_column(view, "Usage", FILESYSTEM_COL_USAGE_TEXT, FILESYSTEM_COL_USAGE_PERCENT, 1.0f, 70);
+    add_table_column(view, "Inodes", FILESYSTEM_COL_INODES_TEXT, FILESYSTEM_COL_INODES_PERCENT, 1.0f, 70);
+    add_table_column(view, "Growth", FILESYSTEM_COL_GROWTH_TEXT, FILESYSTEM_COL_GROWTH_GB_PER_HOUR, 1.0f, 100);
+    add_table_column(view, "Full in", FILESYSTEM_COL_FULL_TEXT, FILESYSTEM_COL_FULL_HOURS, 1.0f, 90);
+    set_table_row_background(view, FILESYSTEM_COL_BACKGROUND);
+    
+    gtk_box_pack_start(GTK_BOX(widgets->storage_vbox), create_table_scroller(view), FALSE, FALSE, 2);
+}
+
+// Build the storage section once: buttons, table, empty-list placeholder
+static void init_storage_table(AppWidgets *widgets) {
     // Create button box (above the table)
     GtkWidget *button_box = gtk_box_new(GTK_ORIENTATION_HORIZONTAL, 5);
     gtk_widget_set_hexpand(button_box, TRUE);
@@ -454,153 +1371,251 @@ static void init_physical_storages(AppWidgets *widgets) {
                      G_CALLBACK(on_storage_speed_test_clicked), widgets);
     gtk_box_pack_end(GTK_BOX(button_box), widgets->speed_test_button, FALSE, FALSE, 0);
     
+    // Opt-in write test (left of the button): the default test only reads the raw device
+    widgets->speed_test_write_check = gtk_check_button_new_with_label("Write test");
+    gtk_widget_set_tooltip_text(widgets->speed_test_write_check,
+                                "Also write a temporary file (16-64 MB, 6 passes) on a mounted partition.\n"
+                                "Wears SD cards; needs a writable filesystem.");
+    
+    // Second opt-in: the sustained write is what wears flash, only with the write test
+    widgets->speed_test_sustained_check = gtk_check_button_new_with_label("Sustained write");
+    gtk_widget_set_tooltip_text(widgets->speed_test_sustained_check,
+                                "Keep writing up to 4 GB (a quarter of the free space at most, one minute of I/O)\n"
+                                "to find where an SSD's SLC cache fills up and the write speed drops.");
+    gtk_widget_set_sensitive(widgets->speed_test_sustained_check, FALSE);
+    g_signal_connect(widgets->speed_test_write_check, "toggled",
+                     G_CALLBACK(on_speed_test_write_toggled), widgets);
+    gtk_box_pack_end(GTK_BOX(button_box), widgets->speed_test_sustained_check, FALSE, FALSE, 0);
+    gtk_box_pack_end(GTK_BOX(button_box), widgets->speed_test_write_check, FALSE, FALSE, 0);
+    
     gtk_box_pack_start(GTK_BOX(widgets->storage_vbox), button_box, FALSE, FALSE, 5);
     
-    // Create a SINGLE grid for the entire table (header + data)
-    GtkWidget *table_grid = gtk_grid_new();
-    gtk_grid_set_column_spacing(GTK_GRID(table_grid), 10);
-    gtk_grid_set_row_spacing(GTK_GRID(table_grid), 5);
-    
-    // Ligne 0: Headers
-    GtkWidget *header_name = gtk_label_new("Storage");
-    gtk_label_set_xalign(GTK_LABEL(header_name), 0.0);
-    
-    GtkWidget *header_type = gtk_label_new("Type");
-    gtk_label_set_xalign(GTK_LABEL(header_type), 0.0);
-    gtk_widget_set_hexpand(header_type, FALSE);
-    
-    GtkWidget *header_interface = gtk_label_new("Interface");
-    gtk_label_set_xalign(GTK_LABEL(header_interface), 0.0);
-    gtk_widget_set_hexpand(header_interface, FALSE);
-    
-    GtkWidget *header_used = gtk_label_new("Used");
-    gtk_label_set_xalign(GTK_LABEL(header_used), 1.0);
-    gtk_widget_set_hexpand(header_used, TRUE);
-    
-    GtkWidget *header_available = gtk_label_new("Available");
-    gtk_label_set_xalign(GTK_LABEL(header_available), 1.0);
-    gtk_widget_set_hexpand(header_available, TRUE);
-    
-    GtkWidget *header_total = gtk_label_new("Total");
-    gtk_label_set_xalign(GTK_LABEL(header_total), 1.0);
-    gtk_widget_set_hexpand(header_total, TRUE);
-    
-    GtkWidget *header_usage = gtk_label_new("Usage");
-    gtk_label_set_xalign(GTK_LABEL(header_usage), 1.0);
-    gtk_widget_set_hexpand(header_usage, TRUE);
-    
-    GtkWidget *header_read = gtk_label_new("Read");
-    gtk_label_set_xalign(GTK_LABEL(header_read), 1.0);
-    gtk_widget_set_hexpand(header_read, TRUE);
-    
-    GtkWidget *header_write = gtk_label_new("Write");
-    gtk_label_set_xalign(GTK_LABEL(header_write), 1.0);
-    gtk_widget_set_hexpand(header_write, TRUE);
-    
-    gtk_grid_attach(GTK_GRID(table_grid), header_name, 0, 0, 1, 1);
-    gtk_grid_attach(GTK_GRID(table_grid), header_type, 1, 0, 1, 1);
-    gtk_grid_attach(GTK_GRID(table_grid), header_interface, 2, 0, 1, 1);
-    gtk_grid_attach(GTK_GRID(table_grid), header_used, 3, 0, 1, 1);
-    gtk_grid_attach(GTK_GRID(table_grid), header_available, 4, 0, 1, 1);
-    gtk_grid_attach(GTK_GRID(table_grid), header_total, 5, 0, 1, 1);
-    gtk_grid_attach(GTK_GRID(table_grid), header_usage, 6, 0, 1, 1);
-    gtk_grid_attach(GTK_GRID(table_grid), header_read, 7, 0, 1, 1);
-    gtk_grid_attach(GTK_GRID(table_grid), header_write, 8, 0, 1, 1);
-    
-    // Ligne 1: Séparateur
-    GtkWidget *separator = gtk_separator_new(GTK_ORIENTATION_HORIZONTAL);
-    gtk_grid_attach(GTK_GRID(table_grid), separator, 0, 1, 9, 1);
-    
-    // Add each disk
-    for (int i = 0; i < storage_count; i++) {
-        PhysicalStorage *disk = &widgets->physical_storages[i];
-        int row = i + 2;
-        
-        // Initialize structure
-        memset(&widgets->storages[i], 0, sizeof(StorageWidgets));
-        strncpy(widgets->storages[i].storage_name, disk->name, sizeof(widgets->storages[i].storage_name) - 1);
+    // Speed test progress and live curve: hidden until the first test
+    widgets->speed_test_progress = gtk_progress_bar_new();
+    gtk_progress_bar_set_show_text(GTK_PROGRESS_BAR(widgets->speed_test_progress), TRUE);  // [GTK]
+    gtk_widget_set_no_show_all(widgets->speed_test_progress, TRUE);
+    gtk_box_pack_start(GTK_BOX(widgets->storage_vbox), widgets->speed_test_progress, FALSE, FALSE, 2);
+    
+    widgets->speed_test_curve = gtk_drawing_area_new();
+    gtk_widget_set_size_request(widgets->speed_test_curve, -1, 100);
+    gtk_widget_set_tooltip_text(widgets->speed_test_curve,
+                                "Instantaneous throughput every 100 ms (warm-up pass included).\n"
+                                "A lasting drop while writing means the SSD's SLC cache is full.");
+    g_signal_connect(widgets->speed_test_curve, "draw", G_CALLBACK(on_speed_curve_draw), widgets);
+    gtk_widget_set_no_show_all(widgets->speed_test_curve, TRUE);
+    gtk_box_pack_start(GTK_BOX(widgets->storage_vbox), widgets->speed_test_curve, FALSE, FALSE, 2);
+    
+    widgets->storage_store = gtk_list_store_new(STORAGE_COL_COUNT,
+                                                G_TYPE_STRING, G_TYPE_STRING, G_TYPE_STRING,
+                                                G_TYPE_STRING, G_TYPE_FLOAT,
+                                                G_TYPE_STRING, G_TYPE_FLOAT,
+                                                G_TYPE_STRING, G_TYPE_FLOAT,
+                                                G_TYPE_STRING, G_TYPE_FLOAT,
+                                                G_TYPE_STRING, G_TYPE_FLOAT,
+                                                G_TYPE_STRING, G_TYPE_FLOAT,
+                                                G_TYPE_STRING, G_TYPE_FLOAT,
+                                                G_TYPE_STRING, G_TYPE_FLOAT,
+                                                G_TYPE_STRING);
+    widgets->storage_view = gtk_tree_view_new_with_model(GTK_TREE_MODEL(widgets->storage_store));
+    g_object_unref(widgets->storage_store);  // Owned by the view from now on
+    gtk_tree_view_set_tooltip_column(GTK_TREE_VIEW(widgets->storage_view), STORAGE_COL_TOOLTIP);
+    
+    GtkWidget *view = widgets->storage_view;
+    add_table_column(view, "Storage", STORAGE_COL_NAME, STORAGE_COL_NAME, 0.0f, 100);
+    add_table_column(view, "Type", STORAGE_COL_TYPE, STORAGE_COL_TYPE, 0.0f, 60);
+    add_table_column(view, "Interface", STORAGE_COL_INTERFACE, STORAGE_COL_INTERFACE, 0.0f, 80);
+    add_table_column(view, "Used", STORAGE_COL_USED_TEXT, STORAGE_COL_USED_GB, 1.0f, 90);
+    add_table_column(view, "Available", STORAGE_COL_AVAILABLE_TEXT, STORAGE_COL_AVAILABLE_GB, 1.0f, 90);
+    add_table_column(view, "Total", STORAGE_COL_TOTAL_TEXT, STORAGE_COL_TOTAL_GB, 1.0f, 90);
+    add_table_column(view, "Usage", STORAGE_COL_USAGE_TEXT, STORAGE_COL_USAGE_PERCENT, 1.0f, 70);
+    add_table_column(view, "Read", STORAGE_COL_READ_TEXT, STORAGE_COL_READ_MBPS, 1.0f, 150);
+    add_table_column(view, "Write", STORAGE_COL_WRITE_TEXT, STORAGE_COL_WRITE_MBPS, 1.0f, 150);
+    add_table_column(view, "Latency", STORAGE_COL_LATENCY_TEXT, STORAGE_COL_LATENCY_MS, 1.0f, 160);
+    add_table_column(view, "Health", STORAGE_COL_HEALTH_TEXT, STORAGE_COL_WEAR_PERCENT, 1.0f, 130);
+    
+    gtk_box_pack_start(GTK_BOX(widgets->storage_vbox), create_table_scroller(view), TRUE, TRUE, 2);
+    
+    // Shown only while the table is empty
+    widgets->storage_empty_label = gtk_label_new("No physical storages found");
+    gtk_box_pack_start(GTK_BOX(widgets->storage_vbox), widgets->storage_empty_label, FALSE, FALSE, 2);
+    
+    create_volume_table(widgets);
+    create_filesystem_table(widgets);
+    
+    gtk_widget_show_all(widgets->storage_vbox);
+}
+
+// Build the top-N cgroup table (rows are replaced whenever the ranking changes)
+static GtkWidget* create_cgroup_table(AppWidgets *widgets) {
+    GtkWidget *vbox = gtk_box_new(GTK_ORIENTATION_VERTICAL, 5);
+    
+    widgets->cgroup_status_label = gtk_label_new("--");
+    gtk_label_set_xalign(GTK_LABEL(widgets->cgroup_status_label), 0.0);
+    gtk_box_pack_start(GTK_BOX(vbox), widgets->cgroup_status_label, FALSE, FALSE, 2);
+    
+    widgets->cgroup_store = gtk_list_store_new(CGROUP_COL_COUNT,
+                                               G_TYPE_STRING,
+                                               G_TYPE_STRING, G_TYPE_FLOAT,
+                                               G_TYPE_STRING, G_TYPE_FLOAT,
+                                               G_TYPE_STRING, G_TYPE_FLOAT,
+                                               G_TYPE_STRING, G_TYPE_FLOAT,
+                                               G_TYPE_STRING, G_TYPE_FLOAT);
+    // Busiest first until the user clicks another header
+    gtk_tree_sortable_set_sort_column_id(GTK_TREE_SORTABLE(widgets->cgroup_store),
+                                         CGROUP_COL_CPU_PERCENT, GTK_SORT_DESCENDING);
+    widgets->cgroup_view = gtk_tree_view_new_with_model(GTK_TREE_MODEL(widgets->cgroup_store));
+    g_object_unref(widgets->cgroup_store);  // Owned by the view from now on
+    
+    GtkWidget *view = widgets->cgroup_view;
+    GtkTreeViewColumn *name_column = add_table_column(view, "Cgroup", CGROUP_COL_NAME, CGROUP_COL_NAME, 0.0f, 300);
+    gtk_tree_view_column_set_expand(name_column, TRUE);
+    add_table_column(view, "CPU", CGROUP_COL_CPU_TEXT, CGROUP_COL_CPU_PERCENT, 1.0f, 80);
+    add_table_column(view, "Memory", CGROUP_COL_MEMORY_TEXT, CGROUP_COL_MEMORY_MB, 1.0f, 90);
+    add_table_column(view, "Mem Pressure", CGROUP_COL_PRESSURE_TEXT, CGROUP_COL_PRESSURE_PERCENT, 1.0f, 100);
+    add_table_column(view, "IO Read", CGROUP_COL_READ_TEXT, CGROUP_COL_READ_KBPS, 1.0f, 100);
+    add_table_column(view, "IO Write", CGROUP_COL_WRITE_TEXT, CGROUP_COL_WRITE_KBPS, 1.0f, 100);
+    
+    gtk_box_pack_start(GTK_BOX(vbox), create_table_scroller(view), TRUE, TRUE, 2);
+    return vbox;
+}
+
+// ============================================================================
+// PRIVATE FUNCTIONS - HOTPLUG
+// ============================================================================
+
+// Apply kernel uevents (disk / interface added or removed) to the tables
+static gboolean on_hotplug_event(gint fd, GIOCondition condition, gpointer user_data) {
+    AppWidgets *widgets = (AppWidgets *)user_data;
+    (void)condition;
+    
+    HotplugEvent event;
+    int status;
+    
+    // Drain every pending message (the socket is non-blocking)
+    while ((status = hotplug_monitor_read(fd, &event)) >= 0) {
+        if (status == 0) {
+            continue;  // Other subsystem, partition, interface "change" event...
+        }
         
-        // Column 0: Disk name
-        GtkWidget *name_label = gtk_label_new(disk->name);
-        gtk_label_set_xalign(GTK_LABEL(name_label), 0.0);
+        // Renamed: the old row goes, the new name is added like a new device
+        if (event.action == HOTPLUG_ACTION_MOVE) {
+            if (event.subsystem == HOTPLUG_SUBSYSTEM_NET) {
+                remove_network_interface_row(widgets, event.old_name);
+            } else {
+                remove_storage_row(widgets, event.old_name);
+            }
+        }
         
-        // Column 1: Type
-        GtkWidget *type_label = gtk_label_new(disk->type);
-        gtk_label_set_xalign(GTK_LABEL(type_label), 0.0);
-        
-        // Column 2: Interface
-        GtkWidget *interface_label = gtk_label_new(disk->interface);
-        gtk_label_set_xalign(GTK_LABEL(interface_label), 0.0);
-        
-        // Columns 3-8: Used, Available, Total, Usage, Read, Write
-        char used_str[64], available_str[64], total_str[64], usage_str[64];
-        
-        // Display in MB if < 1 GB, otherwise in GB
-        if (disk->used_gb < 1.0f) {
-            snprintf(used_str, sizeof(used_str), "%.0f MB", disk->used_gb * 1024.0f);
-        } else {
-            snprintf(used_str, sizeof(used_str), "%.1f GB", disk->used_gb);
-        }
-        
-        if (disk->available_gb < 1.0f) {
-            snprintf(available_str, sizeof(available_str), "%.0f MB", disk->available_gb * 1024.0f);
+        if (event.subsystem == HOTPLUG_SUBSYSTEM_NET) {
+            if (event.action == HOTPLUG_ACTION_REMOVE) {
+                remove_network_interface_row(widgets, event.name);
+            } else {
+                // Same filtering as the startup list: VPN / VLAN / bond shown, container plumbing ignored
+                const char *type = get_network_interface_type(event.name);
+                if (type != NULL) {
+                    add_network_interface_row(widgets, event.name, type);
+                }
+            }
         } else {
-            snprintf(available_str, sizeof(available_str), "%.1f GB", disk->available_gb);
-        }
-        
-        if (disk->capacity_gb < 1.0f) {
-            snprintf(total_str, sizeof(total_str), "%.0f MB", disk->capacity_gb * 1024.0f);
-        } else {
-            snprintf(total_str, sizeof(total_str), "%.1f GB", disk->capacity_gb);
-        }
-        
-        // Calculate usage percentage
-        float usage_percent = 0.0f;
-        if (disk->capacity_gb > 0) {
-            usage_percent = (disk->used_gb / disk->capacity_gb) * 100.0f;
+            PhysicalStorage disk;
+            memset(&disk, 0, sizeof(disk));
+            if (event.action == HOTPLUG_ACTION_REMOVE || !get_physical_storage_info(event.name, &disk)) {
+                remove_storage_row(widgets, event.name);
+            } else if (event.action == HOTPLUG_ACTION_CHANGE) {
+                refresh_storage_row(widgets, &disk);
+            } else {
+                add_storage_row(widgets, &disk);
+            }
         }
-        snprintf(usage_str, sizeof(usage_str), "%.1f%%", usage_percent);
-        
-        widgets->storages[i].used_label = gtk_label_new(used_str);
-        gtk_label_set_xalign(GTK_LABEL(widgets->storages[i].used_label), 1.0);
-        gtk_widget_set_hexpand(widgets->storages[i].used_label, TRUE);
-        
-        widgets->storages[i].available_label = gtk_label_new(available_str);
-        gtk_label_set_xalign(GTK_LABEL(widgets->storages[i].available_label), 1.0);
-        gtk_widget_set_hexpand(widgets->storages[i].available_label, TRUE);
-        
-        widgets->storages[i].total_label = gtk_label_new(total_str);
-        gtk_label_set_xalign(GTK_LABEL(widgets->storages[i].total_label), 1.0);
-        gtk_widget_set_hexpand(widgets->storages[i].total_label, TRUE);
-        
-        widgets->storages[i].percent_label = gtk_label_new(usage_str);
-        gtk_label_set_xalign(GTK_LABEL(widgets->storages[i].percent_label), 1.0);
-        gtk_widget_set_hexpand(widgets->storages[i].percent_label, TRUE);
-        
-        widgets->storages[i].read_label = gtk_label_new("NA");
-        gtk_label_set_xalign(GTK_LABEL(widgets->storages[i].read_label), 1.0);
-        gtk_widget_set_hexpand(widgets->storages[i].read_label, TRUE);
-        
-        widgets->storages[i].write_label = gtk_label_new("NA");
-        gtk_label_set_xalign(GTK_LABEL(widgets->storages[i].write_label), 1.0);
-        gtk_widget_set_hexpand(widgets->storages[i].write_label, TRUE);
-        
-        // Attacher les widgets au grid
-        gtk_grid_attach(GTK_GRID(table_grid), name_label, 0, row, 1, 1);
-        gtk_grid_attach(GTK_GRID(table_grid), type_label, 1, row, 1, 1);
-        gtk_grid_attach(GTK_GRID(table_grid), interface_label, 2, row, 1, 1);
-        gtk_grid_attach(GTK_GRID(table_grid), widgets->storages[i].used_label, 3, row, 1, 1);
-        gtk_grid_attach(GTK_GRID(table_grid), widgets->storages[i].available_label, 4, row, 1, 1);
-        gtk_grid_attach(GTK_GRID(table_grid), widgets->storages[i].total_label, 5, row, 1, 1);
-        gtk_grid_attach(GTK_GRID(table_grid), widgets->storages[i].percent_label, 6, row, 1, 1);
-        gtk_grid_attach(GTK_GRID(table_grid), widgets->storages[i].read_label, 7, row, 1, 1);
-        gtk_grid_attach(GTK_GRID(table_grid), widgets->storages[i].write_label, 8, row, 1, 1);
     }
     
-    // Ajouter le grid à la boîte Disk
-    gtk_box_pack_start(GTK_BOX(widgets->storage_vbox), table_grid, FALSE, FALSE, 2);
+    return G_SOURCE_CONTINUE;
+}
+
+// Start listening to kernel uevents (no-op if netlink is unavailable)
+static void init_hotplug_monitor(AppWidgets *widgets) {
+    widgets->hotplug_fd = hotplug_monitor_open();
+    if (widgets->hotplug_fd < 0) {
+        return;  // Tables stay as enumerated at startup ("Refresh" still works)
+    }
     
-    gtk_widget_show_all(widgets->storage_vbox);
+    widgets->hotplug_source_id = g_unix_fd_add(widgets->hotplug_fd, G_IO_IN, on_hotplug_event, widgets);
+}
+
+// ============================================================================
+// PRIVATE FUNCTIONS - WINDOW VISIBILITY (adaptive refresh)
+// ============================================================================
+
+// Switch between full-rate display collectors and the slow background sampler
+static void apply_window_visibility(AppWidgets *widgets) {
+    gboolean visible = !widgets->window_iconified && !widgets->window_obscured &&
+                       !widgets->window_unmapped;
+    if (visible == widgets->window_visible) {
+        return;
+    }
+    widgets->window_visible = visible;
+    
+    // The block tracepoints would keep filling the perf rings with nobody draining them
+    metrics_set_storage_latency_paused(widgets->metrics, !visible);
+    
+    if (widgets->scheduler == NULL) {
+        return;  // Fallback timer checks window_visible itself
+    }
+    
+    if (!visible) {
+        // Nobody is looking: stop relabelling, only feed the history
+        for (int i = 0; i < widgets->display_collector_count; i++) {
+            scheduler_set_interval(widgets->scheduler, widgets->display_collector_ids[i], 0);
+        }
+        scheduler_set_interval(widgets->scheduler, widgets->history_collector_id,
+                               widgets->background_interval_ms);
+        return;
+    }
+    
+    // Back on screen: catch up immediately, then resume the normal rates
+    scheduler_set_interval(widgets->scheduler, widgets->history_collector_id, 0);
+    for (int i = 0; i < widgets->display_collector_count; i++) {
+        scheduler_set_interval(widgets->scheduler, widgets->display_collector_ids[i],
+                               widgets->display_collector_intervals[i]);
+        scheduler_run_now(widgets->scheduler, widgets->display_collector_ids[i]);
+    }
+}
+
+// Minimised / withdrawn (e.g. sent to another workspace by some window managers)
+static gboolean on_window_state_event(GtkWidget *widget, GdkEventWindowState *event, gpointer user_data) {
+    (void)widget;
+    AppWidgets *widgets = (AppWidgets *)user_data;
+    widgets->window_iconified = (event->new_window_state &
+                                 (GDK_WINDOW_STATE_ICONIFIED | GDK_WINDOW_STATE_WITHDRAWN)) != 0;
+    apply_window_visibility(widgets);
+    return FALSE;
+}
+
+// Fully covered by other windows (only reported by non-compositing X11 setups)
+static gboolean on_visibility_notify_event(GtkWidget *widget, GdkEventVisibility *event, gpointer user_data) {
+    (void)widget;
+    AppWidgets *widgets = (AppWidgets *)user_data;
+    widgets->window_obscured = (event->state == GDK_VISIBILITY_FULLY_OBSCURED);
+    apply_window_visibility(widgets);
+    return FALSE;
+}
+
+static gboolean on_window_map_event(GtkWidget *widget, GdkEvent *event, gpointer user_data) {
+    (void)widget;
+    (void)event;
+    AppWidgets *widgets = (AppWidgets *)user_data;
+    widgets->window_unmapped = FALSE;
+    apply_window_visibility(widgets);
+    return FALSE;
+}
+
+static gboolean on_window_unmap_event(GtkWidget *widget, GdkEvent *event, gpointer user_data) {
+    (void)widget;
+    (void)event;
+    AppWidgets *widgets = (AppWidgets *)user_data;
+    widgets->window_unmapped = TRUE;
+    apply_window_visibility(widgets);
+    return FALSE;
 }
 
 // ============================================================================
@@ -614,6 +1629,13 @@ AppWidgets* create_gui(void) {
         return NULL;
     }
     
+    // Instantanés des collecteurs: requis avant la création des lignes
+    widgets->metrics = metrics_create();
+    if (widgets->metrics == NULL) {
+        free(widgets);
+        return NULL;
+    }
+    
     // Initialiser les pointeurs réseau
     widgets->network_interfaces = NULL;
     widgets->network_interface_count = 0;
@@ -622,6 +1644,28 @@ AppWidgets* create_gui(void) {
     widgets->storages = NULL;
     widgets->storage_count = 0;
     widgets->physical_storages = NULL;
+    widgets->speed_test_control = NULL;
+    widgets->speed_curve_count = 0;
+    widgets->speed_curve_title[0] = '\0';
+    
+    // Hotplug inactif tant que init_hotplug_monitor() n'a pas réussi
+    widgets->hotplug_fd = -1;
+    widgets->hotplug_source_id = 0;
+    widgets->scheduler = NULL;
+    widgets->scheduler_source_id = 0;
+    widgets->display_collector_count = 0;
+    widgets->history_collector_id = -1;
+    widgets->background_interval_ms = BACKGROUND_INTERVAL_MS;
+    
+    // Fenêtre supposée visible jusqu'au premier événement contraire
+    widgets->window_iconified = FALSE;
+    widgets->window_obscured = FALSE;
+    widgets->window_unmapped = FALSE;
+    widgets->window_visible = TRUE;
+    
+    // Historique de la dernière minute (vide si l'allocation échoue: pas d'info-bulle)
+    history_init(&widgets->cpu_history, HISTORY_CAPACITY);
+    history_init(&widgets->memory_history, HISTORY_CAPACITY);
     
     // -------- FENÊTRE PRINCIPALE --------
     widgets->window = gtk_window_new(GTK_WINDOW_TOPLEVEL);  // [GTK] Créer fenêtre
@@ -633,6 +1677,14 @@ AppWidgets* create_gui(void) {
     // [GTK] Connecter événement fermeture
     g_signal_connect(widgets->window, "destroy", G_CALLBACK(gtk_main_quit), NULL);
     
+    // [GTK] Suivre la visibilité pour suspendre le rafraîchissement quand personne ne regarde
+    gtk_widget_add_events(widgets->window, GDK_VISIBILITY_NOTIFY_MASK | GDK_STRUCTURE_MASK);
+    g_signal_connect(widgets->window, "window-state-event", G_CALLBACK(on_window_state_event), widgets);
+    g_signal_connect(widgets->window, "visibility-notify-event",
+                     G_CALLBACK(on_visibility_notify_event), widgets);
+    g_signal_connect(widgets->window, "map-event", G_CALLBACK(on_window_map_event), widgets);
+    g_signal_connect(widgets->window, "unmap-event", G_CALLBACK(on_window_unmap_event), widgets);
+    
     // -------- CONTENEUR PRINCIPAL --------
     GtkWidget *main_vbox = gtk_box_new(GTK_ORIENTATION_VERTICAL, 10);  // [GTK] VBox principal
     gtk_container_add(GTK_CONTAINER(widgets->window), main_vbox);  // [GTK] Ajouter à fenêtre
@@ -758,6 +1810,9 @@ AppWidgets* create_gui(void) {
     widgets->cpu_usage_label = gtk_label_new("--%");  // [GTK]
     gtk_label_set_xalign(GTK_LABEL(widgets->cpu_usage_label), 1.0);  // [GTK]
     gtk_widget_set_hexpand(widgets->cpu_usage_label, TRUE);  // [GTK] Expansion horizontale
+    gtk_widget_set_has_tooltip(widgets->cpu_usage_label, TRUE);  // [GTK]
+    g_signal_connect(widgets->cpu_usage_label, "query-tooltip",
+                     G_CALLBACK(on_history_query_tooltip), &widgets->cpu_history);
     
     GtkWidget *gpu_usage_lbl = gtk_label_new("GPU Usage:");  // [GTK]
     gtk_label_set_xalign(GTK_LABEL(gpu_usage_lbl), 0.0);  // [GTK]
@@ -765,12 +1820,20 @@ AppWidgets* create_gui(void) {
     gtk_label_set_xalign(GTK_LABEL(widgets->gpu_usage_label), 1.0);  // [GTK]
     gtk_widget_set_hexpand(widgets->gpu_usage_label, TRUE);  // [GTK] Expansion horizontale
     
+    GtkWidget *cpu_cache_lbl = gtk_label_new("Cache:");  // [GTK]
+    gtk_label_set_xalign(GTK_LABEL(cpu_cache_lbl), 0.0);  // [GTK]
+    widgets->cpu_cache_label = gtk_label_new("Loading...");  // [GTK]
+    gtk_label_set_xalign(GTK_LABEL(widgets->cpu_cache_label), 1.0);  // [GTK]
+    gtk_widget_set_hexpand(widgets->cpu_cache_label, TRUE);  // [GTK] Expansion horizontale
+    
     gtk_grid_attach(GTK_GRID(cpu_grid), cpu_temp_lbl, 0, 0, 1, 1);  // [GTK] (col, row, width, height)
     gtk_grid_attach(GTK_GRID(cpu_grid), widgets->temp_label, 1, 0, 1, 1);  // [GTK]
     gtk_grid_attach(GTK_GRID(cpu_grid), cpu_usage_lbl, 0, 1, 1, 1);  // [GTK]
     gtk_grid_attach(GTK_GRID(cpu_grid), widgets->cpu_usage_label, 1, 1, 1, 1);  // [GTK]
     gtk_grid_attach(GTK_GRID(cpu_grid), gpu_usage_lbl, 0, 2, 1, 1);  // [GTK]
     gtk_grid_attach(GTK_GRID(cpu_grid), widgets->gpu_usage_label, 1, 2, 1, 1);  // [GTK]
+    gtk_grid_attach(GTK_GRID(cpu_grid), cpu_cache_lbl, 0, 3, 1, 1);  // [GTK]
+    gtk_grid_attach(GTK_GRID(cpu_grid), widgets->cpu_cache_label, 1, 3, 1, 1);  // [GTK]
     
     gtk_box_pack_start(GTK_BOX(row2_hbox), cpu_frame, TRUE, TRUE, 0);  // [GTK]
     
@@ -788,6 +1851,9 @@ AppWidgets* create_gui(void) {
     widgets->mem_usage_label = gtk_label_new("--%");  // [GTK]
     gtk_label_set_xalign(GTK_LABEL(widgets->mem_usage_label), 1.0);  // [GTK]
     gtk_widget_set_hexpand(widgets->mem_usage_label, TRUE);  // [GTK] Expansion horizontale
+    gtk_widget_set_has_tooltip(widgets->mem_usage_label, TRUE);  // [GTK]
+    g_signal_connect(widgets->mem_usage_label, "query-tooltip",
+                     G_CALLBACK(on_history_query_tooltip), &widgets->memory_history);
     
     GtkWidget *mem_available_lbl = gtk_label_new("Available:");  // [GTK]
     gtk_label_set_xalign(GTK_LABEL(mem_available_lbl), 0.0);  // [GTK]
@@ -801,12 +1867,66 @@ AppWidgets* create_gui(void) {
     gtk_label_set_xalign(GTK_LABEL(widgets->mem_total_label), 1.0);  // [GTK]
     gtk_widget_set_hexpand(widgets->mem_total_label, TRUE);  // [GTK] Expansion horizontale
     
+    GtkWidget *swap_lbl = gtk_label_new("Swap:");  // [GTK]
+    gtk_label_set_xalign(GTK_LABEL(swap_lbl), 0.0);  // [GTK]
+    widgets->swap_label = gtk_label_new("--");  // [GTK]
+    gtk_label_set_xalign(GTK_LABEL(widgets->swap_label), 1.0);  // [GTK]
+    gtk_widget_set_hexpand(widgets->swap_label, TRUE);  // [GTK] Expansion horizontale
+    gtk_widget_set_has_tooltip(widgets->swap_label, TRUE);  // [GTK]
+    g_signal_connect(widgets->swap_label, "query-tooltip",
+                     G_CALLBACK(on_swap_query_tooltip), widgets);
+    
+    GtkWidget *paging_lbl = gtk_label_new("Paging:");  // [GTK]
+    gtk_label_set_xalign(GTK_LABEL(paging_lbl), 0.0);  // [GTK]
+    widgets->paging_label = gtk_label_new("--");  // [GTK]
+    gtk_label_set_xalign(GTK_LABEL(widgets->paging_label), 1.0);  // [GTK]
+    gtk_widget_set_hexpand(widgets->paging_label, TRUE);  // [GTK] Expansion horizontale
+    
+    GtkWidget *swap_io_lbl = gtk_label_new("Swapping:");  // [GTK]
+    gtk_label_set_xalign(GTK_LABEL(swap_io_lbl), 0.0);  // [GTK]
+    widgets->swap_io_label = gtk_label_new("--");  // [GTK]
+    gtk_label_set_xalign(GTK_LABEL(widgets->swap_io_label), 1.0);  // [GTK]
+    gtk_widget_set_hexpand(widgets->swap_io_label, TRUE);  // [GTK] Expansion horizontale
+    
+    GtkWidget *faults_lbl = gtk_label_new("Major Faults:");  // [GTK]
+    gtk_label_set_xalign(GTK_LABEL(faults_lbl), 0.0);  // [GTK]
+    widgets->faults_label = gtk_label_new("--");  // [GTK]
+    gtk_label_set_xalign(GTK_LABEL(widgets->faults_label), 1.0);  // [GTK]
+    gtk_widget_set_hexpand(widgets->faults_label, TRUE);  // [GTK] Expansion horizontale
+    
+    GtkWidget *oom_lbl = gtk_label_new("OOM Kills:");  // [GTK]
+    gtk_label_set_xalign(GTK_LABEL(oom_lbl), 0.0);  // [GTK]
+    widgets->oom_label = gtk_label_new("--");  // [GTK]
+    gtk_label_set_xalign(GTK_LABEL(widgets->oom_label), 1.0);  // [GTK]
+    gtk_widget_set_hexpand(widgets->oom_label, TRUE);  // [GTK] Expansion horizontale
+    
+    // Une ligne par nœud NUMA (une seule sans NUMA); info-bulle: CPU de chaque nœud
+    GtkWidget *numa_lbl = gtk_label_new("NUMA Nodes:");  // [GTK]
+    gtk_label_set_xalign(GTK_LABEL(numa_lbl), 0.0);  // [GTK]
+    gtk_widget_set_valign(numa_lbl, GTK_ALIGN_START);  // [GTK]
+    widgets->numa_label = gtk_label_new("--");  // [GTK]
+    gtk_label_set_xalign(GTK_LABEL(widgets->numa_label), 1.0);  // [GTK]
+    gtk_label_set_justify(GTK_LABEL(widgets->numa_label), GTK_JUSTIFY_RIGHT);  // [GTK]
+    gtk_widget_set_hexpand(widgets->numa_label, TRUE);  // [GTK] Expansion horizontale
+    
     gtk_grid_attach(GTK_GRID(mem_grid), mem_usage_lbl, 0, 0, 1, 1);  // [GTK]
     gtk_grid_attach(GTK_GRID(mem_grid), widgets->mem_usage_label, 1, 0, 1, 1);  // [GTK]
     gtk_grid_attach(GTK_GRID(mem_grid), mem_available_lbl, 0, 1, 1, 1);  // [GTK]
     gtk_grid_attach(GTK_GRID(mem_grid), widgets->mem_available_label, 1, 1, 1, 1);  // [GTK]
     gtk_grid_attach(GTK_GRID(mem_grid), mem_total_lbl, 0, 2, 1, 1);  // [GTK]
     gtk_grid_attach(GTK_GRID(mem_grid), widgets->mem_total_label, 1, 2, 1, 1);  // [GTK]
+    gtk_grid_attach(GTK_GRID(mem_grid), swap_lbl, 0, 3, 1, 1);  // [GTK]
+    gtk_grid_attach(GTK_GRID(mem_grid), widgets->swap_label, 1, 3, 1, 1);  // [GTK]
+    gtk_grid_attach(GTK_GRID(mem_grid), paging_lbl, 0, 4, 1, 1);  // [GTK]
+    gtk_grid_attach(GTK_GRID(mem_grid), widgets->paging_label, 1, 4, 1, 1);  // [GTK]
+    gtk_grid_attach(GTK_GRID(mem_grid), swap_io_lbl, 0, 5, 1, 1);  // [GTK]
+    gtk_grid_attach(GTK_GRID(mem_grid), widgets->swap_io_label, 1, 5, 1, 1);  // [GTK]
+    gtk_grid_attach(GTK_GRID(mem_grid), faults_lbl, 0, 6, 1, 1);  // [GTK]
+    gtk_grid_attach(GTK_GRID(mem_grid), widgets->faults_label, 1, 6, 1, 1);  // [GTK]
+    gtk_grid_attach(GTK_GRID(mem_grid), oom_lbl, 0, 7, 1, 1);  // [GTK]
+    gtk_grid_attach(GTK_GRID(mem_grid), widgets->oom_label, 1, 7, 1, 1);  // [GTK]
+    gtk_grid_attach(GTK_GRID(mem_grid), numa_lbl, 0, 8, 1, 1);  // [GTK]
+    gtk_grid_attach(GTK_GRID(mem_grid), widgets->numa_label, 1, 8, 1, 1);  // [GTK]
     
     gtk_box_pack_start(GTK_BOX(row2_hbox), mem_frame, TRUE, TRUE, 0);  // [GTK]
     
@@ -833,6 +1953,20 @@ AppWidgets* create_gui(void) {
     gtk_box_pack_start(GTK_BOX(hostname_hbox), widgets->network_hostname_label, FALSE, FALSE, 0);
     gtk_box_pack_start(GTK_BOX(net_main_vbox), hostname_hbox, FALSE, FALSE, 2);
     
+    // Connexions TCP (sock_diag): résumé sur une ligne, détail par état en info-bulle
+    GtkWidget *sockets_hbox = gtk_box_new(GTK_ORIENTATION_HORIZONTAL, 5);
+    gtk_widget_set_halign(sockets_hbox, GTK_ALIGN_CENTER);
+    
+    GtkWidget *net_sockets_lbl = gtk_label_new("Connections:");  // [GTK]
+    widgets->network_sockets_label = gtk_label_new("--");  // [GTK]
+    gtk_widget_set_has_tooltip(widgets->network_sockets_label, TRUE);  // [GTK]
+    g_signal_connect(widgets->network_sockets_label, "query-tooltip",
+                     G_CALLBACK(on_sockets_query_tooltip), widgets);
+    
+    gtk_box_pack_start(GTK_BOX(sockets_hbox), net_sockets_lbl, FALSE, FALSE, 0);
+    gtk_box_pack_start(GTK_BOX(sockets_hbox), widgets->network_sockets_label, FALSE, FALSE, 0);
+    gtk_box_pack_start(GTK_BOX(net_main_vbox), sockets_hbox, FALSE, FALSE, 2);
+    
     // Conteneur dynamique pour les interfaces (sera rempli dans update)
     widgets->network_vbox = gtk_box_new(GTK_ORIENTATION_VERTICAL, 3);  // [GTK]
     gtk_box_pack_start(GTK_BOX(net_main_vbox), widgets->network_vbox, TRUE, TRUE, 2);
@@ -847,6 +1981,14 @@ AppWidgets* create_gui(void) {
     
     gtk_box_pack_start(GTK_BOX(row3_vbox), disk_frame, TRUE, TRUE, 0);  // [GTK]
     
+    // --- Cadre SERVICES (cgroup v2) ---
+    GtkWidget *cgroup_frame = create_frame("Services (cgroups)");
+    GtkWidget *cgroup_vbox = create_cgroup_table(widgets);
+    gtk_container_set_border_width(GTK_CONTAINER(cgroup_vbox), 10);  // [GTK]
+    gtk_container_add(GTK_CONTAINER(cgroup_frame), cgroup_vbox);  // [GTK]
+    
+    gtk_box_pack_start(GTK_BOX(row3_vbox), cgroup_frame, TRUE, TRUE, 0);  // [GTK]
+    
     // ============ SECTION 4: BOUTONS ============
     GtkWidget *button_hbox = gtk_box_new(GTK_ORIENTATION_HORIZONTAL, 5);  // [GTK]
     gtk_box_pack_start(GTK_BOX(main_vbox), button_hbox, FALSE, FALSE, 5);  // [GTK]
@@ -864,94 +2006,735 @@ AppWidgets* create_gui(void) {
     // -------- FINALISATION --------
     gtk_widget_show_all(widgets->window);  // [GTK] Afficher tout
     
-    update_system_info_display(widgets);  // Lecture initiale System Info
     init_network_interfaces(widgets);     // Initialiser les interfaces réseau (une seule fois)
-    init_physical_storages(widgets);         // Initialiser les disques physiques (une seule fois)
+    init_storage_table(widgets);          // Boutons + tableau des disques (une seule fois)
+    init_physical_storages(widgets);      // Énumérer les disques physiques (et à chaque "Refresh")
+    init_hotplug_monitor(widgets);        // Ajouts/retraits de disques et d'interfaces à chaud
     update_all_displays(widgets);         // Lecture initiale données dynamiques
     
-    // [GTK] Timer: mise à jour toutes les 2 secondes
-    g_timeout_add(1000, update_all_callback, widgets);
+    // Collecteurs: chacun à sa fréquence (System Info une seule fois)
+    init_collectors(widgets);
     
     return widgets;
 }
 
-// Mettre à jour les débits réseau de chaque interface
-static void update_network_bandwidth(AppWidgets *widgets) {
+// Share of the negotiated line rate used by an interface (-1 if the link speed is unknown)
+// Full duplex: each direction has the whole line rate; half duplex: both share it
+static float get_line_rate_percent(const InterfaceSnapshot *iface) {
+    if (iface->link_speed_mbps <= 0) {
+        return -1.0f;
+    }
+    float line_kbps = (float)iface->link_speed_mbps * 1000000.0f / 8.0f / 1024.0f;  // Mb/s -> KB/s
+    float used_kbps = strcmp(iface->duplex, "half") == 0
+                      ? iface->upload_kbps + iface->download_kbps
+                      : (iface->upload_kbps > iface->download_kbps ? iface->upload_kbps : iface->download_kbps);
+    return used_kbps * 100.0f / line_kbps;
+}
+
+// WiFi link columns: "5180 MHz, 866.7 / 650.0 Mb/s, MCS 9" and "-52 / -95 dBm" (signal / noise)
+static void format_wireless_link(const WirelessLinkInfo *wifi, char *link, size_t link_size,
+                                 char *signal, size_t signal_size) {
+    if (!wifi->connected) {
+        snprintf(link, link_size, "Not associated");
+        snprintf(signal, signal_size, "--");
+        return;
+    }
+    
+    char mcs[16] = "";
+    if (wifi->tx_mcs >= 0) {
+        snprintf(mcs, sizeof(mcs), ", MCS %d", wifi->tx_mcs);
+    }
+    snprintf(link, link_size, "%d MHz, %.1f / %.1f Mb/s%s", wifi->frequency_mhz,
+             wifi->tx_bitrate_mbps, wifi->rx_bitrate_mbps, mcs);
+    
+    if (wifi->noise_dbm != 0) {
+        snprintf(signal, signal_size, "%d / %d dBm", wifi->signal_dbm, wifi->noise_dbm);
+    } else {
+        snprintf(signal, signal_size, "%d dBm", wifi->signal_dbm);
+    }
+}
+
+// Afficher débits et adresses IP de chaque interface (dernier instantané réseau)
+// Seules les lignes dont un texte change sont modifiées: un seul row-changed par interface
+static void update_network_display(AppWidgets *widgets) {
     if (widgets == NULL || widgets->network_interfaces == NULL) {
         return;
     }
     
-    char buffer[64];
+    static NetworkSnapshot snapshot;  // ~35 Ko: hors de la pile
+    metrics_read_network(widgets->metrics, &snapshot);
     
-    for (int i = 0; i < widgets->network_interface_count; i++) {
-        // Récupérer l'adresse IP
-        const char *ip = get_interface_ip_address(widgets->network_interfaces[i].interface_name);
-        gtk_label_set_text(GTK_LABEL(widgets->network_interfaces[i].ip_label), ip);
+    char upload[32], download[32], packets[32], errors[32], link[48], line_rate[16], signal[32];
+    
+    for (int s = 0; s < snapshot.interface_count; s++) {
+        const InterfaceSnapshot *iface = &snapshot.interfaces[s];
+        int i = find_network_interface_index(widgets, iface->name);
+        if (i < 0) {
+            continue;  // Row removed since the snapshot was published
+        }
+        NetworkInterfaceWidgets *entry = &widgets->network_interfaces[i];
         
-        // Récupérer les débits pour cette interface
-        float upload = get_interface_upload_kbps(widgets->network_interfaces[i].interface_name);
-        float download = get_interface_download_kbps(widgets->network_interfaces[i].interface_name);
+        snprintf(upload, sizeof(upload), "%.1f KB/s", iface->upload_kbps);
+        snprintf(download, sizeof(download), "%.1f KB/s", iface->download_kbps);
         
-        // Formater et afficher les débits
-        snprintf(buffer, sizeof(buffer), "%.1f KB/s", upload);
-        gtk_label_set_text(GTK_LABEL(widgets->network_interfaces[i].upload_label), buffer);
+        const InterfacePacketRates *rates = &iface->packets;
+        float errors_rate = rates->tx_errors_per_sec + rates->rx_errors_per_sec +
+                            rates->tx_drops_per_sec + rates->rx_drops_per_sec;
+        snprintf(packets, sizeof(packets), "%.0f / %.0f", rates->tx_packets_per_sec, rates->rx_packets_per_sec);
+        snprintf(errors, sizeof(errors), "%.0f / %.0f",
+                 rates->tx_errors_per_sec + rates->tx_drops_per_sec,
+                 rates->rx_errors_per_sec + rates->rx_drops_per_sec);
         
-        snprintf(buffer, sizeof(buffer), "%.1f KB/s", download);
-        gtk_label_set_text(GTK_LABEL(widgets->network_interfaces[i].download_label), buffer);
+        float line_rate_percent = get_line_rate_percent(iface);
+        float link_sort_mbps = (float)iface->link_speed_mbps;
+        float signal_sort_dbm = -200.0f;  // Non-WiFi rows sort below any real signal
+        if (iface->link_speed_mbps > 0) {
+            snprintf(link, sizeof(link), "%d Mb/s %s", iface->link_speed_mbps, iface->duplex);
+            snprintf(line_rate, sizeof(line_rate), "%.1f%%", line_rate_percent);
+        } else {
+            snprintf(link, sizeof(link), "--");
+            snprintf(line_rate, sizeof(line_rate), "--");
+        }
+        snprintf(signal, sizeof(signal), "--");
+        if (iface->wireless) {
+            format_wireless_link(&iface->wifi, link, sizeof(link), signal, sizeof(signal));
+            link_sort_mbps = iface->wifi.tx_bitrate_mbps;
+            if (iface->wifi.connected) {
+                signal_sort_dbm = (float)iface->wifi.signal_dbm;
+            }
+        }
+        
+        // Losing packets or close to line rate: same red/orange as the temperature scale
+        const char *background = NULL;
+        if (errors_rate > 0.0f) {
+            background = "#FF0000";
+        } else if (line_rate_percent >= NETWORK_SATURATION_PERCENT) {
+            background = "#FFA500";
+        }
+        
+        if (strcmp(entry->address, iface->address) == 0 &&
+            strcmp(entry->upload_text, upload) == 0 &&
+            strcmp(entry->download_text, download) == 0 &&
+            strcmp(entry->packets_text, packets) == 0 &&
+            strcmp(entry->errors_text, errors) == 0 &&
+            strcmp(entry->link_text, link) == 0 &&
+            strcmp(entry->line_rate_text, line_rate) == 0 &&
+            strcmp(entry->signal_text, signal) == 0 &&
+            entry->background == background) {
+            continue;
+        }
+        
+        GtkTreeIter iter;
+        if (!get_row_iter(widgets->network_store, entry->row, &iter)) {
+            continue;
+        }
+        snprintf(entry->address, sizeof(entry->address), "%s", iface->address);
+        snprintf(entry->upload_text, sizeof(entry->upload_text), "%s", upload);
+        snprintf(entry->download_text, sizeof(entry->download_text), "%s", download);
+        snprintf(entry->packets_text, sizeof(entry->packets_text), "%s", packets);
+        snprintf(entry->errors_text, sizeof(entry->errors_text), "%s", errors);
+        snprintf(entry->link_text, sizeof(entry->link_text), "%s", link);
+        snprintf(entry->line_rate_text, sizeof(entry->line_rate_text), "%s", line_rate);
+        snprintf(entry->signal_text, sizeof(entry->signal_text), "%s", signal);
+        entry->background = background;
+        gtk_list_store_set(widgets->network_store, &iter,
+                           NET_COL_ADDRESS, entry->address,
+                           NET_COL_UPLOAD_TEXT, entry->upload_text,
+                           NET_COL_UPLOAD_KBPS, iface->upload_kbps,
+                           NET_COL_DOWNLOAD_TEXT, entry->download_text,
+                           NET_COL_DOWNLOAD_KBPS, iface->download_kbps,
+                           NET_COL_PACKETS_TEXT, entry->packets_text,
+                           NET_COL_PACKETS_RATE, rates->tx_packets_per_sec + rates->rx_packets_per_sec,
+                           NET_COL_ERRORS_TEXT, entry->errors_text,
+                           NET_COL_ERRORS_RATE, errors_rate,
+                           NET_COL_LINK_TEXT, entry->link_text,
+                           NET_COL_LINK_MBPS, link_sort_mbps,
+                           NET_COL_LINE_RATE_TEXT, entry->line_rate_text,
+                           NET_COL_LINE_RATE_PERCENT, line_rate_percent,
+                           NET_COL_SIGNAL_TEXT, entry->signal_text,
+                           NET_COL_SIGNAL_DBM, signal_sort_dbm,
+                           NET_COL_BACKGROUND, entry->background,
+                           -1);
     }
 }
 
-// Mettre à jour uniquement la section System Info
-void update_system_info_display(AppWidgets *widgets) {
-    if (widgets == NULL) {
+// Afficher la charge CPU et mémoire de chaque nœud NUMA (un déséquilibre saute aux yeux)
+static void update_numa_display(AppWidgets *widgets) {
+    static NumaSnapshot snapshot;  // ~2 Ko: hors de la pile
+    metrics_read_numa(widgets->metrics, &snapshot);
+    
+    if (snapshot.node_count == 0) {
+        set_label_text(widgets->numa_label, "N/A");
         return;
     }
     
-    char buffer[256];
+    char text[1024];
+    size_t used = 0;
+    for (int i = 0; i < snapshot.node_count; i++) {
+        const NumaNodeUsage *node = &snapshot.nodes[i];
+        float total_gb = (float)node->memory_total_kb / (1024.0f * 1024.0f);
+        float used_gb = (float)node->memory_used_kb / (1024.0f * 1024.0f);
+        int written = snprintf(text + used, sizeof(text) - used, "%sNode %d: CPU %.0f%% · %.1f / %.1f GB",
+                               i > 0 ? "\n" : "", node->id, node->cpu_percent, used_gb, total_gb);
+        if (written < 0 || (size_t)written >= sizeof(text) - used) {
+            break;
+        }
+        used += (size_t)written;
+    }
+    set_label_text(widgets->numa_label, text);
+}
+
+// Texte d'une ligne du tableau des cgroups (comparé d'une mesure à l'autre)
+typedef struct {
+    char name[CGROUP_PATH_MAX];
+    char cpu[16];
+    char memory[16];
+    char pressure[16];
+    char read[24];
+    char write[24];
+} CgroupRowText;
+
+// Afficher les cgroups les plus consommateurs
+// Un cgroup qui reste dans le classement garde sa ligne, mise à jour sur place (le
+// défilement ne saute pas): seules les lignes dont un texte change sont modifiées
+static void update_cgroup_display(AppWidgets *widgets) {
+    static CgroupSnapshot snapshot;
+    static CgroupRowText shown[METRICS_TOP_CGROUPS];
+    static TableRowSlot shown_rows[METRICS_TOP_CGROUPS];
+    static TableRowSlot next_rows[METRICS_TOP_CGROUPS];
+    static int shown_count = 0;
+    
+    metrics_read_cgroups(widgets->metrics, &snapshot);
+    
+    char status[64];
+    if (!snapshot.available) {
+        snprintf(status, sizeof(status), "cgroup v2 not available");
+    } else {
+        snprintf(status, sizeof(status), "Top %d of %d cgroups by CPU", snapshot.top_count, snapshot.cgroup_count);
+    }
+    set_label_text(widgets->cgroup_status_label, status);
+    
+    CgroupRowText rows[METRICS_TOP_CGROUPS];
+    memset(rows, 0, sizeof(rows));
+    for (int i = 0; i < snapshot.top_count; i++) {
+        const CgroupUsage *usage = &snapshot.top[i];
+        snprintf(rows[i].name, sizeof(rows[i].name), "%s", usage->path);
+        snprintf(rows[i].cpu, sizeof(rows[i].cpu), "%.1f%%", usage->cpu_percent);
+        format_storage_size(rows[i].memory, sizeof(rows[i].memory),
+                            (float)usage->memory_bytes / (1024.0f * 1024.0f * 1024.0f));
+        snprintf(rows[i].pressure, sizeof(rows[i].pressure), "%.2f%%", usage->memory_pressure);
+        snprintf(rows[i].read, sizeof(rows[i].read), "%.1f KB/s", usage->io_read_kbps);
+        snprintf(rows[i].write, sizeof(rows[i].write), "%.1f KB/s", usage->io_write_kbps);
+    }
     
-    // Hardware Info (colonne 1)
-    snprintf(buffer, sizeof(buffer), "%s", get_hardware_model());
-    gtk_label_set_text(GTK_LABEL(widgets->hardware_label), buffer);  // [GTK]
+    for (int i = 0; i < snapshot.top_count; i++) {
+        const CgroupUsage *usage = &snapshot.top[i];
+        GtkTreeIter iter;
+        int previous = claim_table_row(widgets->cgroup_store, shown_rows, shown_count, rows[i].name,
+                                       &next_rows[i], &iter);
+        if (previous >= 0 && memcmp(&shown[previous], &rows[i], sizeof(CgroupRowText)) == 0) {
+            continue;
+        }
+        gtk_list_store_set(widgets->cgroup_store, &iter,
+                           CGROUP_COL_NAME, rows[i].name,
+                           CGROUP_COL_CPU_TEXT, rows[i].cpu,
+                           CGROUP_COL_CPU_PERCENT, usage->cpu_percent,
+                           CGROUP_COL_MEMORY_TEXT, rows[i].memory,
+                           CGROUP_COL_MEMORY_MB, (float)usage->memory_bytes / (1024.0f * 1024.0f),
+                           CGROUP_COL_PRESSURE_TEXT, rows[i].pressure,
+                           CGROUP_COL_PRESSURE_PERCENT, usage->memory_pressure,
+                           CGROUP_COL_READ_TEXT, rows[i].read,
+                           CGROUP_COL_READ_KBPS, usage->io_read_kbps,
+                           CGROUP_COL_WRITE_TEXT, rows[i].write,
+                           CGROUP_COL_WRITE_KBPS, usage->io_write_kbps,
+                           -1);
+    }
+    release_table_rows(widgets->cgroup_store, shown_rows, shown_count);
+    memcpy(shown_rows, next_rows, sizeof(next_rows));
+    memcpy(shown, rows, sizeof(rows));
+    shown_count = snapshot.top_count;
+}
+
+// "850 KB/s" below 1 MB/s, "118.4 MB/s" above (disk rates span four orders of magnitude)
+static void format_io_rate(char *buffer, size_t buffer_size, float kbps) {
+    if (kbps < 1024.0f) {
+        snprintf(buffer, buffer_size, "%.0f KB/s", kbps);
+    } else {
+        snprintf(buffer, buffer_size, "%.1f MB/s", kbps / 1024.0f);
+    }
+}
+
+// Texte d'une ligne du tableau des volumes (comparé d'une mesure à l'autre)
+typedef struct {
+    char name[112];
+    char type[16];
+    char members[160];
+    char size[16];
+    char state[64];
+    char read[24];
+    char write[24];
+    char member_io[24];
+    char tooltip[1024];
+    const char *background;
+} VolumeRowText;
+
+// "resync 25.0% · 115.6 MB/s", "degraded (1 of 2 missing)", "clean"
+static void format_volume_state(const LogicalVolume *volume, char *buffer, size_t buffer_size) {
+    if (is_volume_syncing(volume)) {
+        char speed[24];
+        format_io_rate(speed, sizeof(speed), volume->sync_kbps);
+        if (volume->sync_fraction >= 0.0f) {
+            snprintf(buffer, buffer_size, "%s %.1f%% · %s", volume->sync_action,
+                     volume->sync_fraction * 100.0f, speed);
+        } else {
+            snprintf(buffer, buffer_size, "%s · %s", volume->sync_action, speed);
+        }
+    } else if (volume->degraded > 0) {
+        snprintf(buffer, buffer_size, "degraded (%d of %d missing)", volume->degraded, volume->raid_disks);
+    } else {
+        snprintf(buffer, buffer_size, "%s", volume->array_state[0] != '\0' ? volume->array_state : "--");
+    }
+}
+
+// Member-by-member detail: which disk carries the volume and how busy it is
+static void format_volume_tooltip(const LogicalVolume *volume, char *buffer, size_t buffer_size) {
+    GString *tooltip = g_string_new(NULL);
+    char read[24];
+    char write[24];
+    format_io_rate(read, sizeof(read), volume->io.read_kbps);
+    format_io_rate(write, sizeof(write), volume->io.write_kbps);
+    g_string_append_printf(tooltip, "Volume: read %s (%.0f IOPS) · write %s (%.0f IOPS)",
+                           read, volume->io.read_iops, write, volume->io.write_iops);
+    
+    for (int i = 0; i < volume->member_count; i++) {
+        const VolumeMember *member = &volume->members[i];
+        format_io_rate(read, sizeof(read), member->io.read_kbps);
+        format_io_rate(write, sizeof(write), member->io.write_kbps);
+        g_string_append_printf(tooltip, "\n%s on %s%s%s: read %s · write %s", member->member.device,
+                               member->member.disk, member->state[0] != '\0' ? " · " : "", member->state,
+                               read, write);
+    }
+    if (volume->kind == VOLUME_MD && volume->degraded > 0) {
+        g_string_append_printf(tooltip, "\n%d of %d members missing: no redundancy left if another fails",
+                               volume->degraded, volume->raid_disks);
+    }
+    if (is_volume_syncing(volume)) {
+        g_string_append(tooltip, "\nMembers also carry the synchronisation: the volume's own throughput "
+                                 "is reduced until it completes");
+    }
+    snprintf(buffer, buffer_size, "%s", tooltip->str);
+    g_string_free(tooltip, TRUE);
+}
+
+// Afficher les grappes md et volumes dm, reliés aux disques qui les portent
+// Chaque volume garde sa ligne, mise à jour sur place (tri et défilement conservés):
+// seules celles dont un texte change sont modifiées
+static void update_volume_display(AppWidgets *widgets) {
+    static VolumeSnapshot snapshot;  // ~30 Ko: hors de la pile
+    static VolumeRowText shown[METRICS_MAX_VOLUMES];
+    static VolumeRowText rows[METRICS_MAX_VOLUMES];
+    static TableRowSlot shown_rows[METRICS_MAX_VOLUMES];
+    static TableRowSlot next_rows[METRICS_MAX_VOLUMES];
+    static int shown_count = 0;
+    
+    metrics_read_volumes(widgets->metrics, &snapshot);
+    gtk_widget_set_visible(widgets->volume_box, snapshot.volume_count > 0);
+    
+    memset(rows, 0, sizeof(rows));
+    for (int i = 0; i < snapshot.volume_count; i++) {
+        const LogicalVolume *volume = &snapshot.volumes[i];
+        VolumeRowText *row = &rows[i];
+        if (volume->label[0] != '\0') {
+            snprintf(row->name, sizeof(row->name), "%s (%s)", volume->label, volume->name);
+        } else {
+            snprintf(row->name, sizeof(row->name), "%s", volume->name);
+        }
+        snprintf(row->type, sizeof(row->type), "%s", volume->type);
+        
+        size_t used = 0;
+        for (int m = 0; m < volume->member_count && used < sizeof(row->members); m++) {
+            int written = snprintf(row->members + used, sizeof(row->members) - used, "%s%s",
+                                   m > 0 ? ", " : "", volume->members[m].member.device);
+            used += written > 0 ? (size_t)written : 0;
+        }
+        if (volume->member_count == 0) {
+            snprintf(row->members, sizeof(row->members), "--");
+        }
+        
+        format_storage_size(row->size, sizeof(row->size), (float)((double)volume->size_bytes / 1e9));
+        format_volume_state(volume, row->state, sizeof(row->state));
+        format_io_rate(row->read, sizeof(row->read), volume->io.read_kbps);
+        format_io_rate(row->write, sizeof(row->write), volume->io.write_kbps);
+        format_io_rate(row->member_io, sizeof(row->member_io),
+                       volume->member_io.read_kbps + volume->member_io.write_kbps);
+        format_volume_tooltip(volume, row->tooltip, sizeof(row->tooltip));
+        // Red: redundancy lost; orange: resync / rebuild eating the members' bandwidth
+        if (volume->degraded > 0) {
+            row->background = "#FF0000";
+        } else if (is_volume_syncing(volume)) {
+            row->background = "#FFA500";
+        }
+    }
     
-    snprintf(buffer, sizeof(buffer), "%s", get_processor_type());
-    gtk_label_set_text(GTK_LABEL(widgets->processor_label), buffer);  // [GTK]
+    for (int i = 0; i < snapshot.volume_count; i++) {
+        const LogicalVolume *volume = &snapshot.volumes[i];
+        GtkTreeIter iter;
+        int previous = claim_table_row(widgets->volume_store, shown_rows, shown_count, volume->name,
+                                       &next_rows[i], &iter);
+        if (previous >= 0 && memcmp(&shown[previous], &rows[i], sizeof(VolumeRowText)) == 0) {
+            continue;
+        }
+        gtk_list_store_set(widgets->volume_store, &iter,
+                           VOLUME_COL_NAME, rows[i].name,
+                           VOLUME_COL_TYPE, rows[i].type,
+                           VOLUME_COL_MEMBERS, rows[i].members,
+                           VOLUME_COL_SIZE_TEXT, rows[i].size,
+                           VOLUME_COL_SIZE_GB, (float)((double)volume->size_bytes / 1e9),
+                           VOLUME_COL_STATE, rows[i].state,
+                           VOLUME_COL_READ_TEXT, rows[i].read,
+                           VOLUME_COL_READ_KBPS, volume->io.read_kbps,
+                           VOLUME_COL_WRITE_TEXT, rows[i].write,
+                           VOLUME_COL_WRITE_KBPS, volume->io.write_kbps,
+                           VOLUME_COL_MEMBER_IO_TEXT, rows[i].member_io,
+                           VOLUME_COL_MEMBER_IO_KBPS, volume->member_io.read_kbps + volume->member_io.write_kbps,
+                           VOLUME_COL_TOOLTIP, rows[i].tooltip,
+                           VOLUME_COL_BACKGROUND, rows[i].background,
+                           -1);
+    }
+    release_table_rows(widgets->volume_store, shown_rows, shown_count);
+    memcpy(shown_rows, next_rows, sizeof(next_rows));
+    memcpy(shown, rows, sizeof(rows));
+    shown_count = snapshot.volume_count;
+}
+
+// "+1.2 GB/h", "-350 MB/h", "stable" (under 1 MB/h), "--" while the history is too short
+static void format_filesystem_growth(const FilesystemUsage *filesystem, char *buffer, size_t buffer_size) {
+    float growth_gb = filesystem->growth_bytes_per_hour / (1024.0f * 1024.0f * 1024.0f);
+    if (!filesystem->growth_known) {
+        snprintf(buffer, buffer_size, "--");
+    } else if (fabsf(growth_gb) * 1024.0f < 1.0f) {
+        snprintf(buffer, buffer_size, "stable");
+    } else {
+        char size[16];
+        format_storage_size(size, sizeof(size), fabsf(growth_gb));
+        snprintf(buffer, buffer_size, "%s%s/h", growth_gb > 0.0f ? "+" : "-", size);
+    }
+}
+
+// "full", "45 min", "6.5 h", "12 days", "> 1 year"; "--" when usage is not growing
+static void format_fill_time(double seconds, char *buffer, size_t buffer_size) {
+    if (seconds < 0.0) {
+        snprintf(buffer, buffer_size, "--");
+    } else if (seconds < 60.0) {
+        snprintf(buffer, buffer_size, "full");
+    } else if (seconds < 3600.0) {
+        snprintf(buffer, buffer_size, "%.0f min", seconds / 60.0);
+    } else if (seconds < 48 * 3600.0) {
+        snprintf(buffer, buffer_size, "%.1f h", seconds / 3600.0);
+    } else if (seconds < 365 * 86400.0) {
+        snprintf(buffer, buffer_size, "%.0f days", seconds / 86400.0);
+    } else {
+        snprintf(buffer, buffer_size, "> 1 year");
+    }
+}
+
+// Texte d'une ligne du tableau des systèmes de fichiers (comparé d'une mesure à l'autre)
+typedef struct {
+    char device[128];
+    char type[32];
+    char used[16];
+    char available[16];
+    char usage[16];
+    char inodes[16];
+    char growth[24];
+    char full[16];
+    char tooltip[768];
+    const char *background;
+} FilesystemRowText;
+
+// Where the filesystem lives, its inode table and how the trend was obtained
+static void format_filesystem_tooltip(const FilesystemUsage *filesystem, char *buffer, size_t buffer_size) {
+    const MountEntry *mount = &filesystem->mount;
+    GString *tooltip = g_string_new(NULL);
+    g_string_append_printf(tooltip, "%s (%s)", mount->source, mount->device);
+    for (int i = 0; i < mount->disk_count; i++) {
+        g_string_append_printf(tooltip, "%s%s", i == 0 ? " on " : ", ", mount->disks[i]);
+    }
+    if (!filesystem->valid) {
+        g_string_append(tooltip, "\nstatvfs() failed: usage unknown");
+        snprintf(buffer, buffer_size, "%s", tooltip->str);
+        g_string_free(tooltip, TRUE);
+        return;
+    }
     
-    snprintf(buffer, sizeof(buffer), "%s", get_architecture_info());
-    gtk_label_set_text(GTK_LABEL(widgets->architecture_label), buffer);  // [GTK]
+    char total[16];
+    format_storage_size(total, sizeof(total),
+                        (float)((double)filesystem->total_bytes / (1024.0 * 1024.0 * 1024.0)));
+    g_string_append_printf(tooltip, "\n%s %s%s", total, mount->fstype, mount->read_only ? ", read-only" : "");
+    if (filesystem->total_inodes > 0) {
+        g_string_append_printf(tooltip, "\nInodes: %llu used of %llu (%llu available)",
+                               (unsigned long long)filesystem->used_inodes,
+                               (unsigned long long)filesystem->total_inodes,
+                               (unsigned long long)filesystem->available_inodes);
+    } else {
+        g_string_append(tooltip, "\nNo fixed inode table (files limited by space only)");
+    }
+    // Fixed wording: the rolling history length would change the row every statvfs()
+    if (filesystem->growth_known) {
+        g_string_append_printf(tooltip, "\nGrowth: trend over up to the last %d min (one statvfs() every %d s)",
+                               FILESYSTEM_GROWTH_WINDOW_SECONDS / 60, FILESYSTEM_STAT_INTERVAL_SECONDS);
+    } else {
+        g_string_append_printf(tooltip, "\nGrowth: collecting history (needs %d min)",
+                               FILESYSTEM_GROWTH_MIN_SECONDS / 60);
+    }
+    snprintf(buffer, buffer_size, "%s", tooltip->str);
+    g_string_free(tooltip, TRUE);
+}
+
+// Red: nearly full (space or inodes) or full within a day; orange: getting there
+static const char* get_filesystem_background(const FilesystemUsage *filesystem) {
+    if (!filesystem->valid) {
+        return NULL;
+    }
+    double full_hours = filesystem->seconds_until_full / 3600.0;
+    bool filling = filesystem->seconds_until_full >= 0.0;
+    if (filesystem->usage_percent >= FILESYSTEM_ALERT_PERCENT ||
+        filesystem->inode_percent >= FILESYSTEM_ALERT_PERCENT ||
+        (filling && full_hours < FILESYSTEM_ALERT_HOURS)) {
+        return "#FF0000";
+    }
+    if (filesystem->usage_percent >= FILESYSTEM_WARNING_PERCENT ||
+        filesystem->inode_percent >= FILESYSTEM_WARNING_PERCENT ||
+        (filling && full_hours < FILESYSTEM_WARNING_HOURS)) {
+        return "#FFA500";
+    }
+    return NULL;
+}
+
+// Afficher chaque système de fichiers monté avec sa croissance et le temps avant saturation
+// Chaque point de montage garde sa ligne: seules celles dont un texte change sont modifiées
+static void update_filesystem_display(AppWidgets *widgets) {
+    static FilesystemSnapshot snapshot;  // ~50 Ko: hors de la pile
+    static FilesystemRowText shown[METRICS_MAX_FILESYSTEMS];
+    static FilesystemRowText rows[METRICS_MAX_FILESYSTEMS];
+    static TableRowSlot shown_rows[METRICS_MAX_FILESYSTEMS];
+    static TableRowSlot next_rows[METRICS_MAX_FILESYSTEMS];
+    static int shown_count = 0;
+    const float gib = 1024.0f * 1024.0f * 1024.0f;
+    
+    metrics_read_filesystems(widgets->metrics, &snapshot);
+    
+    memset(rows, 0, sizeof(rows));
+    for (int i = 0; i < snapshot.filesystem_count; i++) {
+        const FilesystemUsage *filesystem = &snapshot.filesystems[i];
+        FilesystemRowText *row = &rows[i];
+        // "/dev/mapper/vg-root" says more than "dm-1"; btrfs and others may have no /dev source
+        snprintf(row->device, sizeof(row->device), "%s",
+                 strncmp(filesystem->mount.source, "/dev/", 5) == 0 ? filesystem->mount.source
+                                                                    : filesystem->mount.device);
+        snprintf(row->type, sizeof(row->type), "%s", filesystem->mount.fstype);
+        format_filesystem_tooltip(filesystem, row->tooltip, sizeof(row->tooltip));
+        if (!filesystem->valid) {
+            snprintf(row->used, sizeof(row->used), "--");
+            snprintf(row->available, sizeof(row->available), "--");
+            snprintf(row->usage, sizeof(row->usage), "--");
+            snprintf(row->inodes, sizeof(row->inodes), "--");
+            snprintf(row->growth, sizeof(row->growth), "--");
+            snprintf(row->full, sizeof(row->full), "--");
+            continue;
+        }
+        
+        format_storage_size(row->used, sizeof(row->used), (float)filesystem->used_bytes / gib);
+        format_storage_size(row->available, sizeof(row->available), (float)filesystem->available_bytes / gib);
+        snprintf(row->usage, sizeof(row->usage), "%.1f%%", filesystem->usage_percent);
+        if (filesystem->inode_percent >= 0.0f) {
+            snprintf(row->inodes, sizeof(row->inodes), "%.1f%%", filesystem->inode_percent);
+        } else {
+            snprintf(row->inodes, sizeof(row->inodes), "--");
+        }
+        format_filesystem_growth(filesystem, row->growth, sizeof(row->growth));
+        format_fill_time(filesystem->seconds_until_full, row->full, sizeof(row->full));
+        row->background = get_filesystem_background(filesystem);
+    }
     
-    snprintf(buffer, sizeof(buffer), "%s", get_cpu_cores());
-    gtk_label_set_text(GTK_LABEL(widgets->cpu_cores_label), buffer);  // [GTK]
+    for (int i = 0; i < snapshot.filesystem_count; i++) {
+        const FilesystemUsage *filesystem = &snapshot.filesystems[i];
+        GtkTreeIter iter;
+        int previous = claim_table_row(widgets->filesystem_store, shown_rows, shown_count,
+                                       filesystem->mount.mount_point, &next_rows[i], &iter);
+        if (previous >= 0 && memcmp(&shown[previous], &rows[i], sizeof(FilesystemRowText)) == 0) {
+            continue;
+        }
+        // Not growing (or unknown) sorts after every filesystem that will fill up
+        float full_hours = filesystem->seconds_until_full >= 0.0
+            ? (float)(filesystem->seconds_until_full / 3600.0) : FLT_MAX;
+        gtk_list_store_set(widgets->filesystem_store, &iter,
+                           FILESYSTEM_COL_MOUNT, filesystem->mount.mount_point,
+                           FILESYSTEM_COL_DEVICE, rows[i].device,
+                           FILESYSTEM_COL_TYPE, rows[i].type,
+                           FILESYSTEM_COL_USED_TEXT, rows[i].used,
+                           FILESYSTEM_COL_USED_GB, (float)filesystem->used_bytes / gib,
+                           FILESYSTEM_COL_AVAILABLE_TEXT, rows[i].available,
+                           FILESYSTEM_COL_AVAILABLE_GB, (float)filesystem->available_bytes / gib,
+                           FILESYSTEM_COL_USAGE_TEXT, rows[i].usage,
+                           FILESYSTEM_COL_USAGE_PERCENT, filesystem->usage_percent,
+                           FILESYSTEM_COL_INODES_TEXT, rows[i].inodes,
+                           FILESYSTEM_COL_INODES_PERCENT, filesystem->inode_percent,
+                           FILESYSTEM_COL_GROWTH_TEXT, rows[i].growth,
+                           FILESYSTEM_COL_GROWTH_GB_PER_HOUR, filesystem->growth_bytes_per_hour / gib,
+                           FILESYSTEM_COL_FULL_TEXT, rows[i].full,
+                           FILESYSTEM_COL_FULL_HOURS, full_hours,
+                           FILESYSTEM_COL_TOOLTIP, rows[i].tooltip,
+                           FILESYSTEM_COL_BACKGROUND, rows[i].background,
+                           -1);
+    }
+    release_table_rows(widgets->filesystem_store, shown_rows, shown_count);
+    memcpy(shown_rows, next_rows, sizeof(next_rows));
+    memcpy(shown, rows, sizeof(rows));
+    shown_count = snapshot.filesystem_count;
+}
+
+// Afficher le résumé des connexions TCP
+static void update_sockets_display(AppWidgets *widgets) {
+    SocketSnapshot sockets;
+    metrics_read_sockets(widgets->metrics, &sockets);
     
-    snprintf(buffer, sizeof(buffer), "%s", get_gpu_info());
-    gtk_label_set_text(GTK_LABEL(widgets->gpu_label), buffer);  // [GTK]
+    char buffer[256];
+    if (!sockets.tcp_available) {
+        set_label_text(widgets->network_sockets_label, "N/A");
+        return;
+    }
     
-    // Software Info (colonne 2)
-    snprintf(buffer, sizeof(buffer), "%s", get_kernel_version());
-    gtk_label_set_text(GTK_LABEL(widgets->kernel_label), buffer);  // [GTK]
+    snprintf(buffer, sizeof(buffer), "%u established, %u time-wait, %u listening  |  RTT %.1f ms avg, %.1f ms max  |  %.1f retrans/s",
+             sockets.tcp.established, sockets.tcp.time_wait, sockets.tcp.listening,
+             sockets.tcp.rtt_avg_ms, sockets.tcp.rtt_max_ms, sockets.counters.tcp_retrans_segs);
+    set_label_text(widgets->network_sockets_label, buffer);
+}
+
+// Détail des connexions au survol: sockets par état et débits d'erreurs TCP/UDP
+static gboolean on_sockets_query_tooltip(GtkWidget *widget, gint x, gint y, gboolean keyboard_mode,
+                                         GtkTooltip *tooltip, gpointer user_data) {
+    (void)widget;
+    (void)x;
+    (void)y;
+    (void)keyboard_mode;
+    AppWidgets *widgets = (AppWidgets *)user_data;
     
-    snprintf(buffer, sizeof(buffer), "%s", get_distro_info());
-    gtk_label_set_text(GTK_LABEL(widgets->distro_label), buffer);  // [GTK]
+    SocketSnapshot sockets;
+    if (metrics_read_sockets(widgets->metrics, &sockets) == 0 || !sockets.tcp_available) {
+        return FALSE;
+    }
     
-    snprintf(buffer, sizeof(buffer), "%s", get_desktop_environment());
-    gtk_label_set_text(GTK_LABEL(widgets->display_label), buffer);  // [GTK]
+    GString *text = g_string_new(NULL);
+    g_string_append_printf(text, "TCP sockets: %u (%u retransmitting)", sockets.tcp.total,
+                           sockets.tcp.retransmitting);
+    for (int state = 1; state < TCP_STATE_SLOTS; state++) {
+        if (sockets.tcp.states[state] > 0) {
+            g_string_append_printf(text, "\n  %s: %u", get_tcp_state_name(state), sockets.tcp.states[state]);
+        }
+    }
+    if (sockets.counters_available) {
+        const ProtocolCounterRates *rates = &sockets.counters;
+        g_string_append_printf(text,
+            "\nTCP per second: %.1f active opens, %.1f passive opens, %.1f failed attempts,"
+            "\n  %.1f resets received, %.1f RST sent, %.1f retransmitted segments, %.1f input errors"
+            "\nUDP per second: %.1f input errors, %.1f no port, %.1f receive buffer, %.1f send buffer errors",
+            rates->tcp_active_opens, rates->tcp_passive_opens, rates->tcp_attempt_fails,
+            rates->tcp_estab_resets, rates->tcp_out_rsts, rates->tcp_retrans_segs, rates->tcp_in_errs,
+            rates->udp_in_errors, rates->udp_no_ports, rates->udp_rcvbuf_errors, rates->udp_sndbuf_errors);
+    }
+    gtk_tooltip_set_text(tooltip, text->str);  // [GTK]
+    g_string_free(text, TRUE);
+    return TRUE;
+}
+
+// Détail du swap au survol: cache de swap, zswap et zram
+static gboolean on_swap_query_tooltip(GtkWidget *widget, gint x, gint y, gboolean keyboard_mode,
+                                      GtkTooltip *tooltip, gpointer user_data) {
+    (void)widget;
+    (void)x;
+    (void)y;
+    (void)keyboard_mode;
+    AppWidgets *widgets = (AppWidgets *)user_data;
     
-    snprintf(buffer, sizeof(buffer), "%s", get_locale_info());
-    gtk_label_set_text(GTK_LABEL(widgets->locale_label), buffer);  // [GTK]
+    SensorsSnapshot sensors;
+    if (metrics_read_sensors(widgets->metrics, &sensors) == 0) {
+        return FALSE;
+    }
     
-    snprintf(buffer, sizeof(buffer), "%s", get_uptime_string());
-    gtk_label_set_text(GTK_LABEL(widgets->uptime_label), buffer);  // [GTK]
+    const MemoryUsage *memory = &sensors.memory;
+    GString *text = g_string_new(NULL);
+    g_string_append_printf(text, "Swap cached: %.1f MB", (double)memory->swap_cached_kb / 1024.0);
+    if (memory->has_zswap) {
+        g_string_append_printf(text, "\nzswap: %.1f MB stored in %.1f MB of RAM",
+                               (double)memory->zswapped_kb / 1024.0, (double)memory->zswap_pool_kb / 1024.0);
+    }
+    if (sensors.zram_available) {
+        const ZramUsage *zram = &sensors.zram;
+        g_string_append_printf(text, "\nzram (%d device%s): %.1f MB compressed to %.1f MB, %.1f MB of RAM used",
+                               zram->device_count, zram->device_count > 1 ? "s" : "",
+                               (double)zram->original_kb / 1024.0, (double)zram->compressed_kb / 1024.0,
+                               (double)zram->memory_used_kb / 1024.0);
+    }
+    gtk_tooltip_set_text(tooltip, text->str);  // [GTK]
+    g_string_free(text, TRUE);
+    return TRUE;
 }
 
-// Mettre à jour tous les affichages
-void update_all_displays(AppWidgets *widgets) {
-    if (widgets == NULL) {
-        return;
+// Secondes écoulées (horloge monotone) pour horodater l'historique
+static double history_now(void) {
+    return (double)g_get_monotonic_time() / G_USEC_PER_SEC;
+}
+
+// Info-bulle "moyenne / max sur la dernière minute", calculée seulement au survol
+// (la fixer à chaque mesure réécrivait le tooltip du label 4 fois par seconde)
+static gboolean on_history_query_tooltip(GtkWidget *widget, gint x, gint y, gboolean keyboard_mode,
+                                         GtkTooltip *tooltip, gpointer user_data) {
+    (void)widget;
+    (void)x;
+    (void)y;
+    (void)keyboard_mode;
+    const MetricHistory *history = (const MetricHistory *)user_data;
+    
+    float average, maximum;
+    if (!history_summary(history, history_now(), HISTORY_WINDOW_SECONDS, &average, &maximum)) {
+        return FALSE;
     }
     
+    char text[96];
+    snprintf(text, sizeof(text), "Last minute: avg %.1f%%, max %.1f%%", average, maximum);
+    gtk_tooltip_set_text(tooltip, text);  // [GTK]
+    return TRUE;
+}
+
+// Afficher l'utilisation CPU
+static void update_cpu_display(AppWidgets *widgets) {
+    char buffer[64];
+    CpuSnapshot cpu;
+    metrics_read_cpu(widgets->metrics, &cpu);
+    history_push(&widgets->cpu_history, cpu.timestamp, cpu.usage_percent);
+    
+    snprintf(buffer, sizeof(buffer), "%.1f%%", cpu.usage_percent);
+    set_label_text(widgets->cpu_usage_label, buffer);
+}
+
+// Afficher l'utilisation GPU
+static void update_gpu_display(AppWidgets *widgets) {
+    char buffer[64];
+    GpuSnapshot gpu;
+    metrics_read_gpu(widgets->metrics, &gpu);
+    snprintf(buffer, sizeof(buffer), "%.1f%%", gpu.usage_percent);
+    set_label_text(widgets->gpu_usage_label, buffer);
+}
+
+// Afficher température, mémoire et uptime
+static void update_sensors_display(AppWidgets *widgets) {
     char buffer[128];
+    SensorsSnapshot sensors;
+    metrics_read_sensors(widgets->metrics, &sensors);
     
     // Processeur
-    float temp = get_cpu_temperature_celsius();
+    float temp = sensors.temperature_celsius;
     if (temp >= 0) {
         float temp_fahrenheit = (temp * 9.0f / 5.0f) + 32.0f;
         
@@ -961,38 +2744,465 @@ void update_all_displays(AppWidgets *widgets) {
         snprintf(markup, sizeof(markup), 
                  "<span foreground=\"%s\">%.1f°C (%.1f°F)</span>", 
                  color, temp, temp_fahrenheit);
-        gtk_label_set_markup(GTK_LABEL(widgets->temp_label), markup);
+        set_label_markup(widgets->temp_label, markup);
     } else {
-        snprintf(buffer, sizeof(buffer), "N/A");
-        gtk_label_set_text(GTK_LABEL(widgets->temp_label), buffer);
+        set_label_text(widgets->temp_label, "N/A");
     }
     
-    snprintf(buffer, sizeof(buffer), "%.1f%%", get_cpu_usage_percent());
-    gtk_label_set_text(GTK_LABEL(widgets->cpu_usage_label), buffer);  // [GTK]
+    // Memory
+    history_push(&widgets->memory_history, sensors.timestamp, sensors.memory_usage_percent);
+    snprintf(buffer, sizeof(buffer), "%.1f%%", sensors.memory_usage_percent);
+    set_label_text(widgets->mem_usage_label, buffer);
+    
+    snprintf(buffer, sizeof(buffer), "%.1f GB", sensors.memory_available_gb);
+    set_label_text(widgets->mem_available_label, buffer);
+    
+    snprintf(buffer, sizeof(buffer), "%.1f GB", sensors.memory_total_gb);
+    set_label_text(widgets->mem_total_label, buffer);
+    
+    // Swap et pagination: un taux de swap élevé explique un "87 %" qui rame
+    const MemoryUsage *memory = &sensors.memory;
+    if (memory->swap_total_kb > 0) {
+        uint64_t swap_used_kb = memory->swap_free_kb < memory->swap_total_kb
+            ? memory->swap_total_kb - memory->swap_free_kb : 0;
+        char used_text[16], total_text[16];
+        format_storage_size(used_text, sizeof(used_text), (float)swap_used_kb / (1024.0f * 1024.0f));
+        format_storage_size(total_text, sizeof(total_text), (float)memory->swap_total_kb / (1024.0f * 1024.0f));
+        snprintf(buffer, sizeof(buffer), "%s / %s (%.0f%%)", used_text, total_text,
+                 100.0f * (float)swap_used_kb / (float)memory->swap_total_kb);
+    } else {
+        snprintf(buffer, sizeof(buffer), "None");
+    }
+    set_label_text(widgets->swap_label, buffer);
+    
+    if (sensors.paging_available) {
+        const PagingRates *paging = &sensors.paging;
+        snprintf(buffer, sizeof(buffer), "In %.0f KB/s · Out %.0f KB/s", paging->page_in_kbps, paging->page_out_kbps);
+        set_label_text(widgets->paging_label, buffer);
+        snprintf(buffer, sizeof(buffer), "In %.0f · Out %.0f pages/s", paging->swap_in_per_sec, paging->swap_out_per_sec);
+        set_label_text(widgets->swap_io_label, buffer);
+        snprintf(buffer, sizeof(buffer), "%.0f/s · %.0f compaction stalls/s",
+                 paging->major_faults_per_sec, paging->compaction_stalls_per_sec);
+        set_label_text(widgets->faults_label, buffer);
+        
+        // Processus tués pendant la dernière mesure: en rouge
+        if (paging->oom_kills_per_sec > 0.0f) {
+            snprintf(buffer, sizeof(buffer), "<span foreground=\"#FF0000\">%llu since boot</span>",
+                     (unsigned long long)paging->oom_kills);
+            set_label_markup(widgets->oom_label, buffer);
+        } else {
+            snprintf(buffer, sizeof(buffer), "%llu since boot", (unsigned long long)paging->oom_kills);
+            set_label_text(widgets->oom_label, buffer);
+        }
+    } else {
+        set_label_text(widgets->paging_label, "N/A");
+        set_label_text(widgets->swap_io_label, "N/A");
+        set_label_text(widgets->faults_label, "N/A");
+        set_label_text(widgets->oom_label, "N/A");
+    }
     
-    snprintf(buffer, sizeof(buffer), "%.1f%%", get_gpu_usage_percent());
-    gtk_label_set_text(GTK_LABEL(widgets->gpu_usage_label), buffer);  // [GTK]
+    // System - Uptime (dynamic)
+    set_label_text(widgets->uptime_label, sensors.uptime);
+}
+
+// Afficher l'espace utilisé de chaque disque (dernier instantané)
+static void update_storage_usage_display(AppWidgets *widgets) {
+    static StorageSnapshot snapshot;  // Hors de la pile (128 disques)
+    metrics_read_storage(widgets->metrics, &snapshot);
+    
+    for (int s = 0; s < snapshot.storage_count; s++) {
+        const PhysicalStorage *sample = &snapshot.storages[s];
+        int i = find_storage_index(widgets, sample->name);
+        if (i < 0) {
+            continue;
+        }
+        
+        // Valeurs identiques à l'affichage: pas de row-changed
+        PhysicalStorage *shown = &widgets->physical_storages[i];
+        if (shown->used_gb == sample->used_gb && shown->available_gb == sample->available_gb &&
+            shown->capacity_gb == sample->capacity_gb) {
+            continue;
+        }
+        *shown = *sample;
+        set_storage_usage_cells(widgets, i);
+    }
+}
+
+// Latence des requêtes de chaque disque: p50 / p99 (tracepoints) ou moyenne (stat)
+static void update_storage_latency_display(AppWidgets *widgets) {
+    static StorageLatencySnapshot snapshot;  // Hors de la pile (128 disques)
+    metrics_read_storage_latency(widgets->metrics, &snapshot);
+    
+    for (int s = 0; s < snapshot.storage_count; s++) {
+        const StorageLatencySample *sample = &snapshot.storages[s];
+        int i = find_storage_index(widgets, sample->name);
+        if (i < 0) {
+            continue;
+        }
+        
+        // Aucune requête terminée sur la période: "idle" plutôt qu'une latence périmée
+        const DiskLatency *latency = &sample->latency;
+        char text[48];
+        float sort_ms = 0.0f;
+        if (latency->completed == 0) {
+            snprintf(text, sizeof(text), "idle");
+        } else if (latency->lost_events > 0) {
+            // Tracepoint buffers overflowed: exact average from /sys/block stat, no percentiles
+            snprintf(text, sizeof(text), "avg %.2f ms (events lost)", latency->average_ms);
+            sort_ms = latency->average_ms;
+        } else if (latency->source == LATENCY_SOURCE_TRACEPOINT) {
+            snprintf(text, sizeof(text), "p50 %.2f ms · p99 %.2f ms", latency->p50_ms, latency->p99_ms);
+            sort_ms = latency->p99_ms;
+        } else {
+            snprintf(text, sizeof(text), "avg %.2f ms", latency->average_ms);
+            sort_ms = latency->average_ms;
+        }
+        
+        StorageWidgets *storage = &widgets->storages[i];
+        GtkTreeIter iter;
+        if (strcmp(storage->latency_text, text) == 0 ||
+            !get_row_iter(widgets->storage_store, storage->row, &iter)) {
+            continue;
+        }
+        snprintf(storage->latency_text, sizeof(storage->latency_text), "%s", text);
+        gtk_list_store_set(widgets->storage_store, &iter,
+                           STORAGE_COL_LATENCY_TEXT, text,
+                           STORAGE_COL_LATENCY_MS, sort_ms,
+                           -1);
+    }
+}
+
+// Température et usure de chaque disque; détails SMART / NVMe dans l'info-bulle de la ligne
+static void update_storage_health_display(AppWidgets *widgets) {
+    static StorageHealthSnapshot snapshot;  // Hors de la pile (128 disques)
+    metrics_read_storage_health(widgets->metrics, &snapshot);
+    
+    for (int s = 0; s < snapshot.storage_count; s++) {
+        const StorageHealthSample *sample = &snapshot.storages[s];
+        int i = find_storage_index(widgets, sample->name);
+        if (i < 0) {
+            continue;
+        }
+        
+        const DiskHealth *health = &sample->health;
+        char text[48];
+        char details[192];
+        details[0] = '\0';
+        if (health->source == DISK_HEALTH_NONE) {
+            snprintf(text, sizeof(text), "N/A");
+        } else {
+            // Alerte NVMe ou secteurs illisibles: à remplacer en priorité
+            bool failing = health->critical_warning != 0 || health->media_errors > 0;
+            char temperature[16] = "";
+            char wear[16] = "";
+            if (health->temperature_celsius >= 0) {
+                snprintf(temperature, sizeof(temperature), "%.0f °C", health->temperature_celsius);
+            }
+            if (health->percentage_used >= 0) {
+                snprintf(wear, sizeof(wear), "%d%% used", health->percentage_used);
+            }
+            snprintf(text, sizeof(text), "%s%s%s%s", failing ? "⚠ " : "", temperature,
+                     temperature[0] != '\0' && wear[0] != '\0' ? " · " : "", wear);
+            snprintf(details, sizeof(details),
+                     "%s health\nMedia errors: %llu\nUnsafe shutdowns: %llu\n"
+                     "Data written: %llu GB\nPower-on hours: %llu%s",
+                     health->source == DISK_HEALTH_NVME ? "NVMe" : "SMART",
+                     (unsigned long long)health->media_errors,
+                     (unsigned long long)health->unsafe_shutdowns,
+                     (unsigned long long)health->data_written_gb,
+                     (unsigned long long)health->power_on_hours,
+                     health->critical_warning != 0 ? "\nCritical warning set" : "");
+        }
+        
+        StorageWidgets *storage = &widgets->storages[i];
+        GtkTreeIter iter;
+        if ((strcmp(storage->health_text, text) == 0 && strcmp(storage->health_details, details) == 0) ||
+            !get_row_iter(widgets->storage_store, storage->row, &iter)) {
+            continue;
+        }
+        snprintf(storage->health_text, sizeof(storage->health_text), "%s", text);
+        snprintf(storage->health_details, sizeof(storage->health_details), "%s", details);
+        gtk_list_store_set(widgets->storage_store, &iter,
+                           STORAGE_COL_HEALTH_TEXT, text,
+                           STORAGE_COL_WEAR_PERCENT, (float)health->percentage_used,
+                           -1);
+        set_storage_tooltip(widgets, i, &iter);
+    }
+}
+
+// ============================================================================
+// COLLECTEURS (ordonnanceur multi-fréquences)
+// ============================================================================
+
+// Chaque collecteur publie son instantané puis l'affichage le relit: un autre
+// consommateur (exporteur, enregistrement) pourrait lire le même instantané
+
+static void collect_cpu(void *user_data) {
+    AppWidgets *widgets = (AppWidgets *)user_data;
+    metrics_collect_cpu(widgets->metrics);
+    update_cpu_display(widgets);
+}
+
+static void collect_network(void *user_data) {
+    AppWidgets *widgets = (AppWidgets *)user_data;
+    metrics_collect_network(widgets->metrics);
+    update_network_display(widgets);
+}
+
+static void collect_sensors(void *user_data) {
+    AppWidgets *widgets = (AppWidgets *)user_data;
+    metrics_collect_sensors(widgets->metrics);
+    update_sensors_display(widgets);
+}
+
+static void collect_gpu(void *user_data) {
+    AppWidgets *widgets = (AppWidgets *)user_data;
+    metrics_collect_gpu(widgets->metrics);
+    update_gpu_display(widgets);
+}
+
+static void collect_sockets(void *user_data) {
+    AppWidgets *widgets = (AppWidgets *)user_data;
+    metrics_collect_sockets(widgets->metrics);
+    update_sockets_display(widgets);
+}
+
+// Lignes cpuN de /proc/stat agrégées par nœud NUMA
+static void collect_numa(void *user_data) {
+    AppWidgets *widgets = (AppWidgets *)user_data;
+    metrics_collect_numa(widgets->metrics);
+    update_numa_display(widgets);
+}
+
+// cpu.stat / memory.* / io.stat de chaque cgroup connu
+static void collect_cgroups(void *user_data) {
+    AppWidgets *widgets = (AppWidgets *)user_data;
+    metrics_collect_cgroups(widgets->metrics);
+    update_cgroup_display(widgets);
+}
+
+// Station + survey nl80211 par interface WiFi
+static void collect_wireless(void *user_data) {
+    AppWidgets *widgets = (AppWidgets *)user_data;
+    metrics_collect_wireless(widgets->metrics);
+    update_network_display(widgets);
+}
+
+// Un `ip addr` par interface: fréquence lente
+static void collect_addresses(void *user_data) {
+    AppWidgets *widgets = (AppWidgets *)user_data;
+    metrics_collect_network_addresses(widgets->metrics);
+    update_network_display(widgets);
+}
+
+// Un statvfs() par système de fichiers monté: l'occupation change lentement
+static void collect_storage_usage(void *user_data) {
+    AppWidgets *widgets = (AppWidgets *)user_data;
+    metrics_collect_storage_usage(widgets->metrics);
+    update_storage_usage_display(widgets);
+}
+
+// Tracepoints bloc vidés (ou /sys/block/<disque>/stat) pour chaque disque suivi
+static void collect_storage_latency(void *user_data) {
+    AppWidgets *widgets = (AppWidgets *)user_data;
+    metrics_collect_storage_latency(widgets->metrics);
+    update_storage_latency_display(widgets);
+}
+
+// SMART / NVMe: chaque disque n'est réellement interrogé qu'une fois par minute
+static void collect_storage_health(void *user_data) {
+    AppWidgets *widgets = (AppWidgets *)user_data;
+    metrics_collect_storage_health(widgets->metrics);
+    update_storage_health_display(widgets);
+}
+
+// md / dm volumes: one /proc/diskstats read for the volumes and their members
+static void collect_volumes(void *user_data) {
+    AppWidgets *widgets = (AppWidgets *)user_data;
+    metrics_collect_volumes(widgets->metrics);
+    update_volume_display(widgets);
+}
+
+// Every mounted filesystem: statvfs() at most once per FILESYSTEM_STAT_INTERVAL_SECONDS and mount
+static void collect_filesystems(void *user_data) {
+    AppWidgets *widgets = (AppWidgets *)user_data;
+    metrics_collect_filesystems(widgets->metrics);
+    update_filesystem_display(widgets);
+}
+
+static void collect_system_info(void *user_data) {
+    update_system_info_display((AppWidgets *)user_data);
+}
+
+// Fenêtre cachée: seulement alimenter l'historique, aucun widget touché
+// (la mesure CPU couvre tout l'intervalle depuis la précédente: pas de trou)
+static void record_background_history(AppWidgets *widgets) {
+    CpuSnapshot cpu;
+    SensorsSnapshot sensors;
+    
+    metrics_collect_cpu(widgets->metrics);
+    metrics_collect_sensors(widgets->metrics);
+    metrics_read_cpu(widgets->metrics, &cpu);
+    metrics_read_sensors(widgets->metrics, &sensors);
+    
+    history_push(&widgets->cpu_history, cpu.timestamp, cpu.usage_percent);
+    history_push(&widgets->memory_history, sensors.timestamp, sensors.memory_usage_percent);
+    
+    // La tendance de remplissage continue sans affichage (statvfs limité par montage)
+    metrics_collect_filesystems(widgets->metrics);
+}
+
+static void collect_background_history(void *user_data) {
+    record_background_history((AppWidgets *)user_data);
+}
+
+// Période d'échantillonnage en arrière-plan (SYSWATCH_BACKGROUND_INTERVAL_MS, 0 = aucun)
+static unsigned int get_background_interval_ms(void) {
+    const char *value = getenv("SYSWATCH_BACKGROUND_INTERVAL_MS");
+    if (value == NULL || value[0] == '\0') {
+        return BACKGROUND_INTERVAL_MS;
+    }
     
-    // Memory
-    snprintf(buffer, sizeof(buffer), "%.1f%%", get_memory_usage_percent());
-    gtk_label_set_text(GTK_LABEL(widgets->mem_usage_label), buffer);  // [GTK]
+    char *end = NULL;
+    long interval = strtol(value, &end, 10);
+    if (end == value || *end != '\0' || interval < 0) {
+        return BACKGROUND_INTERVAL_MS;
+    }
     
-    snprintf(buffer, sizeof(buffer), "%.1f GB", get_memory_available_gb());
-    gtk_label_set_text(GTK_LABEL(widgets->mem_available_label), buffer);  // [GTK]
+    // Jamais plus rapide que l'affichage des capteurs: ce serait le contraire du but
+    if (interval > 0 && interval < SENSORS_INTERVAL_MS) {
+        interval = SENSORS_INTERVAL_MS;
+    }
+    return (unsigned int)interval;
+}
+
+// Enregistrer un collecteur d'affichage (suspendu tant que la fenêtre est cachée)
+static void add_display_collector(AppWidgets *widgets, const char *name, unsigned int interval_ms,
+                                  CollectorCallback callback) {
+    int id = scheduler_add_collector(widgets->scheduler, name, interval_ms, callback, widgets);
+    int max_collectors = (int)(sizeof(widgets->display_collector_ids) / sizeof(widgets->display_collector_ids[0]));
+    if (id < 0 || widgets->display_collector_count >= max_collectors) {
+        return;
+    }
     
-    snprintf(buffer, sizeof(buffer), "%.1f GB", get_memory_total_gb());
-    gtk_label_set_text(GTK_LABEL(widgets->mem_total_label), buffer);  // [GTK]
+    widgets->display_collector_ids[widgets->display_collector_count] = id;
+    widgets->display_collector_intervals[widgets->display_collector_count] = interval_ms;
+    widgets->display_collector_count++;
+}
+
+// Au moins un timer a expiré: exécuter les collecteurs concernés
+static gboolean on_scheduler_ready(gint fd, GIOCondition condition, gpointer user_data) {
+    (void)fd;
+    (void)condition;
+    AppWidgets *widgets = (AppWidgets *)user_data;
+    scheduler_dispatch(widgets->scheduler);
+    return G_SOURCE_CONTINUE;
+}
+
+// Enregistrer les collecteurs (un seul descripteur epoll surveillé par GLib)
+static void init_collectors(AppWidgets *widgets) {
+    widgets->scheduler = scheduler_create(SCHEDULER_COALESCE_MS);
+    if (widgets->scheduler == NULL) {
+        // Repli: ancien fonctionnement, tout à 1 seconde
+        update_system_info_display(widgets);
+        g_timeout_add(1000, update_all_callback, widgets);
+        return;
+    }
     
-    // System - Uptime (dynamic)
-    snprintf(buffer, sizeof(buffer), "%s", get_uptime_string());
-    gtk_label_set_text(GTK_LABEL(widgets->uptime_label), buffer);  // [GTK]
+    widgets->background_interval_ms = get_background_interval_ms();
+    
+    scheduler_add_collector(widgets->scheduler, "system-info", 0, collect_system_info, widgets);
+    add_display_collector(widgets, "cpu", CPU_INTERVAL_MS, collect_cpu);
+    add_display_collector(widgets, "network", NETWORK_INTERVAL_MS, collect_network);
+    add_display_collector(widgets, "sensors", SENSORS_INTERVAL_MS, collect_sensors);
+    add_display_collector(widgets, "gpu", GPU_INTERVAL_MS, collect_gpu);
+    add_display_collector(widgets, "addresses", ADDRESSES_INTERVAL_MS, collect_addresses);
+    add_display_collector(widgets, "sockets", SOCKETS_INTERVAL_MS, collect_sockets);
+    add_display_collector(widgets, "wireless", WIRELESS_INTERVAL_MS, collect_wireless);
+    add_display_collector(widgets, "cgroups", CGROUPS_INTERVAL_MS, collect_cgroups);
+    add_display_collector(widgets, "numa", NUMA_INTERVAL_MS, collect_numa);
+    add_display_collector(widgets, "storage-usage", STORAGE_USAGE_INTERVAL_MS, collect_storage_usage);
+    add_display_collector(widgets, "storage-latency", STORAGE_LATENCY_INTERVAL_MS, collect_storage_latency);
+    add_display_collector(widgets, "storage-health", STORAGE_HEALTH_INTERVAL_MS, collect_storage_health);
+    add_display_collector(widgets, "volumes", VOLUMES_INTERVAL_MS, collect_volumes);
+    add_display_collector(widgets, "filesystems", FILESYSTEMS_INTERVAL_MS, collect_filesystems);
+    
+    // Échantillonneur d'arrière-plan: armé seulement quand la fenêtre est cachée
+    widgets->history_collector_id = scheduler_add_collector(widgets->scheduler, "history",
+                                                            widgets->background_interval_ms,
+                                                            collect_background_history, widgets);
+    scheduler_set_interval(widgets->scheduler, widgets->history_collector_id, 0);
+    
+    widgets->scheduler_source_id = g_unix_fd_add(scheduler_get_fd(widgets->scheduler), G_IO_IN,
+                                                 on_scheduler_ready, widgets);
+}
+
+// Mettre à jour uniquement la section System Info
+void update_system_info_display(AppWidgets *widgets) {
+    if (widgets == NULL) {
+        return;
+    }
+    
+    SystemSnapshot info;
+    metrics_collect_system_info(widgets->metrics);
+    metrics_read_system_info(widgets->metrics, &info);
+    
+    // Hardware Info (colonne 1)
+    gtk_label_set_text(GTK_LABEL(widgets->hardware_label), info.hardware_model);  // [GTK]
+    gtk_label_set_text(GTK_LABEL(widgets->processor_label), info.processor);  // [GTK]
+    gtk_label_set_text(GTK_LABEL(widgets->architecture_label), info.architecture);  // [GTK]
+    gtk_label_set_text(GTK_LABEL(widgets->cpu_cores_label), info.cpu_cores);  // [GTK]
+    gtk_label_set_text(GTK_LABEL(widgets->gpu_label), info.gpu);  // [GTK]
+    gtk_label_set_text(GTK_LABEL(widgets->cpu_cache_label), info.cpu_cache);  // [GTK]
+    gtk_widget_set_tooltip_text(widgets->numa_label, info.numa_layout);  // [GTK]
+    
+    // Software Info (colonne 2)
+    gtk_label_set_text(GTK_LABEL(widgets->kernel_label), info.kernel);  // [GTK]
+    gtk_label_set_text(GTK_LABEL(widgets->distro_label), info.distro);  // [GTK]
+    gtk_label_set_text(GTK_LABEL(widgets->display_label), info.desktop);  // [GTK]
+    gtk_label_set_text(GTK_LABEL(widgets->locale_label), info.locale);  // [GTK]
     
     // Network - Hostname
-    snprintf(buffer, sizeof(buffer), "%s", get_hostname());
-    gtk_label_set_text(GTK_LABEL(widgets->network_hostname_label), buffer);  // [GTK]
+    gtk_label_set_text(GTK_LABEL(widgets->network_hostname_label), info.hostname);  // [GTK]
+}
+
+// Mettre à jour tous les affichages
+void update_all_displays(AppWidgets *widgets) {
+    if (widgets == NULL) {
+        return;
+    }
     
-    // Network - Débits et IPs par interface
-    update_network_bandwidth(widgets);
+    metrics_collect_sensors(widgets->metrics);
+    metrics_collect_cpu(widgets->metrics);
+    metrics_collect_gpu(widgets->metrics);
+    metrics_collect_network_addresses(widgets->metrics);
+    metrics_collect_network(widgets->metrics);
+    metrics_collect_wireless(widgets->metrics);
+    metrics_collect_sockets(widgets->metrics);
+    metrics_collect_cgroups(widgets->metrics);
+    metrics_collect_numa(widgets->metrics);
+    metrics_collect_storage_latency(widgets->metrics);
+    metrics_collect_storage_health(widgets->metrics);  // En cache: un ioctl par disque et par minute
+    metrics_collect_volumes(widgets->metrics);
+    metrics_collect_filesystems(widgets->metrics);
+    
+    update_sensors_display(widgets);
+    update_numa_display(widgets);
+    update_cpu_display(widgets);
+    update_gpu_display(widgets);
+    
+    // Network - Débits et IPs par interface, connexions
+    update_network_display(widgets);
+    update_sockets_display(widgets);
+    
+    // Services - cgroups les plus consommateurs
+    update_cgroup_display(widgets);
+    
+    // Storage - latence des requêtes (première lecture: référence), santé SMART / NVMe
+    update_storage_latency_display(widgets);
+    update_storage_health_display(widgets);
+    update_volume_display(widgets);
+    update_filesystem_display(widgets);
 }
 
 // Lancer la boucle principale GTK
@@ -1006,6 +3216,23 @@ void run_gui(AppWidgets *widgets) {
 // Libérer la mémoire
 void cleanup_gui(AppWidgets *widgets) {
     if (widgets != NULL) {
+        if (widgets->scheduler_source_id != 0) {
+            g_source_remove(widgets->scheduler_source_id);
+        }
+        scheduler_destroy(widgets->scheduler);
+        if (widgets->hotplug_source_id != 0) {
+            g_source_remove(widgets->hotplug_source_id);
+        }
+        hotplug_monitor_close(widgets->hotplug_fd);
+        history_free(&widgets->cpu_history);
+        history_free(&widgets->memory_history);
+        metrics_destroy(widgets->metrics);
+        for (int i = 0; i < widgets->network_interface_count; i++) {
+            gtk_tree_row_reference_free(widgets->network_interfaces[i].row);
+        }
+        for (int i = 0; i < widgets->storage_count; i++) {
+            gtk_tree_row_reference_free(widgets->storages[i].row);
+        }
         if (widgets->network_interfaces != NULL) {
             free(widgets->network_interfaces);
         }
@@ -0,0 +1,153 @@
+/*
+ * history.c
+ * Ring buffer of timestamped samples implementation
+ */
+
+#include "history.h"
+#include <stdlib.h>
+#include <string.h>
+
+bool history_init(MetricHistory *history, int capacity) {
+    if (history == NULL || capacity <= 0) {
+        return false;
+    }
+
+    memset(history, 0, sizeof(MetricHistory));
+    history->samples = calloc(capacity, sizeof(HistorySample));
+    if (history->samples == NULL) {
+        return false;
+    }
+    history->capacity = capacity;
+    return true;
+}
+
+void history_free(MetricHistory *history) {
+    if (history != NULL) {
+        free(history->samples);
+        memset(history, 0, sizeof(MetricHistory));
+    }
+}
+
+void history_push(MetricHistory *history, double timestamp, float value) {
+    if (history == NULL || history->samples == NULL) {
+        return;
+    }
+
+    history->samples[history->head].timestamp = timestamp;
+    history->samples[history->head].value = value;
+    history->head = (history->head + 1) % history->capacity;
+    if (history->count < history->capacity) {
+        history->count++;
+    }
+}
+
+bool history_get(const MetricHistory *history, int index, HistorySample *sample) {
+    if (history == NULL || sample == NULL || index < 0 || index >= history->count) {
+        return false;
+    }
+
+    // La plus ancienne mesure se trouve juste après la dernière écrite
+    int oldest = (history->head - history->count + history->capacity) % history->capacity;
+    *sample = history->samples[(oldest + index) % history->capacity];
+    return true;
+}
+
+bool history_summary(const MetricHistory *history, double now, double window_seconds,
+                     float *average, float *maximum) {
+    if (history == NULL || history->count == 0) {
+        return false;
+    }
+
+    double window_start = now - window_seconds;
+    double weighted_sum = 0.0;
+    double total_weight = 0.0;
+    float max_value = 0.0f;
+    int used = 0;
+
+    HistorySample previous;
+    bool has_previous = false;
+
+    for (int i = 0; i < history->count; i++) {
+        HistorySample sample;
+        history_get(history, i, &sample);
+
+        if (sample.timestamp >= window_start) {
+            // Poids = durée couverte par la mesure (bornée au début de la fenêtre)
+            double weight = 1.0;
+            if (has_previous) {
+                double from = previous.timestamp > window_start ? previous.timestamp : window_start;
+                weight = sample.timestamp - from;
+            }
+            if (weight > 0.0) {
+                weighted_sum += sample.value * weight;
+                total_weight += weight;
+            }
+            if (used == 0 || sample.value > max_value) {
+                max_value = sample.value;
+            }
+            used++;
+        }
+
+        previous = sample;
+        has_previous = true;
+    }
+
+    if (used == 0) {
+        return false;
+    }
+
+    if (average != NULL) {
+        *average = total_weight > 0.0 ? (float)(weighted_sum / total_weight) : max_value;
+    }
+    if (maximum != NULL) {
+        *maximum = max_value;
+    }
+    return true;
+}
+
+bool history_slope(const MetricHistory *history, double now, double window_seconds,
+                   double *per_second, double *span_seconds) {
+    if (history == NULL || per_second == NULL || history->count < 2) {
+        return false;
+    }
+
+    double window_start = now - window_seconds;
+    double first = 0.0;
+    double last = 0.0;
+    double sum_t = 0.0;
+    double sum_v = 0.0;
+    double sum_tt = 0.0;
+    double sum_tv = 0.0;
+    int used = 0;
+
+    for (int i = 0; i < history->count; i++) {
+        HistorySample sample;
+        history_get(history, i, &sample);
+        if (sample.timestamp < window_start) {
+            continue;
+        }
+
+        // Instants relatifs à la première mesure: les carrés restent précis
+        if (used == 0) {
+            first = sample.timestamp;
+        }
+        double t = sample.timestamp - first;
+        sum_t += t;
+        sum_v += sample.value;
+        sum_tt += t * t;
+        sum_tv += t * sample.value;
+        last = sample.timestamp;
+        used++;
+    }
+
+    double denominator = used * sum_tt - sum_t * sum_t;
+    if (used < 2 || denominator <= 0.0) {
+        return false;
+    }
+
+    *per_second = (used * sum_tv - sum_t * sum_v) / denominator;
+    if (span_seconds != NULL) {
+        *span_seconds = last - first;
+    }
+    return true;
+}
@@ -0,0 +1,144 @@
+/*
+ * hotplug_monitor.c
+ * Kernel uevent listener (NETLINK_KOBJECT_UEVENT) implementation
+ */
+
+#include "hotplug_monitor.h"
+#include <string.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <linux/netlink.h>
+
+// Groupe multicast des uevents émis directement par le noyau (1 = noyau, 2 = udev)
+#define UEVENT_KERNEL_GROUP 1
+
+int hotplug_monitor_open(void) {
+    int fd = socket(AF_NETLINK, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, NETLINK_KOBJECT_UEVENT);
+    if (fd < 0) {
+        return -1;
+    }
+
+    struct sockaddr_nl addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.nl_family = AF_NETLINK;
+    addr.nl_pid = 0;  // Laisser le noyau attribuer l'identifiant
+    addr.nl_groups = UEVENT_KERNEL_GROUP;
+
+    if (bind(fd, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+        close(fd);
+        return -1;
+    }
+
+    return fd;
+}
+
+int hotplug_monitor_read(int fd, HotplugEvent *event) {
+    if (fd < 0 || event == NULL) {
+        return -1;
+    }
+
+    char buffer[8192];
+    struct sockaddr_nl sender;
+    socklen_t sender_len = sizeof(sender);
+
+    ssize_t len = recvfrom(fd, buffer, sizeof(buffer) - 1, 0,
+                           (struct sockaddr *)&sender, &sender_len);
+    if (len <= 0) {
+        return -1;  // EAGAIN: plus rien à lire
+    }
+    buffer[len] = '\0';
+
+    // SÉCURITÉ: n'accepter que les messages émis par le noyau (pid 0)
+    if (sender_len != sizeof(sender) || sender.nl_pid != 0) {
+        return 0;
+    }
+
+    // Format: "action@devpath\0ACTION=add\0SUBSYSTEM=block\0DEVNAME=sda\0..."
+    const char *action = NULL;
+    const char *subsystem = NULL;
+    const char *devtype = NULL;
+    const char *devname = NULL;
+    const char *interface = NULL;
+    const char *devpath_old = NULL;
+
+    size_t pos = strlen(buffer) + 1;  // Sauter l'en-tête "action@devpath"
+    while (pos < (size_t)len) {
+        const char *field = buffer + pos;
+        size_t field_len = strlen(field);
+
+        if (strncmp(field, "ACTION=", 7) == 0) {
+            action = field + 7;
+        } else if (strncmp(field, "SUBSYSTEM=", 10) == 0) {
+            subsystem = field + 10;
+        } else if (strncmp(field, "DEVTYPE=", 8) == 0) {
+            devtype = field + 8;
+        } else if (strncmp(field, "DEVNAME=", 8) == 0) {
+            devname = field + 8;
+        } else if (strncmp(field, "INTERFACE=", 10) == 0) {
+            interface = field + 10;
+        } else if (strncmp(field, "DEVPATH_OLD=", 12) == 0) {
+            devpath_old = field + 12;
+        }
+
+        pos += field_len + 1;
+    }
+
+    if (action == NULL || subsystem == NULL) {
+        return 0;
+    }
+
+    // Ajout, retrait et renommage modifient les tables; "change" n'intéresse que les disques
+    memset(event->old_name, 0, sizeof(event->old_name));
+    if (strcmp(action, "add") == 0) {
+        event->action = HOTPLUG_ACTION_ADD;
+    } else if (strcmp(action, "remove") == 0) {
+        event->action = HOTPLUG_ACTION_REMOVE;
+    } else if (strcmp(action, "move") == 0) {
+        // "/devices/.../net/eth0": l'ancien nom est le dernier composant
+        const char *old_name = devpath_old != NULL ? strrchr(devpath_old, '/') : NULL;
+        if (old_name == NULL || old_name[1] == '\0' || strlen(old_name + 1) >= sizeof(event->old_name)) {
+            return 0;
+        }
+        event->action = HOTPLUG_ACTION_MOVE;
+        memcpy(event->old_name, old_name + 1, strlen(old_name + 1) + 1);
+    } else if (strcmp(action, "change") == 0 && strcmp(subsystem, "block") == 0) {
+        event->action = HOTPLUG_ACTION_CHANGE;
+    } else {
+        return 0;
+    }
+
+    const char *name = NULL;
+    if (strcmp(subsystem, "block") == 0) {
+        // Ignorer les partitions: seul le disque entier a une ligne dans le tableau
+        if (devtype == NULL || strcmp(devtype, "disk") != 0) {
+            return 0;
+        }
+        event->subsystem = HOTPLUG_SUBSYSTEM_BLOCK;
+        name = devname;
+    } else if (strcmp(subsystem, "net") == 0) {
+        event->subsystem = HOTPLUG_SUBSYSTEM_NET;
+        name = interface;
+    } else {
+        return 0;
+    }
+
+    if (name == NULL || name[0] == '\0' || strlen(name) >= sizeof(event->name)) {
+        return 0;
+    }
+
+    // DEVNAME peut contenir un sous-répertoire de /dev: garder le dernier composant
+    const char *slash = strrchr(name, '/');
+    if (slash != NULL) {
+        name = slash + 1;
+    }
+
+    strncpy(event->name, name, sizeof(event->name) - 1);
+    event->name[sizeof(event->name) - 1] = '\0';
+    return 1;
+}
+
+void hotplug_monitor_close(int fd) {
+    if (fd >= 0) {
+        close(fd);
+    }
+}
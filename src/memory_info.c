@@ -0,0 +1,186 @@
+/*
+ * memory_info.c
+ * Swap / zswap from /proc/meminfo, zram mm_stat and /proc/vmstat paging rates
+ */
+
+#include "memory_info.h"
+#include "sysroot.h"
+#include "parse_utils.h"
+#include "counter_delta.h"
+#include <stdio.h>
+#include <string.h>
+#include <stddef.h>
+#include <limits.h>
+#include <dirent.h>
+
+// ============================================================================
+// /proc/meminfo
+// ============================================================================
+
+// Champs lus et emplacement dans MemoryUsage
+static const struct {
+    const char *name;
+    size_t offset;
+} meminfo_fields[] = {
+    { "MemTotal:", offsetof(MemoryUsage, total_kb) },
+    { "MemAvailable:", offsetof(MemoryUsage, available_kb) },
+    { "SwapCached:", offsetof(MemoryUsage, swap_cached_kb) },
+    { "SwapTotal:", offsetof(MemoryUsage, swap_total_kb) },
+    { "SwapFree:", offsetof(MemoryUsage, swap_free_kb) },
+    { "Zswap:", offsetof(MemoryUsage, zswap_pool_kb) },
+    { "Zswapped:", offsetof(MemoryUsage, zswapped_kb) }
+};
+#define MEMINFO_FIELD_COUNT (int)(sizeof(meminfo_fields) / sizeof(meminfo_fields[0]))
+
+bool get_memory_usage(MemoryUsage *usage) {
+    if (usage == NULL) {
+        return false;
+    }
+    memset(usage, 0, sizeof(*usage));
+
+    char buffer[8192];
+    long length = parse_read_file("/proc/meminfo", buffer, sizeof(buffer));
+    if (length <= 0) {
+        return false;
+    }
+    const char *end = buffer + length;
+
+    int found = 0;
+    bool has_total = false;
+    for (const char *line = buffer; line < end && found < MEMINFO_FIELD_COUNT; line = parse_next_line(line, end)) {
+        for (int i = 0; i < MEMINFO_FIELD_COUNT; i++) {
+            const char *value = parse_skip_prefix(line, end, meminfo_fields[i].name);
+            if (value == NULL) {
+                continue;
+            }
+            uint64_t *field = (uint64_t *)((char *)usage + meminfo_fields[i].offset);
+            if (parse_u64(value, end, field) != NULL) {
+                found++;
+                if (meminfo_fields[i].offset == offsetof(MemoryUsage, total_kb)) {
+                    has_total = true;
+                } else if (meminfo_fields[i].offset == offsetof(MemoryUsage, zswap_pool_kb)) {
+                    usage->has_zswap = true;
+                }
+            }
+            break;
+        }
+    }
+    return has_total;
+}
+
+// ============================================================================
+// zram
+// ============================================================================
+
+bool get_zram_usage(ZramUsage *usage) {
+    if (usage == NULL) {
+        return false;
+    }
+    memset(usage, 0, sizeof(*usage));
+
+    DIR *dir = sysroot_opendir("/sys/block");
+    if (dir == NULL) {
+        return false;
+    }
+
+    struct dirent *entry;
+    while ((entry = readdir(dir)) != NULL) {
+        if (strncmp(entry->d_name, "zram", 4) != 0) {
+            continue;
+        }
+
+        // disksize = 0: périphérique créé mais jamais initialisé (pas de swap dessus)
+        char path[PATH_MAX];
+        char buffer[256];
+        uint64_t disksize = 0;
+        snprintf(path, sizeof(path), "/sys/block/%s/disksize", entry->d_name);
+        long length = parse_read_file(path, buffer, sizeof(buffer));
+        if (length <= 0 || parse_u64(buffer, buffer + length, &disksize) == NULL || disksize == 0) {
+            continue;
+        }
+
+        // Format: orig_data_size compr_data_size mem_used_total mem_limit ... (octets)
+        uint64_t fields[3];
+        snprintf(path, sizeof(path), "/sys/block/%s/mm_stat", entry->d_name);
+        length = parse_read_file(path, buffer, sizeof(buffer));
+        if (length <= 0 || parse_u64_fields(buffer, buffer + length, fields, 3) != 3) {
+            continue;
+        }
+        usage->original_kb += fields[0] / 1024;
+        usage->compressed_kb += fields[1] / 1024;
+        usage->memory_used_kb += fields[2] / 1024;
+        usage->device_count++;
+    }
+    closedir(dir);
+    return usage->device_count > 0;
+}
+
+// ============================================================================
+// /proc/vmstat
+// ============================================================================
+
+// Compteurs lus et champ de PagingRates correspondant
+static const struct {
+    const char *name;
+    size_t offset;
+} vmstat_counters[] = {
+    { "pgpgin ", offsetof(PagingRates, page_in_kbps) },
+    { "pgpgout ", offsetof(PagingRates, page_out_kbps) },
+    { "pswpin ", offsetof(PagingRates, swap_in_per_sec) },
+    { "pswpout ", offsetof(PagingRates, swap_out_per_sec) },
+    { "pgmajfault ", offsetof(PagingRates, major_faults_per_sec) },
+    { "compact_stall ", offsetof(PagingRates, compaction_stalls_per_sec) },
+    { "oom_kill ", offsetof(PagingRates, oom_kills_per_sec) }
+};
+#define VMSTAT_COUNTER_COUNT (int)(sizeof(vmstat_counters) / sizeof(vmstat_counters[0]))
+#define VMSTAT_OOM_KILL (VMSTAT_COUNTER_COUNT - 1)
+
+bool get_paging_rates(PagingRates *rates) {
+    // Compteurs "unsigned long" du noyau: rebouclage à 2^32 sur les systèmes 32 bits
+    static CounterDelta previous[VMSTAT_COUNTER_COUNT];
+    static bool previous_initialized = false;
+    if (!previous_initialized) {
+        for (int i = 0; i < VMSTAT_COUNTER_COUNT; i++) {
+            counter_delta_init(&previous[i], COUNTER_BITS_LONG);
+        }
+        previous_initialized = true;
+    }
+
+    if (rates == NULL) {
+        return false;
+    }
+    memset(rates, 0, sizeof(*rates));
+
+    // ~180 lignes "nom valeur" (5 à 8 Ko selon le noyau)
+    char buffer[16384];
+    long length = parse_read_file("/proc/vmstat", buffer, sizeof(buffer));
+    if (length <= 0) {
+        return false;
+    }
+    const char *end = buffer + length;
+
+    uint64_t current[VMSTAT_COUNTER_COUNT] = {0};
+    bool present[VMSTAT_COUNTER_COUNT] = {false};
+    int found = 0;
+    for (const char *line = buffer; line < end && found < VMSTAT_COUNTER_COUNT; line = parse_next_line(line, end)) {
+        for (int i = 0; i < VMSTAT_COUNTER_COUNT; i++) {
+            const char *value = parse_skip_prefix(line, end, vmstat_counters[i].name);
+            if (value != NULL) {
+                present[i] = parse_u64(value, end, &current[i]) != NULL;
+                found += present[i];
+                break;
+            }
+        }
+    }
+
+    // Compteur absent (oom_kill avant 4.13, compaction désactivée): débit laissé à 0
+    double now = counter_clock_seconds();
+    for (int i = 0; i < VMSTAT_COUNTER_COUNT; i++) {
+        if (present[i]) {
+            float *rate = (float *)((char *)rates + vmstat_counters[i].offset);
+            *rate = (float)counter_delta_rate(&previous[i], current[i], now);
+        }
+    }
+    rates->oom_kills = current[VMSTAT_OOM_KILL];
+    return true;
+}
@@ -0,0 +1,422 @@
+/*
+ * metrics.c
+ * Versioned collector snapshots built on SnapshotCell
+ */
+
+#include "metrics.h"
+#include "snapshot.h"
+#include "system_info.h"
+#include "network_info.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+struct Metrics {
+    SnapshotCell cpu;
+    SnapshotCell sensors;
+    SnapshotCell gpu;
+    SnapshotCell network;
+    SnapshotCell sockets;
+    SnapshotCell cgroups;
+    SnapshotCell numa;
+    SnapshotCell storage;
+    SnapshotCell storage_latency;
+    SnapshotCell storage_health;
+    SnapshotCell volumes;
+    SnapshotCell filesystems;
+    SnapshotCell system;
+
+    // Copies de travail de l'écrivain (complétées puis publiées)
+    NetworkSnapshot network_staging;
+    StorageSnapshot storage_staging;
+};
+
+// Même horloge que g_get_monotonic_time(): comparable aux horodatages de l'interface
+static double monotonic_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+// Copier une chaîne de get_*() (tampon statique) dans un champ de l'instantané
+static void copy_text(char *destination, size_t destination_size, const char *source) {
+    snprintf(destination, destination_size, "%s", source != NULL ? source : "");
+}
+
+Metrics* metrics_create(void) {
+    Metrics *metrics = calloc(1, sizeof(Metrics));
+    if (metrics == NULL) {
+        return NULL;
+    }
+
+    if (!snapshot_cell_init(&metrics->cpu, sizeof(CpuSnapshot)) ||
+        !snapshot_cell_init(&metrics->sensors, sizeof(SensorsSnapshot)) ||
+        !snapshot_cell_init(&metrics->gpu, sizeof(GpuSnapshot)) ||
+        !snapshot_cell_init(&metrics->network, sizeof(NetworkSnapshot)) ||
+        !snapshot_cell_init(&metrics->sockets, sizeof(SocketSnapshot)) ||
+        !snapshot_cell_init(&metrics->cgroups, sizeof(CgroupSnapshot)) ||
+        !snapshot_cell_init(&metrics->numa, sizeof(NumaSnapshot)) ||
+        !snapshot_cell_init(&metrics->storage, sizeof(StorageSnapshot)) ||
+        !snapshot_cell_init(&metrics->storage_latency, sizeof(StorageLatencySnapshot)) ||
+        !snapshot_cell_init(&metrics->storage_health, sizeof(StorageHealthSnapshot)) ||
+        !snapshot_cell_init(&metrics->volumes, sizeof(VolumeSnapshot)) ||
+        !snapshot_cell_init(&metrics->filesystems, sizeof(FilesystemSnapshot)) ||
+        !snapshot_cell_init(&metrics->system, sizeof(SystemSnapshot))) {
+        metrics_destroy(metrics);
+        return NULL;
+    }
+    return metrics;
+}
+
+void metrics_destroy(Metrics *metrics) {
+    if (metrics == NULL) {
+        return;
+    }
+    snapshot_cell_free(&metrics->cpu);
+    snapshot_cell_free(&metrics->sensors);
+    snapshot_cell_free(&metrics->gpu);
+    snapshot_cell_free(&metrics->network);
+    snapshot_cell_free(&metrics->sockets);
+    snapshot_cell_free(&metrics->cgroups);
+    snapshot_cell_free(&metrics->numa);
+    snapshot_cell_free(&metrics->storage);
+    snapshot_cell_free(&metrics->storage_latency);
+    snapshot_cell_free(&metrics->storage_health);
+    snapshot_cell_free(&metrics->volumes);
+    snapshot_cell_free(&metrics->filesystems);
+    snapshot_cell_free(&metrics->system);
+    free(metrics);
+}
+
+// ============================================================================
+// ÉCRIVAIN
+// ============================================================================
+
+void metrics_collect_cpu(Metrics *metrics) {
+    CpuSnapshot snapshot;
+    snapshot.usage_percent = get_cpu_usage_percent();
+    snapshot.timestamp = monotonic_seconds();
+    snapshot_publish(&metrics->cpu, &snapshot);
+}
+
+void metrics_collect_sensors(Metrics *metrics) {
+    SensorsSnapshot snapshot;
+    snapshot.temperature_celsius = get_cpu_temperature_celsius();
+    
+    // Une seule lecture de /proc/meminfo pour la mémoire et le swap
+    MemoryUsage *memory = &snapshot.memory;
+    if (get_memory_usage(memory) && memory->total_kb > 0) {
+        uint64_t used_kb = memory->available_kb < memory->total_kb ? memory->total_kb - memory->available_kb : 0;
+        snapshot.memory_usage_percent = 100.0f * (float)used_kb / (float)memory->total_kb;
+        snapshot.memory_available_gb = memory->available_kb > 0
+            ? (float)memory->available_kb / (1024.0f * 1024.0f) : -1.0f;
+        snapshot.memory_total_gb = (float)memory->total_kb / (1024.0f * 1024.0f);
+    } else {
+        snapshot.memory_usage_percent = -1.0f;
+        snapshot.memory_available_gb = -1.0f;
+        snapshot.memory_total_gb = -1.0f;
+    }
+    snapshot.zram_available = get_zram_usage(&snapshot.zram);
+    snapshot.paging_available = get_paging_rates(&snapshot.paging);
+    copy_text(snapshot.uptime, sizeof(snapshot.uptime), get_uptime_string());
+    snapshot.timestamp = monotonic_seconds();
+    snapshot_publish(&metrics->sensors, &snapshot);
+}
+
+void metrics_collect_gpu(Metrics *metrics) {
+    GpuSnapshot snapshot;
+    snapshot.usage_percent = get_gpu_usage_percent();
+    snapshot.timestamp = monotonic_seconds();
+    snapshot_publish(&metrics->gpu, &snapshot);
+}
+
+// Une seule lecture de /proc/net/dev pour toutes les interfaces suivies
+void metrics_collect_network(Metrics *metrics) {
+    NetworkSnapshot *staging = &metrics->network_staging;
+    const char *names[METRICS_MAX_INTERFACES];
+    static InterfaceRates rates[METRICS_MAX_INTERFACES];
+    for (int i = 0; i < staging->interface_count; i++) {
+        names[i] = staging->interfaces[i].name;
+    }
+    get_interface_rates(names, staging->interface_count, rates);
+    for (int i = 0; i < staging->interface_count; i++) {
+        InterfaceSnapshot *iface = &staging->interfaces[i];
+        iface->upload_kbps = rates[i].upload_kbps;
+        iface->download_kbps = rates[i].download_kbps;
+        iface->packets = rates[i].packets;
+    }
+    staging->timestamp = monotonic_seconds();
+    snapshot_publish(&metrics->network, staging);
+}
+
+void metrics_collect_network_addresses(Metrics *metrics) {
+    NetworkSnapshot *staging = &metrics->network_staging;
+    for (int i = 0; i < staging->interface_count; i++) {
+        InterfaceSnapshot *iface = &staging->interfaces[i];
+        copy_text(iface->address, sizeof(iface->address), get_interface_ip_address(iface->name));
+        // Renégociée rarement (câble, autoneg): même fréquence lente que l'adresse
+        iface->link_speed_mbps = get_interface_link_speed_mbps(iface->name);
+        copy_text(iface->duplex, sizeof(iface->duplex), get_interface_duplex(iface->name));
+    }
+    // Les débits restent ceux de la dernière mesure: même horodatage
+    snapshot_publish(&metrics->network, staging);
+}
+
+void metrics_collect_wireless(Metrics *metrics) {
+    NetworkSnapshot *staging = &metrics->network_staging;
+    bool has_wireless = false;
+    for (int i = 0; i < staging->interface_count; i++) {
+        InterfaceSnapshot *iface = &staging->interfaces[i];
+        if (iface->wireless) {
+            get_wireless_link_info(iface->name, &iface->wifi);
+            has_wireless = true;
+        }
+    }
+    // Pas d'interface WiFi: rien de nouveau à publier
+    if (has_wireless) {
+        snapshot_publish(&metrics->network, staging);
+    }
+}
+
+void metrics_collect_sockets(Metrics *metrics) {
+    SocketSnapshot snapshot;
+    snapshot.tcp_available = get_tcp_socket_summary(&snapshot.tcp);
+    snapshot.counters_available = get_protocol_counter_rates(&snapshot.counters);
+    snapshot.timestamp = monotonic_seconds();
+    snapshot_publish(&metrics->sockets, &snapshot);
+}
+
+void metrics_collect_cgroups(Metrics *metrics) {
+    CgroupSnapshot snapshot;
+    int top_count = get_top_cgroups(snapshot.top, METRICS_TOP_CGROUPS);
+    snapshot.available = top_count >= 0;
+    snapshot.top_count = top_count > 0 ? top_count : 0;
+    snapshot.cgroup_count = get_cgroup_count();
+    snapshot.timestamp = monotonic_seconds();
+    snapshot_publish(&metrics->cgroups, &snapshot);
+}
+
+void metrics_collect_numa(Metrics *metrics) {
+    NumaSnapshot snapshot;
+    int node_count = get_numa_node_usage(snapshot.nodes, TOPOLOGY_MAX_NODES);
+    snapshot.node_count = node_count > 0 ? node_count : 0;
+    snapshot.timestamp = monotonic_seconds();
+    snapshot_publish(&metrics->numa, &snapshot);
+}
+
+void metrics_collect_storage_usage(Metrics *metrics) {
+    StorageSnapshot *staging = &metrics->storage_staging;
+    for (int i = 0; i < staging->storage_count; i++) {
+        update_physical_storage_usage(&staging->storages[i]);
+    }
+    staging->timestamp = monotonic_seconds();
+    snapshot_publish(&metrics->storage, staging);
+}
+
+void metrics_collect_storage_latency(Metrics *metrics) {
+    static StorageLatencySnapshot snapshot;  // Hors de la pile (128 disques)
+    const StorageSnapshot *tracked = &metrics->storage_staging;
+    snapshot.storage_count = 0;
+    for (int i = 0; i < tracked->storage_count; i++) {
+        StorageLatencySample *sample = &snapshot.storages[snapshot.storage_count];
+        if (get_disk_latency(tracked->storages[i].name, &sample->latency)) {
+            copy_text(sample->name, sizeof(sample->name), tracked->storages[i].name);
+            snapshot.storage_count++;
+        }
+    }
+    snapshot.timestamp = monotonic_seconds();
+    snapshot_publish(&metrics->storage_latency, &snapshot);
+}
+
+// Disques non interrogeables (droits, SCSI, carte SD) publiés avec source = DISK_HEALTH_NONE
+void metrics_collect_storage_health(Metrics *metrics) {
+    static StorageHealthSnapshot snapshot;  // Hors de la pile (128 disques)
+    const StorageSnapshot *tracked = &metrics->storage_staging;
+    for (int i = 0; i < tracked->storage_count; i++) {
+        StorageHealthSample *sample = &snapshot.storages[i];
+        copy_text(sample->name, sizeof(sample->name), tracked->storages[i].name);
+        get_disk_health(tracked->storages[i].name, &sample->health);
+    }
+    snapshot.storage_count = tracked->storage_count;
+    snapshot.timestamp = monotonic_seconds();
+    snapshot_publish(&metrics->storage_health, &snapshot);
+}
+
+// Tous les volumes du système (pas seulement ceux des disques suivis): une lecture de /proc/diskstats
+void metrics_collect_volumes(Metrics *metrics) {
+    static VolumeSnapshot snapshot;  // Hors de la pile (~30 Ko)
+    snapshot.volume_count = get_logical_volumes(snapshot.volumes, METRICS_MAX_VOLUMES);
+    snapshot.timestamp = monotonic_seconds();
+    snapshot_publish(&metrics->volumes, &snapshot);
+}
+
+// Chaque montage n'est relu (statvfs) que toutes les FILESYSTEM_STAT_INTERVAL_SECONDS
+void metrics_collect_filesystems(Metrics *metrics) {
+    static FilesystemSnapshot snapshot;  // Hors de la pile (~50 Ko)
+    snapshot.filesystem_count = get_filesystem_usage(snapshot.filesystems, METRICS_MAX_FILESYSTEMS);
+    snapshot.timestamp = monotonic_seconds();
+    snapshot_publish(&metrics->filesystems, &snapshot);
+}
+
+// Une ligne par nœud NUMA: "Node 0: CPUs 0-15"
+static void format_numa_layout(char *buffer, size_t buffer_size) {
+    buffer[0] = '\0';
+    const CpuTopology *topology = get_cpu_topology();
+    size_t used = 0;
+    for (int i = 0; topology != NULL && i < topology->node_count; i++) {
+        int written = snprintf(buffer + used, buffer_size - used, "%sNode %d: CPUs %s",
+                               used > 0 ? "\n" : "", topology->nodes[i].id,
+                               topology->nodes[i].cpulist[0] != '\0' ? topology->nodes[i].cpulist : "none");
+        if (written < 0 || (size_t)written >= buffer_size - used) {
+            break;
+        }
+        used += (size_t)written;
+    }
+}
+
+void metrics_collect_system_info(Metrics *metrics) {
+    SystemSnapshot snapshot;
+    copy_text(snapshot.hardware_model, sizeof(snapshot.hardware_model), get_hardware_model());
+    copy_text(snapshot.processor, sizeof(snapshot.processor), get_processor_type());
+    copy_text(snapshot.architecture, sizeof(snapshot.architecture), get_architecture_info());
+    copy_text(snapshot.cpu_cores, sizeof(snapshot.cpu_cores), get_cpu_cores());
+    copy_text(snapshot.cpu_cache, sizeof(snapshot.cpu_cache), get_cpu_cache_summary());
+    format_numa_layout(snapshot.numa_layout, sizeof(snapshot.numa_layout));
+    copy_text(snapshot.gpu, sizeof(snapshot.gpu), get_gpu_info());
+    copy_text(snapshot.kernel, sizeof(snapshot.kernel), get_kernel_version());
+    copy_text(snapshot.distro, sizeof(snapshot.distro), get_distro_info());
+    copy_text(snapshot.desktop, sizeof(snapshot.desktop), get_desktop_environment());
+    copy_text(snapshot.locale, sizeof(snapshot.locale), get_locale_info());
+    copy_text(snapshot.hostname, sizeof(snapshot.hostname), get_hostname());
+    snapshot_publish(&metrics->system, &snapshot);
+}
+
+bool metrics_track_interface(Metrics *metrics, const char *interface_name) {
+    NetworkSnapshot *staging = &metrics->network_staging;
+    for (int i = 0; i < staging->interface_count; i++) {
+        if (strcmp(staging->interfaces[i].name, interface_name) == 0) {
+            return true;
+        }
+    }
+    if (staging->interface_count >= METRICS_MAX_INTERFACES) {
+        return false;
+    }
+
+    InterfaceSnapshot *iface = &staging->interfaces[staging->interface_count++];
+    memset(iface, 0, sizeof(*iface));
+    copy_text(iface->name, sizeof(iface->name), interface_name);
+    copy_text(iface->address, sizeof(iface->address), "Loading...");
+    iface->link_speed_mbps = -1;
+    copy_text(iface->duplex, sizeof(iface->duplex), "unknown");
+    const char *type = get_network_interface_type(interface_name);
+    iface->wireless = type != NULL && strcmp(type, "WiFi") == 0;
+    iface->wifi.tx_mcs = -1;
+    iface->wifi.rx_mcs = -1;
+    return true;
+}
+
+void metrics_untrack_interface(Metrics *metrics, const char *interface_name) {
+    NetworkSnapshot *staging = &metrics->network_staging;
+    for (int i = 0; i < staging->interface_count; i++) {
+        if (strcmp(staging->interfaces[i].name, interface_name) == 0) {
+            memmove(&staging->interfaces[i], &staging->interfaces[i + 1],
+                    (staging->interface_count - i - 1) * sizeof(InterfaceSnapshot));
+            staging->interface_count--;
+            break;
+        }
+    }
+    // Compteurs et adresse en cache: l'interface peut revenir avec un autre état
+    forget_network_interface(interface_name);
+}
+
+bool metrics_track_storage(Metrics *metrics, const PhysicalStorage *storage) {
+    StorageSnapshot *staging = &metrics->storage_staging;
+    for (int i = 0; i < staging->storage_count; i++) {
+        if (strcmp(staging->storages[i].name, storage->name) == 0) {
+            return true;
+        }
+    }
+    if (staging->storage_count >= METRICS_MAX_STORAGES) {
+        return false;
+    }
+
+    staging->storages[staging->storage_count++] = *storage;
+    return true;
+}
+
+void metrics_untrack_storage(Metrics *metrics, const char *storage_name) {
+    StorageSnapshot *staging = &metrics->storage_staging;
+    for (int i = 0; i < staging->storage_count; i++) {
+        if (strcmp(staging->storages[i].name, storage_name) == 0) {
+            memmove(&staging->storages[i], &staging->storages[i + 1],
+                    (staging->storage_count - i - 1) * sizeof(PhysicalStorage));
+            staging->storage_count--;
+            break;
+        }
+    }
+    // Un autre disque peut reprendre le même nom (et un autre numéro de périphérique)
+    forget_disk_health(storage_name);
+    forget_disk_latency(storage_name);
+}
+
+void metrics_set_storage_latency_paused(Metrics *metrics, bool paused) {
+    (void)metrics;
+    set_block_latency_paused(paused);
+}
+
+// ============================================================================
+// LECTEURS
+// ============================================================================
+
+uint64_t metrics_read_cpu(const Metrics *metrics, CpuSnapshot *snapshot) {
+    return snapshot_read(&metrics->cpu, snapshot);
+}
+
+uint64_t metrics_read_sensors(const Metrics *metrics, SensorsSnapshot *snapshot) {
+    return snapshot_read(&metrics->sensors, snapshot);
+}
+
+uint64_t metrics_read_gpu(const Metrics *metrics, GpuSnapshot *snapshot) {
+    return snapshot_read(&metrics->gpu, snapshot);
+}
+
+uint64_t metrics_read_network(const Metrics *metrics, NetworkSnapshot *snapshot) {
+    return snapshot_read(&metrics->network, snapshot);
+}
+
+uint64_t metrics_read_sockets(const Metrics *metrics, SocketSnapshot *snapshot) {
+    return snapshot_read(&metrics->sockets, snapshot);
+}
+
+uint64_t metrics_read_cgroups(const Metrics *metrics, CgroupSnapshot *snapshot) {
+    return snapshot_read(&metrics->cgroups, snapshot);
+}
+
+uint64_t metrics_read_numa(const Metrics *metrics, NumaSnapshot *snapshot) {
+    return snapshot_read(&metrics->numa, snapshot);
+}
+
+uint64_t metrics_read_storage(const Metrics *metrics, StorageSnapshot *snapshot) {
+    return snapshot_read(&metrics->storage, snapshot);
+}
+
+uint64_t metrics_read_storage_latency(const Metrics *metrics, StorageLatencySnapshot *snapshot) {
+    return snapshot_read(&metrics->storage_latency, snapshot);
+}
+
+uint64_t metrics_read_storage_health(const Metrics *metrics, StorageHealthSnapshot *snapshot) {
+    return snapshot_read(&metrics->storage_health, snapshot);
+}
+
+uint64_t metrics_read_volumes(const Metrics *metrics, VolumeSnapshot *snapshot) {
+    return snapshot_read(&metrics->volumes, snapshot);
+}
+
+uint64_t metrics_read_filesystems(const Metrics *metrics, FilesystemSnapshot *snapshot) {
+    return snapshot_read(&metrics->filesystems, snapshot);
+}
+
+uint64_t metrics_read_system_info(const Metrics *metrics, SystemSnapshot *snapshot) {
+    return snapshot_read(&metrics->system, snapshot);
+}
@@ -0,0 +1,393 @@
+/*
+ * mount_table.c
+ * Mount table parsed from /proc/self/mountinfo, each mount resolved to its
+ * physical disks through /sys/class/block/<dev>/slaves (shared with volume_info.c)
+ */
+
+#include "mount_table.h"
+#include "sysroot.h"
+#include "parse_utils.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <dirent.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/sysmacros.h>
+
+#define MAX_STACK_DEPTH  8      // dm sur dm sur md sur partition...
+
+static pthread_mutex_t table_lock = PTHREAD_MUTEX_INITIALIZER;
+static int mountinfo_fd = -1;
+static MountEntry *table = NULL;
+static int table_count = 0;
+static int table_capacity = 0;
+static char *text = NULL;       // Dernière lecture de mountinfo
+static size_t text_capacity = 0;
+
+// ============================================================================
+// RÉSOLUTION DU PÉRIPHÉRIQUE VERS LES DISQUES
+// ============================================================================
+
+// Dernier composant d'une cible de lien sysfs ("../../devices/.../block/sda/sda1" -> "sda1")
+static bool read_link_name(const char *path, char *name, size_t name_size, char *parent, size_t parent_size) {
+    char full_path[PATH_MAX];
+    char target[PATH_MAX];
+    if (!sysroot_path(full_path, sizeof(full_path), "%s", path)) {
+        return false;
+    }
+    ssize_t length = readlink(full_path, target, sizeof(target) - 1);
+    if (length <= 0) {
+        return false;
+    }
+    target[length] = '\0';
+
+    // Un nom tronqué désignerait un autre périphérique: échec plutôt que copie partielle
+    char *last = strrchr(target, '/');
+    int written = snprintf(name, name_size, "%s", last != NULL ? last + 1 : target);
+    if (written < 0 || (size_t)written >= name_size) {
+        return false;
+    }
+    if (parent != NULL) {
+        parent[0] = '\0';
+        if (last != NULL) {
+            *last = '\0';
+            char *previous = strrchr(target, '/');
+            written = snprintf(parent, parent_size, "%s", previous != NULL ? previous + 1 : target);
+            if (written < 0 || (size_t)written >= parent_size) {
+                return false;
+            }
+        }
+    }
+    return name[0] != '\0';
+}
+
+static void add_disk(MountEntry *entry, const char *disk) {
+    for (int i = 0; i < entry->disk_count; i++) {
+        if (strcmp(entry->disks[i], disk) == 0) {
+            return;
+        }
+    }
+    if (entry->disk_count < MOUNT_MAX_DISKS) {
+        snprintf(entry->disks[entry->disk_count++], sizeof(entry->disks[0]), "%s", disk);
+    }
+}
+
+// Descendre les slaves (dm, md) jusqu'aux partitions, puis remonter de la partition au disque
+static void collect_members(const char *name, BlockMember *members, int *count, int max_members, int depth) {
+    char path[PATH_MAX];
+    snprintf(path, sizeof(path), "/sys/class/block/%s/slaves", name);
+    DIR *dir = depth < MAX_STACK_DEPTH ? sysroot_opendir(path) : NULL;
+    bool has_slaves = false;
+    if (dir != NULL) {
+        struct dirent *slave;
+        while ((slave = readdir(dir)) != NULL) {
+            if (slave->d_name[0] != '.') {
+                has_slaves = true;
+                collect_members(slave->d_name, members, count, max_members, depth + 1);
+            }
+        }
+        closedir(dir);
+    }
+    if (has_slaves) {
+        return;
+    }
+
+    // Même partition atteinte par deux chemins: un seul membre
+    for (int i = 0; i < *count; i++) {
+        if (strcmp(members[i].device, name) == 0) {
+            return;
+        }
+    }
+    if (*count >= max_members) {
+        return;
+    }
+    BlockMember *member = &members[(*count)++];
+    snprintf(member->device, sizeof(member->device), "%s", name);
+    snprintf(member->disk, sizeof(member->disk), "%s", name);
+
+    // Partition: /sys/class/block/sda1 pointe vers .../block/sda/sda1
+    char partition[32];
+    char link_path[64];
+    char link_name[32];
+    char parent[32];
+    snprintf(path, sizeof(path), "/sys/class/block/%s/partition", name);
+    snprintf(link_path, sizeof(link_path), "/sys/class/block/%.31s", name);
+    if (parse_read_file(path, partition, sizeof(partition)) > 0 &&
+        read_link_name(link_path, link_name, sizeof(link_name), parent, sizeof(parent)) && parent[0] != '\0') {
+        snprintf(member->disk, sizeof(member->disk), "%s", parent);
+    }
+}
+
+int get_block_members(const char *device_name, BlockMember *members, int max_members) {
+    if (device_name == NULL || members == NULL || max_members <= 0 || strchr(device_name, '/') != NULL) {
+        return 0;
+    }
+    int count = 0;
+    collect_members(device_name, members, &count, max_members, 0);
+    return count;
+}
+
+// Périphérique bloc d'un montage: major:minor de mountinfo, sinon la source (btrfs: 0:N anonyme)
+static bool resolve_mount_device(MountEntry *entry, unsigned int major, unsigned int minor) {
+    if (major == 0) {
+        if (strncmp(entry->source, "/dev/", 5) != 0) {
+            return false;           // tmpfs, proc, overlay, nfs...
+        }
+        if (sysroot_is_set()) {
+            // Arborescence de test: pas de /dev, le nom du périphérique suffit
+            const char *name = strrchr(entry->source, '/') + 1;
+            char dev_path[PATH_MAX];
+            char dev_text[32];
+            snprintf(dev_path, sizeof(dev_path), "/sys/class/block/%.64s/dev", name);
+            if (parse_read_file(dev_path, dev_text, sizeof(dev_text)) <= 0 ||
+                sscanf(dev_text, "%u:%u", &major, &minor) != 2) {
+                return false;
+            }
+        } else {
+            struct stat st;
+            if (stat(entry->source, &st) != 0 || !S_ISBLK(st.st_mode)) {
+                return false;
+            }
+            major = major(st.st_rdev);
+            minor = minor(st.st_rdev);
+        }
+    }
+
+    char path[64];
+    snprintf(path, sizeof(path), "/sys/dev/block/%u:%u", major, minor);
+    if (!read_link_name(path, entry->device, sizeof(entry->device), NULL, 0)) {
+        return false;
+    }
+    entry->major = major;
+    entry->minor = minor;
+    return true;
+}
+
+// ============================================================================
+// LECTURE DE MOUNTINFO
+// ============================================================================
+
+// Décoder les échappements octaux du noyau ("\040" = espace) sur place
+static void unescape_octal(char *value) {
+    char *out = value;
+    for (char *in = value; *in != '\0'; in++) {
+        if (in[0] == '\\' && in[1] >= '0' && in[1] <= '3' && in[2] >= '0' && in[2] <= '7' &&
+            in[3] >= '0' && in[3] <= '7') {
+            *out++ = (char)((in[1] - '0') * 64 + (in[2] - '0') * 8 + (in[3] - '0'));
+            in += 3;
+        } else {
+            *out++ = *in;
+        }
+    }
+    *out = '\0';
+}
+
+// Ligne: id parent major:minor racine point options [optionnels...] - type source options_sb
+static bool parse_mountinfo_line(char *line, MountEntry *entry, unsigned int *major, unsigned int *minor) {
+    char *fields[12];
+    int count = 0;
+    char *save = NULL;
+    bool after_separator = false;
+    for (char *field = strtok_r(line, " ", &save); field != NULL; field = strtok_r(NULL, " ", &save)) {
+        if (count >= 6 && !after_separator) {
+            after_separator = strcmp(field, "-") == 0;  // Champs optionnels (shared:N, master:N) ignorés
+            continue;
+        }
+        if (count < 12) {
+            fields[count++] = field;
+        }
+    }
+    if (count < 8 || sscanf(fields[2], "%u:%u", major, minor) != 2) {
+        return false;
+    }
+
+    memset(entry, 0, sizeof(*entry));
+    unescape_octal(fields[3]);
+    unescape_octal(fields[4]);
+    unescape_octal(fields[7]);
+    entry->subtree = strcmp(fields[3], "/") != 0;
+    entry->read_only = strncmp(fields[5], "ro", 2) == 0 && (fields[5][2] == ',' || fields[5][2] == '\0');
+    snprintf(entry->mount_point, sizeof(entry->mount_point), "%s", fields[4]);
+    snprintf(entry->fstype, sizeof(entry->fstype), "%s", fields[6]);
+    snprintf(entry->source, sizeof(entry->source), "%s", fields[7]);
+    return true;
+}
+
+static bool read_mountinfo(void) {
+    if (lseek(mountinfo_fd, 0, SEEK_SET) < 0) {
+        return false;
+    }
+    size_t length = 0;
+    for (;;) {
+        if (length + 4096 >= text_capacity) {
+            size_t new_capacity = text_capacity > 0 ? text_capacity * 2 : 16384;
+            char *grown = realloc(text, new_capacity);
+            if (grown == NULL) {
+                return false;
+            }
+            text = grown;
+            text_capacity = new_capacity;
+        }
+        ssize_t count = read(mountinfo_fd, text + length, text_capacity - 1 - length);
+        if (count < 0) {
+            return false;
+        }
+        if (count == 0) {
+            break;
+        }
+        length += (size_t)count;
+    }
+    text[length] = '\0';
+    return true;
+}
+
+static void load_mount_table(void) {
+    table_count = 0;
+    if (!read_mountinfo()) {
+        return;
+    }
+
+    char *save = NULL;
+    for (char *line = strtok_r(text, "\n", &save); line != NULL; line = strtok_r(NULL, "\n", &save)) {
+        if (table_count == table_capacity) {
+            int new_capacity = table_capacity > 0 ? table_capacity * 2 : 64;
+            MountEntry *grown = realloc(table, sizeof(MountEntry) * new_capacity);
+            if (grown == NULL) {
+                return;
+            }
+            table = grown;
+            table_capacity = new_capacity;
+        }
+
+        MountEntry *entry = &table[table_count];
+        unsigned int major = 0;
+        unsigned int minor = 0;
+        if (!parse_mountinfo_line(line, entry, &major, &minor)) {
+            continue;
+        }
+
+        // Même périphérique qu'un montage déjà lu (bind, sous-volume): pas de nouveau parcours de sysfs
+        const MountEntry *same = NULL;
+        for (int i = 0; i < table_count && major != 0; i++) {
+            if (table[i].major == major && table[i].minor == minor) {
+                same = &table[i];
+                break;
+            }
+        }
+        if (same != NULL) {
+            snprintf(entry->device, sizeof(entry->device), "%s", same->device);
+            entry->major = major;
+            entry->minor = minor;
+            entry->disk_count = same->disk_count;
+            memcpy(entry->disks, same->disks, sizeof(entry->disks));
+        } else if (resolve_mount_device(entry, major, minor)) {
+            BlockMember members[MOUNT_MAX_DISKS * 4];
+            int member_count = get_block_members(entry->device, members, MOUNT_MAX_DISKS * 4);
+            for (int i = 0; i < member_count; i++) {
+                add_disk(entry, members[i].disk);
+            }
+        } else {
+            continue;               // Pas sur un périphérique bloc
+        }
+        table_count++;
+    }
+}
+
+// Relire la table au premier appel, puis seulement quand le noyau signale un changement
+static bool refresh_mount_table(void) {
+    if (mountinfo_fd < 0) {
+        char path[PATH_MAX];
+        if (!sysroot_path(path, sizeof(path), "/proc/self/mountinfo")) {
+            return false;
+        }
+        mountinfo_fd = open(path, O_RDONLY | O_CLOEXEC);
+        if (mountinfo_fd < 0) {
+            return false;
+        }
+        load_mount_table();
+        return true;
+    }
+
+    struct pollfd changed = { .fd = mountinfo_fd, .events = POLLPRI };
+    if (poll(&changed, 1, 0) > 0 && (changed.revents & (POLLPRI | POLLERR)) != 0) {
+        load_mount_table();
+    }
+    return true;
+}
+
+// ============================================================================
+// API
+// ============================================================================
+
+int get_mount_table(MountEntry *entries, int max_entries) {
+    if (entries == NULL || max_entries <= 0) {
+        return 0;
+    }
+    pthread_mutex_lock(&table_lock);
+    int count = -1;
+    if (refresh_mount_table()) {
+        count = table_count < max_entries ? table_count : max_entries;
+        memcpy(entries, table, sizeof(MountEntry) * (size_t)count);
+    }
+    pthread_mutex_unlock(&table_lock);
+    return count;
+}
+
+static bool uses_disk(const MountEntry *entry, const char *storage_name) {
+    for (int i = 0; i < entry->disk_count; i++) {
+        if (strcmp(entry->disks[i], storage_name) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Un seul montage par système de fichiers (storage_name NULL: tous les disques)
+static int copy_filesystems(const char *storage_name, MountEntry *entries, int max_entries) {
+    if (entries == NULL || max_entries <= 0) {
+        return 0;
+    }
+    pthread_mutex_lock(&table_lock);
+    int count = 0;
+    if (refresh_mount_table()) {
+        for (int i = 0; i < table_count; i++) {
+            const MountEntry *entry = &table[i];
+            if (storage_name != NULL && !uses_disk(entry, storage_name)) {
+                continue;
+            }
+            // Un seul montage par périphérique: le principal remplace un bind vu avant lui
+            int existing = -1;
+            for (int j = 0; j < count; j++) {
+                if (entries[j].major == entry->major && entries[j].minor == entry->minor) {
+                    existing = j;
+                    break;
+                }
+            }
+            if (existing >= 0) {
+                if (entries[existing].subtree && !entry->subtree) {
+                    entries[existing] = *entry;
+                }
+            } else if (count < max_entries) {
+                entries[count++] = *entry;
+            }
+        }
+    }
+    pthread_mutex_unlock(&table_lock);
+    return count;
+}
+
+int get_storage_filesystems(const char *storage_name, MountEntry *entries, int max_entries) {
+    if (storage_name == NULL) {
+        return 0;
+    }
+    return copy_filesystems(storage_name, entries, max_entries);
+}
+
+int get_mounted_filesystems(MountEntry *entries, int max_entries) {
+    return copy_filesystems(NULL, entries, max_entries);
+}
@@ -4,12 +4,17 @@
  */
 
 #include "network_info.h"
+#include "sysroot.h"
+#include "parse_utils.h"
+#include "counter_delta.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <stdbool.h>
 #include <unistd.h>
 #include <sys/stat.h>
+#include <dirent.h>
+#include <limits.h>
 
 const char* get_hostname(void) {
     static char hostname_buffer[256] = {0};
@@ -20,7 +25,7 @@ const char* get_hostname(void) {
     }
     
     // Read hostname from /etc/hostname
-    FILE *fp = fopen("/etc/hostname", "r");
+    FILE *fp = sysroot_fopen("/etc/hostname", "r");
     if (fp != NULL) {
         if (fgets(hostname_buffer, sizeof(hostname_buffer), fp) != NULL) {
             // Remove newline
@@ -73,33 +78,52 @@ const char* get_local_ip_address(void) {
     return ip_buffer;
 }
 
-const char* get_interface_ip_address(const char *interface_name) {
-    static char ip_buffers[10][64] = {0};
-    static char interface_names[10][64] = {0};
-    static int buffer_count = 0;
-    
-    if (interface_name == NULL) {
-        return "N/A";
+// Cache des adresses IP par interface (une allocation par entrée: l'adresse
+// retournée reste valide quand le tableau grandit)
+typedef struct {
+    char interface_name[64];
+    char address[64];
+} InterfaceAddress;
+
+static InterfaceAddress **ip_cache = NULL;
+static int ip_cache_count = 0;
+static int ip_cache_capacity = 0;
+
+// Chercher ou créer l'entrée d'une interface (NULL si plus de mémoire)
+static InterfaceAddress* get_ip_cache_entry(const char *interface_name) {
+    for (int i = 0; i < ip_cache_count; i++) {
+        if (strcmp(ip_cache[i]->interface_name, interface_name) == 0) {
+            return ip_cache[i];
+        }
     }
     
-    // Chercher si on a déjà un buffer pour cette interface
-    int buffer_index = -1;
-    for (int i = 0; i < buffer_count; i++) {
-        if (strcmp(interface_names[i], interface_name) == 0) {
-            buffer_index = i;
-            break;
+    if (ip_cache_count == ip_cache_capacity) {
+        int new_capacity = ip_cache_capacity > 0 ? ip_cache_capacity * 2 : 8;
+        InterfaceAddress **grown = realloc(ip_cache, sizeof(InterfaceAddress *) * new_capacity);
+        if (grown == NULL) {
+            return NULL;
         }
+        ip_cache = grown;
+        ip_cache_capacity = new_capacity;
     }
     
-    // Créer un nouveau buffer si nécessaire
-    if (buffer_index == -1 && buffer_count < 10) {
-        buffer_index = buffer_count;
-        strncpy(interface_names[buffer_index], interface_name, sizeof(interface_names[0]) - 1);
-        buffer_count++;
+    InterfaceAddress *entry = calloc(1, sizeof(InterfaceAddress));
+    if (entry == NULL) {
+        return NULL;
+    }
+    strncpy(entry->interface_name, interface_name, sizeof(entry->interface_name) - 1);
+    ip_cache[ip_cache_count++] = entry;
+    return entry;
+}
+
+const char* get_interface_ip_address(const char *interface_name) {
+    if (interface_name == NULL) {
+        return "N/A";
     }
     
-    if (buffer_index == -1) {
-        return "N/A";  // Trop d'interfaces
+    InterfaceAddress *entry = get_ip_cache_entry(interface_name);
+    if (entry == NULL) {
+        return "N/A";
     }
     
     // Utiliser 'ip addr show' pour obtenir l'IP de cette interface
@@ -110,142 +134,207 @@ const char* get_interface_ip_address(const char *interface_name) {
     
     FILE *fp = popen(command, "r");
     if (fp != NULL) {
-        if (fgets(ip_buffers[buffer_index], sizeof(ip_buffers[0]), fp) != NULL) {
+        entry->address[0] = '\0';
+        if (fgets(entry->address, sizeof(entry->address), fp) != NULL) {
             // Supprimer la newline
-            size_t len = strlen(ip_buffers[buffer_index]);
-            if (len > 0 && ip_buffers[buffer_index][len-1] == '\n') {
-                ip_buffers[buffer_index][len-1] = '\0';
-            }
-            pclose(fp);
-            
-            // Si on a une IP valide, la retourner
-            if (strlen(ip_buffers[buffer_index]) > 0) {
-                return ip_buffers[buffer_index];
+            size_t len = strlen(entry->address);
+            if (len > 0 && entry->address[len-1] == '\n') {
+                entry->address[len-1] = '\0';
             }
         }
         pclose(fp);
+        
+        // Si on a une IP valide, la retourner
+        if (entry->address[0] != '\0') {
+            return entry->address;
+        }
     }
     
     // Pas d'IP assignée
-    strncpy(ip_buffers[buffer_index], "No IP", sizeof(ip_buffers[0]) - 1);
-    return ip_buffers[buffer_index];
+    snprintf(entry->address, sizeof(entry->address), "No IP");
+    return entry->address;
+}
+
+// DEVTYPE de /sys/class/net/<interface>/uevent ("vlan", "wireguard", "bond"...), vide si absent
+static void read_interface_devtype(const char *interface_name, char *devtype, size_t devtype_size) {
+    devtype[0] = '\0';
+    char path[PATH_MAX];
+    char text[512];
+    if (!sysroot_path(path, sizeof(path), "/sys/class/net/%s/uevent", interface_name)) {
+        return;
+    }
+    long length = parse_read_file_at(path, text, sizeof(text));
+    if (length <= 0) {
+        return;
+    }
+
+    const char *end = text + length;
+    for (const char *line = text; line < end; line = parse_next_line(line, end)) {
+        const char *value = parse_skip_prefix(line, end, "DEVTYPE=");
+        if (value != NULL) {
+            snprintf(devtype, devtype_size, "%.*s", (int)strcspn(value, "\n"), value);
+            return;
+        }
+    }
+}
+
+// Interfaces logiques sans lien "device" qui portent du trafic réel (VPN, VLAN, agrégat)
+// Retourne NULL pour les autres (pont, dummy, tunnels ip...)
+static const char* get_logical_interface_type(const char *interface_name) {
+    char devtype[32];
+    read_interface_devtype(interface_name, devtype, sizeof(devtype));
+    if (strcmp(devtype, "wireguard") == 0) {
+        return "VPN";
+    }
+    if (strcmp(devtype, "vlan") == 0) {
+        return "VLAN";
+    }
+    if (strcmp(devtype, "bond") == 0) {
+        return "Bond";
+    }
+    
+    // tun / tap (OpenVPN...): pas de DEVTYPE, mais un fichier tun_flags
+    char tun_flags_path[PATH_MAX];
+    struct stat tun_stat;
+    if (sysroot_path(tun_flags_path, sizeof(tun_flags_path), "/sys/class/net/%s/tun_flags", interface_name) &&
+        stat(tun_flags_path, &tun_stat) == 0) {
+        return "VPN";
+    }
+    return NULL;
+}
+
+const char* get_network_interface_type(const char *interface_name) {
+    if (interface_name == NULL || interface_name[0] == '\0') {
+        return NULL;
+    }
+    
+    // Ignorer loopback
+    if (strcmp(interface_name, "lo") == 0) {
+        return NULL;
+    }
+    
+    // Ignorer la plomberie des conteneurs et machines virtuelles (par préfixe)
+    if (strncmp(interface_name, "docker", 6) == 0 ||
+        strncmp(interface_name, "veth", 4) == 0 ||
+        strncmp(interface_name, "br-", 3) == 0 ||
+        strncmp(interface_name, "virbr", 5) == 0 ||
+        strncmp(interface_name, "vmnet", 5) == 0 ||
+        strncmp(interface_name, "vbox", 4) == 0) {
+        return NULL;
+    }
+    
+    // VPN, VLAN, bond: reconnus par leur DEVTYPE, apparus au démarrage ou à chaud
+    const char *logical_type = get_logical_interface_type(interface_name);
+    if (logical_type != NULL) {
+        return logical_type;
+    }
+    
+    // Vérifier si c'est une interface physique via le lien device
+    char device_path[256];
+    sysroot_path(device_path, sizeof(device_path), "/sys/class/net/%s/device", interface_name);
+    
+    struct stat stat_buf;
+    if (lstat(device_path, &stat_buf) != 0 || !S_ISLNK(stat_buf.st_mode)) {
+        // Pas un symlink ou n'existe pas -> interface virtuelle
+        return NULL;
+    }
+    
+    // Vérifier le type d'interface (type 1 = Ethernet, type 801 = WiFi 802.11)
+    char type_path[256];
+    sysroot_path(type_path, sizeof(type_path), "/sys/class/net/%s/type", interface_name);
+    char type_text[16];
+    long type_len = parse_read_file_at(type_path, type_text, sizeof(type_text));
+    uint64_t iface_type = 0;
+    if (type_len > 0) {
+        parse_u64(type_text, type_text + type_len, &iface_type);
+    }
+    
+    // Si type n'est ni 1 (Ethernet) ni 801 (WiFi), ignorer
+    if (iface_type != 1 && iface_type != 801) {
+        return NULL;
+    }
+    
+    // Déterminer le type d'interface de manière plus précise
+    const char *type = "Unknown";
+    
+    // Vérifier si c'est du WiFi via /sys/class/net/*/wireless
+    char wireless_path[256];
+    sysroot_path(wireless_path, sizeof(wireless_path), "/sys/class/net/%s/wireless", interface_name);
+    struct stat wireless_stat;
+    if (stat(wireless_path, &wireless_stat) == 0 && S_ISDIR(wireless_stat.st_mode)) {
+        type = "WiFi";
+    } else if (iface_type == 801) {
+        // Type 801 = WiFi même sans répertoire wireless
+        type = "WiFi";
+    } else {
+        // C'est probablement Ethernet si type == 1 et pas WiFi
+        if (strncmp(interface_name, "eth", 3) == 0 || strncmp(interface_name, "enp", 3) == 0 || 
+            strncmp(interface_name, "eno", 3) == 0 || strncmp(interface_name, "ens", 3) == 0) {
+            type = "Ethernet";
+        } else if (strncmp(interface_name, "wlan", 4) == 0 || strncmp(interface_name, "wlp", 3) == 0 ||
+                   strncmp(interface_name, "wlo", 3) == 0 || strncmp(interface_name, "wls", 3) == 0) {
+            type = "WiFi";
+        } else if (strncmp(interface_name, "ww", 2) == 0 || strncmp(interface_name, "usb", 3) == 0) {
+            type = "Mobile";
+        } else {
+            // Par défaut, si type 1, c'est Ethernet
+            type = "Ethernet";
+        }
+    }
+    
+    return type;
 }
 
 const char* get_network_interfaces(void) {
-    static char interfaces_buffer[512] = {0};
+    static char *interfaces_buffer = NULL;
     
     // Si déjà lu, retourner le cache
-    if (interfaces_buffer[0] != '\0') {
+    if (interfaces_buffer != NULL) {
         return interfaces_buffer;
     }
     
-    // Lire les interfaces réseau depuis /sys/class/net/
-    FILE *fp = popen("ls /sys/class/net/ 2>/dev/null", "r");
-    if (fp == NULL) {
-        strncpy(interfaces_buffer, "Unknown", sizeof(interfaces_buffer) - 1);
-        return interfaces_buffer;
+    // Lire les interfaces réseau depuis /sys/class/net/ (triées comme `ls`)
+    char net_path[PATH_MAX];
+    struct dirent **entries = NULL;
+    int entry_count = -1;
+    if (sysroot_path(net_path, sizeof(net_path), "/sys/class/net")) {
+        entry_count = scandir(net_path, &entries, NULL, alphasort);
+    }
+    if (entry_count < 0) {
+        return "Unknown";
     }
     
-    char interface[64];
-    char temp_buffer[512] = {0};
+    // Liste "eth0 (Ethernet), wlan0 (WiFi)" sans limite de nombre d'interfaces
+    char *list = NULL;
+    size_t list_len = 0;
     int count = 0;
     
-    while (fgets(interface, sizeof(interface), fp) != NULL && count < 5) {
-        // Supprimer la newline
-        size_t len = strlen(interface);
-        if (len > 0 && interface[len-1] == '\n') {
-            interface[len-1] = '\0';
-        }
-        
-        // Ignorer loopback
-        if (strcmp(interface, "lo") == 0) {
-            continue;
-        }
-        
-        // Ignorer les interfaces virtuelles par préfixe
-        if (strncmp(interface, "docker", 6) == 0 ||
-            strncmp(interface, "veth", 4) == 0 ||
-            strncmp(interface, "br-", 3) == 0 ||
-            strncmp(interface, "virbr", 5) == 0 ||
-            strncmp(interface, "vmnet", 5) == 0 ||
-            strncmp(interface, "vbox", 4) == 0 ||
-            strncmp(interface, "tun", 3) == 0 ||
-            strncmp(interface, "tap", 3) == 0) {
-            continue;
-        }
-        
-        // Vérifier si c'est une interface physique via le lien device
-        char device_path[256];
-        snprintf(device_path, sizeof(device_path), "/sys/class/net/%s/device", interface);
-        
-        struct stat stat_buf;
-        if (lstat(device_path, &stat_buf) != 0 || !S_ISLNK(stat_buf.st_mode)) {
-            // Pas un symlink ou n'existe pas -> interface virtuelle
-            continue;
-        }
-        
-        // Vérifier le type d'interface (type 1 = Ethernet, type 801 = WiFi 802.11)
-        char type_path[256];
-        snprintf(type_path, sizeof(type_path), "/sys/class/net/%s/type", interface);
-        FILE *type_file = fopen(type_path, "r");
-        int iface_type = 0;
-        if (type_file != NULL) {
-            fscanf(type_file, "%d", &iface_type);
-            fclose(type_file);
-        }
-        
-        // Si type n'est ni 1 (Ethernet) ni 801 (WiFi), ignorer
-        if (iface_type != 1 && iface_type != 801) {
-            continue;
-        }
-        
-        // Déterminer le type d'interface de manière plus précise
-        const char *type = "Unknown";
+    for (int i = 0; i < entry_count; i++) {
+        const char *name = entries[i]->d_name;
         
-        // Vérifier si c'est du WiFi via /sys/class/net/*/wireless
-        char wireless_path[256];
-        snprintf(wireless_path, sizeof(wireless_path), "/sys/class/net/%s/wireless", interface);
-        struct stat wireless_stat;
-        if (stat(wireless_path, &wireless_stat) == 0 && S_ISDIR(wireless_stat.st_mode)) {
-            type = "WiFi";
-        } else if (iface_type == 801) {
-            // Type 801 = WiFi même sans répertoire wireless
-            type = "WiFi";
-        } else {
-            // C'est probablement Ethernet si type == 1 et pas WiFi
-            if (strncmp(interface, "eth", 3) == 0 || strncmp(interface, "enp", 3) == 0 || 
-                strncmp(interface, "eno", 3) == 0 || strncmp(interface, "ens", 3) == 0) {
-                type = "Ethernet";
-            } else if (strncmp(interface, "wlan", 4) == 0 || strncmp(interface, "wlp", 3) == 0 ||
-                       strncmp(interface, "wlo", 3) == 0 || strncmp(interface, "wls", 3) == 0) {
-                type = "WiFi";
-            } else if (strncmp(interface, "ww", 2) == 0 || strncmp(interface, "usb", 3) == 0) {
-                type = "Mobile";
-            } else {
-                // Par défaut, si type 1, c'est Ethernet
-                type = "Ethernet";
+        // Déterminer le type (NULL si interface ignorée)
+        const char *type = name[0] != '.' ? get_network_interface_type(name) : NULL;
+        if (type != NULL) {
+            size_t entry_len = strlen(name) + strlen(type) + 5;  // ", " + " (" + ")"
+            char *grown = realloc(list, list_len + entry_len + 1);
+            if (grown != NULL) {
+                list = grown;
+                list_len += snprintf(list + list_len, entry_len + 1, "%s%s (%s)",
+                                     count > 0 ? ", " : "", name, type);
+                count++;
             }
         }
-        
-        // Ajouter à la liste
-        if (count > 0) {
-            strncat(temp_buffer, ", ", sizeof(temp_buffer) - strlen(temp_buffer) - 1);
-        }
-        
-        char iface_entry[128];
-        snprintf(iface_entry, sizeof(iface_entry), "%s (%s)", interface, type);
-        strncat(temp_buffer, iface_entry, sizeof(temp_buffer) - strlen(temp_buffer) - 1);
-        count++;
+        free(entries[i]);
     }
-    pclose(fp);
+    free(entries);
     
     if (count == 0) {
-        strncpy(interfaces_buffer, "No interfaces found", sizeof(interfaces_buffer) - 1);
-    } else {
-        strncpy(interfaces_buffer, temp_buffer, sizeof(interfaces_buffer) - 1);
+        free(list);
+        list = strdup("No interfaces found");
     }
     
-    return interfaces_buffer;
+    interfaces_buffer = list;
+    return interfaces_buffer != NULL ? interfaces_buffer : "Unknown";
 }
 
 float get_network_upload_kbps(void) {
@@ -260,65 +349,196 @@ float get_network_download_kbps(void) {
 // STATISTIQUES RÉSEAU PAR INTERFACE
 // ============================================================================
 
+// Compteurs d'une ligne de /proc/net/dev conservés par SysWatch
+typedef struct {
+    uint64_t rx_bytes;
+    uint64_t tx_bytes;
+    uint64_t packets[PACKET_COUNTER_COUNT];  // Ordre de InterfacePacketRates
+} InterfaceCounters;
+
+// Valeurs précédentes des compteurs d'une interface pour un appelant
+typedef struct {
+    CounterDelta rx_bytes;
+    CounterDelta tx_bytes;
+    CounterDelta packets[PACKET_COUNTER_COUNT];
+} InterfaceDeltas;
+
 // Structure pour stocker les stats réseau d'une interface
+// (compteurs 64 bits: /proc/net/dev affiche rtnl_link_stats64 sur toutes les architectures)
 typedef struct {
     char interface_name[64];
-    unsigned long rx_bytes;
-    unsigned long tx_bytes;
-    unsigned long rx_bytes_prev;
-    unsigned long tx_bytes_prev;
+    InterfaceDeltas batch;          // get_interface_rates()
+    InterfaceDeltas single;         // Fonctions par interface: chacune n'avance que ses compteurs
+    int line_hint;                  // Ligne de /proc/net/dev où l'interface a été vue en dernier
 } NetworkStats;
 
-// Cache pour les statistiques réseau par interface
-static NetworkStats net_stats[10] = {0};
+// Cache pour les statistiques réseau par interface (agrandi à la demande)
+static NetworkStats *net_stats = NULL;
 static int net_stats_count = 0;
+static int net_stats_capacity = 0;
+
+// Dernière lecture de /proc/net/dev: tampon statique (~110 octets par interface) et débuts de ligne
+static char net_dev_buffer[65536];
+static const char **net_dev_lines = NULL;
+static int net_dev_line_count = 0;
+static int net_dev_line_capacity = 0;
+static const char *net_dev_end = NULL;
 
-// Lire les bytes reçus et transmis d'une interface depuis /proc/net/dev
-static bool read_interface_stats(const char *interface_name, unsigned long *rx_bytes, unsigned long *tx_bytes) {
-    FILE *fp = fopen("/proc/net/dev", "r");
-    if (fp == NULL) {
+// Chercher ou créer l'entrée d'une interface (NULL si plus de mémoire)
+static NetworkStats* get_net_stats_entry(const char *interface_name) {
+    for (int i = 0; i < net_stats_count; i++) {
+        if (strcmp(net_stats[i].interface_name, interface_name) == 0) {
+            return &net_stats[i];
+        }
+    }
+    
+    if (net_stats_count == net_stats_capacity) {
+        int new_capacity = net_stats_capacity > 0 ? net_stats_capacity * 2 : 8;
+        NetworkStats *grown = realloc(net_stats, sizeof(NetworkStats) * new_capacity);
+        if (grown == NULL) {
+            return NULL;
+        }
+        net_stats = grown;
+        net_stats_capacity = new_capacity;
+    }
+    
+    NetworkStats *entry = &net_stats[net_stats_count++];
+    memset(entry, 0, sizeof(NetworkStats));
+    strncpy(entry->interface_name, interface_name, sizeof(entry->interface_name) - 1);
+    return entry;
+}
+
+// Lire /proc/net/dev d'un bloc et repérer le début de chaque ligne d'interface
+static bool read_net_dev(void) {
+    net_dev_line_count = 0;
+    long length = parse_read_file("/proc/net/dev", net_dev_buffer, sizeof(net_dev_buffer));
+    if (length <= 0) {
         return false;
     }
     
-    char line[256];
-    bool found = false;
+    net_dev_end = net_dev_buffer + length;
     
     // Ignorer les 2 premières lignes (headers)
-    fgets(line, sizeof(line), fp);
-    fgets(line, sizeof(line), fp);
-    
-    while (fgets(line, sizeof(line), fp) != NULL) {
-        // Format: "interface: rx_bytes rx_packets rx_errors ... tx_bytes tx_packets ..."
-        char name[64];
-        unsigned long rx, rx_packets, rx_errors, rx_drops, rx_fifo, rx_frame, rx_compressed, rx_multicast;
-        unsigned long tx, tx_packets, tx_errors, tx_drops, tx_fifo, tx_colls, tx_carrier, tx_compressed;
-        
-        // Extraire le nom de l'interface (avant le ':')
-        char *colon = strchr(line, ':');
-        if (colon == NULL) continue;
-        
-        int name_len = colon - line;
-        strncpy(name, line, name_len);
-        name[name_len] = '\0';
-        
-        // Nettoyer les espaces au début
-        char *clean_name = name;
-        while (*clean_name == ' ') clean_name++;
-        
-        if (strcmp(clean_name, interface_name) == 0) {
-            // Parser les statistiques
-            sscanf(colon + 1, "%lu %lu %lu %lu %lu %lu %lu %lu %lu %lu %lu %lu %lu %lu %lu %lu",
-                   &rx, &rx_packets, &rx_errors, &rx_drops, &rx_fifo, &rx_frame, &rx_compressed, &rx_multicast,
-                   &tx, &tx_packets, &tx_errors, &tx_drops, &tx_fifo, &tx_colls, &tx_carrier, &tx_compressed);
-            
-            *rx_bytes = rx;
-            *tx_bytes = tx;
-            found = true;
-            break;
+    const char *line = parse_next_line(net_dev_buffer, net_dev_end);
+    line = parse_next_line(line, net_dev_end);
+    
+    for (; line < net_dev_end; line = parse_next_line(line, net_dev_end)) {
+        if (net_dev_line_count == net_dev_line_capacity) {
+            int new_capacity = net_dev_line_capacity > 0 ? net_dev_line_capacity * 2 : 64;
+            const char **grown = realloc(net_dev_lines, sizeof(const char *) * new_capacity);
+            if (grown == NULL) {
+                return false;
+            }
+            net_dev_lines = grown;
+            net_dev_line_capacity = new_capacity;
+        }
+        net_dev_lines[net_dev_line_count++] = line;
+    }
+    return true;
+}
+
+// Compteurs d'une ligne de la dernière lecture, si elle décrit cette interface
+static bool parse_net_dev_line(int index, const char *interface_name, size_t name_len,
+                               InterfaceCounters *counters) {
+    // Format: "  eth0: rx_bytes rx_packets rx_errors ... tx_bytes tx_packets ..."
+    const char *line = net_dev_lines[index];
+    const char *line_end = parse_next_line(line, net_dev_end);
+    const char *colon = memchr(line, ':', (size_t)(line_end - line));
+    if (colon == NULL) {
+        return false;
+    }
+    
+    // Nom de l'interface: avant le ':' sans les espaces d'alignement
+    const char *name = line;
+    while (name < colon && *name == ' ') {
+        name++;
+    }
+    if ((size_t)(colon - name) != name_len || memcmp(name, interface_name, name_len) != 0) {
+        return false;
+    }
+    
+    // rx: bytes packets errs drop fifo frame compressed multicast, puis tx: bytes ...
+    uint64_t fields[16];
+    if (parse_u64_fields(colon + 1, line_end, fields, 16) < 12) {
+        return false;
+    }
+    counters->rx_bytes = fields[0];
+    counters->tx_bytes = fields[8];
+    counters->packets[0] = fields[1];    // rx_packets
+    counters->packets[1] = fields[9];    // tx_packets
+    counters->packets[2] = fields[2];    // rx_errs
+    counters->packets[3] = fields[10];   // tx_errs
+    counters->packets[4] = fields[3];    // rx_drop
+    counters->packets[5] = fields[11];   // tx_drop
+    return true;
+}
+
+// Compteurs d'une interface dans la dernière lecture
+// Les lignes gardent leur ordre d'une lecture à l'autre: la ligne de la fois précédente est essayée d'abord
+static bool find_interface_counters(NetworkStats *stats, InterfaceCounters *counters) {
+    size_t name_len = strlen(stats->interface_name);
+    if (stats->line_hint < net_dev_line_count &&
+        parse_net_dev_line(stats->line_hint, stats->interface_name, name_len, counters)) {
+        return true;
+    }
+    for (int i = 0; i < net_dev_line_count; i++) {
+        if (parse_net_dev_line(i, stats->interface_name, name_len, counters)) {
+            stats->line_hint = i;
+            return true;
         }
     }
+    return false;
+}
+
+// Lire les compteurs d'une interface depuis /proc/net/dev
+static bool read_interface_stats(NetworkStats *stats, InterfaceCounters *counters) {
+    return read_net_dev() && find_interface_counters(stats, counters);
+}
+
+// Débits de paquets, d'erreurs et de pertes depuis la lecture précédente
+static void compute_packet_rates(InterfaceDeltas *deltas, const InterfaceCounters *counters, double now,
+                                 InterfacePacketRates *rates) {
+    // Champs de InterfacePacketRates dans l'ordre de InterfaceCounters.packets
+    float *fields[PACKET_COUNTER_COUNT] = {
+        &rates->rx_packets_per_sec, &rates->tx_packets_per_sec,
+        &rates->rx_errors_per_sec, &rates->tx_errors_per_sec,
+        &rates->rx_drops_per_sec, &rates->tx_drops_per_sec
+    };
+    for (int i = 0; i < PACKET_COUNTER_COUNT; i++) {
+        *fields[i] = (float)counter_delta_rate(&deltas->packets[i], counters->packets[i], now);
+    }
+}
+
+// Débits d'octets et de paquets depuis la lecture précédente
+static void compute_interface_rates(InterfaceDeltas *deltas, const InterfaceCounters *counters, double now,
+                                    InterfaceRates *rates) {
+    rates->download_kbps = (float)(counter_delta_rate(&deltas->rx_bytes, counters->rx_bytes, now) / 1024.0);
+    rates->upload_kbps = (float)(counter_delta_rate(&deltas->tx_bytes, counters->tx_bytes, now) / 1024.0);
+    compute_packet_rates(deltas, counters, now, &rates->packets);
+}
+
+int get_interface_rates(const char *const *interface_names, int interface_count, InterfaceRates *rates) {
+    if (interface_names == NULL || rates == NULL || interface_count <= 0) {
+        return 0;
+    }
+    memset(rates, 0, sizeof(InterfaceRates) * (size_t)interface_count);
+    if (!read_net_dev()) {
+        return 0;
+    }
     
-    fclose(fp);
+    // Même instant pour toutes les interfaces: une seule lecture
+    double now = counter_clock_seconds();
+    int found = 0;
+    for (int i = 0; i < interface_count; i++) {
+        NetworkStats *stats = interface_names[i] != NULL ? get_net_stats_entry(interface_names[i]) : NULL;
+        InterfaceCounters counters;
+        if (stats == NULL || !find_interface_counters(stats, &counters)) {
+            continue;
+        }
+        compute_interface_rates(&stats->batch, &counters, now, &rates[i]);
+        rates[i].found = true;
+        found++;
+    }
     return found;
 }
 
@@ -328,90 +548,118 @@ float get_interface_download_kbps(const char *interface_name) {
     }
     
     // Chercher ou créer une entrée pour cette interface
-    int index = -1;
-    for (int i = 0; i < net_stats_count; i++) {
-        if (strcmp(net_stats[i].interface_name, interface_name) == 0) {
-            index = i;
-            break;
-        }
+    NetworkStats *stats = get_net_stats_entry(interface_name);
+    if (stats == NULL) {
+        return 0.0f;
     }
     
-    // Créer nouvelle entrée si nécessaire
-    if (index == -1 && net_stats_count < 10) {
-        index = net_stats_count;
-        strcpy(net_stats[index].interface_name, interface_name);
-        net_stats_count++;
+    InterfaceCounters counters;
+    if (!read_interface_stats(stats, &counters)) {
+        return 0.0f;
     }
     
-    if (index == -1) {
-        return 0.0f;  // Trop d'interfaces
+    // Convertir bytes en KB/s sur le temps écoulé (l'intervalle dépend de l'ordonnanceur)
+    // Première lecture ou compteur remis à zéro: 0 plutôt qu'un pic
+    return (float)(counter_delta_rate(&stats->single.rx_bytes, counters.rx_bytes, counter_clock_seconds()) / 1024.0);
+}
+
+float get_interface_upload_kbps(const char *interface_name) {
+    if (interface_name == NULL) {
+        return 0.0f;
     }
     
-    unsigned long rx_bytes = 0, tx_bytes = 0;
-    if (!read_interface_stats(interface_name, &rx_bytes, &tx_bytes)) {
+    // Chercher ou créer une entrée pour cette interface
+    NetworkStats *stats = get_net_stats_entry(interface_name);
+    if (stats == NULL) {
         return 0.0f;
     }
     
-    // Calculer la différence avec la lecture précédente
-    if (net_stats[index].rx_bytes_prev == 0) {
-        // Première lecture
-        net_stats[index].rx_bytes_prev = rx_bytes;
-        net_stats[index].rx_bytes = rx_bytes;
+    InterfaceCounters counters;
+    if (!read_interface_stats(stats, &counters)) {
         return 0.0f;
     }
     
-    unsigned long diff = rx_bytes - net_stats[index].rx_bytes_prev;
-    net_stats[index].rx_bytes_prev = rx_bytes;
-    net_stats[index].rx_bytes = rx_bytes;
-    
-    // Convertir bytes en KB/s (diff en 1 seconde)
-    float kbps = diff / 1024.0f;
-    return kbps;
+    // Convertir bytes en KB/s sur le temps écoulé (l'intervalle dépend de l'ordonnanceur)
+    return (float)(counter_delta_rate(&stats->single.tx_bytes, counters.tx_bytes, counter_clock_seconds()) / 1024.0);
 }
 
-float get_interface_upload_kbps(const char *interface_name) {
+bool get_interface_packet_rates(const char *interface_name, InterfacePacketRates *rates) {
+    if (rates == NULL) {
+        return false;
+    }
+    memset(rates, 0, sizeof(*rates));
     if (interface_name == NULL) {
-        return 0.0f;
+        return false;
     }
     
-    // Chercher ou créer une entrée pour cette interface
-    int index = -1;
-    for (int i = 0; i < net_stats_count; i++) {
-        if (strcmp(net_stats[i].interface_name, interface_name) == 0) {
-            index = i;
-            break;
-        }
+    NetworkStats *stats = get_net_stats_entry(interface_name);
+    InterfaceCounters counters;
+    if (stats == NULL || !read_interface_stats(stats, &counters)) {
+        return false;
     }
-    
-    // Créer nouvelle entrée si nécessaire
-    if (index == -1 && net_stats_count < 10) {
-        index = net_stats_count;
-        strcpy(net_stats[index].interface_name, interface_name);
-        net_stats_count++;
+    compute_packet_rates(&stats->single, &counters, counter_clock_seconds(), rates);
+    return true;
+}
+
+int get_interface_link_speed_mbps(const char *interface_name) {
+    if (interface_name == NULL) {
+        return -1;
     }
     
-    if (index == -1) {
-        return 0.0f;  // Trop d'interfaces
+    // Illisible (EINVAL) si le lien est coupé, "-1" si le pilote ne la connaît pas (WiFi, virtuel)
+    char path[256];
+    sysroot_path(path, sizeof(path), "/sys/class/net/%s/speed", interface_name);
+    char text[32];
+    long length = parse_read_file_at(path, text, sizeof(text));
+    uint64_t speed = 0;
+    if (length <= 0 || parse_u64(text, text + length, &speed) == NULL || speed == 0 || speed > INT_MAX) {
+        return -1;
     }
-    
-    unsigned long rx_bytes = 0, tx_bytes = 0;
-    if (!read_interface_stats(interface_name, &rx_bytes, &tx_bytes)) {
-        return 0.0f;
+    return (int)speed;
+}
+
+const char* get_interface_duplex(const char *interface_name) {
+    if (interface_name == NULL) {
+        return "unknown";
     }
     
-    // Calculer la différence avec la lecture précédente
-    if (net_stats[index].tx_bytes_prev == 0) {
-        // Première lecture
-        net_stats[index].tx_bytes_prev = tx_bytes;
-        net_stats[index].tx_bytes = tx_bytes;
-        return 0.0f;
+    char path[256];
+    sysroot_path(path, sizeof(path), "/sys/class/net/%s/duplex", interface_name);
+    char text[16];
+    long length = parse_read_file_at(path, text, sizeof(text));
+    if (length >= 4 && memcmp(text, "full", 4) == 0) {
+        return "full";
+    }
+    if (length >= 4 && memcmp(text, "half", 4) == 0) {
+        return "half";
+    }
+    return "unknown";
+}
+
+void forget_network_interface(const char *interface_name) {
+    if (interface_name == NULL) {
+        return;
     }
     
-    unsigned long diff = tx_bytes - net_stats[index].tx_bytes_prev;
-    net_stats[index].tx_bytes_prev = tx_bytes;
-    net_stats[index].tx_bytes = tx_bytes;
+    // Libérer l'entrée du cache IP (la dernière entrée prend sa place)
+    for (int i = 0; i < ip_cache_count; i++) {
+        if (strcmp(ip_cache[i]->interface_name, interface_name) == 0) {
+            free(ip_cache[i]);
+            ip_cache_count--;
+            ip_cache[i] = ip_cache[ip_cache_count];
+            break;
+        }
+    }
     
-    // Convertir bytes en KB/s (diff en 1 seconde)
-    float kbps = diff / 1024.0f;
-    return kbps;
+    // Libérer l'entrée des statistiques: une interface recréée repart de zéro
+    for (int i = 0; i < net_stats_count; i++) {
+        if (strcmp(net_stats[i].interface_name, interface_name) == 0) {
+            net_stats_count--;
+            if (i != net_stats_count) {
+                net_stats[i] = net_stats[net_stats_count];
+            }
+            memset(&net_stats[net_stats_count], 0, sizeof(NetworkStats));
+            break;
+        }
+    }
 }
@@ -0,0 +1,100 @@
+/*
+ * parse_utils.c
+ * Allocation-free /proc and /sys field scanner implementation
+ */
+
+#include "parse_utils.h"
+#include "sysroot.h"
+#include <string.h>
+#include <limits.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+
+long parse_read_file_at(const char *full_path, char *buffer, size_t buffer_size) {
+    if (full_path == NULL || buffer == NULL || buffer_size == 0) {
+        return -1;
+    }
+
+    int fd = open(full_path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        buffer[0] = '\0';
+        return -1;
+    }
+
+    // Les fichiers /proc peuvent être servis en plusieurs read()
+    size_t length = 0;
+    while (length < buffer_size - 1) {
+        ssize_t count = read(fd, buffer + length, buffer_size - 1 - length);
+        if (count < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            close(fd);
+            buffer[0] = '\0';
+            return -1;
+        }
+        if (count == 0) {
+            break;
+        }
+        length += (size_t)count;
+    }
+    close(fd);
+
+    buffer[length] = '\0';
+    return (long)length;
+}
+
+long parse_read_file(const char *path, char *buffer, size_t buffer_size) {
+    char full_path[PATH_MAX];
+    if (!sysroot_path(full_path, sizeof(full_path), "%s", path)) {
+        return -1;
+    }
+    return parse_read_file_at(full_path, buffer, buffer_size);
+}
+
+const char* parse_u64(const char *cursor, const char *end, uint64_t *value) {
+    while (cursor < end && (*cursor == ' ' || *cursor == '\t')) {
+        cursor++;
+    }
+
+    // (unsigned)(c - '0') <= 9 : un seul test par caractère
+    if (cursor >= end || (unsigned char)(*cursor - '0') > 9) {
+        return NULL;
+    }
+
+    uint64_t result = 0;
+    do {
+        result = result * 10 + (uint64_t)(*cursor - '0');
+        cursor++;
+    } while (cursor < end && (unsigned char)(*cursor - '0') <= 9);
+
+    *value = result;
+    return cursor;
+}
+
+int parse_u64_fields(const char *cursor, const char *end, uint64_t *values, int max_values) {
+    int count = 0;
+    while (count < max_values) {
+        const char *next = parse_u64(cursor, end, &values[count]);
+        if (next == NULL) {
+            break;
+        }
+        cursor = next;
+        count++;
+    }
+    return count;
+}
+
+const char* parse_next_line(const char *cursor, const char *end) {
+    const char *newline = memchr(cursor, '\n', (size_t)(end - cursor));
+    return newline != NULL ? newline + 1 : end;
+}
+
+const char* parse_skip_prefix(const char *cursor, const char *end, const char *prefix) {
+    size_t prefix_len = strlen(prefix);
+    if ((size_t)(end - cursor) < prefix_len || memcmp(cursor, prefix, prefix_len) != 0) {
+        return NULL;
+    }
+    return cursor + prefix_len;
+}
@@ -0,0 +1,203 @@
+/*
+ * scheduler.c
+ * Multi-rate collector scheduler implementation (timerfd + epoll)
+ */
+
+#include "scheduler.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <time.h>
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
+
+#define MAX_COLLECTORS 32
+
+// Un collecteur et son timer
+typedef struct {
+    char name[32];
+    int timer_fd;
+    unsigned int interval_ms;    // 0 = une seule fois / suspendu
+    CollectorCallback callback;
+    void *user_data;
+} Collector;
+
+struct Scheduler {
+    int epoll_fd;
+    unsigned int coalesce_ms;
+    uint64_t origin_ns;          // Origine commune de tous les timers
+    Collector collectors[MAX_COLLECTORS];
+    int collector_count;
+};
+
+// Horloge monotone en nanosecondes
+static uint64_t monotonic_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+// Arrondir un intervalle au multiple supérieur de la granularité de coalescence
+static unsigned int align_interval(const Scheduler *scheduler, unsigned int interval_ms) {
+    if (interval_ms == 0 || scheduler->coalesce_ms <= 1) {
+        return interval_ms;
+    }
+    unsigned int granule = scheduler->coalesce_ms;
+    return ((interval_ms + granule - 1) / granule) * granule;
+}
+
+// Armer le timer d'un collecteur sur la grille commune (origine + k * intervalle)
+static bool arm_collector(Scheduler *scheduler, Collector *collector, bool run_once) {
+    struct itimerspec spec;
+    memset(&spec, 0, sizeof(spec));
+
+    if (run_once) {
+        // Échéance déjà passée: expire au prochain passage dans la boucle
+        spec.it_value.tv_sec = (time_t)(scheduler->origin_ns / 1000000000ULL);
+        spec.it_value.tv_nsec = (long)(scheduler->origin_ns % 1000000000ULL);
+    } else if (collector->interval_ms > 0) {
+        uint64_t interval_ns = (uint64_t)collector->interval_ms * 1000000ULL;
+        uint64_t elapsed_ns = monotonic_now_ns() - scheduler->origin_ns;
+        uint64_t next_ns = scheduler->origin_ns + (elapsed_ns / interval_ns + 1) * interval_ns;
+
+        spec.it_value.tv_sec = (time_t)(next_ns / 1000000000ULL);
+        spec.it_value.tv_nsec = (long)(next_ns % 1000000000ULL);
+        spec.it_interval.tv_sec = (time_t)(interval_ns / 1000000000ULL);
+        spec.it_interval.tv_nsec = (long)(interval_ns % 1000000000ULL);
+    }
+    // Sinon: it_value à zéro = timer désarmé (collecteur suspendu)
+
+    return timerfd_settime(collector->timer_fd, TFD_TIMER_ABSTIME, &spec, NULL) == 0;
+}
+
+Scheduler* scheduler_create(unsigned int coalesce_ms) {
+    Scheduler *scheduler = calloc(1, sizeof(Scheduler));
+    if (scheduler == NULL) {
+        return NULL;
+    }
+
+    scheduler->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    if (scheduler->epoll_fd < 0) {
+        free(scheduler);
+        return NULL;
+    }
+
+    scheduler->coalesce_ms = coalesce_ms;
+
+    // Origine alignée sur la granularité: les timers de tous les collecteurs
+    // partagent la même grille et expirent ensemble sur leurs multiples communs
+    uint64_t granule_ns = (coalesce_ms > 0 ? coalesce_ms : 1) * 1000000ULL;
+    scheduler->origin_ns = (monotonic_now_ns() / granule_ns) * granule_ns;
+
+    return scheduler;
+}
+
+int scheduler_add_collector(Scheduler *scheduler, const char *name, unsigned int interval_ms,
+                            CollectorCallback callback, void *user_data) {
+    if (scheduler == NULL || callback == NULL || scheduler->collector_count >= MAX_COLLECTORS) {
+        return -1;
+    }
+
+    int id = scheduler->collector_count;
+    Collector *collector = &scheduler->collectors[id];
+    memset(collector, 0, sizeof(Collector));
+
+    collector->timer_fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if (collector->timer_fd < 0) {
+        return -1;
+    }
+
+    snprintf(collector->name, sizeof(collector->name), "%s", name != NULL ? name : "collector");
+    collector->interval_ms = align_interval(scheduler, interval_ms);
+    collector->callback = callback;
+    collector->user_data = user_data;
+
+    struct epoll_event event;
+    memset(&event, 0, sizeof(event));
+    event.events = EPOLLIN;
+    event.data.u32 = (uint32_t)id;
+
+    if (epoll_ctl(scheduler->epoll_fd, EPOLL_CTL_ADD, collector->timer_fd, &event) < 0 ||
+        !arm_collector(scheduler, collector, interval_ms == 0)) {
+        close(collector->timer_fd);
+        return -1;
+    }
+
+    scheduler->collector_count++;
+    return id;
+}
+
+bool scheduler_set_interval(Scheduler *scheduler, int collector_id, unsigned int interval_ms) {
+    if (scheduler == NULL || collector_id < 0 || collector_id >= scheduler->collector_count) {
+        return false;
+    }
+
+    Collector *collector = &scheduler->collectors[collector_id];
+    collector->interval_ms = align_interval(scheduler, interval_ms);
+    return arm_collector(scheduler, collector, false);
+}
+
+void scheduler_run_now(Scheduler *scheduler, int collector_id) {
+    if (scheduler == NULL || collector_id < 0 || collector_id >= scheduler->collector_count) {
+        return;
+    }
+
+    Collector *collector = &scheduler->collectors[collector_id];
+    collector->callback(collector->user_data);
+}
+
+int scheduler_get_fd(const Scheduler *scheduler) {
+    return scheduler != NULL ? scheduler->epoll_fd : -1;
+}
+
+void scheduler_dispatch(Scheduler *scheduler) {
+    if (scheduler == NULL) {
+        return;
+    }
+
+    struct epoll_event events[MAX_COLLECTORS];
+    int ready_count = epoll_wait(scheduler->epoll_fd, events, MAX_COLLECTORS, 0);
+    if (ready_count <= 0) {
+        return;
+    }
+
+    // Marquer les collecteurs arrivés à échéance pendant ce réveil
+    bool ready[MAX_COLLECTORS] = {false};
+    for (int i = 0; i < ready_count; i++) {
+        uint32_t id = events[i].data.u32;
+        if (id < (uint32_t)scheduler->collector_count) {
+            ready[id] = true;
+        }
+    }
+
+    // Les exécuter dans l'ordre d'enregistrement
+    for (int id = 0; id < scheduler->collector_count; id++) {
+        if (!ready[id]) {
+            continue;
+        }
+
+        Collector *collector = &scheduler->collectors[id];
+
+        // Acquitter le timer (nombre d'expirations depuis la dernière lecture)
+        uint64_t expirations = 0;
+        if (read(collector->timer_fd, &expirations, sizeof(expirations)) != sizeof(expirations)) {
+            continue;  // Timer réarmé entre-temps: rien à faire
+        }
+
+        collector->callback(collector->user_data);
+    }
+}
+
+void scheduler_destroy(Scheduler *scheduler) {
+    if (scheduler == NULL) {
+        return;
+    }
+
+    for (int i = 0; i < scheduler->collector_count; i++) {
+        close(scheduler->collectors[i].timer_fd);
+    }
+    close(scheduler->epoll_fd);
+    free(scheduler);
+}
@@ -0,0 +1,72 @@
+/*
+ * snapshot.c
+ * Lock-free single-writer / multi-reader value publication (seqlock latch)
+ */
+
+#include "snapshot.h"
+#include <stdlib.h>
+#include <string.h>
+
+bool snapshot_cell_init(SnapshotCell *cell, size_t size) {
+    if (cell == NULL || size == 0) {
+        return false;
+    }
+
+    atomic_init(&cell->sequence, 0);
+    cell->size = size;
+    cell->copies[0] = calloc(1, size);
+    cell->copies[1] = calloc(1, size);
+    if (cell->copies[0] == NULL || cell->copies[1] == NULL) {
+        snapshot_cell_free(cell);
+        return false;
+    }
+    return true;
+}
+
+void snapshot_cell_free(SnapshotCell *cell) {
+    if (cell == NULL) {
+        return;
+    }
+    free(cell->copies[0]);
+    free(cell->copies[1]);
+    cell->copies[0] = NULL;
+    cell->copies[1] = NULL;
+    cell->size = 0;
+}
+
+uint64_t snapshot_publish(SnapshotCell *cell, const void *value) {
+    // Un seul écrivain: la lecture relâchée de notre propre compteur suffit
+    uint64_t sequence = atomic_load_explicit(&cell->sequence, memory_order_relaxed);
+
+    // Séquence impaire: les lecteurs basculent sur la copie 1 pendant qu'on écrit la 0
+    atomic_store_explicit(&cell->sequence, sequence + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    memcpy(cell->copies[0], value, cell->size);
+
+    // Séquence paire: retour sur la copie 0, puis mise à jour de la copie 1
+    atomic_store_explicit(&cell->sequence, sequence + 2, memory_order_release);
+    atomic_thread_fence(memory_order_release);
+    memcpy(cell->copies[1], value, cell->size);
+
+    return (sequence + 2) / 2;
+}
+
+uint64_t snapshot_read(const SnapshotCell *cell, void *value) {
+    SnapshotCell *shared = (SnapshotCell *)cell;  // Compteur atomique: lecture seule en pratique
+    uint64_t before, after;
+
+    do {
+        before = atomic_load_explicit(&shared->sequence, memory_order_acquire);
+        memcpy(value, cell->copies[before & 1], cell->size);
+        atomic_thread_fence(memory_order_acquire);
+        after = atomic_load_explicit(&shared->sequence, memory_order_relaxed);
+        // Une publication a touché la copie lue pendant la lecture: recommencer
+    } while (before != after);
+
+    return before / 2;
+}
+
+uint64_t snapshot_version(const SnapshotCell *cell) {
+    SnapshotCell *shared = (SnapshotCell *)cell;
+    return atomic_load_explicit(&shared->sequence, memory_order_acquire) / 2;
+}
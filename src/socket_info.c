@@ -0,0 +1,311 @@
+/*
+ * socket_info.c
+ * TCP socket states via NETLINK_SOCK_DIAG and /proc/net/snmp counter rates
+ */
+
+#include "socket_info.h"
+#include "sysroot.h"
+#include "parse_utils.h"
+#include "counter_delta.h"
+#include <string.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+#include <linux/sock_diag.h>
+#include <linux/inet_diag.h>
+
+// Sous-ensemble de tcp_info nécessaire (présent depuis Linux 2.6)
+#define TCP_INFO_MIN_SIZE (offsetof(struct tcp_info, tcpi_rtt) + sizeof(uint32_t))
+
+static const char *tcp_state_names[TCP_STATE_SLOTS] = {
+    "?", "ESTABLISHED", "SYN_SENT", "SYN_RECV", "FIN_WAIT1", "FIN_WAIT2", "TIME_WAIT",
+    "CLOSE", "CLOSE_WAIT", "LAST_ACK", "LISTEN", "CLOSING", "NEW_SYN_RECV"
+};
+
+const char* get_tcp_state_name(int state) {
+    if (state <= 0 || state >= TCP_STATE_SLOTS) {
+        return "?";
+    }
+    return tcp_state_names[state];
+}
+
+// ============================================================================
+// SOCK_DIAG
+// ============================================================================
+
+// Socket netlink conservé entre les appels (un par processus)
+static int diag_fd = -1;
+
+static int get_diag_socket(void) {
+    if (diag_fd < 0) {
+        diag_fd = socket(AF_NETLINK, SOCK_DGRAM | SOCK_CLOEXEC, NETLINK_SOCK_DIAG);
+    }
+    return diag_fd;
+}
+
+static void close_diag_socket(void) {
+    if (diag_fd >= 0) {
+        close(diag_fd);
+        diag_fd = -1;
+    }
+}
+
+// Accumulateurs RTT pendant le dump
+typedef struct {
+    double rtt_sum_ms;
+    unsigned int rtt_count;
+} RttAccumulator;
+
+// Prendre en compte une réponse inet_diag (un socket)
+static void account_socket(const struct nlmsghdr *header, TcpSocketSummary *summary, RttAccumulator *rtt) {
+    if (header->nlmsg_len < NLMSG_LENGTH(sizeof(struct inet_diag_msg))) {
+        return;
+    }
+    const struct inet_diag_msg *msg = NLMSG_DATA(header);
+
+    int state = msg->idiag_state;
+    if (state > 0 && state < TCP_STATE_SLOTS) {
+        summary->states[state]++;
+    }
+    summary->total++;
+
+    // Attribut INET_DIAG_INFO: struct tcp_info (absent pour TIME_WAIT / NEW_SYN_RECV)
+    int attr_len = (int)(header->nlmsg_len - NLMSG_LENGTH(sizeof(*msg)));
+    for (const struct rtattr *attr = (const struct rtattr *)(msg + 1); RTA_OK(attr, attr_len);
+         attr = RTA_NEXT(attr, attr_len)) {
+        if (attr->rta_type != INET_DIAG_INFO || RTA_PAYLOAD(attr) < TCP_INFO_MIN_SIZE) {
+            continue;
+        }
+        const struct tcp_info *info = RTA_DATA(attr);
+        if (info->tcpi_retransmits > 0) {
+            summary->retransmitting++;
+        }
+        if (state == TCP_ESTABLISHED && info->tcpi_rtt > 0) {
+            float rtt_ms = (float)info->tcpi_rtt / 1000.0f;  // tcpi_rtt en µs
+            rtt->rtt_sum_ms += rtt_ms;
+            rtt->rtt_count++;
+            if (rtt_ms > summary->rtt_max_ms) {
+                summary->rtt_max_ms = rtt_ms;
+            }
+        }
+    }
+}
+
+// Dump de tous les sockets TCP d'une famille (AF_INET ou AF_INET6)
+static bool dump_tcp_sockets(int fd, int family, TcpSocketSummary *summary, RttAccumulator *rtt) {
+    struct {
+        struct nlmsghdr header;
+        struct inet_diag_req_v2 request;
+    } message;
+    memset(&message, 0, sizeof(message));
+    message.header.nlmsg_len = sizeof(message);
+    message.header.nlmsg_type = SOCK_DIAG_BY_FAMILY;
+    message.header.nlmsg_flags = NLM_F_REQUEST | NLM_F_DUMP;
+    message.request.sdiag_family = (uint8_t)family;
+    message.request.sdiag_protocol = IPPROTO_TCP;
+    message.request.idiag_states = ~0U;                        // Tous les états
+    message.request.idiag_ext = 1 << (INET_DIAG_INFO - 1);     // + tcp_info
+
+    struct sockaddr_nl kernel;
+    memset(&kernel, 0, sizeof(kernel));
+    kernel.nl_family = AF_NETLINK;
+
+    if (sendto(fd, &message, sizeof(message), 0, (struct sockaddr *)&kernel, sizeof(kernel)) < 0) {
+        return false;
+    }
+
+    // Réponses groupées par le noyau: ~100 sockets par lecture avec tcp_info
+    static char buffer[32768] __attribute__((aligned(NLMSG_ALIGNTO)));
+    for (;;) {
+        ssize_t len = recv(fd, buffer, sizeof(buffer), 0);
+        if (len < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        if (len == 0) {
+            return false;
+        }
+
+        int remaining = (int)len;
+        for (const struct nlmsghdr *header = (const struct nlmsghdr *)buffer; NLMSG_OK(header, remaining);
+             header = NLMSG_NEXT(header, remaining)) {
+            if (header->nlmsg_type == NLMSG_DONE) {
+                return true;
+            }
+            if (header->nlmsg_type == NLMSG_ERROR) {
+                return false;  // Famille non supportée (ex: noyau sans IPv6)
+            }
+            if (header->nlmsg_type == SOCK_DIAG_BY_FAMILY) {
+                account_socket(header, summary, rtt);
+            }
+        }
+    }
+}
+
+bool get_tcp_socket_summary(TcpSocketSummary *summary) {
+    if (summary == NULL) {
+        return false;
+    }
+    memset(summary, 0, sizeof(*summary));
+
+    // netlink décrit toujours l'hôte réel, pas la racine de test
+    if (sysroot_is_set()) {
+        return false;
+    }
+
+    int fd = get_diag_socket();
+    if (fd < 0) {
+        return false;
+    }
+
+    RttAccumulator rtt = {0};
+    if (!dump_tcp_sockets(fd, AF_INET, summary, &rtt)) {
+        // Dump interrompu: le socket peut contenir une fin de réponse, repartir d'un neuf
+        close_diag_socket();
+        return false;
+    }
+    if (!dump_tcp_sockets(fd, AF_INET6, summary, &rtt)) {
+        close_diag_socket();  // IPv6 absent: résultat IPv4 seul
+    }
+
+    summary->established = summary->states[TCP_ESTABLISHED];
+    summary->time_wait = summary->states[TCP_TIME_WAIT];
+    summary->listening = summary->states[TCP_LISTEN];
+    if (rtt.rtt_count > 0) {
+        summary->rtt_avg_ms = (float)(rtt.rtt_sum_ms / rtt.rtt_count);
+    }
+    return true;
+}
+
+// ============================================================================
+// /proc/net/snmp
+// ============================================================================
+
+// Compteurs lus (TCP puis UDP) et champ de ProtocolCounterRates correspondant
+static const char *tcp_counter_names[] = {
+    "ActiveOpens", "PassiveOpens", "AttemptFails", "EstabResets", "RetransSegs", "InErrs", "OutRsts"
+};
+static const char *udp_counter_names[] = {
+    "InErrors", "NoPorts", "RcvbufErrors", "SndbufErrors"
+};
+static const size_t counter_rate_offsets[] = {
+    offsetof(ProtocolCounterRates, tcp_active_opens),
+    offsetof(ProtocolCounterRates, tcp_passive_opens),
+    offsetof(ProtocolCounterRates, tcp_attempt_fails),
+    offsetof(ProtocolCounterRates, tcp_estab_resets),
+    offsetof(ProtocolCounterRates, tcp_retrans_segs),
+    offsetof(ProtocolCounterRates, tcp_in_errs),
+    offsetof(ProtocolCounterRates, tcp_out_rsts),
+    offsetof(ProtocolCounterRates, udp_in_errors),
+    offsetof(ProtocolCounterRates, udp_no_ports),
+    offsetof(ProtocolCounterRates, udp_rcvbuf_errors),
+    offsetof(ProtocolCounterRates, udp_sndbuf_errors)
+};
+#define TCP_COUNTER_COUNT (int)(sizeof(tcp_counter_names) / sizeof(tcp_counter_names[0]))
+#define UDP_COUNTER_COUNT (int)(sizeof(udp_counter_names) / sizeof(udp_counter_names[0]))
+#define SNMP_COUNTER_COUNT (TCP_COUNTER_COUNT + UDP_COUNTER_COUNT)
+
+static bool is_field_end(char c) {
+    return c == ' ' || c == '\n' || c == '\0';
+}
+
+/*
+ * Format: une ligne d'en-têtes puis une ligne de valeurs de même préfixe
+ *   Tcp: RtoAlgorithm RtoMin RtoMax MaxConn ActiveOpens ...
+ *   Tcp: 1 200 120000 -1 12345 ...
+ * Les valeurs négatives (MaxConn = -1) ne sont jamais des compteurs recherchés
+ */
+static bool read_snmp_section(const char *buffer, const char *end, const char *prefix,
+                              const char **names, int name_count, uint64_t *values) {
+    const char *line = buffer;
+    while (line < end && parse_skip_prefix(line, end, prefix) == NULL) {
+        line = parse_next_line(line, end);
+    }
+    const char *header = parse_skip_prefix(line, end, prefix);
+    if (header == NULL) {
+        return false;
+    }
+    const char *data = parse_skip_prefix(parse_next_line(line, end), end, prefix);
+    if (data == NULL) {
+        return false;
+    }
+
+    int found = 0;
+    for (;;) {
+        while (header < end && *header == ' ') header++;
+        while (data < end && *data == ' ') data++;
+        if (header >= end || *header == '\n' || data >= end || *data == '\n') {
+            break;
+        }
+
+        const char *name = header;
+        while (header < end && !is_field_end(*header)) header++;
+        size_t name_len = (size_t)(header - name);
+
+        uint64_t value = 0;
+        if (*data == '-') {
+            while (data < end && !is_field_end(*data)) data++;   // Valeur négative: ignorée
+        } else {
+            const char *next = parse_u64(data, end, &value);
+            if (next == NULL) {
+                return false;
+            }
+            data = next;
+        }
+
+        for (int i = 0; i < name_count; i++) {
+            if (strlen(names[i]) == name_len && memcmp(names[i], name, name_len) == 0) {
+                values[i] = value;
+                found++;
+                break;
+            }
+        }
+    }
+    return found == name_count;
+}
+
+bool get_protocol_counter_rates(ProtocolCounterRates *rates) {
+    // Compteurs "unsigned long" du noyau: rebouclage à 2^32 sur les systèmes 32 bits
+    static CounterDelta previous[SNMP_COUNTER_COUNT];
+    static bool previous_initialized = false;
+    if (!previous_initialized) {
+        for (int i = 0; i < SNMP_COUNTER_COUNT; i++) {
+            counter_delta_init(&previous[i], COUNTER_BITS_LONG);
+        }
+        previous_initialized = true;
+    }
+
+    if (rates == NULL) {
+        return false;
+    }
+    memset(rates, 0, sizeof(*rates));
+
+    char buffer[4096];
+    long length = parse_read_file("/proc/net/snmp", buffer, sizeof(buffer));
+    if (length <= 0) {
+        return false;
+    }
+    const char *end = buffer + length;
+
+    uint64_t current[SNMP_COUNTER_COUNT] = {0};
+    if (!read_snmp_section(buffer, end, "Tcp:", tcp_counter_names, TCP_COUNTER_COUNT, current) ||
+        !read_snmp_section(buffer, end, "Udp:", udp_counter_names, UDP_COUNTER_COUNT,
+                           current + TCP_COUNTER_COUNT)) {
+        return false;
+    }
+
+    double now = counter_clock_seconds();
+    for (int i = 0; i < SNMP_COUNTER_COUNT; i++) {
+        float *rate = (float *)((char *)rates + counter_rate_offsets[i]);
+        *rate = (float)counter_delta_rate(&previous[i], current[i], now);
+    }
+    return true;
+}
@@ -0,0 +1,250 @@
+/*
+ * speed_history.c
+ * Persistent speed test results keyed by disk identity (tab-separated text file)
+ */
+
+#include "speed_history.h"
+#include "parse_utils.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <unistd.h>
+#include <sys/file.h>
+#include <sys/stat.h>
+
+// Entiers seulement (KiB/s, IOPS): le fichier ne dépend pas du séparateur décimal de la locale
+#define HISTORY_HEADER "# syswatch speed tests v1: identity\ttime\tkind\tKiB/s\tIOPS\tparameters\n"
+
+// ============================================================================
+// IDENTITÉ DU DISQUE
+// ============================================================================
+
+// Copier un identifiant sysfs sans espaces de bourrage ("t10.ATA     Samsung  SSD" -> "t10.ATA_Samsung_SSD")
+static void normalize_identity(const char *source, size_t length, char *identity, size_t identity_size) {
+    size_t used = 0;
+    bool pending_separator = false;
+    for (size_t i = 0; i < length && used + 2 < identity_size; i++) {
+        unsigned char c = (unsigned char)source[i];
+        if (isspace(c) || !isprint(c)) {
+            pending_separator = used > 0;
+            continue;
+        }
+        if (pending_separator) {
+            identity[used++] = '_';
+            pending_separator = false;
+        }
+        identity[used++] = (char)c;
+    }
+    identity[used] = '\0';
+}
+
+bool get_storage_identity(const char *storage_name, char *identity, size_t identity_size) {
+    if (storage_name == NULL || identity == NULL || identity_size == 0 || strchr(storage_name, '/') != NULL) {
+        return false;
+    }
+    identity[0] = '\0';
+
+    // Du plus au moins universel: WWN / EUI (SCSI, SATA, NVMe), numéro de série, CID des cartes SD/eMMC
+    static const char *sources[] = { "wwid", "device/wwid", "device/serial", "serial", "device/cid" };
+    for (size_t i = 0; i < sizeof(sources) / sizeof(sources[0]); i++) {
+        char path[PATH_MAX];
+        char buffer[256];
+        snprintf(path, sizeof(path), "/sys/block/%s/%s", storage_name, sources[i]);
+        long length = parse_read_file(path, buffer, sizeof(buffer));
+        if (length <= 0) {
+            continue;
+        }
+        normalize_identity(buffer, (size_t)length, identity, identity_size);
+        if (identity[0] != '\0') {
+            return true;
+        }
+    }
+    return false;
+}
+
+// ============================================================================
+// FICHIER D'HISTORIQUE
+// ============================================================================
+
+// Créer chaque composant manquant du répertoire (mkdir -p)
+static bool make_directories(char *directory) {
+    for (char *slash = strchr(directory + 1, '/'); ; slash = strchr(slash + 1, '/')) {
+        if (slash != NULL) {
+            *slash = '\0';
+        }
+        bool ok = mkdir(directory, 0755) == 0 || errno == EEXIST;
+        if (slash != NULL) {
+            *slash = '/';
+        }
+        if (!ok) {
+            return false;
+        }
+        if (slash == NULL) {
+            return true;
+        }
+    }
+}
+
+static bool get_history_path(char *path, size_t path_size, bool create_directory) {
+    char directory[PATH_MAX - 32];
+    const char *state_home = getenv("XDG_STATE_HOME");
+    const char *home = getenv("HOME");
+    if (state_home != NULL && state_home[0] == '/') {
+        snprintf(directory, sizeof(directory), "%s/syswatch", state_home);
+    } else if (home != NULL && home[0] == '/') {
+        snprintf(directory, sizeof(directory), "%s/.local/state/syswatch", home);
+    } else {
+        return false;
+    }
+    if (create_directory && !make_directories(directory)) {
+        return false;
+    }
+    snprintf(path, path_size, "%s/speed_tests.tsv", directory);
+    return true;
+}
+
+static const char* kind_name(SpeedRecordKind kind) {
+    return kind == SPEED_RECORD_WRITE ? "write" : "read";
+}
+
+// Découper une ligne "identity\ttime\tkind\tKiB/s\tIOPS\tparameters" (modifiée sur place)
+static bool parse_history_line(char *line, char **identity, SpeedTestRecord *record) {
+    char *fields[6];
+    char *cursor = line;
+    for (int i = 0; i < 6; i++) {
+        fields[i] = cursor;
+        cursor = i < 5 ? strchr(cursor, '\t') : strchr(cursor, '\n');
+        if (cursor == NULL) {
+            if (i < 5) {
+                return false;
+            }
+        } else {
+            *cursor++ = '\0';
+        }
+    }
+
+    memset(record, 0, sizeof(*record));
+    *identity = fields[0];
+    record->timestamp = strtoll(fields[1], NULL, 10);
+    if (strcmp(fields[2], "read") == 0) {
+        record->kind = SPEED_RECORD_READ;
+    } else if (strcmp(fields[2], "write") == 0) {
+        record->kind = SPEED_RECORD_WRITE;
+    } else {
+        return false;
+    }
+    record->mbps = (float)strtoull(fields[3], NULL, 10) / 1024.0f;
+    record->iops = (float)strtoull(fields[4], NULL, 10);
+    snprintf(record->parameters, sizeof(record->parameters), "%s", fields[5]);
+    return true;
+}
+
+bool speed_history_find_latest(const char *identity, SpeedRecordKind kind, const char *parameters,
+                               SpeedTestRecord *record) {
+    char path[PATH_MAX];
+    if (identity == NULL || parameters == NULL || record == NULL || !get_history_path(path, sizeof(path), false)) {
+        return false;
+    }
+    FILE *fp = fopen(path, "re");
+    if (fp == NULL) {
+        return false;
+    }
+
+    // Fichier en ordre chronologique: la dernière ligne correspondante gagne
+    bool found = false;
+    char line[512];
+    while (fgets(line, sizeof(line), fp) != NULL) {
+        char *line_identity;
+        SpeedTestRecord candidate;
+        if (line[0] == '#' || !parse_history_line(line, &line_identity, &candidate)) {
+            continue;
+        }
+        if (candidate.kind == kind && strcmp(line_identity, identity) == 0 &&
+            strcmp(candidate.parameters, parameters) == 0) {
+            *record = candidate;
+            found = true;
+        }
+    }
+    fclose(fp);
+    return found;
+}
+
+// Ne garder que la seconde moitié du fichier (mesures les plus récentes), remplacement atomique
+static void compact_history(const char *path, int fd, off_t size) {
+    char *content = malloc((size_t)size + 1);
+    if (content == NULL) {
+        return;
+    }
+    ssize_t length = pread(fd, content, (size_t)size, 0);
+    if (length <= 0) {
+        free(content);
+        return;
+    }
+    content[length] = '\0';
+
+    const char *keep = strchr(content + length / 2, '\n');
+    char temporary[PATH_MAX];
+    snprintf(temporary, sizeof(temporary), "%.*s.tmp", PATH_MAX - 8, path);
+    FILE *fp = keep != NULL ? fopen(temporary, "we") : NULL;
+    if (fp != NULL) {
+        bool ok = fputs(HISTORY_HEADER, fp) >= 0 && fputs(keep + 1, fp) >= 0;
+        ok = fclose(fp) == 0 && ok;
+        if (!ok || rename(temporary, path) != 0) {
+            unlink(temporary);
+        }
+    }
+    free(content);
+}
+
+bool speed_history_append(const char *identity, const SpeedTestRecord *record) {
+    char path[PATH_MAX];
+    if (identity == NULL || record == NULL || identity[0] == '\0' ||
+        strpbrk(identity, "\t\n") != NULL || strpbrk(record->parameters, "\t\n") != NULL ||
+        !get_history_path(path, sizeof(path), true)) {
+        return false;
+    }
+
+    // Plusieurs instances de SysWatch peuvent écrire en même temps. Une compaction
+    // remplace le fichier pendant qu'une autre attend le verrou: l'ancien inode n'est
+    // plus lu par personne, il faut alors rouvrir le chemin et reprendre le verrou
+    int fd;
+    for (;;) {
+        fd = open(path, O_RDWR | O_APPEND | O_CREAT | O_CLOEXEC, 0644);
+        if (fd < 0) {
+            return false;
+        }
+        flock(fd, LOCK_EX);
+        struct stat locked, current;
+        bool replaced = fstat(fd, &locked) == 0 &&
+                        (stat(path, &current) != 0 || locked.st_ino != current.st_ino ||
+                         locked.st_dev != current.st_dev);
+        if (!replaced) {
+            break;
+        }
+        close(fd);                      // Libère aussi le verrou
+    }
+
+    char line[512];
+    int length = snprintf(line, sizeof(line), "%.127s\t%lld\t%s\t%llu\t%llu\t%s\n", identity,
+                          (long long)record->timestamp, kind_name(record->kind),
+                          (unsigned long long)(record->mbps > 0 ? record->mbps * 1024.0f + 0.5f : 0),
+                          (unsigned long long)(record->iops > 0 ? record->iops + 0.5f : 0),
+                          record->parameters);
+    struct stat st;
+    bool ok = fstat(fd, &st) == 0;
+    if (ok && st.st_size == 0) {
+        ok = write(fd, HISTORY_HEADER, strlen(HISTORY_HEADER)) == (ssize_t)strlen(HISTORY_HEADER);
+    }
+    ok = ok && length > 0 && length < (int)sizeof(line) && write(fd, line, (size_t)length) == length;
+
+    if (ok && fstat(fd, &st) == 0 && st.st_size > SPEED_HISTORY_MAX_BYTES) {
+        compact_history(path, fd, st.st_size);
+    }
+    flock(fd, LOCK_UN);
+    close(fd);
+    return ok;
+}
@@ -0,0 +1,378 @@
+/*
+ * speed_test.c
+ * Disk benchmark runner (warm-up, repetitions, statistics, time slices) and the
+ * read-only test: aligned O_DIRECT reads spread over the raw block device
+ */
+
+#define _GNU_SOURCE  // Pour O_DIRECT
+#include "speed_test.h"
+#include "sysroot.h"
+#include "counter_delta.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <linux/fs.h>
+
+#define SEQUENTIAL_BLOCK_SIZE   (1024 * 1024)
+#define SEQUENTIAL_REGIONS      16          // Zones réparties du début à la fin du disque
+#define SEQUENTIAL_REGION_BLOCKS 4          // 4 Mio par zone: 64 Mio par passe
+#define RANDOM_BLOCK_SIZE       4096
+#define RANDOM_MAX_READS        4096
+#define RANDOM_MAX_SECONDS      0.5         // Un disque dur fait ~100 IOPS: la durée borne chaque passe
+#define RANDOM_PASS_WORK        ((uint64_t)RANDOM_MAX_READS * RANDOM_BLOCK_SIZE)  // Part d'une passe aléatoire dans l'avancement
+
+// Chute de débit: fenêtre glissante sous CLIFF_RATIO fois le débit initial, jusqu'à la fin
+#define CLIFF_MIN_SLICES        10
+#define CLIFF_WINDOW_SLICES     5
+#define CLIFF_RATIO             0.6f
+
+// ============================================================================
+// STATISTIQUES
+// ============================================================================
+
+// Quantile 0,975 de la loi de Student pour 1 à 30 degrés de liberté (loi normale au-delà)
+static const float student_t_975[] = {
+    12.706f, 4.303f, 3.182f, 2.776f, 2.571f, 2.447f, 2.365f, 2.306f, 2.262f, 2.228f,
+    2.201f, 2.179f, 2.160f, 2.145f, 2.131f, 2.120f, 2.110f, 2.101f, 2.093f, 2.086f,
+    2.080f, 2.074f, 2.069f, 2.064f, 2.060f, 2.056f, 2.052f, 2.048f, 2.045f, 2.042f
+};
+
+static int compare_floats(const void *a, const void *b) {
+    float x = *(const float *)a;
+    float y = *(const float *)b;
+    return (x > y) - (x < y);
+}
+
+static float sorted_median(const float *sorted, int count) {
+    return count % 2 == 1 ? sorted[count / 2] : (sorted[count / 2 - 1] + sorted[count / 2]) / 2.0f;
+}
+
+void speed_test_summarize(float *samples, int count, SpeedTestStats *stats) {
+    memset(stats, 0, sizeof(*stats));
+    if (samples == NULL || count <= 0) {
+        return;
+    }
+    qsort(samples, (size_t)count, sizeof(float), compare_floats);
+
+    double sum = 0.0;
+    for (int i = 0; i < count; i++) {
+        sum += samples[i];
+    }
+    double mean = sum / count;
+    double squares = 0.0;
+    for (int i = 0; i < count; i++) {
+        squares += (samples[i] - mean) * (samples[i] - mean);
+    }
+
+    stats->runs = count;
+    stats->median = sorted_median(samples, count);
+    stats->mean = (float)mean;
+    stats->min = samples[0];
+    stats->max = samples[count - 1];
+    if (count > 1) {
+        int degrees = count - 1;
+        float t = degrees <= (int)(sizeof(student_t_975) / sizeof(student_t_975[0]))
+            ? student_t_975[degrees - 1] : 1.960f;
+        stats->stddev = (float)sqrt(squares / degrees);
+        stats->ci95 = t * stats->stddev / sqrtf((float)count);
+    }
+}
+
+// ============================================================================
+// DÉBIT PAR TRANCHE DE TEMPS
+// ============================================================================
+
+void speed_test_timeline_start(SpeedTestTimeline *timeline) {
+    memset(timeline, 0, sizeof(*timeline));
+    timeline->cliff_seconds = -1.0f;
+}
+
+static void close_slice(SpeedTestTimeline *timeline) {
+    if (timeline->slice_count < SPEED_TEST_MAX_SLICES && timeline->slice_seconds > 0) {
+        timeline->slice_mbps[timeline->slice_count++] =
+            (float)(timeline->slice_bytes / (1024.0 * 1024.0) / timeline->slice_seconds);
+    }
+    timeline->slice_seconds = 0.0;
+    timeline->slice_bytes = 0;
+}
+
+void speed_test_timeline_add(SpeedTestTimeline *timeline, uint64_t bytes, double seconds) {
+    timeline->slice_bytes += bytes;
+    timeline->slice_seconds += seconds;
+    if (timeline->slice_seconds >= SPEED_TEST_SLICE_SECONDS) {
+        close_slice(timeline);
+    }
+}
+
+// Médiane d'une partie de la série (copie triée: la série garde son ordre chronologique)
+static float range_median(const float *values, int count) {
+    float sorted[SPEED_TEST_MAX_SLICES];
+    memcpy(sorted, values, (size_t)count * sizeof(float));
+    qsort(sorted, (size_t)count, sizeof(float), compare_floats);
+    return sorted_median(sorted, count);
+}
+
+void speed_test_timeline_finish(SpeedTestTimeline *timeline) {
+    // Dernière tranche partielle gardée si elle couvre au moins la moitié d'une tranche
+    if (timeline->slice_seconds >= SPEED_TEST_SLICE_SECONDS / 2) {
+        close_slice(timeline);
+    }
+    timeline->cliff_seconds = -1.0f;
+    timeline->sustained_mbps = 0.0f;
+    int count = timeline->slice_count;
+    if (count < CLIFF_MIN_SLICES) {
+        return;
+    }
+
+    // Débit initial: premier dixième de la série (trois tranches au moins)
+    int head = count / 10 > 3 ? count / 10 : 3;
+    float baseline = range_median(timeline->slice_mbps, head);
+    float threshold = baseline * CLIFF_RATIO;
+
+    // Première tranche sous le seuil suivie d'une fenêtre et d'une fin de série sous le seuil
+    // (pas un simple creux)
+    for (int k = head; k + CLIFF_WINDOW_SLICES <= count; k++) {
+        if (timeline->slice_mbps[k] >= threshold ||
+            range_median(&timeline->slice_mbps[k], CLIFF_WINDOW_SLICES) >= threshold) {
+            continue;
+        }
+        float tail = range_median(&timeline->slice_mbps[k], count - k);
+        if (tail < threshold) {
+            timeline->cliff_seconds = (float)(k * SPEED_TEST_SLICE_SECONDS);
+            timeline->sustained_mbps = tail;
+            return;
+        }
+    }
+}
+
+// ============================================================================
+// AVANCEMENT ET ANNULATION
+// ============================================================================
+
+void speed_test_meter_start(SpeedTestMeter *meter, SpeedTestControl *control, uint64_t total_work) {
+    memset(meter, 0, sizeof(*meter));
+    meter->control = control;
+    meter->total_work = total_work;
+    meter->start = counter_clock_seconds();
+    meter->window_start = meter->start;
+}
+
+bool speed_test_meter_add(SpeedTestMeter *meter, const char *phase, uint64_t bytes, uint64_t work) {
+    meter->done_work += work;
+    meter->window_bytes += bytes;
+    SpeedTestControl *control = meter->control;
+    if (control == NULL) {
+        return true;
+    }
+    if (atomic_load_explicit(&control->cancel, memory_order_relaxed)) {
+        return false;
+    }
+
+    double now = counter_clock_seconds();
+    double window = now - meter->window_start;
+    if (control->progress != NULL && window >= SPEED_TEST_PROGRESS_SECONDS) {
+        SpeedTestProgress progress;
+        progress.phase = phase;
+        progress.fraction = meter->total_work > 0 ? (float)meter->done_work / (float)meter->total_work : 0.0f;
+        progress.fraction = progress.fraction < 1.0f ? progress.fraction : 1.0f;
+        progress.mbps = (float)(meter->window_bytes / (1024.0 * 1024.0) / window);
+        progress.elapsed_seconds = now - meter->start;
+        control->progress(&progress, control->user_data);
+        meter->window_start = now;
+        meter->window_bytes = 0;
+    }
+    return true;
+}
+
+// ============================================================================
+// CACHE DE PAGES
+// ============================================================================
+
+bool speed_test_drop_caches(int fd) {
+    // Pages propres seulement: le fichier doit être écrit sur le disque avant
+    fdatasync(fd);
+    posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+
+    if (sysroot_is_set() || geteuid() != 0) {
+        return false;
+    }
+    int control = open("/proc/sys/vm/drop_caches", O_WRONLY | O_CLOEXEC);
+    if (control < 0) {
+        return false;
+    }
+    bool dropped = write(control, "1", 1) == 1;
+    close(control);
+    return dropped;
+}
+
+// ============================================================================
+// TEST EN LECTURE SEULE SUR LE PÉRIPHÉRIQUE BRUT
+// ============================================================================
+
+typedef struct {
+    int fd;
+    uint64_t device_size;
+    size_t alignment;
+    void *buffer;
+    uint64_t random_state;
+} RawDevice;
+
+// xorshift64: positions aléatoires reproductibles pour une graine donnée
+static uint64_t next_random(uint64_t *state) {
+    uint64_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    *state = x;
+    return x;
+}
+
+// Lecture complète d'un bloc aligné (pread peut rendre moins en fin de périphérique)
+static bool read_block(int fd, void *buffer, size_t size, uint64_t offset) {
+    ssize_t bytes = pread(fd, buffer, size, (off_t)offset);
+    return bytes == (ssize_t)size;
+}
+
+// Zones réparties: la vitesse d'un disque dur baisse vers la fin (pistes intérieures)
+// Décalées d'une zone à chaque passe: le cache du disque ne resert pas la passe précédente
+static int sequential_regions(const RawDevice *device) {
+    uint64_t region_size = (uint64_t)SEQUENTIAL_REGION_BLOCKS * SEQUENTIAL_BLOCK_SIZE;
+    return device->device_size >= region_size * SEQUENTIAL_REGIONS ? SEQUENTIAL_REGIONS : 1;
+}
+
+static uint64_t sequential_region_blocks(const RawDevice *device) {
+    uint64_t region_size = (uint64_t)SEQUENTIAL_REGION_BLOCKS * SEQUENTIAL_BLOCK_SIZE;
+    return device->device_size >= region_size ? SEQUENTIAL_REGION_BLOCKS : device->device_size / SEQUENTIAL_BLOCK_SIZE;
+}
+
+static bool read_sequential_pass(const RawDevice *device, int pass, SpeedTestMeter *meter,
+                                 float *mbps, uint64_t *bytes) {
+    uint64_t region_size = (uint64_t)SEQUENTIAL_REGION_BLOCKS * SEQUENTIAL_BLOCK_SIZE;
+    int regions = sequential_regions(device);
+    uint64_t region_blocks = sequential_region_blocks(device);
+    uint64_t span = device->device_size - region_blocks * SEQUENTIAL_BLOCK_SIZE;
+    const char *phase = pass < SPEED_TEST_WARMUP_RUNS ? "Warm-up read" : "Sequential read";
+
+    bool ok = true;
+    uint64_t pass_bytes = 0;
+    double start = counter_clock_seconds();
+    for (int r = 0; r < regions && ok; r++) {
+        uint64_t offset = regions > 1 ? span / (uint64_t)(regions - 1) * (uint64_t)r : 0;
+        offset = (offset + (uint64_t)pass * region_size) % (span + 1);
+        offset -= offset % device->alignment;
+        for (uint64_t b = 0; b < region_blocks && ok; b++) {
+            ok = read_block(device->fd, device->buffer, SEQUENTIAL_BLOCK_SIZE, offset + b * SEQUENTIAL_BLOCK_SIZE) &&
+                 speed_test_meter_add(meter, phase, SEQUENTIAL_BLOCK_SIZE, SEQUENTIAL_BLOCK_SIZE);
+            pass_bytes += ok ? SEQUENTIAL_BLOCK_SIZE : 0;
+        }
+    }
+    double seconds = counter_clock_seconds() - start;
+
+    *bytes += pass_bytes;
+    *mbps = seconds > 0 ? (float)(pass_bytes / (1024.0 * 1024.0) / seconds) : 0.0f;
+    return ok;
+}
+
+// Avancement de la passe: lectures faites ou temps écoulé, selon la limite la plus proche
+static uint64_t random_pass_work(int reads, double elapsed) {
+    uint64_t by_reads = (uint64_t)reads * RANDOM_BLOCK_SIZE;
+    uint64_t by_time = elapsed < RANDOM_MAX_SECONDS
+        ? (uint64_t)(elapsed / RANDOM_MAX_SECONDS * RANDOM_PASS_WORK) : RANDOM_PASS_WORK;
+    uint64_t work = by_reads > by_time ? by_reads : by_time;
+    return work < RANDOM_PASS_WORK ? work : RANDOM_PASS_WORK;
+}
+
+static bool read_random_pass(RawDevice *device, SpeedTestMeter *meter, float *iops, uint64_t *bytes) {
+    uint64_t slots = device->device_size / device->alignment;
+    int reads = 0;
+    uint64_t credited = 0;
+    bool ok = true;
+    double start = counter_clock_seconds();
+    double elapsed = 0.0;
+    while (reads < RANDOM_MAX_READS && elapsed < RANDOM_MAX_SECONDS && ok) {
+        uint64_t offset = next_random(&device->random_state) % slots * device->alignment;
+        ok = read_block(device->fd, device->buffer, RANDOM_BLOCK_SIZE, offset);
+        reads += ok;
+        elapsed = counter_clock_seconds() - start;
+        uint64_t work = random_pass_work(reads, elapsed);
+        ok = ok && speed_test_meter_add(meter, "Random read", RANDOM_BLOCK_SIZE, work - credited);
+        credited = work;
+    }
+    double seconds = counter_clock_seconds() - start;
+    meter->done_work += RANDOM_PASS_WORK - credited;  // Passe arrêtée par le temps: avancement complet
+
+    *bytes += (uint64_t)reads * RANDOM_BLOCK_SIZE;
+    *iops = seconds > 0 ? (float)(reads / seconds) : 0.0f;
+    return ok;
+}
+
+bool get_storage_read_speed_test(const char *storage_name, ReadSpeedTestResult *result,
+                                 SpeedTestControl *control) {
+    if (result == NULL) {
+        return false;
+    }
+    memset(result, 0, sizeof(*result));
+    if (storage_name == NULL || strchr(storage_name, '/') != NULL || sysroot_is_set()) {
+        return false;
+    }
+
+    char path[64];
+    snprintf(path, sizeof(path), "/dev/%.31s", storage_name);
+    RawDevice device;
+    memset(&device, 0, sizeof(device));
+    device.fd = open(path, O_RDONLY | O_DIRECT | O_CLOEXEC);
+    if (device.fd < 0) {
+        return false;
+    }
+
+    // Alignement O_DIRECT: taille de bloc logique (512 ou 4096), 4 Kio au moins
+    int logical_block = 512;
+    if (ioctl(device.fd, BLKGETSIZE64, &device.device_size) != 0 ||
+        device.device_size < 2 * SEQUENTIAL_BLOCK_SIZE) {
+        close(device.fd);
+        return false;
+    }
+    ioctl(device.fd, BLKSSZGET, &logical_block);
+    device.alignment = logical_block > RANDOM_BLOCK_SIZE ? (size_t)logical_block : RANDOM_BLOCK_SIZE;
+    device.random_state = (uint64_t)(counter_clock_seconds() * 1e9) | 1;
+    if (posix_memalign(&device.buffer, device.alignment, SEQUENTIAL_BLOCK_SIZE) != 0) {
+        close(device.fd);
+        return false;
+    }
+
+    SpeedTestMeter meter;
+    uint64_t pass_work = (uint64_t)sequential_regions(&device) * sequential_region_blocks(&device) *
+                         SEQUENTIAL_BLOCK_SIZE + RANDOM_PASS_WORK;
+    speed_test_meter_start(&meter, control, pass_work * (SPEED_TEST_WARMUP_RUNS + SPEED_TEST_RUNS));
+
+    // Passes d'échauffement (réveil du disque, montée en fréquence du contrôleur) non comptées
+    float sequential[SPEED_TEST_RUNS];
+    float random[SPEED_TEST_RUNS];
+    bool ok = true;
+    for (int pass = 0; pass < SPEED_TEST_WARMUP_RUNS + SPEED_TEST_RUNS && ok; pass++) {
+        int run = pass - SPEED_TEST_WARMUP_RUNS;
+        float sequential_mbps = 0.0f;
+        float random_iops = 0.0f;
+        ok = read_sequential_pass(&device, pass, &meter, &sequential_mbps, &result->bytes_read) &&
+             read_random_pass(&device, &meter, &random_iops, &result->bytes_read);
+        if (ok && run >= 0) {
+            sequential[run] = sequential_mbps;
+            random[run] = random_iops;
+        }
+    }
+
+    free(device.buffer);
+    close(device.fd);
+    if (!ok) {
+        return false;
+    }
+
+    speed_test_summarize(sequential, SPEED_TEST_RUNS, &result->sequential_mbps);
+    speed_test_summarize(random, SPEED_TEST_RUNS, &result->random_iops);
+    result->random_mbps = result->random_iops.median * RANDOM_BLOCK_SIZE / (1024.0f * 1024.0f);
+    return true;
+}
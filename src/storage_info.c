@@ -5,6 +5,10 @@
 
 #define _GNU_SOURCE
 #include "storage_info.h"
+#include "sysroot.h"
+#include "parse_utils.h"
+#include "counter_delta.h"
+#include "mount_table.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -16,6 +20,8 @@
 #include <stdbool.h>
 #include <fcntl.h>
 #include <errno.h>
+#include <dirent.h>
+#include <limits.h>
 
 float get_storage_used_gb(void) {
     return 45.2f;  // Mock: 45.2 GB
@@ -132,248 +138,283 @@ static bool is_safe_storage_name(const char *name) {
     return true;
 }
 
-// Récupérer la liste des stockages physiques
-PhysicalStorage* get_physical_storages(int *count) {
-    if (count == NULL) {
-        return NULL;
+// Mettre à jour l'espace utilisé/disponible d'un stockage (somme de ses systèmes de fichiers montés)
+// Les volumes LVM, dm-crypt et md comptent pour chacun des disques qui les portent
+bool update_physical_storage_usage(PhysicalStorage *storage) {
+    if (storage == NULL || !is_safe_storage_name(storage->name)) {
+        return false;
     }
     
-    *count = 0;
+    storage->used_gb = 0.0f;
+    storage->available_gb = 0.0f;
     
-    // Lire depuis /sys/block pour identifier les disques
-    FILE *fp = popen("ls /sys/block/ | grep -E '^(sd|nvme|hd|mmcblk)'", "r");
-    if (fp == NULL) {
-        return NULL;
+    MountEntry filesystems[32];
+    int count = get_storage_filesystems(storage->name, filesystems, 32);
+    uint64_t total = 0;
+    uint64_t used = 0;
+    uint64_t available = 0;
+    bool found = false;
+    for (int i = 0; i < count; i++) {
+        char path[PATH_MAX];
+        struct statvfs fs;
+        if (!sysroot_path(path, sizeof(path), "%s", filesystems[i].mount_point) || statvfs(path, &fs) != 0) {
+            continue;
+        }
+        total += (uint64_t)fs.f_blocks * fs.f_frsize;
+        used += (uint64_t)(fs.f_blocks - fs.f_bfree) * fs.f_frsize;
+        available += (uint64_t)fs.f_bavail * fs.f_frsize;
+        found = true;
     }
     
-    char storage_name[32];
-    int storage_count = 0;
-    PhysicalStorage *storages = malloc(sizeof(PhysicalStorage) * 10);  // Max 10 stockages
-    
-    // Lire les noms de stockages
-    while (fgets(storage_name, sizeof(storage_name), fp) != NULL && storage_count < 10) {
-        // Supprimer la newline
-        size_t len = strlen(storage_name);
-        if (len > 0 && storage_name[len-1] == '\n') {
-            storage_name[len-1] = '\0';
-        }
-        
-        // SÉCURITÉ: Valider le nom pour prévenir l'injection de commande
-        if (!is_safe_storage_name(storage_name)) {
-            continue;  // Ignorer les noms suspects
-        }
-        
-        // Ignorer les partitions:
-        // - sda1, sdb2, etc. (partition SD/SATA)
-        // - nvme0n1p1, etc. (partition NVMe) - contient 'p' suivi de chiffres
-        // - hda1, hdb2, etc. (partition IDE)
-        // - mmcblk0p1, etc. (partition SD card)
-        // Les vrais disques: sda, nvme0n1, hda, mmcblk0
-        
-        // Vérifier si c'est une partition
-        bool is_partition = false;
-        if (strncmp(storage_name, "nvme", 4) == 0) {
-            // Pour NVMe: nvme0n1 est OK, nvme0n1p1 n'est pas OK
-            if (strchr(storage_name, 'p') != NULL && isdigit(storage_name[strlen(storage_name)-1])) {
-                is_partition = true;  // C'est nvme0n1p1, nvme0n1p2, etc.
-            }
-        } else if (strncmp(storage_name, "mmcblk", 6) == 0) {
-            // Pour SD card: mmcblk0 est OK, mmcblk0p1 n'est pas OK
-            if (strchr(storage_name, 'p') != NULL && isdigit(storage_name[strlen(storage_name)-1])) {
-                is_partition = true;  // C'est mmcblk0p1, mmcblk0p2, etc.
-            }
-        } else {
-            // Pour SD/HD: sda, sdb sont OK, sda1, sda2 ne sont pas OK
-            if (strlen(storage_name) > 0 && isdigit(storage_name[strlen(storage_name)-1])) {
-                is_partition = true;
-            }
+    if (found) {
+        storage->capacity_gb = (float)(total / (1024.0 * 1024.0 * 1024.0));
+        storage->used_gb = (float)(used / (1024.0 * 1024.0 * 1024.0));
+        storage->available_gb = (float)(available / (1024.0 * 1024.0 * 1024.0));
+    }
+    return found;
+}
+
+// Lire les informations d'un stockage physique
+bool get_physical_storage_info(const char *storage_name, PhysicalStorage *storage) {
+    if (storage_name == NULL || storage == NULL) {
+        return false;
+    }
+    
+    // SÉCURITÉ: Valider le nom pour prévenir l'injection de commande
+    if (!is_safe_storage_name(storage_name)) {
+        return false;  // Ignorer les noms suspects
+    }
+    
+    // Ne garder que les familles de disques prises en charge (sd, nvme, hd, mmcblk)
+    if (strncmp(storage_name, "sd", 2) != 0 && strncmp(storage_name, "nvme", 4) != 0 &&
+        strncmp(storage_name, "hd", 2) != 0 && strncmp(storage_name, "mmcblk", 6) != 0) {
+        return false;
+    }
+    
+    // Ignorer les partitions:
+    // - sda1, sdb2, etc. (partition SD/SATA)
+    // - nvme0n1p1, etc. (partition NVMe) - contient 'p' suivi de chiffres
+    // - hda1, hdb2, etc. (partition IDE)
+    // - mmcblk0p1, etc. (partition SD card)
+    // Les vrais disques: sda, nvme0n1, hda, mmcblk0
+    
+    // Vérifier si c'est une partition
+    bool is_partition = false;
+    if (strncmp(storage_name, "nvme", 4) == 0) {
+        // Pour NVMe: nvme0n1 est OK, nvme0n1p1 n'est pas OK
+        if (strchr(storage_name, 'p') != NULL && isdigit(storage_name[strlen(storage_name)-1])) {
+            is_partition = true;  // C'est nvme0n1p1, nvme0n1p2, etc.
         }
-        
-        if (is_partition) {
-            continue;
+    } else if (strncmp(storage_name, "mmcblk", 6) == 0) {
+        // Pour SD card: mmcblk0 est OK, mmcblk0p1 n'est pas OK
+        if (strchr(storage_name, 'p') != NULL && isdigit(storage_name[strlen(storage_name)-1])) {
+            is_partition = true;  // C'est mmcblk0p1, mmcblk0p2, etc.
         }
-        
-        // Ignorer les loops et autres
-        if (strncmp(storage_name, "loop", 4) == 0 || 
-            strncmp(storage_name, "dm-", 3) == 0 ||
-            strncmp(storage_name, "ram", 3) == 0 ||
-            strncmp(storage_name, "zram", 4) == 0) {
-            continue;
+    } else {
+        // Pour SD/HD: sda, sdb sont OK, sda1, sda2 ne sont pas OK
+        if (strlen(storage_name) > 0 && isdigit(storage_name[strlen(storage_name)-1])) {
+            is_partition = true;
         }
+    }
+    
+    if (is_partition) {
+        return false;
+    }
+    
+    // Ignorer les loops et autres
+    if (strncmp(storage_name, "loop", 4) == 0 || 
+        strncmp(storage_name, "dm-", 3) == 0 ||
+        strncmp(storage_name, "ram", 3) == 0 ||
+        strncmp(storage_name, "zram", 4) == 0) {
+        return false;
+    }
+    
+    // Initialiser la structure
+    memset(storage, 0, sizeof(PhysicalStorage));
+    strncpy(storage->name, storage_name, sizeof(storage->name) - 1);
+    
+    // Déterminer le type de disque
+    if (strncmp(storage_name, "nvme", 4) == 0) {
+        strncpy(storage->type, "NVMe", sizeof(storage->type) - 1);
         
-        // Initialiser la structure
-        memset(&storages[storage_count], 0, sizeof(PhysicalStorage));
-        strncpy(storages[storage_count].name, storage_name, sizeof(storages[storage_count].name) - 1);
+        // Détecter la génération PCIe (Gen3, Gen4, Gen5)
+        char pcie_speed_path[256];
+        sysroot_path(pcie_speed_path, sizeof(pcie_speed_path), 
+                 "/sys/block/%s/device/device/current_link_speed", storage_name);
         
-        // Déterminer le type de disque
-        if (strncmp(storage_name, "nvme", 4) == 0) {
-            strncpy(storages[storage_count].type, "NVMe", sizeof(storages[storage_count].type) - 1);
-            
-            // Détecter la génération PCIe (Gen3, Gen4, Gen5)
-            char pcie_speed_path[256];
-            snprintf(pcie_speed_path, sizeof(pcie_speed_path), 
-                     "/sys/block/%s/device/device/current_link_speed", storage_name);
-            
-            FILE *speed_fp = fopen(pcie_speed_path, "r");
-            if (speed_fp != NULL) {
-                char speed_str[32];
-                if (fgets(speed_str, sizeof(speed_str), speed_fp) != NULL) {
-                    // Format typique: "8.0 GT/s" (Gen3) ou "16.0 GT/s" (Gen4)
-                    float speed_gt = 0.0f;
-                    if (sscanf(speed_str, "%f GT/s", &speed_gt) == 1) {
-                        if (speed_gt >= 32.0f) {
-                            strncpy(storages[storage_count].interface, "PCIe Gen5", sizeof(storages[storage_count].interface) - 1);
-                        } else if (speed_gt >= 16.0f) {
-                            strncpy(storages[storage_count].interface, "PCIe Gen4", sizeof(storages[storage_count].interface) - 1);
-                        } else if (speed_gt >= 8.0f) {
-                            strncpy(storages[storage_count].interface, "PCIe Gen3", sizeof(storages[storage_count].interface) - 1);
-                        } else if (speed_gt >= 5.0f) {
-                            strncpy(storages[storage_count].interface, "PCIe Gen2", sizeof(storages[storage_count].interface) - 1);
-                        } else {
-                            strncpy(storages[storage_count].interface, "PCIe Gen1", sizeof(storages[storage_count].interface) - 1);
-                        }
+        FILE *speed_fp = fopen(pcie_speed_path, "r");
+        if (speed_fp != NULL) {
+            char speed_str[32];
+            if (fgets(speed_str, sizeof(speed_str), speed_fp) != NULL) {
+                // Format typique: "8.0 GT/s" (Gen3) ou "16.0 GT/s" (Gen4)
+                float speed_gt = 0.0f;
+                if (sscanf(speed_str, "%f GT/s", &speed_gt) == 1) {
+                    if (speed_gt >= 32.0f) {
+                        strncpy(storage->interface, "PCIe Gen5", sizeof(storage->interface) - 1);
+                    } else if (speed_gt >= 16.0f) {
+                        strncpy(storage->interface, "PCIe Gen4", sizeof(storage->interface) - 1);
+                    } else if (speed_gt >= 8.0f) {
+                        strncpy(storage->interface, "PCIe Gen3", sizeof(storage->interface) - 1);
+                    } else if (speed_gt >= 5.0f) {
+                        strncpy(storage->interface, "PCIe Gen2", sizeof(storage->interface) - 1);
                     } else {
-                        strncpy(storages[storage_count].interface, "PCIe", sizeof(storages[storage_count].interface) - 1);
+                        strncpy(storage->interface, "PCIe Gen1", sizeof(storage->interface) - 1);
                     }
                 } else {
-                    strncpy(storages[storage_count].interface, "PCIe", sizeof(storages[storage_count].interface) - 1);
+                    strncpy(storage->interface, "PCIe", sizeof(storage->interface) - 1);
                 }
-                fclose(speed_fp);
             } else {
-                // Fallback si le fichier n'existe pas
-                strncpy(storages[storage_count].interface, "PCIe", sizeof(storages[storage_count].interface) - 1);
+                strncpy(storage->interface, "PCIe", sizeof(storage->interface) - 1);
             }
-        } else if (strncmp(storage_name, "sd", 2) == 0 || strncmp(storage_name, "hd", 2) == 0) {
-            // Vérifier si c'est USB
-            char usb_path[256];
-            snprintf(usb_path, sizeof(usb_path), "/sys/block/%s/device", storage_name);
-            char *resolved = realpath(usb_path, NULL);
+            fclose(speed_fp);
+        } else {
+            // Fallback si le fichier n'existe pas
+            strncpy(storage->interface, "PCIe", sizeof(storage->interface) - 1);
+        }
+    } else if (strncmp(storage_name, "sd", 2) == 0 || strncmp(storage_name, "hd", 2) == 0) {
+        // Vérifier si c'est USB
+        char usb_path[256];
+        sysroot_path(usb_path, sizeof(usb_path), "/sys/block/%s/device", storage_name);
+        char *resolved = realpath(usb_path, NULL);
+        
+        if (resolved != NULL && strstr(resolved, "usb") != NULL) {
+            strncpy(storage->type, "USB", sizeof(storage->type) - 1);
+            
+            // Déterminer la version USB en lisant la vitesse du port USB
+            char speed_path[512];
+            char *usb_device = strstr(resolved, "/usb");
             
-            if (resolved != NULL && strstr(resolved, "usb") != NULL) {
-                strncpy(storages[storage_count].type, "USB", sizeof(storages[storage_count].type) - 1);
-                
-                // Déterminer la version USB en lisant la vitesse du port USB
-                char speed_path[512];
-                char *usb_device = strstr(resolved, "/usb");
-                
-                if (usb_device != NULL) {
-                    // Extraire le chemin jusqu'au device USB
-                    char *next_slash = strchr(usb_device + 4, '/');
+            if (usb_device != NULL) {
+                // Extraire le chemin jusqu'au device USB
+                char *next_slash = strchr(usb_device + 4, '/');
+                if (next_slash != NULL) {
+                    next_slash = strchr(next_slash + 1, '/');
                     if (next_slash != NULL) {
-                        next_slash = strchr(next_slash + 1, '/');
-                        if (next_slash != NULL) {
-                            size_t len = next_slash - resolved;
-                            snprintf(speed_path, sizeof(speed_path), "%.*s/speed", (int)len, resolved);
-                            
-                            // Lire la vitesse
-                            FILE *speed_fp = fopen(speed_path, "r");
-                            if (speed_fp != NULL) {
-                                int speed = 0;
-                                if (fscanf(speed_fp, "%d", &speed) == 1) {
-                                    // USB 1.x = 1.5 ou 12 Mbps
-                                    // USB 2.0 = 480 Mbps
-                                    // USB 3.0 = 5000 Mbps
-                                    // USB 3.1 = 10000 Mbps
-                                    // USB 3.2 = 20000 Mbps
-                                    if (speed >= 10000) {
-                                        strncpy(storages[storage_count].interface, "USB 3.1+", sizeof(storages[storage_count].interface) - 1);
-                                    } else if (speed >= 5000) {
-                                        strncpy(storages[storage_count].interface, "USB 3.0", sizeof(storages[storage_count].interface) - 1);
-                                    } else if (speed >= 480) {
-                                        strncpy(storages[storage_count].interface, "USB 2.0", sizeof(storages[storage_count].interface) - 1);
-                                    } else {
-                                        strncpy(storages[storage_count].interface, "USB 1.x", sizeof(storages[storage_count].interface) - 1);
-                                    }
+                        size_t len = next_slash - resolved;
+                        snprintf(speed_path, sizeof(speed_path), "%.*s/speed", (int)len, resolved);
+                        
+                        // Lire la vitesse
+                        FILE *speed_fp = fopen(speed_path, "r");
+                        if (speed_fp != NULL) {
+                            int speed = 0;
+                            if (fscanf(speed_fp, "%d", &speed) == 1) {
+                                // USB 1.x = 1.5 ou 12 Mbps
+                                // USB 2.0 = 480 Mbps
+                                // USB 3.0 = 5000 Mbps
+                                // USB 3.1 = 10000 Mbps
+                                // USB 3.2 = 20000 Mbps
+                                if (speed >= 10000) {
+                                    strncpy(storage->interface, "USB 3.1+", sizeof(storage->interface) - 1);
+                                } else if (speed >= 5000) {
+                                    strncpy(storage->interface, "USB 3.0", sizeof(storage->interface) - 1);
+                                } else if (speed >= 480) {
+                                    strncpy(storage->interface, "USB 2.0", sizeof(storage->interface) - 1);
                                 } else {
-                                    strncpy(storages[storage_count].interface, "USB", sizeof(storages[storage_count].interface) - 1);
+                                    strncpy(storage->interface, "USB 1.x", sizeof(storage->interface) - 1);
                                 }
-                                fclose(speed_fp);
                             } else {
-                                strncpy(storages[storage_count].interface, "USB", sizeof(storages[storage_count].interface) - 1);
+                                strncpy(storage->interface, "USB", sizeof(storage->interface) - 1);
                             }
+                            fclose(speed_fp);
                         } else {
-                            strncpy(storages[storage_count].interface, "USB", sizeof(storages[storage_count].interface) - 1);
+                            strncpy(storage->interface, "USB", sizeof(storage->interface) - 1);
                         }
                     } else {
-                        strncpy(storages[storage_count].interface, "USB", sizeof(storages[storage_count].interface) - 1);
+                        strncpy(storage->interface, "USB", sizeof(storage->interface) - 1);
                     }
                 } else {
-                    strncpy(storages[storage_count].interface, "USB", sizeof(storages[storage_count].interface) - 1);
+                    strncpy(storage->interface, "USB", sizeof(storage->interface) - 1);
                 }
-                free(resolved);
             } else {
-                // SATA ou IDE
-                strncpy(storages[storage_count].type, "HDD", sizeof(storages[storage_count].type) - 1);
-                strncpy(storages[storage_count].interface, "SATA", sizeof(storages[storage_count].interface) - 1);
-                if (resolved != NULL) free(resolved);
+                strncpy(storage->interface, "USB", sizeof(storage->interface) - 1);
             }
-        } else if (strncmp(storage_name, "mmcblk", 6) == 0) {
-            strncpy(storages[storage_count].type, "SD Card", sizeof(storages[storage_count].type) - 1);
-            strncpy(storages[storage_count].interface, "SD/MMC", sizeof(storages[storage_count].interface) - 1);
-        }
-        
-        // Lire la capacité depuis /sys/block/[storage]/size (fallback)
-        char size_path[256];
-        snprintf(size_path, sizeof(size_path), "/sys/block/%s/size", storage_name);
-        FILE *size_fp = fopen(size_path, "r");
-        if (size_fp != NULL) {
-            unsigned long sectors = 0;
-            fscanf(size_fp, "%lu", &sectors);
-            fclose(size_fp);
-            storages[storage_count].capacity_gb = (sectors * 512) / (1024.0 * 1024.0 * 1024.0);
+            free(resolved);
+        } else {
+            // SATA ou IDE
+            strncpy(storage->type, "HDD", sizeof(storage->type) - 1);
+            strncpy(storage->interface, "SATA", sizeof(storage->interface) - 1);
+            if (resolved != NULL) free(resolved);
         }
-        
-        // Lire le modèle du stockage
-        char model_path[256];
-        snprintf(model_path, sizeof(model_path), "/sys/block/%s/device/model", storage_name);
-        FILE *model_fp = fopen(model_path, "r");
-        if (model_fp != NULL) {
-            if (fgets(storages[storage_count].model, sizeof(storages[storage_count].model), model_fp) != NULL) {
-                // Supprimer la newline
-                size_t model_len = strlen(storages[storage_count].model);
-                if (model_len > 0 && storages[storage_count].model[model_len-1] == '\n') {
-                    storages[storage_count].model[model_len-1] = '\0';
-                }
+    } else if (strncmp(storage_name, "mmcblk", 6) == 0) {
+        strncpy(storage->type, "SD Card", sizeof(storage->type) - 1);
+        strncpy(storage->interface, "SD/MMC", sizeof(storage->interface) - 1);
+    }
+    
+    // Lire la capacité depuis /sys/block/[storage]/size (fallback)
+    char size_path[256];
+    sysroot_path(size_path, sizeof(size_path), "/sys/block/%s/size", storage_name);
+    char size_text[32];
+    long size_len = parse_read_file_at(size_path, size_text, sizeof(size_text));
+    uint64_t sectors = 0;
+    if (size_len > 0 && parse_u64(size_text, size_text + size_len, &sectors) != NULL) {
+        storage->capacity_gb = (sectors * 512) / (1024.0 * 1024.0 * 1024.0);
+    }
+    
+    // Lire le modèle du stockage
+    char model_path[256];
+    sysroot_path(model_path, sizeof(model_path), "/sys/block/%s/device/model", storage_name);
+    FILE *model_fp = fopen(model_path, "r");
+    if (model_fp != NULL) {
+        if (fgets(storage->model, sizeof(storage->model), model_fp) != NULL) {
+            // Supprimer la newline
+            size_t model_len = strlen(storage->model);
+            if (model_len > 0 && storage->model[model_len-1] == '\n') {
+                storage->model[model_len-1] = '\0';
             }
-            fclose(model_fp);
-        }
-        
-        // Lire les données d'utilisation via df (prioritaire pour la capacité réelle)
-        storages[storage_count].used_gb = 0.0f;
-        storages[storage_count].available_gb = 0.0f;
-        
-        // Chercher toutes les partitions du stockage et additionner leurs stats
-        // Utiliser -B 1M pour obtenir les tailles en MB, puis convertir en GB
-        char partition_pattern[512];
-        if (strncmp(storage_name, "nvme", 4) == 0) {
-            snprintf(partition_pattern, sizeof(partition_pattern), 
-                     "df -B 1M | grep '/dev/%sp' | awk '{total+=$2; used+=$3; avail+=$4} END {if (NR>0) print total, used, avail}'", storage_name);
-        } else if (strncmp(storage_name, "mmcblk", 6) == 0) {
-            snprintf(partition_pattern, sizeof(partition_pattern), 
-                     "df -B 1M | grep '/dev/%sp' | awk '{total+=$2; used+=$3; avail+=$4} END {if (NR>0) print total, used, avail}'", storage_name);
-        } else {
-            snprintf(partition_pattern, sizeof(partition_pattern),
-                     "df -B 1M | grep '/dev/%s' | grep -E '[0-9]' | awk '{total+=$2; used+=$3; avail+=$4} END {if (NR>0) print total, used, avail}'", storage_name);
         }
+        fclose(model_fp);
+    }
+    
+    // Occupation: statvfs des systèmes de fichiers du disque (LVM, dm-crypt et md compris)
+    update_physical_storage_usage(storage);
+    
+    return true;
+}
+
+// Récupérer la liste des stockages physiques
+PhysicalStorage* get_physical_storages(int *count) {
+    if (count == NULL) {
+        return NULL;
+    }
+    
+    *count = 0;
+    
+    // Lire depuis /sys/block pour identifier les disques (triés comme `ls`)
+    char block_path[PATH_MAX];
+    struct dirent **entries = NULL;
+    int entry_count = -1;
+    if (sysroot_path(block_path, sizeof(block_path), "/sys/block")) {
+        entry_count = scandir(block_path, &entries, NULL, alphasort);
+    }
+    if (entry_count < 0) {
+        return NULL;
+    }
+    
+    int storage_count = 0;
+    int storage_capacity = 0;
+    PhysicalStorage *storages = NULL;
+    
+    for (int i = 0; i < entry_count; i++) {
+        const char *storage_name = entries[i]->d_name;
         
-        FILE *df_fp = popen(partition_pattern, "r");
-        if (df_fp != NULL) {
-            char df_line[256];
-            if (fgets(df_line, sizeof(df_line), df_fp) != NULL) {
-                unsigned long total, used, available;
-                // Format: size used available (en MB grâce à -B 1M)
-                if (sscanf(df_line, "%lu %lu %lu", &total, &used, &available) == 3) {
-                    storages[storage_count].capacity_gb = (float)total / 1024.0f;
-                    storages[storage_count].used_gb = (float)used / 1024.0f;
-                    storages[storage_count].available_gb = (float)available / 1024.0f;
-                }
+        // Agrandir le tableau à la demande (pas de nombre maximal de disques)
+        if (storage_count == storage_capacity) {
+            int new_capacity = storage_capacity > 0 ? storage_capacity * 2 : 8;
+            PhysicalStorage *grown = realloc(storages, sizeof(PhysicalStorage) * new_capacity);
+            if (grown != NULL) {
+                storages = grown;
+                storage_capacity = new_capacity;
             }
-            pclose(df_fp);
         }
         
-        storage_count++;
+        // Lire les informations (ignore partitions, loops, etc.)
+        if (storage_count < storage_capacity &&
+            get_physical_storage_info(storage_name, &storages[storage_count])) {
+            storage_count++;
+        }
+        free(entries[i]);
     }
-    pclose(fp);
+    free(entries);
     
     *count = storage_count;
     
@@ -392,247 +433,286 @@ void free_physical_storages(PhysicalStorage *storages) {
     }
 }
 
-// Trouver le point de montage pour un disque donné
-static bool find_storage_mount_point(const char *storage_name, char *mount_point, size_t max_len) {
-    if (storage_name == NULL || mount_point == NULL) {
+// Trouver un système de fichiers inscriptible porté par ce disque (partition, LVM, dm-crypt...)
+static bool find_storage_mount(const char *storage_name, MountEntry *mount) {
+    MountEntry filesystems[32];
+    int count = get_storage_filesystems(storage_name, filesystems, 32);
+    for (int i = 0; i < count; i++) {
+        if (!filesystems[i].read_only) {
+            *mount = filesystems[i];
+            return true;
+        }
+    }
+    return false;
+}
+
+#define FILE_TEST_BLOCK_SIZE     (1024 * 1024)
+#define SUSTAINED_WRITE_MAX_MB   4096    // Cache SLC statique courant; usure bornée à chaque test
+#define SUSTAINED_WRITE_FREE_SHARE 4     // Jamais plus d'un quart de l'espace libre
+
+// Données pseudo-aléatoires: un contrôleur qui compresse ou déduplique (SandForce, certains
+// SSD d'entrée de gamme) écrirait un motif répétitif bien plus vite que des données réelles
+// Tout le bloc est régénéré à partir de (passe, bloc): aucune page de 4 Kio ne se répète
+// d'un bloc ou d'une passe à l'autre. Hors du temps mesuré (~0,3 ms par Mio).
+static void fill_incompressible(unsigned char *data, size_t size, uint64_t pass, uint64_t block) {
+    uint64_t state = ((pass << 32) ^ block) * 0x9E3779B97F4A7C15ULL ^ 0xD1B54A32D192ED03ULL;
+    state = state != 0 ? state : 1;  // xorshift64 reste à 0 pour une graine nulle
+    for (size_t i = 0; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t)) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        memcpy(&data[i], &state, sizeof(state));
+    }
+}
+
+// Une passe d'écriture: blocs de 1 Mio puis fdatasync, compté dans la durée
+static bool write_file_pass(int fd, unsigned char *buffer, int blocks, int pass,
+                            SpeedTestTimeline *timeline, SpeedTestMeter *meter, float *mbps) {
+    const char *phase = pass < SPEED_TEST_WARMUP_RUNS ? "Warm-up write" : "Write";
+    double total = 0.0;
+    for (int i = 0; i < blocks; i++) {
+        fill_incompressible(buffer, FILE_TEST_BLOCK_SIZE, (uint64_t)pass, (uint64_t)i);
+        double start = counter_clock_seconds();
+        ssize_t written = pwrite(fd, buffer, FILE_TEST_BLOCK_SIZE, (off_t)i * FILE_TEST_BLOCK_SIZE);
+        double seconds = counter_clock_seconds() - start;
+        if (written != FILE_TEST_BLOCK_SIZE) {
+            return false;
+        }
+        speed_test_timeline_add(timeline, FILE_TEST_BLOCK_SIZE, seconds);
+        total += seconds;
+        if (!speed_test_meter_add(meter, phase, FILE_TEST_BLOCK_SIZE, FILE_TEST_BLOCK_SIZE)) {
+            return false;
+        }
+    }
+    double start = counter_clock_seconds();
+    if (fdatasync(fd) != 0) {
         return false;
     }
-    
-    // Construire le pattern de recherche pour les partitions
-    char partition_pattern[128];
-    if (strncmp(storage_name, "nvme", 4) == 0 || strncmp(storage_name, "mmcblk", 6) == 0) {
-        snprintf(partition_pattern, sizeof(partition_pattern), "/dev/%sp", storage_name);
-    } else {
-        snprintf(partition_pattern, sizeof(partition_pattern), "/dev/%s", storage_name);
+    double seconds = counter_clock_seconds() - start;
+    speed_test_timeline_add(timeline, 0, seconds);
+    total += seconds;
+
+    *mbps = total > 0 ? (float)(blocks / total) : 0.0f;
+    return true;
+}
+
+// Écriture soutenue à la suite du fichier (blocs jamais écrits): les passes réécrivent 64 Mio,
+// moins que le cache SLC, qui ne se remplit qu'ici. S'arrête au volume prévu, à la
+// série pleine (SPEED_TEST_MAX_SLICES tranches d'E/S) ou au disque plein.
+static bool write_sustained(int fd, unsigned char *buffer, int first_block, uint64_t max_blocks,
+                            SpeedTestTimeline *timeline, SpeedTestMeter *meter, uint64_t *written_blocks) {
+    uint64_t budget = max_blocks * FILE_TEST_BLOCK_SIZE;
+    uint64_t credited = 0;
+    for (uint64_t i = 0; i < max_blocks && timeline->slice_count < SPEED_TEST_MAX_SLICES; i++) {
+        uint64_t block = (uint64_t)first_block + i;
+        fill_incompressible(buffer, FILE_TEST_BLOCK_SIZE, SPEED_TEST_WARMUP_RUNS + SPEED_TEST_RUNS, block);
+        double start = counter_clock_seconds();
+        ssize_t written = pwrite(fd, buffer, FILE_TEST_BLOCK_SIZE, (off_t)(block * FILE_TEST_BLOCK_SIZE));
+        double seconds = counter_clock_seconds() - start;
+        if (written < 0 && errno == ENOSPC) {
+            break;  // Espace pris par un autre processus pendant le test
+        }
+        if (written != FILE_TEST_BLOCK_SIZE) {
+            return false;
+        }
+        speed_test_timeline_add(timeline, FILE_TEST_BLOCK_SIZE, seconds);
+        *written_blocks = i + 1;
+
+        // Avancement: volume écrit ou temps d'E/S écoulé, selon la limite la plus proche
+        uint64_t by_bytes = (i + 1) * FILE_TEST_BLOCK_SIZE;
+        uint64_t by_time = budget / SPEED_TEST_MAX_SLICES * (uint64_t)timeline->slice_count;
+        uint64_t work = by_bytes > by_time ? by_bytes : by_time;
+        work = work < budget ? work : budget;
+        if (!speed_test_meter_add(meter, "Sustained write", FILE_TEST_BLOCK_SIZE, work - credited)) {
+            return false;
+        }
+        credited = work;
     }
-    
-    // Lire /proc/mounts pour trouver une partition montée de ce disque
-    FILE *fp = fopen("/proc/mounts", "r");
-    if (fp == NULL) {
+    meter->done_work += budget - credited;
+
+    double start = counter_clock_seconds();
+    if (fdatasync(fd) != 0) {
         return false;
     }
-    
-    char line[512];
-    
-    while (fgets(line, sizeof(line), fp) != NULL) {
-        char device[256], mpoint[256], fstype[64];
-        if (sscanf(line, "%255s %255s %63s", device, mpoint, fstype) == 3) {
-            // Vérifier si c'est une partition de notre disque
-            if (strncmp(device, partition_pattern, strlen(partition_pattern)) == 0) {
-                // Éviter les pseudo-filesystems
-                if (strcmp(fstype, "tmpfs") != 0 && 
-                    strcmp(fstype, "devtmpfs") != 0 &&
-                    strcmp(fstype, "proc") != 0 &&
-                    strcmp(fstype, "sysfs") != 0) {
-                    // Prendre le premier point de montage valide trouvé
-                    strncpy(mount_point, mpoint, max_len - 1);
-                    mount_point[max_len - 1] = '\0';
-                    fclose(fp);
-                    return true;
-                }
-            }
+    speed_test_timeline_add(timeline, 0, counter_clock_seconds() - start);
+    return true;
+}
+
+static bool read_file_pass(int fd, unsigned char *buffer, int blocks, int pass,
+                           SpeedTestMeter *meter, float *mbps) {
+    const char *phase = pass < SPEED_TEST_WARMUP_RUNS ? "Warm-up read" : "Read";
+    double start = counter_clock_seconds();
+    for (int i = 0; i < blocks; i++) {
+        if (pread(fd, buffer, FILE_TEST_BLOCK_SIZE, (off_t)i * FILE_TEST_BLOCK_SIZE) != FILE_TEST_BLOCK_SIZE ||
+            !speed_test_meter_add(meter, phase, FILE_TEST_BLOCK_SIZE, FILE_TEST_BLOCK_SIZE)) {
+            return false;
         }
     }
-    fclose(fp);
-    
-    return false;
+    double seconds = counter_clock_seconds() - start;
+    *mbps = seconds > 0 ? (float)(blocks / seconds) : 0.0f;
+    return true;
 }
 
-// Effectuer un test de vitesse pour un disque spécifique
-void get_storage_speed_test(const char *storage_name, float *read_mbps, float *write_mbps) {
-    if (storage_name == NULL || read_mbps == NULL || write_mbps == NULL) {
-        return;
+// Fichier de test sans nom: il disparaît avec le descripteur, même si SysWatch est tué
+// pendant le test (une version précédente laissait .syswatch_speed_test_<disque>.bin)
+static int open_test_file(const char *test_dir, const char *test_file, bool direct_io) {
+    int flags = O_RDWR | O_CLOEXEC | (direct_io ? O_DIRECT : 0);
+    unlink(test_file);
+    int fd = open(test_dir, flags | O_TMPFILE, 0600);
+    if (fd < 0) {
+        // Pas d'O_TMPFILE (FAT, exFAT, noyau < 3.11): nom retiré dès la création
+        fd = open(test_file, flags | O_CREAT | O_EXCL, 0600);
+        if (fd >= 0) {
+            unlink(test_file);
+        }
+    }
+    return fd;
+}
+
+void get_file_speed_test_parameters(int size_mb, bool direct_io, char *parameters, size_t parameters_size) {
+    snprintf(parameters, parameters_size, "tempfile %dMiB %s+fdatasync median of %d",
+             size_mb, direct_io ? "O_DIRECT" : "buffered", SPEED_TEST_RUNS);
+}
+
+// Effectuer un test de vitesse pour un disque spécifique (fichier temporaire)
+bool get_storage_file_speed_test(const char *storage_name, bool sustained_write, FileSpeedTestResult *result,
+                                 SpeedTestControl *control) {
+    if (result == NULL) {
+        return false;
+    }
+    memset(result, 0, sizeof(*result));
+    speed_test_timeline_start(&result->write_timeline);
+    if (storage_name == NULL) {
+        return false;
     }
-    
-    *read_mbps = 0.0f;
-    *write_mbps = 0.0f;
     
     // Trouver un point de montage pour ce disque
-    char mount_point[256];
-    if (!find_storage_mount_point(storage_name, mount_point, sizeof(mount_point))) {
+    MountEntry mount;
+    if (!find_storage_mount(storage_name, &mount)) {
         // Pas de point de montage trouvé, le test ne peut pas être effectué
-        return;
+        return false;
     }
     
     // Si le point de montage est la racine ("/"), on doit trouver un autre emplacement
     // ATTENTION: /tmp est souvent un tmpfs (RAM) sur les systèmes modernes, pas le vrai disque!
     char test_dir[512];
-    
-    if (strcmp(mount_point, "/") == 0) {
-        // Pour le disque racine, utiliser un répertoire sur le vrai disque
-        // /var/tmp est généralement sur le disque, contrairement à /tmp qui peut être en RAM
-        struct stat st;
-        if (stat("/var/tmp", &st) == 0 && S_ISDIR(st.st_mode)) {
-            snprintf(test_dir, sizeof(test_dir), "/var/tmp");
-        } else {
-            // Fallback: utiliser le home de l'utilisateur
-            const char *home = getenv("HOME");
-            if (home != NULL) {
-                snprintf(test_dir, sizeof(test_dir), "%s", home);
-            } else {
-                snprintf(test_dir, sizeof(test_dir), "/tmp");  // Dernier recours
+    snprintf(test_dir, sizeof(test_dir), "%s", mount.mount_point);
+    
+    if (strcmp(mount.mount_point, "/") == 0) {
+        // Pour le disque racine, /var/tmp ou le home s'ils sont sur le même système de fichiers
+        // (ils peuvent être un tmpfs ou un autre volume), sinon la racine elle-même
+        const char *candidates[] = { "/var/tmp", getenv("HOME") };
+        struct stat root_st;
+        for (size_t i = 0; i < 2 && stat("/", &root_st) == 0; i++) {
+            struct stat st;
+            if (candidates[i] != NULL && stat(candidates[i], &st) == 0 && S_ISDIR(st.st_mode) &&
+                st.st_dev == root_st.st_dev && access(candidates[i], W_OK) == 0) {
+                snprintf(test_dir, sizeof(test_dir), "%s", candidates[i]);
+                break;
             }
         }
-    } else {
-        snprintf(test_dir, sizeof(test_dir), "%s", mount_point);
-    }
-    
-    // Vérifier les permissions d'écriture sur le répertoire de test
-    char test_write_path[512];
-    snprintf(test_write_path, sizeof(test_write_path), "%s/.syswatch_perm_test", test_dir);
-    FILE *perm_test = fopen(test_write_path, "w");
-    if (perm_test == NULL) {
-        // Impossible d'écrire sur ce disque
-        return;
     }
-    fclose(perm_test);
-    unlink(test_write_path);
     
-    // Créer un fichier de test
+    // Nom du fichier de test quand O_TMPFILE n'est pas disponible
     char test_file[512];
     snprintf(test_file, sizeof(test_file), "%s/.syswatch_speed_test_%s.bin", 
              test_dir, storage_name);
     
     // Vérifier l'espace disponible pour ajuster la taille du test
     struct statvfs stat;
-    int test_size_mb = 100;
+    int test_size_mb = FILE_SPEED_TEST_MB;
+    uint64_t available_mb = 0;
     if (statvfs(test_dir, &stat) == 0) {
-        unsigned long available_mb = (stat.f_bavail * stat.f_bsize) / (1024 * 1024);
-        if (available_mb < 200) {
-            test_size_mb = 20;
-        }
-    }
-    
-    // Détecter le système de fichiers
-    bool use_direct_io = true;
-    bool use_aligned_buffer = false;
-    
-    FILE *mounts_fp = fopen("/proc/mounts", "r");
-    if (mounts_fp != NULL) {
-        char line[512];
-        while (fgets(line, sizeof(line), mounts_fp) != NULL) {
-            char device[256], mpoint[256], fs[64];
-            if (sscanf(line, "%255s %255s %63s", device, mpoint, fs) == 3) {
-                if (strcmp(mpoint, mount_point) == 0) {
-                    // VFAT/FAT32 ne supporte pas O_DIRECT
-                    if (strcmp(fs, "vfat") == 0 || strcmp(fs, "msdos") == 0 || strcmp(fs, "fat") == 0) {
-                        use_direct_io = false;
-                    } else {
-                        use_direct_io = true;
-                        use_aligned_buffer = true;
-                    }
-                    break;
-                }
-            }
+        available_mb = (uint64_t)stat.f_bavail * stat.f_bsize / (1024 * 1024);
+        if (available_mb < 4 * FILE_SPEED_TEST_MB) {
+            test_size_mb = FILE_SPEED_TEST_SMALL_MB;
         }
-        fclose(mounts_fp);
     }
     
-    const size_t buffer_size = 1024 * 1024;
-    const int iterations = test_size_mb;
+    // VFAT/FAT32 ne supporte pas O_DIRECT
+    bool use_direct_io = strcmp(mount.fstype, "vfat") != 0 && strcmp(mount.fstype, "msdos") != 0 &&
+                         strcmp(mount.fstype, "fat") != 0;
     
-    // Allouer un buffer
-    void *buffer = NULL;
-    if (use_aligned_buffer) {
-        if (posix_memalign(&buffer, 512, buffer_size) != 0) {
-            return;
-        }
-    } else {
-        buffer = malloc(buffer_size);
-        if (buffer == NULL) {
-            return;
-        }
-    }
-    
-    // Remplir le buffer avec des données
-    unsigned char *data = (unsigned char *)buffer;
-    for (size_t i = 0; i < buffer_size; i++) {
-        data[i] = (unsigned char)(i % 256);
+    // Tampon aligné dans tous les cas (O_DIRECT peut être refusé à l'ouverture)
+    unsigned char *buffer = NULL;
+    if (posix_memalign((void **)&buffer, 4096, FILE_TEST_BLOCK_SIZE) != 0) {
+        return false;
     }
     
-    struct timespec start, end;
-    
-    // ========== TEST D'ÉCRITURE ==========
-    int fd;
-    if (use_direct_io) {
-        fd = open(test_file, O_WRONLY | O_CREAT | O_TRUNC | O_DIRECT | O_SYNC, 0644);
-        if (fd < 0) {
-            fd = open(test_file, O_WRONLY | O_CREAT | O_TRUNC | O_SYNC, 0644);
-        }
-    } else {
-        fd = open(test_file, O_WRONLY | O_CREAT | O_TRUNC | O_SYNC, 0644);
+    // Échec des deux ouvertures: impossible d'écrire sur ce disque
+    int fd = use_direct_io ? open_test_file(test_dir, test_file, true) : -1;
+    if (fd < 0) {
+        use_direct_io = false;
+        fd = open_test_file(test_dir, test_file, false);
     }
-    
     if (fd < 0) {
         free(buffer);
-        return;
-    }
-    
-    clock_gettime(CLOCK_MONOTONIC, &start);
-    for (int i = 0; i < iterations; i++) {
-        data[0] = (unsigned char)i;
-        ssize_t written = write(fd, buffer, buffer_size);
-        if (written != (ssize_t)buffer_size) {
-            close(fd);
-            unlink(test_file);
-            free(buffer);
-            return;
-        }
+        return false;
     }
-    fsync(fd);
-    clock_gettime(CLOCK_MONOTONIC, &end);
-    close(fd);
+    result->direct_io = use_direct_io;
+    result->size_mb = test_size_mb;
     
-    double write_time = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
-    *write_mbps = (write_time > 0) ? ((float)iterations / write_time) : 0.0f;
+    // Écriture soutenue: sur demande, un quart de l'espace libre au plus, et seulement en
+    // O_DIRECT (en cache, les tranches mesurent la mémoire et la série n'est pas gardée)
+    uint64_t sustained_mb = available_mb / SUSTAINED_WRITE_FREE_SHARE;
+    sustained_mb = sustained_mb < SUSTAINED_WRITE_MAX_MB ? sustained_mb : SUSTAINED_WRITE_MAX_MB;
+    sustained_mb = sustained_write && use_direct_io && sustained_mb > (uint64_t)test_size_mb
+        ? sustained_mb - (uint64_t)test_size_mb : 0;
     
-    // ========== TEST DE LECTURE ==========
-    sync();
+    SpeedTestMeter meter;
+    speed_test_meter_start(&meter, control, (2ULL * (SPEED_TEST_WARMUP_RUNS + SPEED_TEST_RUNS) *
+                                             (uint64_t)test_size_mb + sustained_mb) * FILE_TEST_BLOCK_SIZE);
     
-    if (use_direct_io) {
-        usleep(100000);
-    } else {
-        usleep(500000);
+    // ========== TEST D'ÉCRITURE ==========
+    // Première passe: allocation des blocs du fichier, non comptée
+    float write_runs[SPEED_TEST_RUNS];
+    float read_runs[SPEED_TEST_RUNS];
+    bool ok = true;
+    for (int pass = 0; pass < SPEED_TEST_WARMUP_RUNS + SPEED_TEST_RUNS && ok; pass++) {
+        float mbps = 0.0f;
+        ok = write_file_pass(fd, buffer, test_size_mb, pass, &result->write_timeline, &meter, &mbps);
+        if (ok && pass >= SPEED_TEST_WARMUP_RUNS) {
+            write_runs[pass - SPEED_TEST_WARMUP_RUNS] = mbps;
+        }
     }
     
-    if (use_direct_io) {
-        fd = open(test_file, O_RDONLY | O_DIRECT);
-        if (fd < 0) {
-            fd = open(test_file, O_RDONLY);
+    // ========== TEST DE LECTURE ==========
+    // O_DIRECT contourne le cache de pages; sinon le vider avant chaque passe
+    for (int pass = 0; pass < SPEED_TEST_WARMUP_RUNS + SPEED_TEST_RUNS && ok; pass++) {
+        if (!use_direct_io) {
+            result->caches_dropped = speed_test_drop_caches(fd);
+        }
+        float mbps = 0.0f;
+        ok = read_file_pass(fd, buffer, test_size_mb, pass, &meter, &mbps);
+        if (ok && pass >= SPEED_TEST_WARMUP_RUNS) {
+            read_runs[pass - SPEED_TEST_WARMUP_RUNS] = mbps;
         }
-    } else {
-        fd = open(test_file, O_RDONLY);
     }
     
-    if (fd < 0) {
-        unlink(test_file);
-        free(buffer);
-        return;
+    // ========== ÉCRITURE SOUTENUE ==========
+    // Après les lectures: un SSD qui vide son cache SLC ne les ralentit pas
+    // La série de tranches continue celle des passes d'écriture
+    if (ok && sustained_mb > 0) {
+        uint64_t written_blocks = 0;
+        ok = write_sustained(fd, buffer, test_size_mb, sustained_mb, &result->write_timeline, &meter,
+                             &written_blocks);
+        result->sustained_mb = (int)written_blocks;  // Blocs de 1 Mio
     }
     
-    if (!use_direct_io) {
-        posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+    close(fd);  // Libère les blocs du fichier (déjà sans nom)
+    free(buffer);
+    if (!ok) {
+        speed_test_timeline_start(&result->write_timeline);
+        return false;
     }
     
-    clock_gettime(CLOCK_MONOTONIC, &start);
-    for (int i = 0; i < iterations; i++) {
-        ssize_t bytes_read = read(fd, buffer, buffer_size);
-        if (bytes_read != (ssize_t)buffer_size) {
-            close(fd);
-            unlink(test_file);
-            free(buffer);
-            return;
-        }
-        if (!use_direct_io) {
-            posix_fadvise(fd, i * buffer_size, buffer_size, POSIX_FADV_DONTNEED);
-        }
+    speed_test_summarize(write_runs, SPEED_TEST_RUNS, &result->write_mbps);
+    speed_test_summarize(read_runs, SPEED_TEST_RUNS, &result->read_mbps);
+    if (use_direct_io) {
+        speed_test_timeline_finish(&result->write_timeline);
+    } else {
+        // Écritures en cache puis fdatasync: les tranches ne reflètent pas le disque
+        speed_test_timeline_start(&result->write_timeline);
     }
-    clock_gettime(CLOCK_MONOTONIC, &end);
-    close(fd);
-    
-    double read_time = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
-    *read_mbps = (read_time > 0) ? ((float)iterations / read_time) : 0.0f;
-    
-    unlink(test_file);
-    free(buffer);
+    return true;
 }
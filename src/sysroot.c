@@ -0,0 +1,87 @@
+/*
+ * sysroot.c
+ * Configurable root prefix for /proc, /sys and /etc reads
+ */
+
+#include "sysroot.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <limits.h>
+
+static char root_prefix[PATH_MAX] = {0};
+static bool root_initialized = false;
+
+// Copier la racine sans '/' final ("/" seul = système réel)
+static void store_root(const char *root) {
+    root_prefix[0] = '\0';
+    root_initialized = true;
+
+    if (root == NULL || root[0] == '\0') {
+        return;
+    }
+
+    size_t len = strlen(root);
+    while (len > 0 && root[len - 1] == '/') {
+        len--;
+    }
+    if (len == 0 || len >= sizeof(root_prefix)) {
+        return;  // "/" ou chemin trop long: système réel
+    }
+
+    memcpy(root_prefix, root, len);
+    root_prefix[len] = '\0';
+}
+
+void sysroot_set(const char *root) {
+    store_root(root);
+}
+
+const char* sysroot_get(void) {
+    // Première utilisation: lire SYSWATCH_ROOT
+    if (!root_initialized) {
+        store_root(getenv("SYSWATCH_ROOT"));
+    }
+    return root_prefix;
+}
+
+bool sysroot_is_set(void) {
+    return sysroot_get()[0] != '\0';
+}
+
+bool sysroot_path(char *buffer, size_t buffer_size, const char *format, ...) {
+    if (buffer == NULL || buffer_size == 0) {
+        return false;
+    }
+
+    const char *root = sysroot_get();
+    size_t root_len = strlen(root);
+    if (root_len >= buffer_size) {
+        buffer[0] = '\0';
+        return false;
+    }
+    memcpy(buffer, root, root_len);
+
+    va_list args;
+    va_start(args, format);
+    int written = vsnprintf(buffer + root_len, buffer_size - root_len, format, args);
+    va_end(args);
+
+    return written >= 0 && (size_t)written < buffer_size - root_len;
+}
+
+FILE* sysroot_fopen(const char *path, const char *mode) {
+    char full_path[PATH_MAX];
+    if (!sysroot_path(full_path, sizeof(full_path), "%s", path)) {
+        return NULL;
+    }
+    return fopen(full_path, mode);
+}
+
+DIR* sysroot_opendir(const char *path) {
+    char full_path[PATH_MAX];
+    if (!sysroot_path(full_path, sizeof(full_path), "%s", path)) {
+        return NULL;
+    }
+    return opendir(full_path);
+}
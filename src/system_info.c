@@ -6,6 +6,10 @@
 #define _GNU_SOURCE  // Pour strcasestr
 #include "system_info.h"
 #include "storage_info.h"
+#include "sysroot.h"
+#include "parse_utils.h"
+#include "counter_delta.h"
+#include "cpu_topology.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -22,7 +26,7 @@ float get_cpu_temperature_celsius(void) {
     char buffer[128];
     
     // Method 1: Direct read from /sys/class/thermal (universal Linux)
-    fp = fopen("/sys/class/thermal/thermal_zone0/temp", "r");
+    fp = sysroot_fopen("/sys/class/thermal/thermal_zone0/temp", "r");
     if (fp != NULL) {
         if (fgets(buffer, sizeof(buffer), fp) != NULL) {
             // Temperature is in millidegrees Celsius
@@ -86,7 +90,7 @@ const char* get_hardware_model(void) {
     }
     
     // Méthode 1: Device Tree (Raspberry Pi, ARM)
-    FILE *fp = fopen("/sys/firmware/devicetree/base/model", "r");
+    FILE *fp = sysroot_fopen("/sys/firmware/devicetree/base/model", "r");
     if (fp != NULL) {
         if (fgets(hardware_buffer, sizeof(hardware_buffer), fp) != NULL) {
             // Supprimer le \0 final du device tree
@@ -101,7 +105,7 @@ const char* get_hardware_model(void) {
     }
     
     // Méthode 2: /proc/cpuinfo (ligne Model)
-    fp = fopen("/proc/cpuinfo", "r");
+    fp = sysroot_fopen("/proc/cpuinfo", "r");
     if (fp != NULL) {
         char line[256];
         while (fgets(line, sizeof(line), fp) != NULL) {
@@ -124,7 +128,7 @@ const char* get_hardware_model(void) {
     }
     
     // Méthode 3: DMI pour PC x86 (manufacturer + product)
-    fp = fopen("/sys/class/dmi/id/product_name", "r");
+    fp = sysroot_fopen("/sys/class/dmi/id/product_name", "r");
     if (fp != NULL) {
         if (fgets(hardware_buffer, sizeof(hardware_buffer), fp) != NULL) {
             char *newline = strchr(hardware_buffer, '\n');
@@ -194,7 +198,7 @@ const char* get_processor_type(void) {
     }
     
     // Méthode 2: /proc/cpuinfo pour x86 (ligne "model name")
-    fp = fopen("/proc/cpuinfo", "r");
+    fp = sysroot_fopen("/proc/cpuinfo", "r");
     if (fp != NULL) {
         char line[256];
         while (fgets(line, sizeof(line), fp) != NULL) {
@@ -326,7 +330,7 @@ const char* get_gpu_info(void) {
     }
     
     // Méthode 2: Essayer sysfs pour GPU (Linux moderne)
-    fp = fopen("/sys/class/drm/card0/device/vendor", "r");
+    fp = sysroot_fopen("/sys/class/drm/card0/device/vendor", "r");
     if (fp != NULL) {
         char vendor_id[16] = {0};
         if (fgets(vendor_id, sizeof(vendor_id), fp) != NULL) {
@@ -375,7 +379,7 @@ const char* get_kernel_version(void) {
     }
     
     // Lire depuis /proc/version
-    FILE *fp = fopen("/proc/version", "r");
+    FILE *fp = sysroot_fopen("/proc/version", "r");
     if (fp != NULL) {
         if (fgets(kernel_buffer, sizeof(kernel_buffer), fp) != NULL) {
             // Format: "Linux version 6.6.51+rpt-rpi-2712 ..."
@@ -410,7 +414,7 @@ const char* get_distro_info(void) {
     }
     
     // Lire PRETTY_NAME depuis /etc/os-release
-    FILE *fp = fopen("/etc/os-release", "r");
+    FILE *fp = sysroot_fopen("/etc/os-release", "r");
     if (fp != NULL) {
         char line[256];
         while (fgets(line, sizeof(line), fp) != NULL) {
@@ -506,23 +510,21 @@ const char* get_cpu_cores(void) {
         return cores_buffer;
     }
     
-    // Méthode 1: Utiliser nproc (le plus rapide et universellement disponible)
-    FILE *fp = popen("nproc 2>/dev/null", "r");
-    if (fp != NULL) {
-        char line[16];
-        if (fgets(line, sizeof(line), fp) != NULL) {
-            int cores = atoi(line);
-            pclose(fp);
-            if (cores > 0) {
-                snprintf(cores_buffer, sizeof(cores_buffer), "%d", cores);
-                return cores_buffer;
-            }
+    // Méthode 1: topologie sysfs (CPU logiques, cœurs physiques, sockets), sans sous-processus
+    const CpuTopology *topology = get_cpu_topology();
+    if (topology != NULL && topology->cpu_count > 0) {
+        int length = snprintf(cores_buffer, sizeof(cores_buffer), "%d", topology->cpu_count);
+        if (topology->package_count > 1) {
+            snprintf(cores_buffer + length, sizeof(cores_buffer) - length, " (%d cores, %d sockets)",
+                     topology->core_count, topology->package_count);
+        } else if (topology->core_count != topology->cpu_count) {
+            snprintf(cores_buffer + length, sizeof(cores_buffer) - length, " (%d cores)", topology->core_count);
         }
-        pclose(fp);
+        return cores_buffer;
     }
     
     // Méthode 2: Compter les lignes "processor" dans /proc/cpuinfo
-    fp = fopen("/proc/cpuinfo", "r");
+    FILE *fp = sysroot_fopen("/proc/cpuinfo", "r");
     if (fp != NULL) {
         int cores = 0;
         char line[256];
@@ -546,13 +548,13 @@ const char* get_cpu_cores(void) {
 const char* get_uptime_string(void) {
     static char uptime_buffer[128] = {0};
     
-    FILE *fp = fopen("/proc/uptime", "r");
-    if (fp != NULL) {
-        double uptime_seconds_double;
-        if (fscanf(fp, "%lf", &uptime_seconds_double) == 1) {
-            fclose(fp);
-            
-            unsigned long uptime_seconds = (unsigned long)uptime_seconds_double;
+    // Format: "123456.78 987654.32" (seule la partie entière est utile)
+    char buffer[64];
+    long length = parse_read_file("/proc/uptime", buffer, sizeof(buffer));
+    if (length > 0) {
+        uint64_t uptime_value = 0;
+        if (parse_u64(buffer, buffer + length, &uptime_value) != NULL) {
+            unsigned long uptime_seconds = (unsigned long)uptime_value;
             unsigned long days = uptime_seconds / (24 * 3600);
             unsigned long hours = (uptime_seconds % (24 * 3600)) / 3600;
             unsigned long minutes = (uptime_seconds % 3600) / 60;
@@ -580,7 +582,6 @@ const char* get_uptime_string(void) {
             }
             return uptime_buffer;
         }
-        fclose(fp);
     }
     
     // Fallback
@@ -726,12 +727,11 @@ const char* get_locale_info(void) {
             if (len > 0 && locale_buffer[len-1] == '\n') {
                 locale_buffer[len-1] = '\0';
             }
-            pclose(fp);
-            if (locale_buffer[0] != '\0') {
-                return locale_buffer;
-            }
         }
         pclose(fp);
+        if (locale_buffer[0] != '\0') {
+            return locale_buffer;
+        }
     }
     
     // Fallback
@@ -740,47 +740,38 @@ const char* get_locale_info(void) {
 }
 
 float get_cpu_usage_percent(void) {
-    static unsigned long long prev_idle = 0, prev_total = 0;
-    unsigned long long idle, total;
-    unsigned long long user, nice, system, idle_time, iowait, irq, softirq, steal;
+    // Jiffies cumulés (u64 dans /proc/stat): remis à zéro seulement si /proc change (conteneur)
+    static CounterDelta idle_counter, total_counter;
     
-    FILE *fp = fopen("/proc/stat", "r");
-    if (fp == NULL) {
+    // Seule la première ligne est utile: inutile de lire les lignes par cœur
+    char buffer[512];
+    long length = parse_read_file("/proc/stat", buffer, sizeof(buffer));
+    if (length <= 0) {
         return -1.0f;
     }
+    const char *end = buffer + length;
     
-    // Lecture de la ligne "cpu" : user nice system idle iowait irq softirq steal
-    if (fscanf(fp, "cpu %llu %llu %llu %llu %llu %llu %llu %llu",
-               &user, &nice, &system, &idle_time, &iowait, &irq, &softirq, &steal) != 8) {
-        fclose(fp);
+    // Ligne "cpu" : user nice system idle iowait irq softirq steal
+    uint64_t fields[8];
+    const char *cursor = parse_skip_prefix(buffer, end, "cpu ");
+    if (cursor == NULL || parse_u64_fields(cursor, end, fields, 8) != 8) {
         return -1.0f;
     }
-    fclose(fp);
     
     // Calcul du temps total et idle
-    idle = idle_time + iowait;
-    total = user + nice + system + idle_time + iowait + irq + softirq + steal;
-    
-    // Première lecture : initialiser les valeurs précédentes
-    if (prev_total == 0) {
-        prev_idle = idle;
-        prev_total = total;
-        return 0.0f;  // Pas de données pour calculer le %
-    }
-    
-    // Calcul du delta
-    unsigned long long total_diff = total - prev_total;
-    unsigned long long idle_diff = idle - prev_idle;
-    
-    // Sauvegarder pour la prochaine fois
-    prev_idle = idle;
-    prev_total = total;
-    
-    // Calculer le pourcentage d'utilisation
-    if (total_diff == 0) {
+    uint64_t idle = fields[3] + fields[4];
+    uint64_t total = fields[0] + fields[1] + fields[2] + fields[3] + fields[4] + fields[5] + fields[6] + fields[7];
+    
+    // Première lecture ou remise à zéro: pas de données pour calculer le %
+    double now = counter_clock_seconds();
+    uint64_t idle_diff = 0, total_diff = 0;
+    CounterStatus idle_status = counter_delta_update(&idle_counter, idle, now, &idle_diff, NULL);
+    CounterStatus total_status = counter_delta_update(&total_counter, total, now, &total_diff, NULL);
+    if (idle_status != COUNTER_OK || total_status != COUNTER_OK || total_diff == 0 || idle_diff > total_diff) {
         return 0.0f;
     }
     
+    // Calculer le pourcentage d'utilisation
     float usage = 100.0f * (float)(total_diff - idle_diff) / (float)total_diff;
     return usage;
 }
@@ -807,7 +798,7 @@ float get_gpu_usage_percent(void) {
         char path[256];
         
         // AMD: gpu_busy_percent
-        snprintf(path, sizeof(path), "/sys/class/drm/card%d/device/gpu_busy_percent", i);
+        sysroot_path(path, sizeof(path), "/sys/class/drm/card%d/device/gpu_busy_percent", i);
         fp = fopen(path, "r");
         if (fp != NULL) {
             unsigned int usage;
@@ -819,7 +810,7 @@ float get_gpu_usage_percent(void) {
         }
         
         // AMD alternative: utilization
-        snprintf(path, sizeof(path), "/sys/class/drm/card%d/device/utilization", i);
+        sysroot_path(path, sizeof(path), "/sys/class/drm/card%d/device/utilization", i);
         fp = fopen(path, "r");
         if (fp != NULL) {
             unsigned int usage;
@@ -834,7 +825,7 @@ float get_gpu_usage_percent(void) {
     // ===== MÉTHODE 3: INTEL GPU (sysfs) =====
     for (i = 0; i < 4; i++) {
         char path[256];
-        snprintf(path, sizeof(path), "/sys/class/drm/card%d/gt/gt0/rps_cur_freq_mhz", i);
+        sysroot_path(path, sizeof(path), "/sys/class/drm/card%d/gt/gt0/rps_cur_freq_mhz", i);
         
         fp = fopen(path, "r");
         if (fp != NULL) {
@@ -843,7 +834,7 @@ float get_gpu_usage_percent(void) {
                 fclose(fp);
                 
                 // Lire fréquence max
-                snprintf(path, sizeof(path), "/sys/class/drm/card%d/gt/gt0/rps_max_freq_mhz", i);
+                sysroot_path(path, sizeof(path), "/sys/class/drm/card%d/gt/gt0/rps_max_freq_mhz", i);
                 fp = fopen(path, "r");
                 if (fp != NULL && fscanf(fp, "%u", &max_freq) == 1) {
                     fclose(fp);
@@ -897,56 +888,48 @@ float get_gpu_usage_percent(void) {
     return 0.0f;
 }
 
-float get_memory_usage_percent(void) {
-    FILE *fp = fopen("/proc/meminfo", "r");
-    if (fp == NULL) {
-        return -1.0f;
+// Lire MemTotal et MemAvailable (kB) en un seul passage sur /proc/meminfo
+static bool read_meminfo_totals(uint64_t *mem_total_kb, uint64_t *mem_available_kb) {
+    char buffer[4096];
+    long length = parse_read_file("/proc/meminfo", buffer, sizeof(buffer));
+    if (length <= 0) {
+        return false;
     }
     
-    unsigned long mem_total = 0;
-    unsigned long mem_available = 0;
-    char line[256];
+    const char *end = buffer + length;
+    bool has_total = false, has_available = false;
+    *mem_total_kb = 0;
+    *mem_available_kb = 0;
     
-    // Lire MemTotal et MemAvailable
-    while (fgets(line, sizeof(line), fp) != NULL) {
-        if (sscanf(line, "MemTotal: %lu kB", &mem_total) == 1) {
-            continue;
-        }
-        if (sscanf(line, "MemAvailable: %lu kB", &mem_available) == 1) {
-            break;  // On a tout ce qu'il faut
+    for (const char *line = buffer; line < end && !(has_total && has_available);
+         line = parse_next_line(line, end)) {
+        const char *value;
+        if ((value = parse_skip_prefix(line, end, "MemTotal:")) != NULL) {
+            has_total = parse_u64(value, end, mem_total_kb) != NULL;
+        } else if ((value = parse_skip_prefix(line, end, "MemAvailable:")) != NULL) {
+            has_available = parse_u64(value, end, mem_available_kb) != NULL;
         }
     }
-    fclose(fp);
     
-    if (mem_total == 0) {
+    return has_total;
+}
+
+float get_memory_usage_percent(void) {
+    uint64_t mem_total = 0, mem_available = 0;
+    if (!read_meminfo_totals(&mem_total, &mem_available) || mem_total == 0) {
         return -1.0f;
     }
     
     // Calculer le pourcentage utilisé
-    unsigned long mem_used = mem_total - mem_available;
+    uint64_t mem_used = mem_total - mem_available;
     float usage = 100.0f * (float)mem_used / (float)mem_total;
     
     return usage;
 }
 
 float get_memory_available_gb(void) {
-    FILE *fp = fopen("/proc/meminfo", "r");
-    if (fp == NULL) {
-        return -1.0f;
-    }
-    
-    unsigned long mem_available_kb = 0;
-    char line[256];
-    
-    // Lire MemAvailable
-    while (fgets(line, sizeof(line), fp) != NULL) {
-        if (sscanf(line, "MemAvailable: %lu kB", &mem_available_kb) == 1) {
-            break;
-        }
-    }
-    fclose(fp);
-    
-    if (mem_available_kb == 0) {
+    uint64_t mem_total_kb = 0, mem_available_kb = 0;
+    if (!read_meminfo_totals(&mem_total_kb, &mem_available_kb) || mem_available_kb == 0) {
         return -1.0f;
     }
     
@@ -957,23 +940,8 @@ float get_memory_available_gb(void) {
 }
 
 float get_memory_total_gb(void) {
-    FILE *fp = fopen("/proc/meminfo", "r");
-    if (fp == NULL) {
-        return -1.0f;
-    }
-    
-    unsigned long mem_total_kb = 0;
-    char line[256];
-    
-    // Lire MemTotal
-    while (fgets(line, sizeof(line), fp) != NULL) {
-        if (sscanf(line, "MemTotal: %lu kB", &mem_total_kb) == 1) {
-            break;
-        }
-    }
-    fclose(fp);
-    
-    if (mem_total_kb == 0) {
+    uint64_t mem_total_kb = 0, mem_available_kb = 0;
+    if (!read_meminfo_totals(&mem_total_kb, &mem_available_kb) || mem_total_kb == 0) {
         return -1.0f;
     }
     
@@ -982,4 +950,3 @@ float get_memory_total_gb(void) {
     
     return mem_total_gb;
 }
-
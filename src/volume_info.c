@@ -0,0 +1,308 @@
+/*
+ * volume_info.c
+ * Software RAID (md) and device-mapper volumes with /proc/diskstats I/O rates
+ */
+
+#include "volume_info.h"
+#include "sysroot.h"
+#include "parse_utils.h"
+#include "counter_delta.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <limits.h>
+#include <dirent.h>
+
+#define MAX_VOLUME_NAMES 256
+
+// ============================================================================
+// /proc/diskstats
+// ============================================================================
+
+// Compteurs d'une ligne de /proc/diskstats conservés par SysWatch ("unsigned long" du noyau)
+typedef struct {
+    char name[32];
+    CounterDelta read_ios;
+    CounterDelta read_sectors;
+    CounterDelta write_ios;
+    CounterDelta write_sectors;
+    BlockIoRates rates;             // Calculés à la dernière lecture
+    unsigned int generation;        // Lecture où le périphérique a été vu
+} DiskStatsEntry;
+
+static DiskStatsEntry *disk_stats = NULL;
+static int disk_stats_count = 0;
+static int disk_stats_capacity = 0;
+static unsigned int disk_stats_generation = 0;
+
+static bool entry_has_name(const DiskStatsEntry *entry, const char *name, size_t name_length) {
+    return strncmp(entry->name, name, name_length) == 0 && entry->name[name_length] == '\0';
+}
+
+// Chercher ou créer l'entrée d'un périphérique (NULL si plus de mémoire)
+// Les lignes gardent leur ordre d'une lecture à l'autre: l'entrée attendue est essayée d'abord
+static DiskStatsEntry* get_disk_stats_entry(const char *name, size_t name_length, int expected) {
+    if (expected < disk_stats_count && entry_has_name(&disk_stats[expected], name, name_length)) {
+        return &disk_stats[expected];
+    }
+    for (int i = 0; i < disk_stats_count; i++) {
+        if (entry_has_name(&disk_stats[i], name, name_length)) {
+            return &disk_stats[i];
+        }
+    }
+
+    if (disk_stats_count == disk_stats_capacity) {
+        int new_capacity = disk_stats_capacity > 0 ? disk_stats_capacity * 2 : 32;
+        DiskStatsEntry *grown = realloc(disk_stats, sizeof(DiskStatsEntry) * new_capacity);
+        if (grown == NULL) {
+            return NULL;
+        }
+        disk_stats = grown;
+        disk_stats_capacity = new_capacity;
+    }
+
+    DiskStatsEntry *entry = &disk_stats[disk_stats_count++];
+    memset(entry, 0, sizeof(*entry));
+    snprintf(entry->name, sizeof(entry->name), "%.*s", (int)name_length, name);
+    counter_delta_init(&entry->read_ios, COUNTER_BITS_LONG);
+    counter_delta_init(&entry->read_sectors, COUNTER_BITS_LONG);
+    counter_delta_init(&entry->write_ios, COUNTER_BITS_LONG);
+    counter_delta_init(&entry->write_sectors, COUNTER_BITS_LONG);
+    return entry;
+}
+
+// Une lecture pour tous les périphériques; les disparus sont oubliés
+static void sample_diskstats(void) {
+    // Tampon statique: ~100 octets par périphérique, pas d'allocation à chaque tick
+    static char buffer[65536];
+    long length = parse_read_file("/proc/diskstats", buffer, sizeof(buffer));
+    if (length <= 0) {
+        return;
+    }
+    disk_stats_generation++;
+    double now = counter_clock_seconds();
+
+    const char *end = buffer + length;
+    int index = 0;
+    for (const char *line = buffer; line < end; line = parse_next_line(line, end)) {
+        // Format: major minor nom lectures fusions secteurs ms écritures fusions secteurs ms ...
+        const char *line_end = parse_next_line(line, end);
+        uint64_t major;
+        uint64_t minor;
+        const char *cursor = parse_u64(line, line_end, &major);
+        cursor = cursor != NULL ? parse_u64(cursor, line_end, &minor) : NULL;
+        if (cursor == NULL) {
+            continue;
+        }
+        while (cursor < line_end && *cursor == ' ') {
+            cursor++;
+        }
+        const char *name = cursor;
+        while (cursor < line_end && *cursor != ' ' && *cursor != '\n') {
+            cursor++;
+        }
+        uint64_t fields[7];
+        size_t name_length = (size_t)(cursor - name);
+        if (name_length == 0 || name_length >= sizeof(disk_stats[0].name) ||
+            parse_u64_fields(cursor, line_end, fields, 7) < 7) {
+            continue;
+        }
+
+        DiskStatsEntry *entry = get_disk_stats_entry(name, name_length, index++);
+        if (entry == NULL) {
+            continue;
+        }
+        // Secteurs de 512 octets quelle que soit la taille de bloc du disque
+        entry->rates.read_iops = (float)counter_delta_rate(&entry->read_ios, fields[0], now);
+        entry->rates.read_kbps = (float)(counter_delta_rate(&entry->read_sectors, fields[2], now) / 2.0);
+        entry->rates.write_iops = (float)counter_delta_rate(&entry->write_ios, fields[4], now);
+        entry->rates.write_kbps = (float)(counter_delta_rate(&entry->write_sectors, fields[6], now) / 2.0);
+        entry->generation = disk_stats_generation;
+    }
+
+    int kept = 0;
+    for (int i = 0; i < disk_stats_count; i++) {
+        if (disk_stats[i].generation == disk_stats_generation) {
+            disk_stats[kept++] = disk_stats[i];
+        }
+    }
+    disk_stats_count = kept;
+}
+
+static void copy_rates(const char *name, BlockIoRates *rates) {
+    memset(rates, 0, sizeof(*rates));
+    for (int i = 0; i < disk_stats_count; i++) {
+        if (strcmp(disk_stats[i].name, name) == 0) {
+            *rates = disk_stats[i].rates;
+            return;
+        }
+    }
+}
+
+// ============================================================================
+// md / device-mapper
+// ============================================================================
+
+// Lire /sys/block/<volume>/<fichier> sans le saut de ligne final
+static bool read_volume_text(const char *volume, const char *file, char *text, size_t text_size) {
+    char path[PATH_MAX];
+    snprintf(path, sizeof(path), "/sys/block/%s/%s", volume, file);
+    long length = parse_read_file(path, text, text_size);
+    if (length <= 0) {
+        text[0] = '\0';
+        return false;
+    }
+    while (length > 0 && (text[length - 1] == '\n' || text[length - 1] == ' ')) {
+        text[--length] = '\0';
+    }
+    return true;
+}
+
+static uint64_t read_volume_u64(const char *volume, const char *file) {
+    char text[32];
+    uint64_t value = 0;
+    if (read_volume_text(volume, file, text, sizeof(text))) {
+        parse_u64(text, text + strlen(text), &value);
+    }
+    return value;
+}
+
+static void read_md_details(LogicalVolume *volume) {
+    char level[16];
+    read_volume_text(volume->name, "md/level", level, sizeof(level));
+    for (size_t i = 0; level[i] != '\0'; i++) {
+        level[i] = (char)toupper((unsigned char)level[i]);
+    }
+    snprintf(volume->type, sizeof(volume->type), "%s", level[0] != '\0' ? level : "md");
+    read_volume_text(volume->name, "md/array_state", volume->array_state, sizeof(volume->array_state));
+    read_volume_text(volume->name, "md/sync_action", volume->sync_action, sizeof(volume->sync_action));
+    volume->raid_disks = (int)read_volume_u64(volume->name, "md/raid_disks");
+    volume->degraded = (int)read_volume_u64(volume->name, "md/degraded");
+
+    // sync_completed: "secteurs faits / total" pendant une synchronisation, "none" sinon
+    char completed[64];
+    uint64_t done = 0;
+    uint64_t total = 0;
+    volume->sync_fraction = -1.0f;
+    if (is_volume_syncing(volume) && read_volume_text(volume->name, "md/sync_completed", completed, sizeof(completed))) {
+        const char *end = completed + strlen(completed);
+        const char *slash = strchr(completed, '/');
+        if (parse_u64(completed, end, &done) != NULL && slash != NULL &&
+            parse_u64(slash + 1, end, &total) != NULL && total > 0) {
+            volume->sync_fraction = (float)((double)done / (double)total);
+        }
+        volume->sync_kbps = (float)read_volume_u64(volume->name, "md/sync_speed");
+    }
+
+    for (int i = 0; i < volume->member_count; i++) {
+        char file[64];
+        snprintf(file, sizeof(file), "md/dev-%.31s/state", volume->members[i].member.device);
+        read_volume_text(volume->name, file, volume->members[i].state, sizeof(volume->members[i].state));
+    }
+}
+
+// Type de volume d'après le préfixe de l'uuid dm posé par l'outil qui l'a créé
+static void read_dm_details(LogicalVolume *volume) {
+    char uuid[160];
+    read_volume_text(volume->name, "dm/name", volume->label, sizeof(volume->label));
+    read_volume_text(volume->name, "dm/uuid", uuid, sizeof(uuid));
+    snprintf(volume->array_state, sizeof(volume->array_state), "%s",
+             read_volume_u64(volume->name, "dm/suspended") != 0 ? "suspended" : "active");
+    if (strncmp(uuid, "LVM-", 4) == 0) {
+        volume->kind = VOLUME_LVM;
+        snprintf(volume->type, sizeof(volume->type), "LVM");
+    } else if (strncmp(uuid, "CRYPT-", 6) == 0) {
+        // "CRYPT-LUKS2-<uuid>-<nom>", "CRYPT-PLAIN-<nom>"
+        volume->kind = VOLUME_CRYPT;
+        if (strncmp(uuid + 6, "LUKS", 4) == 0) {
+            snprintf(volume->type, sizeof(volume->type), "%.5s", uuid + 6);
+        } else {
+            snprintf(volume->type, sizeof(volume->type), "crypt");
+        }
+    } else if (strncmp(uuid, "mpath-", 6) == 0) {
+        volume->kind = VOLUME_DM;
+        snprintf(volume->type, sizeof(volume->type), "multipath");
+    } else {
+        volume->kind = VOLUME_DM;
+        snprintf(volume->type, sizeof(volume->type), "dm");
+    }
+}
+
+bool is_volume_syncing(const LogicalVolume *volume) {
+    static const char *actions[] = { "resync", "recover", "check", "repair", "reshape" };
+    if (volume == NULL || volume->kind != VOLUME_MD) {
+        return false;
+    }
+    for (size_t i = 0; i < sizeof(actions) / sizeof(actions[0]); i++) {
+        if (strcmp(volume->sync_action, actions[i]) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool is_volume_name(const char *name) {
+    return (strncmp(name, "md", 2) == 0 && isdigit((unsigned char)name[2])) || strncmp(name, "dm-", 3) == 0;
+}
+
+static int compare_names(const void *a, const void *b) {
+    return strcmp((const char *)a, (const char *)b);
+}
+
+int get_logical_volumes(LogicalVolume *volumes, int max_volumes) {
+    if (volumes == NULL || max_volumes <= 0) {
+        return 0;
+    }
+    sample_diskstats();
+
+    DIR *dir = sysroot_opendir("/sys/block");
+    if (dir == NULL) {
+        return 0;
+    }
+    static char names[MAX_VOLUME_NAMES][32];
+    int name_count = 0;
+    struct dirent *entry;
+    while ((entry = readdir(dir)) != NULL && name_count < MAX_VOLUME_NAMES) {
+        if (is_volume_name(entry->d_name) && strlen(entry->d_name) < sizeof(names[0])) {
+            snprintf(names[name_count++], sizeof(names[0]), "%.31s", entry->d_name);
+        }
+    }
+    closedir(dir);
+    qsort(names, (size_t)name_count, sizeof(names[0]), compare_names);
+
+    int count = 0;
+    for (int i = 0; i < name_count && count < max_volumes; i++) {
+        LogicalVolume *volume = &volumes[count++];
+        memset(volume, 0, sizeof(*volume));
+        snprintf(volume->name, sizeof(volume->name), "%.31s", names[i]);
+        volume->size_bytes = read_volume_u64(volume->name, "size") * 512;
+        volume->sync_fraction = -1.0f;
+        copy_rates(volume->name, &volume->io);
+
+        BlockMember members[VOLUME_MAX_MEMBERS];
+        volume->member_count = get_block_members(volume->name, members, VOLUME_MAX_MEMBERS);
+        for (int m = 0; m < volume->member_count; m++) {
+            VolumeMember *member = &volume->members[m];
+            member->member = members[m];
+            copy_rates(member->member.device, &member->io);
+            volume->member_io.read_kbps += member->io.read_kbps;
+            volume->member_io.write_kbps += member->io.write_kbps;
+            volume->member_io.read_iops += member->io.read_iops;
+            volume->member_io.write_iops += member->io.write_iops;
+        }
+        // Sans slaves, get_block_members() rend le volume lui-même: pas un membre
+        if (volume->member_count == 1 && strcmp(volume->members[0].member.device, volume->name) == 0) {
+            volume->member_count = 0;
+            memset(&volume->member_io, 0, sizeof(volume->member_io));
+        }
+
+        if (names[i][0] == 'm') {
+            volume->kind = VOLUME_MD;
+            read_md_details(volume);
+        } else {
+            read_dm_details(volume);
+        }
+    }
+    return count;
+}
@@ -0,0 +1,301 @@
+/*
+ * wireless_info.c
+ * WiFi link state over nl80211 generic netlink (no subprocess, no libnl)
+ */
+
+#include "wireless_info.h"
+#include "sysroot.h"
+#include <string.h>
+#include <stdint.h>
+#include <errno.h>
+#include <unistd.h>
+#include <net/if.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <linux/netlink.h>
+#include <linux/genetlink.h>
+#include <linux/nl80211.h>
+
+// ============================================================================
+// GENERIC NETLINK
+// ============================================================================
+
+// Socket et identifiant de famille "nl80211" conservés entre les appels
+static int genl_fd = -1;
+static uint16_t nl80211_family = 0;
+static uint32_t genl_sequence = 0;
+
+// Requête: en-têtes + quelques attributs (nom de famille ou ifindex)
+typedef struct {
+    struct nlmsghdr header;
+    struct genlmsghdr genl;
+    char attributes[64];
+} GenlRequest;
+
+// Appelé pour chaque réponse avec ses attributs de premier niveau [start, end)
+typedef void (*GenlHandler)(const char *start, const char *end, void *context);
+
+static void close_genl_socket(void) {
+    if (genl_fd >= 0) {
+        close(genl_fd);
+        genl_fd = -1;
+    }
+    nl80211_family = 0;
+}
+
+static void init_request(GenlRequest *request, uint16_t family, uint8_t command, bool dump) {
+    memset(request, 0, sizeof(*request));
+    request->header.nlmsg_len = NLMSG_LENGTH(GENL_HDRLEN);
+    request->header.nlmsg_type = family;
+    request->header.nlmsg_flags = NLM_F_REQUEST | (dump ? NLM_F_DUMP : 0);
+    request->header.nlmsg_seq = ++genl_sequence;
+    request->genl.cmd = command;
+    request->genl.version = 1;
+}
+
+static void add_attribute(GenlRequest *request, uint16_t type, const void *data, uint16_t length) {
+    struct nlattr *attribute = (struct nlattr *)((char *)request + NLMSG_ALIGN(request->header.nlmsg_len));
+    attribute->nla_type = type;
+    attribute->nla_len = (uint16_t)(NLA_HDRLEN + length);
+    memcpy((char *)attribute + NLA_HDRLEN, data, length);
+    request->header.nlmsg_len = NLMSG_ALIGN(request->header.nlmsg_len) + NLA_ALIGN(attribute->nla_len);
+}
+
+// Envoyer une requête et passer chaque réponse à handler
+// dump: lire jusqu'à NLMSG_DONE; sinon, la première réponse suffit
+static bool genl_transact(GenlRequest *request, bool dump, GenlHandler handler, void *context) {
+    if (send(genl_fd, request, request->header.nlmsg_len, 0) < 0) {
+        return false;
+    }
+
+    // Réponses d'un dump groupées par le noyau (une station ~1 Ko, un canal de survey ~100 octets)
+    static char buffer[16384] __attribute__((aligned(NLMSG_ALIGNTO)));
+    for (;;) {
+        ssize_t length = recv(genl_fd, buffer, sizeof(buffer), 0);
+        if (length < 0 && errno == EINTR) {
+            continue;
+        }
+        if (length <= 0) {
+            return false;  // Erreur ou délai de réception dépassé
+        }
+
+        int remaining = (int)length;
+        for (const struct nlmsghdr *header = (const struct nlmsghdr *)buffer; NLMSG_OK(header, remaining);
+             header = NLMSG_NEXT(header, remaining)) {
+            if (header->nlmsg_seq != request->header.nlmsg_seq) {
+                continue;  // Fin d'une réponse abandonnée plus tôt
+            }
+            if (header->nlmsg_type == NLMSG_DONE) {
+                return true;
+            }
+            if (header->nlmsg_type == NLMSG_ERROR) {
+                const struct nlmsgerr *error = NLMSG_DATA(header);
+                return header->nlmsg_len >= NLMSG_LENGTH(sizeof(*error)) && error->error == 0;
+            }
+            if (header->nlmsg_len < NLMSG_LENGTH(GENL_HDRLEN)) {
+                continue;
+            }
+            const char *start = (const char *)NLMSG_DATA(header) + GENL_HDRLEN;
+            handler(start, (const char *)header + header->nlmsg_len, context);
+            if (!dump) {
+                return true;
+            }
+        }
+    }
+}
+
+// Parcourir une liste d'attributs netlink [start, end) en s'arrêtant sur un attribut tronqué
+#define FOR_EACH_ATTRIBUTE(attribute, start, end) \
+    for (const struct nlattr *attribute = (const struct nlattr *)(start); \
+         (const char *)attribute + NLA_HDRLEN <= (end) && attribute->nla_len >= NLA_HDRLEN && \
+         (const char *)attribute + attribute->nla_len <= (end); \
+         attribute = (const struct nlattr *)((const char *)attribute + NLA_ALIGN(attribute->nla_len)))
+
+static const void* attribute_data(const struct nlattr *attribute) {
+    return (const char *)attribute + NLA_HDRLEN;
+}
+
+static int attribute_length(const struct nlattr *attribute) {
+    return attribute->nla_len - NLA_HDRLEN;
+}
+
+static const char* attribute_end(const struct nlattr *attribute) {
+    return (const char *)attribute + attribute->nla_len;
+}
+
+static void on_family(const char *start, const char *end, void *context) {
+    uint16_t *family = context;
+    FOR_EACH_ATTRIBUTE(attribute, start, end) {
+        if (attribute->nla_type == CTRL_ATTR_FAMILY_ID && attribute_length(attribute) >= 2) {
+            memcpy(family, attribute_data(attribute), sizeof(*family));
+        }
+    }
+}
+
+// Ouvrir le socket et résoudre l'identifiant de la famille nl80211 (une fois)
+static bool open_nl80211(void) {
+    if (genl_fd >= 0 && nl80211_family != 0) {
+        return true;
+    }
+
+    genl_fd = socket(AF_NETLINK, SOCK_RAW | SOCK_CLOEXEC, NETLINK_GENERIC);
+    if (genl_fd < 0) {
+        return false;
+    }
+    // Firmware muet (brcmfmac en veille...): ne jamais bloquer le thread des collecteurs
+    struct timeval timeout = { .tv_sec = 1, .tv_usec = 0 };
+    setsockopt(genl_fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+    GenlRequest request;
+    init_request(&request, GENL_ID_CTRL, CTRL_CMD_GETFAMILY, false);
+    add_attribute(&request, CTRL_ATTR_FAMILY_NAME, NL80211_GENL_NAME, sizeof(NL80211_GENL_NAME));
+    if (!genl_transact(&request, false, on_family, &nl80211_family) || nl80211_family == 0) {
+        close_genl_socket();  // Noyau sans cfg80211: aucune interface WiFi
+        return false;
+    }
+    return true;
+}
+
+// ============================================================================
+// NL80211
+// ============================================================================
+
+// Débit (100 kb/s) et MCS d'un attribut NL80211_STA_INFO_TX/RX_BITRATE
+static void parse_rate_info(const struct nlattr *rate, float *bitrate_mbps, int *mcs) {
+    *mcs = -1;
+    FOR_EACH_ATTRIBUTE(attribute, attribute_data(rate), attribute_end(rate)) {
+        int length = attribute_length(attribute);
+        const uint8_t *data = attribute_data(attribute);
+        switch (attribute->nla_type) {
+            case NL80211_RATE_INFO_BITRATE32:
+                if (length >= 4) {
+                    uint32_t value;
+                    memcpy(&value, data, sizeof(value));
+                    *bitrate_mbps = (float)value / 10.0f;
+                }
+                break;
+            case NL80211_RATE_INFO_BITRATE:
+                // 16 bits: ignoré si BITRATE32 (débits > 6,5 Gb/s) est aussi présent
+                if (length >= 2 && *bitrate_mbps == 0.0f) {
+                    uint16_t value;
+                    memcpy(&value, data, sizeof(value));
+                    *bitrate_mbps = (float)value / 10.0f;
+                }
+                break;
+            case NL80211_RATE_INFO_MCS:
+            case NL80211_RATE_INFO_VHT_MCS:
+            case NL80211_RATE_INFO_HE_MCS:
+                if (length >= 1) {
+                    *mcs = data[0];
+                }
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+// Réponse de NL80211_CMD_GET_STATION: le point d'accès en mode station (première station retenue)
+static void on_station(const char *start, const char *end, void *context) {
+    WirelessLinkInfo *info = context;
+    if (info->connected) {
+        return;
+    }
+    FOR_EACH_ATTRIBUTE(attribute, start, end) {
+        if (attribute->nla_type != NL80211_ATTR_STA_INFO) {
+            continue;
+        }
+        info->connected = true;
+        FOR_EACH_ATTRIBUTE(station, attribute_data(attribute), attribute_end(attribute)) {
+            switch (station->nla_type) {
+                case NL80211_STA_INFO_SIGNAL:
+                    if (attribute_length(station) >= 1) {
+                        info->signal_dbm = *(const int8_t *)attribute_data(station);
+                    }
+                    break;
+                case NL80211_STA_INFO_TX_BITRATE:
+                    parse_rate_info(station, &info->tx_bitrate_mbps, &info->tx_mcs);
+                    break;
+                case NL80211_STA_INFO_RX_BITRATE:
+                    parse_rate_info(station, &info->rx_bitrate_mbps, &info->rx_mcs);
+                    break;
+                default:
+                    break;
+            }
+        }
+    }
+}
+
+// Réponse de NL80211_CMD_GET_INTERFACE: canal courant
+static void on_interface(const char *start, const char *end, void *context) {
+    WirelessLinkInfo *info = context;
+    FOR_EACH_ATTRIBUTE(attribute, start, end) {
+        if (attribute->nla_type == NL80211_ATTR_WIPHY_FREQ && attribute_length(attribute) >= 4) {
+            uint32_t frequency;
+            memcpy(&frequency, attribute_data(attribute), sizeof(frequency));
+            info->frequency_mhz = (int)frequency;
+        }
+    }
+}
+
+// Réponses de NL80211_CMD_GET_SURVEY: bruit du canal marqué "en service"
+static void on_survey(const char *start, const char *end, void *context) {
+    WirelessLinkInfo *info = context;
+    FOR_EACH_ATTRIBUTE(attribute, start, end) {
+        if (attribute->nla_type != NL80211_ATTR_SURVEY_INFO) {
+            continue;
+        }
+        bool in_use = false;
+        int noise = 0;
+        FOR_EACH_ATTRIBUTE(survey, attribute_data(attribute), attribute_end(attribute)) {
+            if (survey->nla_type == NL80211_SURVEY_INFO_IN_USE) {
+                in_use = true;
+            } else if (survey->nla_type == NL80211_SURVEY_INFO_NOISE && attribute_length(survey) >= 1) {
+                noise = *(const int8_t *)attribute_data(survey);
+            }
+        }
+        if (in_use) {
+            info->noise_dbm = noise;
+        }
+    }
+}
+
+static bool request_for_interface(uint8_t command, bool dump, uint32_t ifindex,
+                                  GenlHandler handler, WirelessLinkInfo *info) {
+    GenlRequest request;
+    init_request(&request, nl80211_family, command, dump);
+    add_attribute(&request, NL80211_ATTR_IFINDEX, &ifindex, sizeof(ifindex));
+    return genl_transact(&request, dump, handler, info);
+}
+
+bool get_wireless_link_info(const char *interface_name, WirelessLinkInfo *info) {
+    if (info == NULL) {
+        return false;
+    }
+    memset(info, 0, sizeof(*info));
+    info->tx_mcs = -1;
+    info->rx_mcs = -1;
+
+    if (interface_name == NULL || sysroot_is_set()) {
+        return false;
+    }
+    uint32_t ifindex = if_nametoindex(interface_name);
+    if (ifindex == 0 || !open_nl80211()) {
+        return false;
+    }
+
+    // GET_INTERFACE échoue (ENODEV/EOPNOTSUPP) pour une interface non cfg80211
+    if (!request_for_interface(NL80211_CMD_GET_INTERFACE, false, ifindex, on_interface, info)) {
+        return false;
+    }
+    if (!request_for_interface(NL80211_CMD_GET_STATION, true, ifindex, on_station, info)) {
+        return false;
+    }
+    if (!info->connected) {
+        info->frequency_mhz = 0;
+        return true;
+    }
+    // Survey facultatif (non fourni par certains pilotes): bruit inconnu seulement
+    request_for_interface(NL80211_CMD_GET_SURVEY, true, ifindex, on_survey, info);
+    return true;
+}